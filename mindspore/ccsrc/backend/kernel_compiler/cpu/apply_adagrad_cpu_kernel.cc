@@ -16,7 +16,6 @@
 
 #include "backend/kernel_compiler/cpu/apply_adagrad_cpu_kernel.h"
 
-#include <thread>
 #include <vector>
 
 namespace mindspore {
@@ -75,27 +74,8 @@ void ApplyAdagradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs)
 
   // multithreading
   size_t length = inputs[0]->size / sizeof(T);
-  size_t max_thread_num = std::thread::hardware_concurrency();
-  size_t use_thread_num = length < 128 * max_thread_num ? std::ceil(length / 128.0) : max_thread_num;
-  std::vector<std::thread> threads;
-  threads.reserve(use_thread_num);
-  size_t start = 0;
-  const size_t batch_size = (length + use_thread_num - 1) / use_thread_num;
-
-  if (batch_size == 0) {
-    MS_LOG(EXCEPTION) << "Error occur in launch kernel";
-    return;
-  }
-  while (start < length) {
-    size_t end = (start + batch_size) > length ? length : (start + batch_size);
-    threads.emplace_back(
-      std::thread(&ApplyAdagradCPUKernel::LaunchApplyAdagrad<T *>, this, var, accum, lr, gradient, start, end));
-    start += batch_size;
-  }
-
-  for (auto &it : threads) {
-    it.join();
-  }
+  auto task = [&](size_t start, size_t end) { LaunchApplyAdagrad(var, accum, lr, gradient, start, end); };
+  CPUKernelUtils::ParallelFor(task, length, kElementwiseGrainSize);
 }
 
 template <typename T>
@@ -15,12 +15,25 @@
  */
 #include <cmath>
 #include <string>
-#include <thread>
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// Result of a division by zero: NaN for 0 / 0, else the infinity or the limit of the sign of the dividend
+template <typename T>
+T DivideByZero(T dividend) {
+  if (dividend == 0) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  if (std::numeric_limits<T>::has_infinity) {
+    return dividend > 0 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
+  }
+  return dividend > 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+}
+}  // namespace
+
 template <typename T>
 void ArithmeticCPUKernel::AssignAdd(T *input1, const T *input2, T *out, size_t start, size_t end) {
   for (size_t i = start; i < end; i++) {
@@ -31,190 +44,95 @@ void ArithmeticCPUKernel::AssignAdd(T *input1, const T *input2, T *out, size_t s
 
 template <typename T>
 void ArithmeticCPUKernel::Add(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] + input2[idx[1]];
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) { return x + y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Sub(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] - input2[idx[1]];
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) { return x - y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Mul(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] * input2[idx[1]];
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) { return x * y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::RealDiv(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto dividend = input1[idx[0]];
-    auto divisor = input2[idx[1]];
-    if (divisor == 0) {
-      if (dividend == 0) {
-        out[i] = std::numeric_limits<T>::quiet_NaN();
-        continue;
-      }
-      if (std::numeric_limits<T>::has_infinity) {
-        out[i] = dividend > 0 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-      } else {
-        out[i] = dividend > 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-      }
-      continue;
-    }
-    out[i] = dividend / divisor;
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end,
+                             [](T x, T y) { return y == 0 ? DivideByZero(x) : static_cast<T>(x / y); });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Div(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto dividend = input1[idx[0]];
-    auto divisor = input2[idx[1]];
-    if (divisor == 0) {
-      if (dividend == 0) {
-        out[i] = std::numeric_limits<T>::quiet_NaN();
-        continue;
-      }
-      if (std::numeric_limits<T>::has_infinity) {
-        out[i] = dividend > 0 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-      } else {
-        out[i] = dividend > 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-      }
-      continue;
-    }
-    out[i] = dividend / divisor;
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end,
+                             [](T x, T y) { return y == 0 ? DivideByZero(x) : static_cast<T>(x / y); });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::FloorDiv(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto dividend = input1[idx[0]];
-    auto divisor = input2[idx[1]];
-    if (divisor == 0) {
-      if (dividend == 0) {
-        out[i] = std::numeric_limits<T>::quiet_NaN();
-        continue;
-      }
-      if (std::numeric_limits<T>::has_infinity) {
-        out[i] = dividend > 0 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-      } else {
-        out[i] = dividend > 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-      }
-      continue;
-    }
-    out[i] = floor(dividend / divisor);
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end,
+                             [](T x, T y) { return y == 0 ? DivideByZero(x) : static_cast<T>(floor(x / y)); });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Mod(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto x = static_cast<double>(input1[idx[0]]);
-    auto y = static_cast<double>(input2[idx[1]]);
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T input_x, T input_y) {
+    auto x = static_cast<double>(input_x);
+    auto y = static_cast<double>(input_y);
     auto data_div = x / y;
     auto data_div_min = data_div < 0.0 ? data_div : 0.0;
     auto data_div_max = data_div > 0.0 ? data_div : 0.0;
     auto data_div_max_floor = floor(data_div_max);
     auto data_div_min_ceil = ceil(data_div_min);
     auto data_div_res = data_div_max_floor + data_div_min_ceil;
-    out[i] = static_cast<T>(x - data_div_res * y);
-  }
+    return static_cast<T>(x - data_div_res * y);
+  });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Pow(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto x = static_cast<double>(input1[idx[0]]);
-    auto y = static_cast<double>(input2[idx[1]]);
-    out[i] = static_cast<T>(std::pow(x, y));
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) {
+    return static_cast<T>(std::pow(static_cast<double>(x), static_cast<double>(y)));
+  });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Less(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] < input2[idx[1]];
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) { return x < y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Equal(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] == input2[idx[1]];
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) { return x == y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::NotEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] != input2[idx[1]];
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) { return x != y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::SquaredDifference(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    T diff = input1[idx[0]] - input2[idx[1]];
-    out[i] = diff * diff;
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) {
+    T diff = x - y;
+    return static_cast<T>(diff * diff);
+  });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::Greater(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] > input2[idx[1]];
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) { return x > y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::GreaterEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] >= input2[idx[1]];
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) { return x >= y; });
 }
 
 template <typename T>
 void ArithmeticCPUKernel::LessEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] <= input2[idx[1]];
-  }
+  broadcast_iterator_->Apply(input1, input2, out, start, end, [](T x, T y) { return x <= y; });
 }
 
 void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -270,9 +188,7 @@ void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   for (size_t i = 0; i < output_shape_.size() - l; ++i) {
     input_shape1_.insert(input_shape1_.begin(), 1);
   }
-  CPUKernelUtils::GetElementNumEveryDim(input_shape0_, &input_element_num0_);
-  CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
-  CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+  broadcast_iterator_ = std::make_shared<BroadcastIterator>(input_shape0_, input_shape1_, output_shape_);
   dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 1)) {
     MS_LOG(EXCEPTION) << "Input0 and input1 must has the same data type";
@@ -297,37 +213,6 @@ bool ArithmeticCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   return true;
 }
 
-void ArithmeticCPUKernel::GenIndex(size_t num, std::vector<size_t> *idx) {
-  std::vector<size_t> tmp;
-  for (size_t i = 0; i < output_shape_.size() - 1; ++i) {
-    if (output_element_num_[i] > num) {
-      tmp.push_back(0);
-    } else {
-      tmp.push_back(num / output_element_num_[i]);
-      num %= output_element_num_[i];
-    }
-  }
-  tmp.push_back(num);
-  size_t idx0 = 0;
-  size_t idx1 = 0;
-  for (size_t k = 0; k < tmp.size() - 1; ++k) {
-    if (input_shape0_[k] > 1) {
-      idx0 += tmp[k] * input_element_num0_[k];
-    }
-    if (input_shape1_[k] > 1) {
-      idx1 += tmp[k] * input_element_num1_[k];
-    }
-  }
-  if (input_shape0_[tmp.size() - 1] > 1) {
-    idx0 += tmp[tmp.size() - 1];
-  }
-  if (input_shape1_[tmp.size() - 1] > 1) {
-    idx1 += tmp[tmp.size() - 1];
-  }
-  idx->push_back(idx0);
-  idx->push_back(idx1);
-}
-
 template <typename T>
 void ArithmeticCPUKernel::LaunchKernelLogic(const std::vector<AddressPtr> &inputs,
                                             const std::vector<AddressPtr> &outputs) {
@@ -336,44 +221,23 @@ void ArithmeticCPUKernel::LaunchKernelLogic(const std::vector<AddressPtr> &input
   bool *output = reinterpret_cast<bool *>(outputs[0]->addr);
 
   size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(bool)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == LESS) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Less<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == EQUAL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Equal<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == NOTEQUAL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::NotEqual<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == GREATER) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Greater<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == GREATEREQUAL) {
-      threads.emplace_back(
-        std::thread(&ArithmeticCPUKernel::GreaterEqual<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == LESSEQUAL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::LessEqual<T>, this, input1, input2, output, start, end));
-    } else {
-      MS_LOG(EXCEPTION) << "Not support " << operate_type_;
-    }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  CTask task;
+  if (operate_type_ == LESS) {
+    task = [&](size_t start, size_t end) { Less<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == EQUAL) {
+    task = [&](size_t start, size_t end) { Equal<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == NOTEQUAL) {
+    task = [&](size_t start, size_t end) { NotEqual<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == GREATER) {
+    task = [&](size_t start, size_t end) { Greater<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == GREATEREQUAL) {
+    task = [&](size_t start, size_t end) { GreaterEqual<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == LESSEQUAL) {
+    task = [&](size_t start, size_t end) { LessEqual<T>(input1, input2, output, start, end); };
+  } else {
+    MS_LOG(EXCEPTION) << "Not support " << operate_type_;
   }
+  CPUKernelUtils::ParallelFor(task, lens, kElementwiseGrainSize);
 }
 
 template <typename T>
@@ -387,52 +251,31 @@ void ArithmeticCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, co
   T *output = reinterpret_cast<T *>(outputs[0]->addr);
 
   size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(T)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == ADD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Add<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == SUB) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Sub<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == MUL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Mul<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == REALDIV) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::RealDiv<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == DIV) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Div<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == FLOORDIV) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::FloorDiv<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == MOD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Mod<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == POW) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Pow<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == ASSIGNADD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::AssignAdd<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == SQUAREDDIFFERENCE) {
-      threads.emplace_back(
-        std::thread(&ArithmeticCPUKernel::SquaredDifference<T>, this, input1, input2, output, start, end));
-    } else {
-      MS_LOG(EXCEPTION) << "Not support " << operate_type_;
-    }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  CTask task;
+  if (operate_type_ == ADD) {
+    task = [&](size_t start, size_t end) { Add<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == SUB) {
+    task = [&](size_t start, size_t end) { Sub<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == MUL) {
+    task = [&](size_t start, size_t end) { Mul<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == REALDIV) {
+    task = [&](size_t start, size_t end) { RealDiv<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == DIV) {
+    task = [&](size_t start, size_t end) { Div<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == FLOORDIV) {
+    task = [&](size_t start, size_t end) { FloorDiv<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == MOD) {
+    task = [&](size_t start, size_t end) { Mod<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == POW) {
+    task = [&](size_t start, size_t end) { Pow<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == ASSIGNADD) {
+    task = [&](size_t start, size_t end) { AssignAdd<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == SQUAREDDIFFERENCE) {
+    task = [&](size_t start, size_t end) { SquaredDifference<T>(input1, input2, output, start, end); };
+  } else {
+    MS_LOG(EXCEPTION) << "Not support " << operate_type_;
   }
+  CPUKernelUtils::ParallelFor(task, lens, kElementwiseGrainSize);
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -18,6 +18,7 @@
 #include <memory>
 #include <vector>
 #include <limits>
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
@@ -38,7 +39,6 @@ class ArithmeticCPUKernel : public CPUKernel {
   void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
 
  private:
-  void GenIndex(size_t num, std::vector<size_t> *tmp);
   template <typename T>
   void Sub(const T *input1, const T *input2, T *out, size_t start, size_t end);
   template <typename T>
@@ -73,10 +73,8 @@ class ArithmeticCPUKernel : public CPUKernel {
   void LessEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end);
   std::vector<size_t> input_shape0_;
   std::vector<size_t> input_shape1_;
-  std::vector<size_t> input_element_num0_;
-  std::vector<size_t> input_element_num1_;
   std::vector<size_t> output_shape_;
-  std::vector<size_t> output_element_num_;
+  std::shared_ptr<BroadcastIterator> broadcast_iterator_{nullptr};
   OperateType operate_type_{ADD};
   TypeId dtype_{kTypeUnknown};
   TypeId target_dtype_{kTypeUnknown};
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+BroadcastIterator::BroadcastIterator(const std::vector<size_t> &input_shape_a,
+                                     const std::vector<size_t> &input_shape_b,
+                                     const std::vector<size_t> &output_shape) {
+  size_t rank = output_shape.size();
+  if (input_shape_a.size() > rank || input_shape_b.size() > rank) {
+    MS_LOG(EXCEPTION) << "The inputs have more dimensions than the output, input0 " << input_shape_a.size()
+                      << ", input1 " << input_shape_b.size() << ", output " << rank;
+  }
+  // Align the input shapes on the last dimension of the output
+  std::vector<size_t> shape_a(rank - input_shape_a.size(), 1);
+  shape_a.insert(shape_a.end(), input_shape_a.begin(), input_shape_a.end());
+  std::vector<size_t> shape_b(rank - input_shape_b.size(), 1);
+  shape_b.insert(shape_b.end(), input_shape_b.begin(), input_shape_b.end());
+
+  std::vector<bool> broadcast_a;
+  std::vector<bool> broadcast_b;
+  for (size_t d = 0; d < rank; ++d) {
+    if ((shape_a[d] != 1 && shape_a[d] != output_shape[d]) || (shape_b[d] != 1 && shape_b[d] != output_shape[d])) {
+      MS_LOG(EXCEPTION) << "Dimension " << d << " of the inputs, " << shape_a[d] << " and " << shape_b[d]
+                        << ", can not be broadcast to " << output_shape[d];
+    }
+    output_size_ *= output_shape[d];
+    if (output_shape[d] == 1) {
+      continue;
+    }
+    bool bcast_a = shape_a[d] == 1;
+    bool bcast_b = shape_b[d] == 1;
+    if (!shape_.empty() && broadcast_a.back() == bcast_a && broadcast_b.back() == bcast_b) {
+      shape_.back() *= output_shape[d];
+      continue;
+    }
+    shape_.push_back(output_shape[d]);
+    broadcast_a.push_back(bcast_a);
+    broadcast_b.push_back(bcast_b);
+  }
+  if (shape_.empty()) {
+    shape_.push_back(1);
+    broadcast_a.push_back(false);
+    broadcast_b.push_back(false);
+  }
+
+  strides_a_.resize(shape_.size(), 0);
+  strides_b_.resize(shape_.size(), 0);
+  size_t stride_a = 1;
+  size_t stride_b = 1;
+  for (size_t d = shape_.size(); d-- > 0;) {
+    if (!broadcast_a[d]) {
+      strides_a_[d] = stride_a;
+      stride_a *= shape_[d];
+    }
+    if (!broadcast_b[d]) {
+      strides_b_[d] = stride_b;
+      stride_b *= shape_[d];
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
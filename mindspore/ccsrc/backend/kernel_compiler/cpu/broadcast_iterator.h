@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_BROADCAST_ITERATOR_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_BROADCAST_ITERATOR_H_
+#include <algorithm>
+#include <vector>
+
+namespace mindspore {
+namespace kernel {
+// Offsets of two inputs broadcast to the shape of an output. The dimensions of size 1 in the output are dropped and
+// the neighbouring dimensions which both inputs broadcast the same way are merged, then the strides of each input
+// are computed once, 0 on a broadcast dimension. The output is walked in runs along the innermost dimension, where
+// the step of each input is 0 or 1, and the offsets are only updated at the end of a run.
+class BroadcastIterator {
+ public:
+  // Raise an exception if an input has more dimensions than the output, or can not be broadcast to it
+  BroadcastIterator(const std::vector<size_t> &input_shape_a, const std::vector<size_t> &input_shape_b,
+                    const std::vector<size_t> &output_shape);
+  ~BroadcastIterator() = default;
+
+  size_t output_size() const { return output_size_; }
+
+  // Call task(output_offset, a_offset, b_offset, a_step, b_step, count) for every run of the output items
+  // [start, end) along the innermost dimension.
+  template <typename Task>
+  void ForEachRun(size_t start, size_t end, const Task &task) const;
+
+  // out[i] = op(a[i'], b[i'']) for the output items [start, end), i' and i'' being the broadcast offsets of i.
+  template <typename T, typename S, typename Op>
+  void Apply(const T *a, const T *b, S *out, size_t start, size_t end, const Op &op) const;
+
+ private:
+  std::vector<size_t> shape_;
+  std::vector<size_t> strides_a_;
+  std::vector<size_t> strides_b_;
+  size_t output_size_{1};
+};
+
+template <typename Task>
+void BroadcastIterator::ForEachRun(size_t start, size_t end, const Task &task) const {
+  end = std::min(end, output_size_);
+  if (start >= end) {
+    return;
+  }
+  size_t rank = shape_.size();
+  size_t inner = shape_[rank - 1];
+  size_t a_step = strides_a_[rank - 1];
+  size_t b_step = strides_b_[rank - 1];
+  // Coordinates of the first item, the only divisions of the walk
+  std::vector<size_t> coord(rank, 0);
+  size_t a_base = 0;
+  size_t b_base = 0;
+  size_t rest = start;
+  for (size_t d = rank; d-- > 0;) {
+    coord[d] = rest % shape_[d];
+    rest /= shape_[d];
+    if (d + 1 < rank) {
+      a_base += coord[d] * strides_a_[d];
+      b_base += coord[d] * strides_b_[d];
+    }
+  }
+  size_t pos = start;
+  while (pos < end) {
+    size_t inner_pos = coord[rank - 1];
+    size_t count = std::min(inner - inner_pos, end - pos);
+    task(pos, a_base + inner_pos * a_step, b_base + inner_pos * b_step, a_step, b_step, count);
+    pos += count;
+    coord[rank - 1] = 0;
+    for (size_t d = rank - 1; d-- > 0;) {
+      a_base += strides_a_[d];
+      b_base += strides_b_[d];
+      if (++coord[d] < shape_[d]) {
+        break;
+      }
+      a_base -= coord[d] * strides_a_[d];
+      b_base -= coord[d] * strides_b_[d];
+      coord[d] = 0;
+    }
+  }
+}
+
+template <typename T, typename S, typename Op>
+void BroadcastIterator::Apply(const T *a, const T *b, S *out, size_t start, size_t end, const Op &op) const {
+  // Each step pattern gets its own loop over plain pointers, which the compiler can vectorize
+  ForEachRun(start, end,
+             [a, b, out, &op](size_t out_offset, size_t a_offset, size_t b_offset, size_t a_step, size_t b_step,
+                              size_t count) {
+               const T *x = a + a_offset;
+               const T *y = b + b_offset;
+               S *z = out + out_offset;
+               if (a_step == 1 && b_step == 1) {
+                 for (size_t k = 0; k < count; ++k) {
+                   z[k] = op(x[k], y[k]);
+                 }
+               } else if (a_step == 1) {
+                 const T y0 = y[0];
+                 for (size_t k = 0; k < count; ++k) {
+                   z[k] = op(x[k], y0);
+                 }
+               } else if (b_step == 1) {
+                 const T x0 = x[0];
+                 for (size_t k = 0; k < count; ++k) {
+                   z[k] = op(x0, y[k]);
+                 }
+               } else {
+                 const S z0 = op(x[0], y[0]);
+                 for (size_t k = 0; k < count; ++k) {
+                   z[k] = z0;
+                 }
+               }
+             });
+}
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_BROADCAST_ITERATOR_H_
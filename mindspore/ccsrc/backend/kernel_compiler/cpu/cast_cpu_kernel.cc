@@ -16,7 +16,6 @@
 #include <cmath>
 #include <map>
 #include <string>
-#include <thread>
 #include "backend/kernel_compiler/cpu/cast_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
@@ -36,29 +35,8 @@ void LaunchCast(const std::vector<kernel::AddressPtr> &inputs, const std::vector
   MS_LOG(DEBUG) << "Type source: " << typeid(S).name() << "; target: " << typeid(T).name();
 
   size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(T)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    threads.emplace_back(std::thread(Cast<S, T>, input, output, start, end));
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  auto task = [&](size_t start, size_t end) { Cast<S, T>(input, output, start, end); };
+  CPUKernelUtils::ParallelFor(task, lens, kElementwiseGrainSize);
 }
 
 void CastCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include <algorithm>
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -80,21 +82,32 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   std::reverse(element_num->begin(), element_num->end());
 }
 
-void CPUKernelUtils::ParallelFor(const CTask &task, size_t count) {
-  auto max_thread_num = std::thread::hardware_concurrency();
-  const float block_size = 128.0;
-  size_t thread_num = count < block_size * max_thread_num ? std::ceil(count / block_size) : max_thread_num;
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  size_t start = 0;
+void CPUKernelUtils::ParallelFor(const CTask &task, size_t count, size_t grain_size) {
+  if (count == 0) {
+    return;
+  }
+  grain_size = std::max(grain_size, static_cast<size_t>(1));
+  // The thread calling SyncRun runs tasks too
+  size_t max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum() + 1;
+  size_t thread_num = std::min(max_thread_num, (count + grain_size - 1) / grain_size);
+  if (thread_num <= 1) {
+    task(0, count);
+    return;
+  }
   size_t once_compute_size = (count + thread_num - 1) / thread_num;
+  std::vector<common::Task> tasks;
+  tasks.reserve(thread_num);
+  size_t start = 0;
   while (start < count) {
     size_t end = (start + once_compute_size) > count ? count : (start + once_compute_size);
-    threads.emplace_back(std::thread(task, start, end));
+    tasks.emplace_back([&task, start, end]() {
+      task(start, end);
+      return common::SUCCESS;
+    });
     start += once_compute_size;
   }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  if (!common::ThreadPool::GetInstance().SyncRun(tasks)) {
+    MS_LOG(EXCEPTION) << "Fail to run " << tasks.size() << " tasks of " << count << " items in the thread pool.";
   }
 }
 
@@ -57,6 +57,11 @@ const char START[] = "start";
 const char LIMIT[] = "limit";
 const char DELTA[] = "delta";
 
+// Fewest items given to one thread by ParallelFor
+const size_t kDefaultGrainSize = 128;
+// Elementwise kernels do little work per item, a thread gets more of them
+const size_t kElementwiseGrainSize = 4096;
+
 enum OperateType {
   ADD = 0,
   SUB,
@@ -121,7 +126,8 @@ class CPUKernelUtils {
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
-  static void ParallelFor(const CTask &task, size_t count);
+  // Split [0, count) into ranges of at least grain_size items and run them in the shared thread pool
+  static void ParallelFor(const CTask &task, size_t count, size_t grain_size = kDefaultGrainSize);
   static std::vector<size_t> FlatShapeByAxis(const std::vector<size_t> &shape, int axis);
 };
 }  // namespace kernel
@@ -19,6 +19,7 @@
 #include <memory>
 #include <unordered_map>
 #include <vector>
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
@@ -44,6 +45,7 @@ class MaximumGradCPUKernel : public CPUKernel {
   std::vector<size_t> dout_shape;
   std::vector<size_t> dx_shape;
   std::vector<size_t> dy_shape;
+  std::shared_ptr<BroadcastIterator> broadcast_iterator_{nullptr};
   TypeId dtype_{kTypeUnknown};
 };
 
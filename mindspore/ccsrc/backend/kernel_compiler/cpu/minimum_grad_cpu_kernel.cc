@@ -21,18 +21,6 @@
 namespace mindspore {
 namespace kernel {
 namespace {
-void GetCargo(std::vector<size_t> *cargo, const std::vector<size_t> &shape, const std::vector<size_t> &dout_shape) {
-  int i = dout_shape.size() - 1;
-  int j = shape.size() - 1;
-  (*cargo)[i] = 1;
-  for (--i; j >= 1; --i, --j) {
-    (*cargo)[i] = shape[j] * (*cargo)[i + 1];
-  }
-  for (; i >= 0; i--) {
-    (*cargo)[i] = 1;
-  }
-}
-
 size_t GetTensorLen(const std::vector<size_t> &shape) {
   size_t len = 1;
   for (size_t i = 0; i < shape.size(); i++) {
@@ -40,14 +28,6 @@ size_t GetTensorLen(const std::vector<size_t> &shape) {
   }
   return len;
 }
-
-void GetShape(std::vector<size_t> *shape, const std::vector<size_t> &shape_, const std::vector<size_t> &dout_shape) {
-  int k = dout_shape.size() - 1;
-  int i = shape_.size() - 1;
-  for (; i >= 0; i--, k--) {
-    (*shape)[k] = shape_[i];
-  }
-}
 }  // namespace
 
 void MinimumGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -61,6 +41,7 @@ void MinimumGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (!x_shape_.size() || !y_shape_.size() || !dout_shape.size()) {
     MS_LOG(EXCEPTION) << "Input NULL";
   }
+  broadcast_iterator_ = std::make_shared<BroadcastIterator>(x_shape_, y_shape_, dout_shape);
 }
 
 bool MinimumGradCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -82,29 +63,6 @@ bool MinimumGradCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   return true;
 }
 
-template <typename T>
-void MinimumGradRecTask(T *x, T *y, T *dout, T *dx, T *dy, size_t dim, size_t x_index, size_t y_index,
-                        size_t dout_index, const std::vector<size_t> &x_cargo, const std::vector<size_t> &y_cargo,
-                        const std::vector<size_t> &dout_cargo, const std::vector<size_t> &x_shape,
-                        const std::vector<size_t> &y_shape, const std::vector<size_t> &dout_shape) {
-  for (size_t i = 0; i < dout_shape[dim]; i++) {
-    size_t x_i = x_shape[dim] == dout_shape[dim] ? i * x_cargo[dim] : 0;
-    size_t y_i = y_shape[dim] == dout_shape[dim] ? i * y_cargo[dim] : 0;
-    size_t dout_i = i * dout_cargo[dim];
-
-    if (dim == dout_shape.size() - 1) {
-      if (*(x + x_index + x_i) <= *(y + y_index + y_i)) {
-        *(dx + x_index + x_i) += *(dout + dout_index + i);
-      } else {
-        *(dy + y_index + y_i) += *(dout + dout_index + i);
-      }
-    } else {
-      MinimumGradRecTask(x, y, dout, dx, dy, dim + 1, x_index + x_i, y_index + y_i, dout_index + dout_i, x_cargo,
-                         y_cargo, dout_cargo, x_shape, y_shape, dout_shape);
-    }
-  }
-}
-
 template <typename T>
 void MinimumGradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) {
   auto x_addr = reinterpret_cast<T *>(inputs[0]->addr);
@@ -118,21 +76,21 @@ void MinimumGradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, c
   memset(dx_addr, 0, x_tensor_len * sizeof(T));
   memset(dy_addr, 0, y_tensor_len * sizeof(T));
 
-  std::vector<size_t> x_shape(dout_shape.size(), 1);
-  std::vector<size_t> y_shape(dout_shape.size(), 1);
-  std::vector<size_t> x_cargo(dout_shape.size(), 0);
-  std::vector<size_t> y_cargo(dout_shape.size(), 0);
-  std::vector<size_t> dout_cargo(dout_shape.size(), 0);
-
-  GetShape(&x_shape, x_shape_, dout_shape);
-  GetShape(&y_shape, y_shape_, dout_shape);
-
-  GetCargo(&x_cargo, x_shape, dout_shape);
-  GetCargo(&y_cargo, y_shape, dout_shape);
-  GetCargo(&dout_cargo, dout_shape, dout_shape);
-
-  MinimumGradRecTask<T>(x_addr, y_addr, dout_addr, dx_addr, dy_addr, 0, 0, 0, 0, x_cargo, y_cargo, dout_cargo, x_shape,
-                        y_shape, dout_shape);
+  // The items of dout broadcast from the same item of x or y add up, so the walk stays in one thread
+  MS_EXCEPTION_IF_NULL(broadcast_iterator_);
+  broadcast_iterator_->ForEachRun(
+    0, broadcast_iterator_->output_size(),
+    [=](size_t dout_offset, size_t x_offset, size_t y_offset, size_t x_step, size_t y_step, size_t count) {
+      for (size_t k = 0; k < count; ++k) {
+        size_t x_i = x_offset + k * x_step;
+        size_t y_i = y_offset + k * y_step;
+        if (x_addr[x_i] <= y_addr[y_i]) {
+          dx_addr[x_i] += dout_addr[dout_offset + k];
+        } else {
+          dy_addr[y_i] += dout_addr[dout_offset + k];
+        }
+      }
+    });
 }
 
 void MinimumGradCPUKernel::CheckParam(const CNodePtr &kernel_node) {
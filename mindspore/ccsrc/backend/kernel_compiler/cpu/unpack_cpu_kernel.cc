@@ -64,28 +64,8 @@ void UnpackCPUKernel<T>::LaunchKernel(const std::vector<AddressPtr> &inputs,
     outputs_host_[i] = reinterpret_cast<T *>(outputs[i]->addr);
     MS_EXCEPTION_IF_NULL(outputs_host_[i]);
   }
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = input_size_ < 128 * max_thread_num ? std::ceil(input_size_ / 128.0) : max_thread_num;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num" << thread_num;
-    return;
-  }
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t one_gap = (input_size_ + thread_num - 1) / thread_num;
-  if (one_gap < 1) {
-    MS_LOG(ERROR) << "Invalid value: one_gap " << one_gap;
-    return;
-  }
-  while (start < input_size_) {
-    size_t end = (start + one_gap) > input_size_ ? input_size_ : (start + one_gap);
-    threads.emplace_back(std::thread(&UnpackCPUKernel::UnpackResult, this, start, end));
-    start += one_gap;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  auto task = [this](size_t start, size_t end) { UnpackResult(start, end); };
+  CPUKernelUtils::ParallelFor(task, input_size_, kElementwiseGrainSize);
 }
 
 template <typename T>
@@ -15,11 +15,16 @@
  */
 
 #include "common/thread_pool.h"
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 #include <algorithm>
 #include <exception>
 #include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
 #include "utils/ms_exception.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace common {
@@ -27,6 +32,13 @@ namespace common {
 const int kDeviceNum = 8;
 #endif
 const int kMaxThreadNum = 23;
+namespace {
+// Set to 1 to bind each thread of SyncRun to its own core
+const char kBindCoreEnv[] = "MS_CPU_BIND_CORE";
+// Set while the thread runs tasks of SyncRun
+thread_local bool in_sync_run = false;
+}  // namespace
+
 bool Queue::Enqueue(Task *task) {
   const int tail_index = tail_.load(std::memory_order_relaxed);
   // queue full
@@ -70,6 +82,7 @@ ThreadPool::ThreadPool() {
   if (max_thread_num_ > kMaxThreadNum) {
     max_thread_num_ = kMaxThreadNum;
   }
+  bind_core_ = common::GetEnv(kBindCoreEnv) == "1";
 }
 
 bool ThreadPool::SetThreadPool(int config_thread_num) {
@@ -146,61 +159,124 @@ void ThreadPool::SubRunThread(int num) {
   cur_thread_run_nums_ = num;
 }
 
+void ThreadPool::BindSyncRunThread(std::thread *thread, int index) {
+#ifdef __linux__
+  // Core 0 is left to the thread calling SyncRun
+  int core_num = static_cast<int>(std::thread::hardware_concurrency());
+  if (!bind_core_ || core_num < 2) {
+    return;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET((index + 1) % core_num, &cpu_set);
+  auto ret = pthread_setaffinity_np(thread->native_handle(), sizeof(cpu_set), &cpu_set);
+  if (ret != 0) {
+    MS_LOG(WARNING) << "Fail to bind thread " << index << " to core " << (index + 1) % core_num << ", error " << ret;
+  }
+#endif
+}
+
+void ThreadPool::RunSyncTask(const SyncRunTask &item) {
+  int ret = FAIL;
+  std::exception_ptr exception = nullptr;
+  try {
+    ret = item.task();
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  {
+    std::unique_lock<std::mutex> task_lock(task_mutex_);
+    auto state = item.state;
+    if (ret != SUCCESS) {
+      state->failed = true;
+    }
+    // The first exception is the one given back to the caller of SyncRun
+    if (exception != nullptr && state->exception == nullptr) {
+      state->exception = exception;
+    }
+    --state->pending;
+  }
+  // Several calls may be waiting, each for its own tasks
+  finished_cond_var_.notify_all();
+}
+
 void ThreadPool::SyncRunLoop() {
+  in_sync_run = true;
   while (true) {
-    Task task;
+    SyncRunTask item;
     {
       std::unique_lock<std::mutex> lock(task_mutex_);
       task_cond_var_.wait(lock, [this] { return !task_queue_.empty() || exit_run_; });
       if (exit_run_) {
         return;
       }
-      task = task_queue_.front();
+      item = task_queue_.front();
       task_queue_.pop();
     }
-    try {
-      task();
-    } catch (std::exception &e) {
-      MsException::Instance().SetException();
-    }
-    {
-      std::unique_lock<std::mutex> task_lock(task_mutex_);
-      task_finished_count_ = task_finished_count_ + 1;
-    }
-    finished_cond_var_.notify_one();
+    RunSyncTask(item);
   }
 }
 
 bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
-  if (tasks.size() == 1) {
-    auto ret = tasks[0]();
-    return ret == SUCCESS;
+  // A task of the pool splitting its work again would wait for threads which are all busy, it runs the new tasks
+  // itself.
+  if (tasks.size() == 1 || in_sync_run) {
+    bool succ_flag = true;
+    for (auto &task : tasks) {
+      succ_flag = task() == SUCCESS && succ_flag;
+    }
+    return succ_flag;
   }
-  std::unique_lock<std::mutex> lock(pool_mtx_);
-  exit_run_ = false;
   int task_num = tasks.size();
-  int thread_num = sync_run_threads_.size();
-  if (thread_num < max_thread_num_ && thread_num < task_num) {
-    auto new_thread_num = max_thread_num_;
-    if (task_num < max_thread_num_) {
-      new_thread_num = task_num;
-    }
-    for (int i = thread_num; i < new_thread_num; ++i) {
-      sync_run_threads_.emplace_back(std::thread(&ThreadPool::SyncRunLoop, this));
+  {
+    std::lock_guard<std::mutex> sync_run_lock(pool_mtx_);
+    exit_run_ = false;
+    int thread_num = sync_run_threads_.size();
+    if (thread_num < max_thread_num_ && thread_num < task_num) {
+      auto new_thread_num = max_thread_num_;
+      if (task_num < max_thread_num_) {
+        new_thread_num = task_num;
+      }
+      for (int i = thread_num; i < new_thread_num; ++i) {
+        sync_run_threads_.emplace_back(std::thread(&ThreadPool::SyncRunLoop, this));
+        BindSyncRunThread(&sync_run_threads_.back(), i);
+      }
     }
   }
 
-  for (auto &task : tasks) {
+  // Kernels running concurrently queue their tasks behind each other instead of waiting for the pool
+  SyncRunState state;
+  state.pending = task_num;
+  {
     std::lock_guard<std::mutex> task_lock(task_mutex_);
-    task_queue_.push(task);
-    task_cond_var_.notify_one();
+    for (auto &task : tasks) {
+      task_queue_.push({task, &state});
+    }
   }
+  task_cond_var_.notify_all();
+  // The calling thread takes tasks too instead of only waiting
+  in_sync_run = true;
+  while (true) {
+    SyncRunTask item;
+    {
+      std::unique_lock<std::mutex> task_lock(task_mutex_);
+      if (task_queue_.empty()) {
+        break;
+      }
+      item = task_queue_.front();
+      task_queue_.pop();
+    }
+    RunSyncTask(item);
+  }
+  in_sync_run = false;
   {
     std::unique_lock<std::mutex> task_lock(task_mutex_);
-    finished_cond_var_.wait(task_lock, [this, task_num] { return task_num == task_finished_count_; });
-    task_finished_count_ = 0;
+    finished_cond_var_.wait(task_lock, [&state] { return state.pending == 0; });
   }
-  return true;
+  if (state.exception != nullptr) {
+    std::rethrow_exception(state.exception);
+  }
+  return !state.failed;
 }
 
 bool ThreadPool::InnerSyncRun(const std::vector<Task> &tasks) {
@@ -27,6 +27,7 @@
 #include <memory>
 #include <utility>
 #include <functional>
+#include <exception>
 #include <iostream>
 #include "utils/log_adapter.h"
 
@@ -57,11 +58,25 @@ class ThreadPool {
   ThreadPool(const ThreadPool &) = delete;
   ThreadPool &operator=(const ThreadPool &) = delete;
   static ThreadPool &GetInstance();
+  // Run the tasks in the pool and the calling thread, and return once all of them are done. Calls from several
+  // threads share the pool, each one waits for its own tasks only. A task calling SyncRun again runs the new tasks in
+  // its own thread. Return false if a task failed, and rethrow the first exception a task threw.
   bool SyncRun(const std::vector<Task> &tasks);
   size_t GetSyncRunThreadNum() { return max_thread_num_; }
   void ClearThreadPool();
 
  private:
+  // Completion of the tasks of one SyncRun call
+  struct SyncRunState {
+    int pending{0};
+    bool failed{false};
+    std::exception_ptr exception{nullptr};
+  };
+  struct SyncRunTask {
+    Task task;
+    SyncRunState *state{nullptr};
+  };
+
   ThreadPool();
   bool SetThreadPool(int config_thread_num);
   void AddNewThread(int add_num);
@@ -70,11 +85,14 @@ class ThreadPool {
   bool CheckResult();
   bool InnerSyncRun(const std::vector<Task> &tasks);
   void SyncRunLoop();
+  void RunSyncTask(const SyncRunTask &item);
+  void BindSyncRunThread(std::thread *thread, int index);
 
   int cur_thread_nums_{0};
   int cur_thread_run_nums_{0};
   int core_thread_num_{kCoreThreadNum};
   int max_thread_num_{kDefaultMaxThreadNum};
+  bool bind_core_{false};
   std::mutex pool_mtx_;
   std::mutex thread_mtx_;
   std::condition_variable queue_ready_;
@@ -83,10 +101,9 @@ class ThreadPool {
   std::vector<std::thread> thread_list_{};
   std::vector<std::shared_ptr<Queue>> queue_list_{};
   std::vector<std::pair<int, std::pair<bool, int>>> error_info_{};
-  std::queue<Task> task_queue_;
+  std::queue<SyncRunTask> task_queue_;
   std::mutex task_mutex_;
   std::condition_variable task_cond_var_;
-  int task_finished_count_{0};
   std::condition_variable finished_cond_var_;
   std::vector<std::thread> sync_run_threads_{};
 };
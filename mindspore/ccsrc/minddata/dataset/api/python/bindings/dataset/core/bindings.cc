@@ -36,7 +36,13 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                   (void)py::class_<ConfigManager, std::shared_ptr<ConfigManager>>(*m, "ConfigManager")
                     .def("__str__", &ConfigManager::ToString)
                     .def("get_auto_num_workers", &ConfigManager::auto_num_workers)
+                    .def("get_autotune_interval", &ConfigManager::autotune_interval)
                     .def("get_callback_timeout", &ConfigManager::callback_timeout)
+                    .def("get_enable_autotune", &ConfigManager::enable_autotune)
+                    .def("get_io_prefetch_window", &ConfigManager::io_prefetch_window)
+                    .def("get_lock_free_connector", &ConfigManager::lock_free_connector)
+                    .def("get_map_work_stealing", &ConfigManager::map_work_stealing)
+                    .def("get_mindrecord_mmap", &ConfigManager::mindrecord_mmap)
                     .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
                     .def("get_num_parallel_workers", &ConfigManager::num_parallel_workers)
                     .def("get_numa_enable", &ConfigManager::numa_enable)
@@ -44,16 +50,26 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_op_connector_size", &ConfigManager::op_connector_size)
                     .def("get_rows_per_buffer", &ConfigManager::rows_per_buffer)
                     .def("get_seed", &ConfigManager::seed)
+                    .def("get_tensor_pool_cache_size", &ConfigManager::tensor_pool_cache_size)
+                    .def("get_tensor_pool_enable", &ConfigManager::tensor_pool_enable)
                     .def("set_rank_id", &ConfigManager::set_rank_id)
                     .def("get_worker_connector_size", &ConfigManager::worker_connector_size)
                     .def("set_auto_num_workers", &ConfigManager::set_auto_num_workers)
                     .def("set_auto_worker_config", &ConfigManager::set_auto_worker_config_)
+                    .def("set_autotune_interval", &ConfigManager::set_autotune_interval)
                     .def("set_callback_timeout", &ConfigManager::set_callback_timeout)
+                    .def("set_enable_autotune", &ConfigManager::set_enable_autotune)
+                    .def("set_io_prefetch_window", &ConfigManager::set_io_prefetch_window)
+                    .def("set_lock_free_connector", &ConfigManager::set_lock_free_connector)
+                    .def("set_map_work_stealing", &ConfigManager::set_map_work_stealing)
+                    .def("set_mindrecord_mmap", &ConfigManager::set_mindrecord_mmap)
                     .def("set_monitor_sampling_interval", &ConfigManager::set_monitor_sampling_interval)
                     .def("set_num_parallel_workers", &ConfigManager::set_num_parallel_workers)
                     .def("set_op_connector_size", &ConfigManager::set_op_connector_size)
                     .def("set_rows_per_buffer", &ConfigManager::set_rows_per_buffer)
                     .def("set_seed", &ConfigManager::set_seed)
+                    .def("set_tensor_pool_cache_size", &ConfigManager::set_tensor_pool_cache_size)
+                    .def("set_tensor_pool_enable", &ConfigManager::set_tensor_pool_enable)
                     .def("set_worker_connector_size", &ConfigManager::set_worker_connector_size)
                     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
@@ -102,6 +102,14 @@ PYBIND_REGISTER(
              THROW_IF_ERROR(g.RandomWalk(node_list, meta_path, step_home_param, step_away_param, default_node, &out));
              return out;
            })
+      .def("save_csr",
+           [](gnn::GraphData &g, const std::string &csr_file) {
+             auto *graph_impl = dynamic_cast<gnn::GraphDataImpl *>(&g);
+             if (graph_impl == nullptr) {
+               throw std::runtime_error("save_csr is only supported in local mode.");
+             }
+             THROW_IF_ERROR(graph_impl->SaveCsr(csr_file));
+           })
       .def("stop", [](gnn::GraphData &g) { THROW_IF_ERROR(g.Stop()); });
 
     (void)py::class_<gnn::GraphDataServer, std::shared_ptr<gnn::GraphDataServer>>(*m, "GraphDataServer")
@@ -38,10 +38,22 @@ PYBIND_REGISTER(PythonIteratorConsumer, 1, ([](const py::module *m) {
                            THROW_IF_ERROR(self.GetNextAsDict(&output));
                            return output;
                          })
-                    .def("GetNextAsList", [](PythonIteratorConsumer &self) {
-                      py::list output;
-                      THROW_IF_ERROR(self.GetNextAsList(&output));
-                      return output;
+                    .def("GetNextAsList",
+                         [](PythonIteratorConsumer &self) {
+                           py::list output;
+                           THROW_IF_ERROR(self.GetNextAsList(&output));
+                           return output;
+                         })
+                    .def("GetCheckpoint",
+                         [](PythonIteratorConsumer &self) {
+                           nlohmann::json checkpoint;
+                           THROW_IF_ERROR(self.GetCheckpoint(&checkpoint));
+                           return checkpoint.dump();
+                         })
+                    .def("Restore", [](PythonIteratorConsumer &self, const std::string &checkpoint) {
+                      nlohmann::json state = nlohmann::json::parse(checkpoint, nullptr, false);
+                      if (state.is_discarded()) throw std::runtime_error("Invalid checkpoint: " + checkpoint);
+                      THROW_IF_ERROR(self.Restore(state));
                     });
                 }));
 
@@ -50,6 +50,7 @@
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_with_bbox_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_with_bbox_op.h"
 #include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
@@ -1339,6 +1340,21 @@ std::shared_ptr<TensorOp> RandomCropDecodeResizeOperation::Build() {
 RandomCropDecodeResizeOperation::RandomCropDecodeResizeOperation(const RandomResizedCropOperation &base)
     : RandomResizedCropOperation(base) {}
 
+// RandomCropDecodeResizeNormalizeOperation
+RandomCropDecodeResizeNormalizeOperation::RandomCropDecodeResizeNormalizeOperation(
+  const RandomResizedCropOperation &base, std::vector<float> mean, std::vector<float> std, float flip_probability,
+  std::string dtype)
+    : RandomCropDecodeResizeOperation(base),
+      mean_(mean),
+      std_(std),
+      flip_probability_(flip_probability),
+      dtype_(dtype) {}
+
+std::shared_ptr<TensorOp> RandomCropDecodeResizeNormalizeOperation::Build() {
+  auto crop_op = std::dynamic_pointer_cast<RandomCropAndResizeOp>(RandomCropDecodeResizeOperation::Build());
+  return std::make_shared<RandomCropDecodeResizeNormalizeOp>(*crop_op, mean_, std_, flip_probability_, dtype_);
+}
+
 // RandomCropWithBBoxOperation
 RandomCropWithBBoxOperation::RandomCropWithBBoxOperation(std::vector<int32_t> size, std::vector<int32_t> padding,
                                                          bool pad_if_needed, std::vector<uint8_t> fill_value,
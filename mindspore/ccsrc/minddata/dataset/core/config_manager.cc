@@ -47,7 +47,15 @@ ConfigManager::ConfigManager()
       auto_num_workers_(kDftAutoNumWorkers),
       num_cpu_threads_(std::thread::hardware_concurrency()),
       auto_num_workers_num_shards_(1),
-      auto_worker_config_(0) {
+      auto_worker_config_(0),
+      mindrecord_mmap_(kDftMindRecordMmap),
+      io_prefetch_window_(kDftIoPrefetchWindow),
+      lock_free_connector_(kDftLockFreeConnector),
+      map_work_stealing_(kDftMapWorkStealing),
+      enable_autotune_(kDftEnableAutotune),
+      autotune_interval_(kDftAutotuneInterval),
+      tensor_pool_enable_(kDftTensorPoolEnable),
+      tensor_pool_cache_size_(kDftTensorPoolCacheSize) {
   auto env_cache_host = std::getenv("MS_CACHE_HOST");
   auto env_cache_port = std::getenv("MS_CACHE_PORT");
   if (env_cache_host != nullptr) {
@@ -87,6 +95,8 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_cache_port(j.value("cachePort", cache_port_));
   set_num_connections(j.value("numConnections", num_connections_));
   set_prefetch_size(j.value("prefetchSize", prefetch_size_));
+  set_tensor_pool_enable(j.value("tensorPoolEnable", tensor_pool_enable_));
+  set_tensor_pool_cache_size(j.value("tensorPoolCacheSize", tensor_pool_cache_size_));
   return Status::OK();
 }
 
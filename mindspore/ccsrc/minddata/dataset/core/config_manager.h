@@ -192,6 +192,70 @@ class ConfigManager {
   // @param num_shards_
   int32_t get_num_shards_for_auto_num_workers() const { return auto_num_workers_num_shards_; }
 
+  // getter function
+  // @return Whether MindRecordOp reads shard files through memory mapping
+  bool mindrecord_mmap() const { return mindrecord_mmap_; }
+
+  // setter function
+  // @param mindrecord_mmap - whether MindRecordOp reads shard files through memory mapping
+  void set_mindrecord_mmap(bool mindrecord_mmap) { mindrecord_mmap_ = mindrecord_mmap; }
+
+  // getter function
+  // @return Number of rows which source ops read asynchronously ahead of their workers, 0 means disabled
+  int32_t io_prefetch_window() const { return io_prefetch_window_; }
+
+  // setter function
+  // @param io_prefetch_window - number of rows which source ops read asynchronously ahead of their workers
+  void set_io_prefetch_window(int32_t io_prefetch_window) { io_prefetch_window_ = io_prefetch_window; }
+
+  // getter function
+  // @return Whether the output connectors of the ops use lock-free queues
+  bool lock_free_connector() const { return lock_free_connector_; }
+
+  // setter function
+  // @param lock_free_connector - whether the output connectors of the ops use lock-free queues
+  void set_lock_free_connector(bool lock_free_connector) { lock_free_connector_ = lock_free_connector; }
+
+  // getter function
+  // @return Whether idle map workers steal pending buffers of the other workers
+  bool map_work_stealing() const { return map_work_stealing_; }
+
+  // setter function
+  // @param map_work_stealing - whether idle map workers steal pending buffers of the other workers
+  void set_map_work_stealing(bool map_work_stealing) { map_work_stealing_ = map_work_stealing; }
+
+  // getter function
+  // @return Whether the pipeline is tuned at runtime
+  bool enable_autotune() const { return enable_autotune_; }
+
+  // setter function
+  // @param enable_autotune - whether the worker pools and the connector sizes are tuned while the pipeline runs
+  void set_enable_autotune(bool enable_autotune) { enable_autotune_ = enable_autotune; }
+
+  // getter function
+  // @return The interval in milliseconds between two samples of the auto tuner
+  int32_t autotune_interval() const { return autotune_interval_; }
+
+  // setter function
+  // @param autotune_interval - the interval in milliseconds between two samples of the auto tuner
+  void set_autotune_interval(int32_t autotune_interval) { autotune_interval_ = autotune_interval; }
+
+  // getter function
+  // @return Whether the tensor buffers freed by a pipeline are kept to be reused by the next rows
+  bool tensor_pool_enable() const { return tensor_pool_enable_; }
+
+  // setter function, it takes effect when the next pipeline is launched
+  // @param tensor_pool_enable - whether the tensor buffers freed by a pipeline are kept to be reused
+  void set_tensor_pool_enable(bool tensor_pool_enable) { tensor_pool_enable_ = tensor_pool_enable; }
+
+  // getter function
+  // @return The free memory in bytes the tensor pool keeps per numa node
+  uint64_t tensor_pool_cache_size() const { return tensor_pool_cache_size_; }
+
+  // setter function, it takes effect when the next pipeline is launched
+  // @param tensor_pool_cache_size - the free memory in bytes the tensor pool keeps per numa node
+  void set_tensor_pool_cache_size(uint64_t tensor_pool_cache_size) { tensor_pool_cache_size_ = tensor_pool_cache_size; }
+
   // setter function
   // @param timeout - The setting to apply to the config
   void set_callback_timeout(uint32_t timeout);
@@ -233,6 +297,14 @@ class ConfigManager {
   const int32_t num_cpu_threads_;
   int32_t auto_num_workers_num_shards_;
   uint8_t auto_worker_config_;
+  bool mindrecord_mmap_;
+  int32_t io_prefetch_window_;
+  bool lock_free_connector_;
+  bool map_work_stealing_;
+  bool enable_autotune_;
+  int32_t autotune_interval_;
+  bool tensor_pool_enable_;
+  uint64_t tensor_pool_cache_size_;
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
   Status FromJson(const nlohmann::json &j);
@@ -96,6 +96,14 @@ constexpr char kCfgDefaultCacheHost[] = "127.0.0.1";
 constexpr int32_t kDftPrefetchSize = 20;
 constexpr int32_t kDftNumConnections = 12;
 constexpr int32_t kDftAutoNumWorkers = false;
+constexpr bool kDftMindRecordMmap = false;
+constexpr int32_t kDftIoPrefetchWindow = 0;
+constexpr bool kDftLockFreeConnector = false;
+constexpr bool kDftMapWorkStealing = false;
+constexpr bool kDftEnableAutotune = false;
+constexpr int32_t kDftAutotuneInterval = 100;  // milliseconds
+constexpr bool kDftTensorPoolEnable = true;
+constexpr uint64_t kDftTensorPoolCacheSize = 512 * 1024 * 1024;  // free memory kept per numa node
 
 // Invalid OpenCV type should not be from 0 to 7 (opencv4/opencv2/core/hal/interface.h)
 constexpr uint8_t kCVInvalidType = 255;
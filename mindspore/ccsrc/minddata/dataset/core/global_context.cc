@@ -25,6 +25,9 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/util/allocator.h"
 #include "minddata/dataset/util/circular_pool.h"
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/util/recycling_pool.h"
+#endif
 #include "minddata/dataset/util/system_pool.h"
 
 namespace mindspore {
@@ -53,7 +56,13 @@ GlobalContext *GlobalContext::Instance() {
 
 Status GlobalContext::Init() {
   config_manager_ = std::make_shared<ConfigManager>();
+#ifndef ENABLE_ANDROID
+  // The tensor buffers freed by a pipeline are kept to be reused by the next rows.
+  mem_pool_ =
+    std::make_shared<RecyclingPool>(std::make_shared<SystemPool>(), config_manager_->tensor_pool_cache_size());
+#else
   mem_pool_ = std::make_shared<SystemPool>();
+#endif
   // For testing we can use Dummy pool instead
 
   // Create some tensor allocators for the different types and hook them into the pool.
@@ -65,9 +74,33 @@ Status GlobalContext::Init() {
   return Status::OK();
 }
 
+void GlobalContext::ConfigureMemPool() {
+#ifndef ENABLE_ANDROID
+  auto recycling_pool = std::dynamic_pointer_cast<RecyclingPool>(mem_pool_);
+  if (recycling_pool != nullptr) {
+    recycling_pool->SetLimits(config_manager_->tensor_pool_enable(), config_manager_->tensor_pool_cache_size());
+  }
+#endif
+}
+
+void GlobalContext::TrimMemPool() {
+#ifndef ENABLE_ANDROID
+  auto recycling_pool = std::dynamic_pointer_cast<RecyclingPool>(mem_pool_);
+  if (recycling_pool != nullptr) {
+    recycling_pool->Trim();
+  }
+#endif
+}
+
 // A print method typically used for debugging
 void GlobalContext::Print(std::ostream &out) const {
   out << "GlobalContext contains the following default config: " << *config_manager_ << "\n";
+#ifndef ENABLE_ANDROID
+  auto recycling_pool = std::dynamic_pointer_cast<RecyclingPool>(mem_pool_);
+  if (recycling_pool != nullptr) {
+    out << *recycling_pool << "\n";
+  }
+#endif
 }
 }  // namespace dataset
 }  // namespace mindspore
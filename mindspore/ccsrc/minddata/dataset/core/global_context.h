@@ -74,6 +74,12 @@ class GlobalContext {
   // @return the mem pool
   std::shared_ptr<MemoryPool> mem_pool() const { return mem_pool_; }
 
+  // Apply the tensor pool settings of the config manager to the mem pool
+  void ConfigureMemPool();
+
+  // Give the free tensor buffers kept by the mem pool back to the system
+  void TrimMemPool();
+
   // Getter method
   // @return the tensor allocator as raw pointer
   const TensorAlloc *tensor_allocator() const { return tensor_allocator_.get(); }
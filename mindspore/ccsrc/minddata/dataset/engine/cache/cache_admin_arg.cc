@@ -49,6 +49,8 @@ CacheAdminArgHandler::CacheAdminArgHandler()
       memory_cap_ratio_(kMemoryCapRatio),
       hostname_(kCfgDefaultCacheHost),
       spill_dir_(DefaultSpillDir()),
+      eviction_policy_(kDefaultEvictionPolicy),
+      compression_(kDefaultCompression),
       command_id_(CommandId::kCmdUnknown) {
   // Initialize the command mappings
   arg_map_["-h"] = ArgValue::kArgHost;
@@ -73,6 +75,10 @@ CacheAdminArgHandler::CacheAdminArgHandler()
   arg_map_["-r"] = ArgValue::kArgMemoryCapRatio;
   arg_map_["--memory_cap_ratio"] = ArgValue::kArgMemoryCapRatio;
   arg_map_["--list_sessions"] = ArgValue::kArgListSessions;
+  arg_map_["-e"] = ArgValue::kArgEvictionPolicy;
+  arg_map_["--eviction"] = ArgValue::kArgEvictionPolicy;
+  arg_map_["-z"] = ArgValue::kArgCompression;
+  arg_map_["--compression"] = ArgValue::kArgCompression;
   // Initialize argument tracker with false values
   for (int16_t i = 0; i < static_cast<int16_t>(ArgValue::kArgNumArgs); ++i) {
     ArgValue currAV = static_cast<ArgValue>(i);
@@ -276,6 +282,14 @@ Status CacheAdminArgHandler::ParseArgStream(std::stringstream *arg_stream) {
         RETURN_IF_NOT_OK(AssignArg(tok, &memory_cap_ratio_, arg_stream));
         break;
       }
+      case ArgValue::kArgEvictionPolicy: {
+        RETURN_IF_NOT_OK(AssignArg(tok, &eviction_policy_, arg_stream));
+        break;
+      }
+      case ArgValue::kArgCompression: {
+        RETURN_IF_NOT_OK(AssignArg(tok, &compression_, arg_stream));
+        break;
+      }
       case ArgValue::kArgListSessions: {
         RETURN_IF_NOT_OK(AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream, CommandId::kCmdListSessions));
         break;
@@ -319,6 +333,12 @@ Status CacheAdminArgHandler::Validate() {
   if (memory_cap_ratio_ <= 0 || memory_cap_ratio_ > 1)
     return Status(StatusCode::kSyntaxError, "Memory cap ratio should be positive and no greater than 1");
   if (port_ < 1025 || port_ > 65535) return Status(StatusCode::kSyntaxError, "Port must be in range (1025..65535).");
+  CacheEvictionPolicy eviction_policy;
+  if (!StringToEvictionPolicy(eviction_policy_, &eviction_policy))
+    return Status(StatusCode::kSyntaxError, "Eviction policy must be one of none, lru, clock or arc.");
+  CacheCompression compression;
+  if (!StringToCompression(compression_, &compression))
+    return Status(StatusCode::kSyntaxError, "Compression must be one of none or zlib.");
 
   return Status::OK();
 }
@@ -365,7 +385,7 @@ Status CacheAdminArgHandler::RunCommand() {
     case CommandId::kCmdGenerateSession: {
       CacheClientGreeter comm(hostname_, port_, 1);
       RETURN_IF_NOT_OK(comm.ServiceStart());
-      auto rq = std::make_shared<GenerateSessionIdRequest>();
+      auto rq = std::make_shared<GenerateSessionIdRequest>(compression_);
       RETURN_IF_NOT_OK(comm.HandleRequest(rq));
       RETURN_IF_NOT_OK(rq->Wait());
       std::cout << "Session created for server on port " << std::to_string(port_) << ": " << rq->GetSessionId()
@@ -394,13 +414,14 @@ Status CacheAdminArgHandler::RunCommand() {
       if (!session_info.empty()) {
         std::cout << std::setw(12) << "Session" << std::setw(12) << "Cache Id" << std::setw(12) << "Mem cached"
                   << std::setw(12) << "Disk cached" << std::setw(16) << "Avg cache size" << std::setw(10) << "Numa hit"
-                  << std::endl;
+                  << std::setw(13) << "Compression" << std::endl;
         for (auto curr_session : session_info) {
           std::string cache_id;
           std::string stat_mem_cached;
           std::string stat_disk_cached;
           std::string stat_avg_cached;
           std::string stat_numa_hit;
+          std::string stat_compression;
           uint32_t crc = (curr_session.connection_id & 0x00000000FFFFFFFF);
           cache_id = (curr_session.connection_id == 0) ? "n/a" : std::to_string(crc);
           stat_mem_cached =
@@ -411,10 +432,17 @@ Status CacheAdminArgHandler::RunCommand() {
             (curr_session.stats.avg_cache_sz == 0) ? "n/a" : std::to_string(curr_session.stats.avg_cache_sz);
           stat_numa_hit =
             (curr_session.stats.num_numa_hit == 0) ? "n/a" : std::to_string(curr_session.stats.num_numa_hit);
+          if (curr_session.connection_id == 0) {
+            stat_compression = "n/a";
+          } else {
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(2) << curr_session.stats.compression_ratio;
+            stat_compression = ss.str();
+          }
 
           std::cout << std::setw(12) << curr_session.session_id << std::setw(12) << cache_id << std::setw(12)
                     << stat_mem_cached << std::setw(12) << stat_disk_cached << std::setw(16) << stat_avg_cached
-                    << std::setw(10) << stat_numa_hit << std::endl;
+                    << std::setw(10) << stat_numa_hit << std::setw(13) << stat_compression << std::endl;
         }
       } else {
         std::cout << "No active sessions." << std::endl;
@@ -511,7 +539,7 @@ Status CacheAdminArgHandler::StartServer(CommandId command_id) {
     std::string daemonize_string = "true";
     std::string memory_cap_ratio_string = std::to_string(memory_cap_ratio_);
 
-    char *argv[9];
+    char *argv[10];
     argv[0] = cache_server_binary.data();
     argv[1] = spill_dir_.data();
     argv[2] = workers_string.data();
@@ -520,7 +548,8 @@ Status CacheAdminArgHandler::StartServer(CommandId command_id) {
     argv[5] = minloglevel_string.data();
     argv[6] = daemonize_string.data();
     argv[7] = memory_cap_ratio_string.data();
-    argv[8] = nullptr;
+    argv[8] = eviction_policy_.data();
+    argv[9] = nullptr;
 
     // Now exec the binary
     execv(cache_server_binary.data(), argv);
@@ -540,10 +569,13 @@ void CacheAdminArgHandler::Help() {
   std::cerr << "                [[-w | --workers] <number of workers>]    Default is " << kDefaultNumWorkers << ".\n";
   std::cerr << "                [[-s | --spilldir] <spilling directory>]  Default is " << DefaultSpillDir() << ".\n";
   std::cerr << "                [[-l | --loglevel] <log level>]           Default is 1 (warning level).\n";
+  std::cerr << "                [[-e | --eviction] <none|lru|clock|arc>]  Default is " << kDefaultEvictionPolicy
+            << ".\n";
   std::cerr << "            [--destroy_session  | -d] <session id>\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
   std::cerr << "            [--generate_session | -g]\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
+  std::cerr << "                [[-z | --compression] <none|zlib>]        Default is " << kDefaultCompression << ".\n";
   std::cerr << "            [--list_sessions]\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
   std::cerr << "            [--help]" << std::endl;
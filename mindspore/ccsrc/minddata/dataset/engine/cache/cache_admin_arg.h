@@ -74,7 +74,9 @@ class CacheAdminArgHandler {
     kArgLogLevel = 11,
     kArgMemoryCapRatio = 12,
     kArgListSessions = 13,
-    kArgNumArgs = 14  // Must be the last position to provide a count
+    kArgEvictionPolicy = 14,
+    kArgCompression = 15,
+    kArgNumArgs = 16  // Must be the last position to provide a count
   };
 
   Status StartServer(CommandId command_id);
@@ -99,6 +101,8 @@ class CacheAdminArgHandler {
   session_id_type session_id_;
   std::string hostname_;
   std::string spill_dir_;
+  std::string eviction_policy_;
+  std::string compression_;
   std::string trailing_args_;
   std::map<std::string, ArgValue> arg_map_;
   std::map<ArgValue, bool> used_args_;
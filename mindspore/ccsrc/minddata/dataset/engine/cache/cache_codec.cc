@@ -0,0 +1,97 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/cache/cache_codec.h"
+#include <zlib.h>
+#include <limits>
+#include <string>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// zlib counts the bytes of one call in uInt
+constexpr size_t kMaxZlibChunk = std::numeric_limits<uInt>::max();
+}  // namespace
+
+Status CacheCodec::Compress(const std::vector<ReadableSlice> &buf, size_t sz, std::vector<uint8_t> *out) const {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  out->clear();
+  CHECK_FAIL_RETURN_UNEXPECTED(compression_ == CacheCompression::kZlib, "Unsupported compression");
+  // Nothing to gain on a tiny buffer, and the output must be strictly smaller to tell the two forms apart.
+  if (sz < 2 || sz > kMaxZlibChunk) {
+    return Status::OK();
+  }
+  z_stream strm{};
+  CHECK_FAIL_RETURN_UNEXPECTED(deflateInit(&strm, Z_BEST_SPEED) == Z_OK, "Fail to initialize zlib");
+  // Stop as soon as the output reaches the input size, the data is then kept as it is.
+  out->resize(sz - 1);
+  strm.next_out = out->data();
+  strm.avail_out = static_cast<uInt>(out->size());
+  // An empty slice is skipped, deflate makes no progress on it and returns Z_BUF_ERROR.
+  size_t last = buf.size();
+  for (size_t i = 0; i < buf.size(); ++i) {
+    if (buf[i].GetSize() > 0) {
+      last = i;
+    }
+  }
+  int ret = Z_OK;
+  for (size_t i = 0; i < buf.size() && ret == Z_OK; ++i) {
+    if (buf[i].GetSize() == 0) {
+      continue;
+    }
+    strm.next_in = static_cast<Bytef *>(const_cast<void *>(buf[i].GetPointer()));
+    strm.avail_in = static_cast<uInt>(buf[i].GetSize());
+    int flush = i == last ? Z_FINISH : Z_NO_FLUSH;
+    ret = deflate(&strm, flush);
+    if (ret == Z_OK && strm.avail_out == 0) {
+      // The output is full before the input runs out
+      ret = Z_BUF_ERROR;
+    }
+  }
+  auto compressed_sz = strm.total_out;
+  (void)deflateEnd(&strm);
+  if (ret == Z_STREAM_END) {
+    out->resize(compressed_sz);
+  } else if (ret == Z_OK || ret == Z_BUF_ERROR) {
+    out->clear();
+  } else {
+    out->clear();
+    RETURN_STATUS_UNEXPECTED("Fail to compress the buffer, zlib error " + std::to_string(ret));
+  }
+  return Status::OK();
+}
+
+Status CacheCodec::Decompress(const ReadableSlice &src, size_t raw_sz, WritableSlice *dest) const {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  CHECK_FAIL_RETURN_UNEXPECTED(compression_ == CacheCompression::kZlib, "Unsupported compression");
+  CHECK_FAIL_RETURN_UNEXPECTED(dest->GetSize() >= raw_sz, "Destination is too small for the buffer");
+  CHECK_FAIL_RETURN_UNEXPECTED(raw_sz <= kMaxZlibChunk && src.GetSize() <= kMaxZlibChunk, "Buffer is too big");
+  z_stream strm{};
+  CHECK_FAIL_RETURN_UNEXPECTED(inflateInit(&strm) == Z_OK, "Fail to initialize zlib");
+  strm.next_in = static_cast<Bytef *>(const_cast<void *>(src.GetPointer()));
+  strm.avail_in = static_cast<uInt>(src.GetSize());
+  strm.next_out = static_cast<Bytef *>(dest->GetMutablePointer());
+  strm.avail_out = static_cast<uInt>(raw_sz);
+  int ret = inflate(&strm, Z_FINISH);
+  auto restored_sz = strm.total_out;
+  (void)inflateEnd(&strm);
+  if (ret != Z_STREAM_END || restored_sz != raw_sz) {
+    RETURN_STATUS_UNEXPECTED("Fail to decompress the buffer, zlib error " + std::to_string(ret) + ". Restored " +
+                             std::to_string(restored_sz) + " bytes of " + std::to_string(raw_sz) + ".");
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,56 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_CODEC_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_CODEC_H_
+
+#include <cstdint>
+#include <vector>
+#include "minddata/dataset/engine/cache/cache_common.h"
+#include "minddata/dataset/util/slice.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A CacheCodec compresses the buffers a CachePool keeps, and restores them on read. zlib runs at its fastest
+/// level since every row goes through it on the way in and out. The functions are thread safe.
+class CacheCodec {
+ public:
+  /// \brief Constructor
+  /// \param compression The compression, not CacheCompression::kNone
+  explicit CacheCodec(CacheCompression compression) : compression_(compression) {}
+  ~CacheCodec() = default;
+
+  /// \brief Compress a sequence of ReadableSlice objects into one buffer
+  /// \param[in] buf The slices to compress
+  /// \param[in] sz Total size of the slices
+  /// \param[out] out The compressed buffer. It is left empty if the data does not shrink, the data should then be
+  /// kept as it is.
+  /// \return Error code
+  Status Compress(const std::vector<ReadableSlice> &buf, size_t sz, std::vector<uint8_t> *out) const;
+
+  /// \brief Restore a buffer produced by Compress
+  /// \param[in] src The compressed buffer
+  /// \param[in] raw_sz Size of the data before compression
+  /// \param[out] dest The destination, at least raw_sz bytes
+  /// \return Error code
+  Status Decompress(const ReadableSlice &src, size_t raw_sz, WritableSlice *dest) const;
+
+ private:
+  CacheCompression compression_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_CODEC_H_
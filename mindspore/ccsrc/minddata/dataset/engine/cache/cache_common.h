@@ -86,6 +86,52 @@ inline int64_t round_up_4K(int64_t sz) {
 /// Memory policy
 enum CachePoolPolicy : int8_t { kOnNode, kPreferred, kLocal, kInterleave, kNone };
 
+/// \brief Eviction policy of the rows in memory of a cache which spills to disk
+enum class CacheEvictionPolicy : int8_t { kNone = 0, kLru = 1, kClock = 2, kArc = 3 };
+
+/// \brief Default eviction policy used by the server
+const char kDefaultEvictionPolicy[] = "none";
+
+/// \brief Convert the name of an eviction policy, i.e. none, lru, clock or arc
+/// \param name[in] Name of the policy
+/// \param policy[in/out] Pointer to the policy
+/// \return False if the name is unknown
+inline bool StringToEvictionPolicy(const std::string &name, CacheEvictionPolicy *policy) {
+  if (name == "none") {
+    *policy = CacheEvictionPolicy::kNone;
+  } else if (name == "lru") {
+    *policy = CacheEvictionPolicy::kLru;
+  } else if (name == "clock") {
+    *policy = CacheEvictionPolicy::kClock;
+  } else if (name == "arc") {
+    *policy = CacheEvictionPolicy::kArc;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/// \brief Compression of the rows the server keeps for the caches of a session
+enum class CacheCompression : int8_t { kNone = 0, kZlib = 1 };
+
+/// \brief Default compression of a session
+const char kDefaultCompression[] = "none";
+
+/// \brief Convert the name of a compression, i.e. none or zlib
+/// \param name[in] Name of the compression
+/// \param compression[in/out] Pointer to the compression
+/// \return False if the name is unknown
+inline bool StringToCompression(const std::string &name, CacheCompression *compression) {
+  if (name == "none") {
+    *compression = CacheCompression::kNone;
+  } else if (name == "zlib") {
+    *compression = CacheCompression::kZlib;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 /// Misc typedef
 using worker_id_t = int32_t;
 using numa_id_t = int32_t;
@@ -0,0 +1,178 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/cache/cache_eviction.h"
+#include <algorithm>
+
+namespace mindspore {
+namespace dataset {
+std::unique_ptr<CacheEviction> CacheEviction::Create(CacheEvictionPolicy policy) {
+  switch (policy) {
+    case CacheEvictionPolicy::kLru:
+      return std::make_unique<LruEviction>();
+    case CacheEvictionPolicy::kClock:
+      return std::make_unique<ClockEviction>();
+    case CacheEvictionPolicy::kArc:
+      return std::make_unique<ArcEviction>();
+    default:
+      return nullptr;
+  }
+}
+
+void LruEviction::Admit(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = pos_.find(key);
+  if (it != pos_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+  lru_.push_front(key);
+  pos_.emplace(key, lru_.begin());
+}
+
+void LruEviction::Touch(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = pos_.find(key);
+  if (it != pos_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+  }
+}
+
+bool LruEviction::Victim(key_type *key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (lru_.empty()) {
+    return false;
+  }
+  *key = lru_.back();
+  lru_.pop_back();
+  pos_.erase(*key);
+  return true;
+}
+
+void ClockEviction::Admit(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = slot_of_.find(key);
+  if (it != slot_of_.end()) {
+    ring_[it->second].referenced = true;
+    return;
+  }
+  size_t slot;
+  if (free_slots_.empty()) {
+    slot = ring_.size();
+    ring_.push_back(Slot{key, true, false});
+  } else {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+    ring_[slot] = Slot{key, true, false};
+  }
+  slot_of_.emplace(key, slot);
+}
+
+void ClockEviction::Touch(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = slot_of_.find(key);
+  if (it != slot_of_.end()) {
+    ring_[it->second].referenced = true;
+  }
+}
+
+bool ClockEviction::Victim(key_type *key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (slot_of_.empty()) {
+    return false;
+  }
+  // Two rounds at most, the first one may only clear the reference bits.
+  for (size_t n = 0; n < 2 * ring_.size(); ++n) {
+    Slot &slot = ring_[hand_];
+    size_t cur = hand_;
+    hand_ = (hand_ + 1) % ring_.size();
+    if (!slot.used) {
+      continue;
+    }
+    if (slot.referenced) {
+      slot.referenced = false;
+      continue;
+    }
+    *key = slot.key;
+    slot.used = false;
+    free_slots_.push_back(cur);
+    slot_of_.erase(*key);
+    return true;
+  }
+  return false;
+}
+
+void ArcEviction::MoveTo(key_type key, ListId list) {
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    lists_[it->second.list].erase(it->second.pos);
+  }
+  lists_[list].push_front(key);
+  entries_[key] = Entry{list, lists_[list].begin()};
+}
+
+void ArcEviction::TrimGhost(ListId list) {
+  size_t capacity = std::max<size_t>(1, lists_[kT1].size() + lists_[kT2].size());
+  while (lists_[list].size() > capacity) {
+    entries_.erase(lists_[list].back());
+    lists_[list].pop_back();
+  }
+}
+
+void ArcEviction::Admit(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = entries_.find(key);
+  double capacity = static_cast<double>(lists_[kT1].size() + lists_[kT2].size() + 1);
+  if (it == entries_.end()) {
+    MoveTo(key, kT1);
+  } else if (it->second.list == kB1) {
+    // A row evicted for being read only once is wanted again, the first list should have been bigger.
+    double delta = std::max(1.0, static_cast<double>(lists_[kB2].size()) / lists_[kB1].size());
+    target_t1_ = std::min(capacity, target_t1_ + delta);
+    MoveTo(key, kT2);
+  } else if (it->second.list == kB2) {
+    double delta = std::max(1.0, static_cast<double>(lists_[kB1].size()) / lists_[kB2].size());
+    target_t1_ = std::max(0.0, target_t1_ - delta);
+    MoveTo(key, kT2);
+  } else {
+    MoveTo(key, kT2);
+  }
+  TrimGhost(kB1);
+  TrimGhost(kB2);
+}
+
+void ArcEviction::Touch(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = entries_.find(key);
+  if (it != entries_.end() && (it->second.list == kT1 || it->second.list == kT2)) {
+    MoveTo(key, kT2);
+  }
+}
+
+bool ArcEviction::Victim(key_type *key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (lists_[kT1].empty() && lists_[kT2].empty()) {
+    return false;
+  }
+  bool from_t1 = !lists_[kT1].empty() && (lists_[kT1].size() > target_t1_ || lists_[kT2].empty());
+  ListId from = from_t1 ? kT1 : kT2;
+  *key = lists_[from].back();
+  MoveTo(*key, from_t1 ? kB1 : kB2);
+  TrimGhost(kB1);
+  TrimGhost(kB2);
+  return true;
+}
+}  // namespace dataset
+}  // namespace mindspore
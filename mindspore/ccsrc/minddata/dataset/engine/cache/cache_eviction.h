@@ -0,0 +1,119 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_EVICTION_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_EVICTION_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "minddata/dataset/engine/cache/cache_common.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A CacheEviction keeps track of the rows a CachePool holds in memory, and picks the one to move to disk
+/// when the memory runs out. All the functions are thread safe.
+class CacheEviction {
+ public:
+  using key_type = int64_t;
+
+  CacheEviction() = default;
+  virtual ~CacheEviction() = default;
+
+  /// \brief Create the tracker of a policy
+  /// \param policy The eviction policy
+  /// \return The tracker, or nullptr for CacheEvictionPolicy::kNone
+  static std::unique_ptr<CacheEviction> Create(CacheEvictionPolicy policy);
+
+  /// \brief A row is placed in memory
+  virtual void Admit(key_type key) = 0;
+
+  /// \brief A row in memory is read. A row which is not tracked is ignored.
+  virtual void Touch(key_type key) = 0;
+
+  /// \brief Pick a row to leave the memory. The row is no longer tracked.
+  /// \param[out] key The row picked
+  /// \return False if no row is in memory
+  virtual bool Victim(key_type *key) = 0;
+
+ protected:
+  std::mutex mux_;
+};
+
+/// \brief Evict the least recently used row
+class LruEviction : public CacheEviction {
+ public:
+  void Admit(key_type key) override;
+  void Touch(key_type key) override;
+  bool Victim(key_type *key) override;
+
+ private:
+  std::list<key_type> lru_;  // the most recently used row first
+  std::unordered_map<key_type, std::list<key_type>::iterator> pos_;
+};
+
+/// \brief Second chance. A read only sets the reference bit of a row, the hand sweeps the rows in a ring and evicts the
+/// first one without the bit, clearing the bits on its way.
+class ClockEviction : public CacheEviction {
+ public:
+  void Admit(key_type key) override;
+  void Touch(key_type key) override;
+  bool Victim(key_type *key) override;
+
+ private:
+  struct Slot {
+    key_type key;
+    bool used;
+    bool referenced;
+  };
+  std::vector<Slot> ring_;
+  std::vector<size_t> free_slots_;
+  std::unordered_map<key_type, size_t> slot_of_;
+  size_t hand_ = 0;
+};
+
+/// \brief Adaptive replacement cache. The rows read once and the rows read again are kept in two lru lists, and the
+/// rows recently evicted from them in two ghost lists. A row coming back from a ghost list moves the target size of
+/// the first list towards the list it was evicted from. The capacity is the number of rows in memory, as the rows
+/// have no fixed size.
+class ArcEviction : public CacheEviction {
+ public:
+  void Admit(key_type key) override;
+  void Touch(key_type key) override;
+  bool Victim(key_type *key) override;
+
+ private:
+  enum ListId : int8_t { kT1 = 0, kT2 = 1, kB1 = 2, kB2 = 3, kNumLists = 4 };
+  struct Entry {
+    ListId list;
+    std::list<key_type>::iterator pos;
+  };
+
+  /// \brief Move a row to the front of a list
+  void MoveTo(key_type key, ListId list);
+
+  /// \brief Forget the oldest rows of a ghost list past the capacity
+  void TrimGhost(ListId list);
+
+  std::list<key_type> lists_[kNumLists];  // the most recent row first
+  std::unordered_map<key_type, Entry> entries_;
+  double target_t1_ = 0;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_EVICTION_H_
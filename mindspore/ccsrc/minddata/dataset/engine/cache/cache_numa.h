@@ -63,6 +63,9 @@ class NumaMemoryPool : public MemoryPool {
   /// \brief Return maximum available memory
   int64_t GetAvailableMemory() const { return memory_cap_; }
 
+  /// \brief Return the hardware control the pool is created with
+  std::shared_ptr<CacheServerHW> GetHWControl() const { return hw_; }
+
  private:
   std::shared_ptr<CacheServerHW> hw_;
   float memory_cap_ratio_;
@@ -16,13 +16,23 @@
 #include <algorithm>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/engine/cache/cache_pool.h"
-#include "minddata/dataset/engine/cache/cache_server.h"
 #include "minddata/dataset/util/services.h"
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {}
+CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root, CacheEvictionPolicy policy,
+                     CacheCompression compression)
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      policy_(policy),
+      sm_(nullptr),
+      tree_(nullptr),
+      codec_(compression == CacheCompression::kNone ? nullptr : std::make_unique<CacheCodec>(compression)),
+      num_evicted_(0),
+      num_promoted_(0),
+      num_mem_hit_(0),
+      num_disk_hit_(0) {}
 
 Status CachePool::DoServiceStart() {
   tree_ = std::make_shared<data_index>();
@@ -34,6 +44,14 @@ Status CachePool::DoServiceStart() {
     RETURN_IF_NOT_OK(sm_->ServiceStart());
     MS_LOG(INFO) << "CachePool will use disk folder: " << spill.toString();
   }
+  if (policy_ != CacheEvictionPolicy::kNone) {
+    // Evicting a buffer moves it to disk. Without a disk folder there is nowhere to move it.
+    if (sm_ != nullptr) {
+      evict_ = CacheEviction::Create(policy_);
+    } else {
+      MS_LOG(WARNING) << "Eviction is ignored since spilling is disabled.";
+    }
+  }
   return Status::OK();
 }
 
@@ -47,6 +65,7 @@ Status CachePool::DoServiceStop() {
     }
   }
   sm_.reset();
+  evict_.reset();
 
   // We used to free the memory allocated from each DataLocator but
   // since all of them are coming from NumaMemoryPool and we will
@@ -81,21 +100,32 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   for (auto &v : buf) {
     sz += v.GetSize();
   }
-  bl.sz = sz;
-  rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
+  // The compressed form replaces the slices, unless the data does not shrink.
+  std::vector<uint8_t> compressed;
+  if (codec_ != nullptr) {
+    RETURN_IF_NOT_OK(codec_->Compress(buf, sz, &compressed));
+  }
+  std::vector<ReadableSlice> packed;
+  if (!compressed.empty()) {
+    packed.emplace_back(compressed.data(), compressed.size());
+  }
+  const std::vector<ReadableSlice> &data = compressed.empty() ? buf : packed;
+  bl.raw_sz = sz;
+  bl.sz = compressed.empty() ? sz : compressed.size();
+  rc = mp_->Allocate(bl.sz, reinterpret_cast<void **>(&bl.ptr));
+  if (rc.IsOutofMemory() && evict_ != nullptr) {
+    rc = AllocateByEviction(bl.sz, &bl.ptr);
+  }
   if (rc.IsOk()) {
-    // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
-    if (CacheServerHW::numa_enabled()) {
-      auto &cs = CacheServer::GetInstance();
-      auto node_id = cs.GetHWControl()->GetMyNode();
-      bl.node_id = mp_->FindNode(bl.ptr);
-      CHECK_FAIL_RETURN_UNEXPECTED(bl.node_id != -1, "Allocator is not from numa memory pool");
-      bl.node_hit = (bl.node_id == node_id);
+    Status rc_node = SetNumaNode(&bl);
+    if (rc_node.IsError()) {
+      mp_->Deallocate(bl.ptr);
+      return rc_node;
     }
     // We will do a piecewise copy.
     WritableSlice dest(bl.ptr, bl.sz);
     size_t pos = 0;
-    for (auto &v : buf) {
+    for (auto &v : data) {
       WritableSlice out(dest, pos);
       rc = WritableSlice::Copy(&out, v);
       if (rc.IsError()) {
@@ -112,7 +142,8 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     // If no memory, write to disk.
     if (sm_ != nullptr) {
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
-      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
+      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, data));
+      bl.on_disk = true;
     } else {
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
@@ -133,31 +164,167 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     bl.ptr = nullptr;
     return rc;
   }
+  if (rc.IsOk() && bl.ptr != nullptr && evict_ != nullptr) {
+    evict_->Admit(key);
+  }
+  return rc;
+}
+
+Status CachePool::SetNumaNode(DataLocator *bl) const {
+  // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
+  if (CacheServerHW::numa_enabled()) {
+    // The pool shares the hardware control of the server.
+    auto node_id = mp_->GetHWControl()->GetMyNode();
+    bl->node_id = mp_->FindNode(bl->ptr);
+    CHECK_FAIL_RETURN_UNEXPECTED(bl->node_id != -1, "Allocator is not from numa memory pool");
+    bl->node_hit = (bl->node_id == node_id);
+  }
+  return Status::OK();
+}
+
+Status CachePool::AllocateByEviction(size_t sz, pointer *p) const {
+  Status rc(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+  for (int32_t i = 0; i < kMaxEvictionsPerAllocation; ++i) {
+    bool evicted = false;
+    RETURN_IF_NOT_OK(EvictOne(&evicted));
+    if (!evicted) {
+      break;
+    }
+    rc = mp_->Allocate(sz, reinterpret_cast<void **>(p));
+    if (!rc.IsOutofMemory()) {
+      break;
+    }
+  }
   return rc;
 }
 
+Status CachePool::EvictOne(bool *evicted) const {
+  *evicted = false;
+  key_type key;
+  if (!evict_->Victim(&key)) {
+    return Status::OK();
+  }
+  DataLocator bl;
+  {
+    auto r = tree_->Search(key);
+    if (!r.second) {
+      return Status::OK();
+    }
+    bl = *(r.first);
+  }
+  *evicted = true;
+  if (bl.ptr == nullptr) {
+    return Status::OK();
+  }
+  // Only the first eviction of a buffer writes to disk, the copy stays valid after the buffer moves back to memory.
+  DataLocator nl(bl);
+  nl.ptr = nullptr;
+  nl.node_hit = false;
+  if (!bl.on_disk) {
+    Status rc = sm_->Write(&nl.storage_key, {ReadableSlice(bl.ptr, bl.sz)});
+    if (rc.IsError()) {
+      evict_->Admit(key);
+      return rc;
+    }
+    nl.on_disk = true;
+  }
+  // Readers copy the buffer under the lock of the leaf, which the update waits for. No one reads it afterwards.
+  (void)tree_->DoUpdate(key, nl);
+  mp_->Deallocate(bl.ptr);
+  ++num_evicted_;
+  return Status::OK();
+}
+
+Status CachePool::Promote(key_type key, const DataLocator &bl, const ReadableSlice &src) const {
+  {
+    // Only the reader which reaches the threshold moves the buffer
+    std::unique_lock<std::mutex> lock(disk_hits_mux_);
+    int32_t hits = ++disk_hits_[key];
+    if (hits < kPromoteThreshold) {
+      return Status::OK();
+    }
+    disk_hits_.erase(key);
+  }
+  DataLocator nl(bl);
+  Status rc = mp_->Allocate(bl.sz, reinterpret_cast<void **>(&nl.ptr));
+  if (rc.IsOutofMemory()) {
+    rc = AllocateByEviction(bl.sz, &nl.ptr);
+  }
+  if (rc.IsOutofMemory()) {
+    // Stay on disk
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(rc);
+  WritableSlice dest(nl.ptr, nl.sz);
+  rc = WritableSlice::Copy(&dest, src);
+  if (rc.IsOk()) {
+    rc = SetNumaNode(&nl);
+  }
+  if (rc.IsError()) {
+    mp_->Deallocate(nl.ptr);
+    return rc;
+  }
+  (void)tree_->DoUpdate(key, nl);
+  evict_->Admit(key);
+  ++num_promoted_;
+  return Status::OK();
+}
+
 Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
   RETURN_UNEXPECTED_IF_NULL(dest);
-  auto r = tree_->Search(key);
-  if (r.second) {
+  DataLocator bl;
+  {
+    auto r = tree_->Search(key);
+    if (!r.second) {
+      RETURN_STATUS_UNEXPECTED("Key not found");
+    }
     auto &it = r.first;
     if (it->ptr != nullptr) {
       ReadableSlice src(it->ptr, it->sz);
-      RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
-    } else if (sm_ != nullptr) {
-      size_t expectedLength = 0;
-      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
-      if (expectedLength != it->sz) {
-        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
-                      << " Internal key: " << key << "\n";
-        RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
+      if (it->raw_sz != it->sz) {
+        RETURN_IF_NOT_OK(codec_->Decompress(src, it->raw_sz, dest));
+      } else {
+        RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      }
+      if (bytesRead != nullptr) {
+        *bytesRead = it->raw_sz;
+      }
+      ++num_mem_hit_;
+      if (evict_ != nullptr) {
+        evict_->Touch(key);
       }
+      return Status::OK();
     }
-    if (bytesRead != nullptr) {
-      *bytesRead = it->sz;
+    bl = *it;
+  }
+  // A copy on disk never changes, so it is read without holding the tree.
+  if (sm_ != nullptr) {
+    // A compressed buffer is read into a scratch area first, and restored into the destination.
+    bool compressed = bl.raw_sz != bl.sz;
+    std::vector<uint8_t> stored;
+    WritableSlice disk_dest(*dest);
+    if (compressed) {
+      stored.resize(bl.sz);
+      disk_dest = WritableSlice(stored.data(), stored.size());
     }
-  } else {
-    RETURN_STATUS_UNEXPECTED("Key not found");
+    size_t expectedLength = 0;
+    RETURN_IF_NOT_OK(sm_->Read(bl.storage_key, &disk_dest, &expectedLength));
+    if (expectedLength != bl.sz) {
+      MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << bl.sz << "."
+                    << " Internal key: " << key << "\n";
+      RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
+    }
+    ReadableSlice src(disk_dest.GetPointer(), bl.sz);
+    if (compressed) {
+      RETURN_IF_NOT_OK(codec_->Decompress(src, bl.raw_sz, dest));
+    }
+    ++num_disk_hit_;
+    if (evict_ != nullptr) {
+      RETURN_IF_NOT_OK(Promote(key, bl, src));
+    }
+  }
+  if (bytesRead != nullptr) {
+    *bytesRead = bl.raw_sz;
   }
   return Status::OK();
 }
@@ -169,14 +336,16 @@ Path CachePool::GetSpillPath() const {
 
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   tree_->LockShared();  // Prevent any node split while we search.
-  CacheStat cs{-1, -1, 0, 0, 0, 0};
+  CacheStat cs{-1, -1, 0, 0, 0, 0, num_evicted_, num_promoted_, num_mem_hit_, num_disk_hit_, 1.0};
   int64_t total_sz = 0;
+  int64_t total_raw_sz = 0;
   if (tree_->begin() != tree_->end()) {
     cs.min_key = tree_->begin().key();
     cs.max_key = cs.min_key;  // will adjust later.
     for (auto it = tree_->begin(); it != tree_->end(); ++it) {
       it.LockShared();
       total_sz += it.value().sz;
+      total_raw_sz += it.value().raw_sz;
       if (it.value().ptr != nullptr) {
         ++cs.num_mem_cached;
       } else {
@@ -201,6 +370,7 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     if (cs.average_cache_sz == 0) {
       cs.average_cache_sz = 1;
     }
+    cs.compression_ratio = static_cast<float>(total_raw_sz) / static_cast<float>(total_sz);
   }
   tree_->Unlock();
   return cs;
@@ -214,9 +384,12 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
     auto &it = r.first;
     DataLocatorMsgBuilder bld(*fbb);
     bld.add_key(key);
-    bld.add_size(it->sz);
+    bld.add_size(it->raw_sz);
     bld.add_node_id(it->node_id);
-    bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
+    // With eviction the buffer can leave the memory before it is fetched, and a compressed buffer has to be
+    // restored, so both are fetched by the key instead.
+    bool by_key = evict_ != nullptr || it->raw_sz != it->sz;
+    bld.add_addr(by_key ? 0 : reinterpret_cast<int64_t>(it->ptr));
     auto offset = bld.Finish();
     *out = offset;
   } else {
@@ -16,12 +16,16 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
+#include "minddata/dataset/engine/cache/cache_codec.h"
 #include "minddata/dataset/engine/cache/cache_common.h"
+#include "minddata/dataset/engine/cache/cache_eviction.h"
 #include "minddata/dataset/engine/cache/cache_numa.h"
 #include "minddata/dataset/engine/cache/storage_manager.h"
 #include "minddata/dataset/util/allocator.h"
@@ -35,6 +39,9 @@ namespace dataset {
 /// \brief A CachePool provides service for backup/restore a buffer. A buffer can be represented in a form of vector of
 /// ReadableSlice where all memory blocks will be copied to one contiguous block which can be in memory or spilled to
 /// disk (if a disk directory is provided). User must provide a key to insert the buffer.
+/// With an eviction policy and a disk directory, the memory and the disk are two tiers. A buffer in memory is moved to
+/// disk to make room when the memory runs out, and a buffer read often from disk is moved back to memory.
+/// With a compression, a buffer is kept compressed in memory and on disk, and is restored on read.
 /// \see ReadableSlice
 class CachePool : public Service {
  public:
@@ -48,37 +55,47 @@ class CachePool : public Service {
   // An internal class to locate the whereabouts of a backed up buffer which can be either in
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator() : ptr(nullptr), sz(0), raw_sz(0), node_id(0), node_hit(false), on_disk(false), storage_key(0) {}
     ~DataLocator() = default;
     DataLocator(const DataLocator &other) = default;
     DataLocator &operator=(const DataLocator &other) = default;
     DataLocator(DataLocator &&other) noexcept {
       ptr = other.ptr;
       sz = other.sz;
+      raw_sz = other.raw_sz;
       node_id = other.node_id;
       node_hit = other.node_hit;
+      on_disk = other.on_disk;
       storage_key = other.storage_key;
       other.ptr = nullptr;
       other.sz = 0;
+      other.raw_sz = 0;
+      other.on_disk = false;
       other.storage_key = 0;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
         ptr = other.ptr;
         sz = other.sz;
+        raw_sz = other.raw_sz;
         node_id = other.node_id;
         node_hit = other.node_hit;
+        on_disk = other.on_disk;
         storage_key = other.storage_key;
         other.ptr = nullptr;
         other.sz = 0;
+        other.raw_sz = 0;
+        other.on_disk = false;
         other.storage_key = 0;
       }
       return *this;
     }
     pointer ptr;
-    size_t sz;
+    size_t sz;          // size of the buffer kept
+    size_t raw_sz;      // size of the data inserted, the buffer kept is compressed if it differs from sz
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
+    bool on_disk;       // a copy is on disk at storage_key, the copy is kept when the buffer moves back to memory
     StorageManager::key_type storage_key;
   };
 
@@ -95,13 +112,22 @@ class CachePool : public Service {
     int64_t num_disk_cached;
     int64_t average_cache_sz;
     int64_t num_numa_hit;
+    int64_t num_evicted;      // buffers moved from memory to disk
+    int64_t num_promoted;     // buffers moved from disk back to memory
+    int64_t num_mem_hit;      // reads served from memory
+    int64_t num_disk_hit;     // reads served from disk
+    float compression_ratio;  // size of the data inserted over the size kept
     std::vector<key_type> gap;
   };
 
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "");
+  /// \param policy Optional eviction policy, only used with a disk folder
+  /// \param compression Optional compression of the buffers
+  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "",
+                     CacheEvictionPolicy policy = CacheEvictionPolicy::kNone,
+                     CacheCompression compression = CacheCompression::kNone);
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -125,7 +151,7 @@ class CachePool : public Service {
   /// \brief Restore a cached buffer (from memory or disk)
   /// \param[in] key A previous key returned from Insert
   /// \param[out] dest The cached buffer will be copied to this destination represented by a WritableSlice
-  /// \param[out] bytesRead Optional. Number of bytes read.
+  /// \param[out] bytesRead Optional. Number of bytes read, i.e. the size of the data inserted.
   /// \return Error code
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
 
@@ -141,14 +167,45 @@ class CachePool : public Service {
 
   /// \brief Toggle locking
   /// \note Once locking is off. It is user's responsibility to ensure concurrency
-  void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
+  /// \note Locking stays on with eviction since the buffers keep moving between memory and disk
+  void SetLocking(bool on_off) { tree_->SetLocking(on_off || evict_ != nullptr); }
 
  private:
+  /// \brief A buffer is moved back to memory on this many reads from disk
+  static constexpr int32_t kPromoteThreshold = 2;
+  /// \brief Number of buffers moved to disk at most to make room for one allocation
+  static constexpr int32_t kMaxEvictionsPerAllocation = 64;
+
   std::shared_ptr<NumaMemoryPool> mp_;
   Path root_;
   const std::string subfolder_;
+  CacheEvictionPolicy policy_;
   std::shared_ptr<StorageManager> sm_;
   std::shared_ptr<data_index> tree_;
+  std::unique_ptr<CacheEviction> evict_;
+  std::unique_ptr<CacheCodec> codec_;
+  mutable std::mutex disk_hits_mux_;
+  mutable std::unordered_map<key_type, int32_t> disk_hits_;
+  mutable std::atomic<int64_t> num_evicted_;
+  mutable std::atomic<int64_t> num_promoted_;
+  mutable std::atomic<int64_t> num_mem_hit_;
+  mutable std::atomic<int64_t> num_disk_hit_;
+
+  /// \brief Record the numa node of the memory of a buffer
+  Status SetNumaNode(DataLocator *bl) const;
+
+  /// \brief Allocate memory, moving buffers to disk until there is room
+  Status AllocateByEviction(size_t sz, pointer *p) const;
+
+  /// \brief Move the buffer picked by the eviction policy to disk
+  /// \param[out] evicted False if there is no buffer in memory
+  Status EvictOne(bool *evicted) const;
+
+  /// \brief Count a read from disk, and move the buffer back to memory once it is read often enough
+  /// \param[in] key Key of the buffer
+  /// \param[in] bl Locator of the buffer on disk
+  /// \param[in] src Content of the buffer just read
+  Status Promote(key_type key, const DataLocator &bl, const ReadableSlice &src) const;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -302,6 +302,11 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.num_evicted = msg->num_evicted();
+  stat_.num_promoted = msg->num_promoted();
+  stat_.num_mem_hit = msg->num_mem_hit();
+  stat_.num_disk_hit = msg->num_disk_hit();
+  stat_.compression_ratio = msg->compression_ratio();
   return Status::OK();
 }
 
@@ -330,6 +335,11 @@ Status ListSessionsRequest::PostReply() {
     stats.min_row_id = current_session_info->stats()->min_row_id();
     stats.max_row_id = current_session_info->stats()->max_row_id();
     stats.cache_service_state = current_session_info->stats()->state();
+    stats.num_evicted = current_session_info->stats()->num_evicted();
+    stats.num_promoted = current_session_info->stats()->num_promoted();
+    stats.num_mem_hit = current_session_info->stats()->num_mem_hit();
+    stats.num_disk_hit = current_session_info->stats()->num_disk_hit();
+    stats.compression_ratio = current_session_info->stats()->compression_ratio();
     current_info.stats = stats;  // fixed length struct.  = operator is safe
     session_info_list_.push_back(current_info);
   }
@@ -45,6 +45,11 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_evicted;
+  int64_t num_promoted;
+  int64_t num_mem_hit;
+  int64_t num_disk_hit;
+  float compression_ratio;
 };
 
 /// \brief Info structure ListSessionsRequest
@@ -357,6 +362,11 @@ class GenerateSessionIdRequest : public BaseRequest {
     rq_.set_connection_id(0);
   }
 
+  /// \param compression Name of the compression of the caches of the session, e.g. zlib
+  explicit GenerateSessionIdRequest(const std::string &compression) : GenerateSessionIdRequest() {
+    rq_.add_buf_data(compression);
+  }
+
   ~GenerateSessionIdRequest() override = default;
 
   session_id_type GetSessionId() { return atoi(reply_.result().data()); }
@@ -170,6 +170,8 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   if (session_it == active_sessions_.end()) {
     RETURN_STATUS_UNEXPECTED("A cache creation has been requested but the session was not found!");
   }
+  auto compression_it = session_compression_.find(session_id);
+  auto compression = compression_it == session_compression_.end() ? CacheCompression::kNone : compression_it->second;
 
   // We concat both numbers to form the internal connection id.
   auto connection_id = GetConnectionID(session_id, crc);
@@ -237,7 +239,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
     }
     std::unique_ptr<CacheService> cs;
     try {
-      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id);
+      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id, compression);
       RETURN_IF_NOT_OK(cs->ServiceStart());
       cookie = cs->cookie();
       client_id = cs->num_clients_.fetch_add(1);
@@ -525,6 +527,11 @@ Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.stat_.max_key);
     bld.add_min_row_id(svc_stat.stat_.min_key);
     bld.add_state(svc_stat.state_);
+    bld.add_num_evicted(svc_stat.stat_.num_evicted);
+    bld.add_num_promoted(svc_stat.stat_.num_promoted);
+    bld.add_num_mem_hit(svc_stat.stat_.num_mem_hit);
+    bld.add_num_disk_hit(svc_stat.stat_.num_disk_hit);
+    bld.add_compression_ratio(svc_stat.stat_.compression_ratio);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -658,7 +665,10 @@ Status CacheServer::ListSessions(CacheReply *reply) {
         RETURN_IF_NOT_OK(cs->GetStat(&svc_stat));
         auto current_stats = CreateServiceStatMsg(fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached,
                                                   svc_stat.stat_.average_cache_sz, svc_stat.stat_.num_numa_hit,
-                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_);
+                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_,
+                                                  svc_stat.stat_.num_evicted, svc_stat.stat_.num_promoted,
+                                                  svc_stat.stat_.num_mem_hit, svc_stat.stat_.num_disk_hit,
+                                                  svc_stat.stat_.compression_ratio);
         auto current_session_info = CreateListSessionMsg(fbb, current_session_id, current_conn_id, current_stats);
         session_msgs_vector.push_back(current_session_info);
       }
@@ -842,7 +852,7 @@ Status CacheServer::ProcessRequest(CacheServerRequest *cache_req) {
       break;
     }
     case BaseRequest::RequestType::kGenerateSessionId: {
-      cache_req->rc_ = GenerateClientSessionID(GenerateSessionID(), &reply);
+      cache_req->rc_ = GenerateSessionID(&rq, &reply);
       break;
     }
     case BaseRequest::RequestType::kAllocateSharedBlock: {
@@ -936,7 +946,8 @@ session_id_type CacheServer::GetSessionID(connection_id_type connection_id) cons
 }
 
 CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port,
-                         int32_t shared_meory_sz_in_gb, float memory_cap_ratio)
+                         int32_t shared_meory_sz_in_gb, float memory_cap_ratio,
+                         CacheEvictionPolicy eviction_policy)
     : top_(spill_path),
       num_workers_(num_workers),
       num_grpc_workers_(num_workers_),
@@ -944,6 +955,7 @@ CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int
       shared_memory_sz_in_gb_(shared_meory_sz_in_gb),
       global_shutdown_(false),
       memory_cap_ratio_(memory_cap_ratio),
+      eviction_policy_(eviction_policy),
       numa_affinity_(true) {
   hw_info_ = std::make_shared<CacheServerHW>();
   // If we are not linked with numa library (i.e. NUMA_ENABLED is false), turn off cpu
@@ -1022,6 +1034,7 @@ Status CacheServer::DestroySession(CacheRequest *rq) {
   }
   // Finally remove the session itself
   auto n = active_sessions_.erase(drop_session_id);
+  (void)session_compression_.erase(drop_session_id);
   if (n > 0) {
     MS_LOG(WARNING) << "Session destroyed with id " << drop_session_id;
     return Status::OK();
@@ -1038,7 +1051,7 @@ Status CacheServer::DestroySession(CacheRequest *rq) {
   }
 }
 
-session_id_type CacheServer::GenerateSessionID() {
+session_id_type CacheServer::GenerateSessionID(CacheCompression compression) {
   UniqueLock sess_lck(&sessions_lock_);
   auto mt = GetRandomDevice();
   std::uniform_int_distribution<session_id_type> distribution(0, std::numeric_limits<session_id_type>::max());
@@ -1049,9 +1062,22 @@ session_id_type CacheServer::GenerateSessionID() {
     auto r = active_sessions_.insert(session_id);
     duplicate = !r.second;
   } while (duplicate);
+  if (compression != CacheCompression::kNone) {
+    session_compression_[session_id] = compression;
+  }
   return session_id;
 }
 
+Status CacheServer::GenerateSessionID(CacheRequest *rq, CacheReply *reply) {
+  // The compression is optional. Clients which do not send one get a session without compression.
+  CacheCompression compression = CacheCompression::kNone;
+  if (!rq->buf_data().empty()) {
+    auto &name = rq->buf_data(0);
+    CHECK_FAIL_RETURN_UNEXPECTED(StringToCompression(name, &compression), "Unknown compression: " + name);
+  }
+  return GenerateClientSessionID(GenerateSessionID(compression), reply);
+}
+
 Status CacheServer::AllocateSharedMemory(CacheRequest *rq, CacheReply *reply) {
   auto client_id = rq->client_id();
   CHECK_FAIL_RETURN_UNEXPECTED(client_id != -1, "Client ID not set");
@@ -1217,7 +1243,8 @@ CacheServer::Builder::Builder()
       num_workers_(std::thread::hardware_concurrency() / 2),
       port_(50052),
       shared_memory_sz_in_gb_(kDefaultSharedMemorySize),
-      memory_cap_ratio_(kDefaultMemoryCapRatio) {
+      memory_cap_ratio_(kDefaultMemoryCapRatio),
+      eviction_policy_(CacheEvictionPolicy::kNone) {
   if (num_workers_ == 0) {
     num_workers_ = 1;
   }
@@ -70,6 +70,7 @@ class CacheServer : public Service {
     int32_t GetPort() const { return port_; }
     int32_t GetSharedMemorySzInGb() const { return shared_memory_sz_in_gb_; }
     float GetMemoryCapRatio() const { return memory_cap_ratio_; }
+    CacheEvictionPolicy GetEvictionPolicy() const { return eviction_policy_; }
 
     Builder &SetRootDirectory(std::string root) {
       top_ = std::move(root);
@@ -91,6 +92,10 @@ class CacheServer : public Service {
       memory_cap_ratio_ = ratio;
       return *this;
     }
+    Builder &SetEvictionPolicy(CacheEvictionPolicy policy) {
+      eviction_policy_ = policy;
+      return *this;
+    }
 
     Status SanityCheck();
 
@@ -100,7 +105,8 @@ class CacheServer : public Service {
           << "Number of parallel workers: " << GetNumWorkers() << "\n"
           << "Tcp/ip port: " << GetPort() << "\n"
           << "Shared memory size (in GB): " << GetSharedMemorySzInGb() << "\n"
-          << "Memory cap ratio: " << GetMemoryCapRatio();
+          << "Memory cap ratio: " << GetMemoryCapRatio() << "\n"
+          << "Eviction policy: " << static_cast<int32_t>(GetEvictionPolicy());
     }
 
     friend std::ostream &operator<<(std::ostream &out, const Builder &bld) {
@@ -112,8 +118,8 @@ class CacheServer : public Service {
       RETURN_IF_NOT_OK(SanityCheck());
       // We need to bring up the Task Manager by bringing up the Services singleton.
       RETURN_IF_NOT_OK(Services::CreateInstance());
-      RETURN_IF_NOT_OK(
-        CacheServer::CreateInstance(top_, num_workers_, port_, shared_memory_sz_in_gb_, memory_cap_ratio_));
+      RETURN_IF_NOT_OK(CacheServer::CreateInstance(top_, num_workers_, port_, shared_memory_sz_in_gb_,
+                                                   memory_cap_ratio_, eviction_policy_));
       return Status::OK();
     }
 
@@ -123,6 +129,7 @@ class CacheServer : public Service {
     int32_t port_;
     int32_t shared_memory_sz_in_gb_;
     float memory_cap_ratio_;
+    CacheEvictionPolicy eviction_policy_;
 
     /// \brief Sanity checks on the shared memory.
     /// \return Status object
@@ -138,11 +145,12 @@ class CacheServer : public Service {
   ~CacheServer() override { (void)ServiceStop(); }
 
   static Status CreateInstance(const std::string &spill_path, int32_t num_workers, int32_t port,
-                               int32_t shared_memory_sz, float memory_cap_ratio) {
+                               int32_t shared_memory_sz, float memory_cap_ratio,
+                               CacheEvictionPolicy eviction_policy = CacheEvictionPolicy::kNone) {
     std::call_once(init_instance_flag_, [&]() -> Status {
       auto &SvcManager = Services::GetInstance();
-      RETURN_IF_NOT_OK(
-        SvcManager.AddHook(&instance_, spill_path, num_workers, port, shared_memory_sz, memory_cap_ratio));
+      RETURN_IF_NOT_OK(SvcManager.AddHook(&instance_, spill_path, num_workers, port, shared_memory_sz,
+                                          memory_cap_ratio, eviction_policy));
       return Status::OK();
     });
     return Status::OK();
@@ -201,6 +209,9 @@ class CacheServer : public Service {
   /// \brief Return the memory cap ratio
   float GetMemoryCapRatio() const { return memory_cap_ratio_; }
 
+  /// \brief Return the eviction policy of the caches
+  CacheEvictionPolicy GetEvictionPolicy() const { return eviction_policy_; }
+
   /// \brief How a request is handled.
   /// \note that it can be process immediately by a grpc thread or routed to a server thread
   /// which is pinned to some numa node core.
@@ -231,6 +242,7 @@ class CacheServer : public Service {
   std::string top_;
   cache_index all_caches_;
   std::set<session_id_type> active_sessions_;
+  std::map<session_id_type, CacheCompression> session_compression_;  // sessions which compress their caches
   std::shared_ptr<QueueList<CacheServerRequest *>> cache_q_;
   std::shared_ptr<CacheServerGreeterImpl> comm_layer_;
   TaskGroup vg_;
@@ -240,6 +252,7 @@ class CacheServer : public Service {
   int32_t shared_memory_sz_in_gb_;
   std::atomic<bool> global_shutdown_;
   float memory_cap_ratio_;
+  CacheEvictionPolicy eviction_policy_;
   std::shared_ptr<CacheServerHW> hw_info_;
   std::map<worker_id_t, Task *> numa_tasks_;
   bool numa_affinity_;
@@ -250,7 +263,7 @@ class CacheServer : public Service {
   /// \param spill_path Top directory for spilling buffers to.
   /// \param num_workers Number of threads for handling requests.
   explicit CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port, int32_t share_memory_sz_in_gb,
-                       float memory_cap_ratio);
+                       float memory_cap_ratio, CacheEvictionPolicy eviction_policy);
 
   /// \brief Locate a cache service from connection id.
   /// \return Pointer to cache service. Null if not found
@@ -288,8 +301,15 @@ class CacheServer : public Service {
   session_id_type GetSessionID(connection_id_type connection_id) const;
 
   /// \brief Generate a session ID for the client
+  /// \param compression Compression of the rows of the caches of the session
   /// \return Session ID
-  session_id_type GenerateSessionID();
+  session_id_type GenerateSessionID(CacheCompression compression = CacheCompression::kNone);
+
+  /// \brief Handle kGenerateSessionId request
+  /// \param rq CacheRequest
+  /// \param reply CacheReply
+  /// \return Status object
+  Status GenerateSessionID(CacheRequest *rq, CacheReply *reply);
 
   /// \brief Handle kAllocateSharedBlock request
   /// \param rq CacheRequest
@@ -49,7 +49,9 @@ class CacheService : public Service {
   /// \param root Spill path. Empty string means no spilling
   /// \param generate_id If the cache service should generate row id for buffer that is cached.
   /// For non-mappable dataset, this should be set to true.
-  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id);
+  /// \param compression Compression of the rows kept by the cache
+  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id,
+               CacheCompression compression = CacheCompression::kNone);
   ~CacheService() override;
 
   Status DoServiceStart() override;
@@ -131,6 +133,7 @@ class CacheService : public Service {
   std::shared_ptr<CachePool> cp_;
   std::atomic<row_id_type> next_id_;
   bool generate_id_;
+  CacheCompression compression_;
   std::string cookie_;
   std::atomic<int32_t> num_clients_;
   std::atomic<CacheServiceState> st_;
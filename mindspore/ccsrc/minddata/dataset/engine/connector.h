@@ -22,6 +22,7 @@
 #include <vector>
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/ring_queue.h"
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/cond_var.h"
 
@@ -50,6 +51,14 @@ namespace dataset {
 //        - The caller thread of pop() is not equal to the _expectConsumer. This is to enforce
 //          the ordering.
 //
+// Lock-free mode:
+//   With lock_free set, the internal queues are RingQueues which push and pop without taking a lock on the fast
+//   path, and a single consumer pops without the turn-taking lock. The order is the same as above.
+//   With ordered unset as well, all the producers share one RingQueue and the consumers pop from it in whatever
+//   order the elements arrive. This is only for pipelines which do not need a deterministic order and do not rely
+//   on the position of one element relative to those of other producers (e.g. an eoe marker following the rows of
+//   the epoch), so it is never the default.
+//
 // Future improvement:
 //   1. Fault tolerant: Right now, if one of the worker dies, the Connector will not work
 //      properly.
@@ -71,8 +80,11 @@ class Connector {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each queue.
-  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
+  // @param lock_free Use lock-free ring queues, see the lock-free mode at the top of this file.
+  // @param ordered Keep the round-robin order, the lock-free mode is implied when it is unset.
+  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false,
+            bool ordered = true)
+      : num_producers_(n_producers), num_consumers_(n_consumers), lock_free_(lock_free || !ordered), ordered_(ordered) {
     MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
@@ -84,7 +96,15 @@ class Connector {
 
     // Initialize the queues_ to have num_producers_ number of queues.
     // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    if (!ordered_) {
+      ring_queues_.emplace_back(std::make_unique<RingQueue<T>>(num_producers_ * queue_capacity));
+    } else if (lock_free_) {
+      for (int32_t i = 0; i < num_producers_; ++i) {
+        ring_queues_.emplace_back(std::make_unique<RingQueue<T>>(queue_capacity));
+      }
+    } else {
+      queues_.Init(num_producers_, queue_capacity);
+    }
   }
 
   // Destructor of Connector
@@ -96,11 +116,23 @@ class Connector {
   // @param result The address of an object where the popped element will be placed.
   virtual Status Pop(int32_t worker_id,  // The worker-id of the caller. See the requirement at the top of this file.
                      T *result) noexcept {
+    MS_ASSERT(worker_id < num_consumers_);
+    if (!ordered_) {
+      RETURN_IF_NOT_OK(ring_queues_[0]->PopFront(result));
+      out_buffers_count_++;
+      return Status::OK();
+    }
+    if (lock_free_ && num_consumers_ == 1) {
+      // A single consumer has nobody to take turns with.
+      RETURN_IF_NOT_OK(PopFrom(pop_from_, result));
+      pop_from_ = (pop_from_ + 1) % num_producers_;
+      out_buffers_count_++;
+      return Status::OK();
+    }
     {
-      MS_ASSERT(worker_id < num_consumers_);
       std::unique_lock<std::mutex> lk(m_);
       RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
-      RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+      RETURN_IF_NOT_OK(PopFrom(pop_from_, result));
       pop_from_ = (pop_from_ + 1) % num_producers_;
       out_buffers_count_++;
       expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
@@ -116,9 +148,9 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A const lvalue element to be passed/added/pushed.
   Status Push(int32_t worker_id, const T &el) noexcept {
-    MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
-    MS_ASSERT(queues_[worker_id] != nullptr);
-    return (queues_[worker_id]->Add(el));
+    MS_ASSERT(worker_id < num_producers_);
+    T copy(el);
+    return PushTo(worker_id, std::move(copy));
   }
 
   auto out_buffers_count() const { return out_buffers_count_.load(); }
@@ -129,9 +161,51 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el An element to be passed/added/pushed.
   virtual Status Push(int32_t worker_id, T &&el) noexcept {
-    MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
-    MS_ASSERT(queues_[worker_id] != nullptr);
-    return (queues_[worker_id]->Add(std::forward<T>(el)));
+    MS_ASSERT(worker_id < num_producers_);
+    return PushTo(worker_id, std::forward<T>(el));
+  }
+
+  // Add a batch of elements in order, the consumers are woken up once per batch in the lock-free mode.
+  // The vector is cleared once all the elements are added.
+  // @param worker_id The id of a worker thread calling this method.
+  // @param el The elements to be moved into the internal queue.
+  Status PushBatch(int32_t worker_id, std::vector<T> *el) noexcept {
+    MS_ASSERT(worker_id < num_producers_);
+    if (lock_free_) {
+      return ring_queues_[ordered_ ? worker_id : 0]->AddBatch(el);
+    }
+    for (auto &e : *el) {
+      RETURN_IF_NOT_OK(queues_[worker_id]->Add(std::move(e)));
+    }
+    el->clear();
+    return Status::OK();
+  }
+
+  // Get at least one and at most max_count elements from the Connector, it only blocks for the first one.
+  // More than one element is popped at a time only when no other consumer is waiting for its turn, i.e. in the
+  // lock-free mode with a single consumer or without order, so that the order seen by each consumer is unchanged.
+  // @param worker_id The id of a worker thread calling this method.
+  // @param result The vector where the popped elements will be appended.
+  // @param max_count The max number of elements to be popped.
+  Status PopBatch(int32_t worker_id, std::vector<T> *result, int32_t max_count) noexcept {
+    MS_ASSERT(worker_id < num_consumers_);
+    if (!ordered_) {
+      size_t before = result->size();
+      RETURN_IF_NOT_OK(ring_queues_[0]->PopFrontBatch(result, max_count));
+      out_buffers_count_ += result->size() - before;
+      return Status::OK();
+    }
+    T el;
+    RETURN_IF_NOT_OK(Pop(worker_id, &el));
+    result->push_back(std::move(el));
+    if (lock_free_ && num_consumers_ == 1) {
+      for (int32_t i = 1; i < max_count && ring_queues_[pop_from_]->TryPop(&el); ++i) {
+        result->push_back(std::move(el));
+        pop_from_ = (pop_from_ + 1) % num_producers_;
+        out_buffers_count_++;
+      }
+    }
+    return Status::OK();
   }
 
   // Resets the internal index tracking of the queue so that it can be used again with new inputs,
@@ -140,6 +214,9 @@ class Connector {
     for (int i = 0; i < queues_.size(); ++i) {
       queues_[i]->ResetQue();
     }
+    for (auto &ring_queue : ring_queues_) {
+      ring_queue->ResetQue();
+    }
     expect_consumer_ = 0;
     pop_from_ = 0;
     out_buffers_count_ = 0;
@@ -163,6 +240,9 @@ class Connector {
     for (int32_t i = 0; i < queues_.size(); ++i) {
       size += queues_[i]->size();
     }
+    for (const auto &ring_queue : ring_queues_) {
+      size += ring_queue->size();
+    }
     return size;
   }
 
@@ -171,26 +251,67 @@ class Connector {
     for (int32_t i = 0; i < queues_.size(); ++i) {
       capacity += queues_[i]->capacity();
     }
+    for (const auto &ring_queue : ring_queues_) {
+      capacity += ring_queue->capacity();
+    }
     return capacity;
   }
 
+  // Change the capacity of every internal queue while the producers and consumers are running.
+  // The ring queues of a lock free connector have a fixed capacity and can not be resized.
+  // @param queue_capacity The new capacity of each internal queue.
+  // @return Status error code
+  Status Resize(int32_t queue_capacity) {
+    CHECK_FAIL_RETURN_UNEXPECTED(!lock_free_, "Lock free connector " + my_name_ + " can not be resized.");
+    for (int i = 0; i < queues_.size(); ++i) {
+      RETURN_IF_NOT_OK(queues_[i]->Resize(queue_capacity));
+    }
+    MS_LOG(DEBUG) << "Connector " << my_name_ << " resized to " << queue_capacity << " per queue.";
+    return Status::OK();
+  }
+
   // Register the internal resources with Task group for interruption service.
   // @param vg
   // @return
   Status Register(TaskGroup *vg) {
     Status rc = queues_.Register(vg);
+    for (auto &ring_queue : ring_queues_) {
+      if (rc.IsOk()) {
+        rc = ring_queue->Register(vg);
+      }
+    }
     if (rc.IsOk()) {
       rc = cv_.Register(vg->GetIntrpService());
     }
     return rc;
   }
 
+  bool lock_free() const { return lock_free_; }
+
+  bool ordered() const { return ordered_; }
+
  protected:
+  // Pop from the internal queue of the producer, which ever kind of queue it is.
+  Status PopFrom(int32_t queue_id, T *result) {
+    return lock_free_ ? ring_queues_[queue_id]->PopFront(result) : queues_[queue_id]->PopFront(result);
+  }
+
+  // Push to the internal queue of the producer, all the producers share one queue when the order is relaxed.
+  Status PushTo(int32_t worker_id, T &&el) {
+    if (lock_free_) {
+      return ring_queues_[ordered_ ? worker_id : 0]->Add(std::forward<T>(el));
+    }
+    return queues_[worker_id]->Add(std::forward<T>(el));
+  }
+
   std::string my_name_;
 
   // A list of Queues that are thread safe.
   QueueList<T> queues_;
 
+  // The lock-free queues used instead of queues_ in the lock-free mode, only one of them when not ordered.
+  std::vector<std::unique_ptr<RingQueue<T>>> ring_queues_;
+
   // The consumer that we allow to get the next data from pop()
   int32_t expect_consumer_;
 
@@ -199,6 +320,8 @@ class Connector {
 
   int32_t num_producers_;
   int32_t num_consumers_;
+  bool lock_free_;
+  bool ordered_;
 
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
@@ -111,6 +111,13 @@ Status IteratorConsumer::GetNextAsOrderedPair(std::vector<std::pair<std::string,
   return Status::OK();
 }
 
+Status IteratorConsumer::GetCheckpoint(nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  return tree_adapter_->GetCheckpoint(out_json);
+}
+
+Status IteratorConsumer::Restore(const nlohmann::json &checkpoint) { return tree_adapter_->Restore(checkpoint); }
+
 // ToDevice
 Status ToDevice::Init(std::shared_ptr<DatasetNode> d) { return tree_adapter_->Compile(std::move(d), num_epochs_); }
 
@@ -216,6 +223,10 @@ Status SaveToDisk::Save() {
   if (mindrecord::SUCCESS != mindrecord::ShardWriter::initialize(&mr_writer, file_names)) {
     RETURN_STATUS_UNEXPECTED("Error: failed to initialize ShardWriter.");
   }
+  // rows are flushed while the next ones are fetched, and the index is generated by Commit
+  if (mindrecord::SUCCESS != mr_writer->SetStreamingMode(true)) {
+    RETURN_STATUS_UNEXPECTED("Error: failed to set streaming mode of ShardWriter.");
+  }
 
   std::unordered_map<std::string, int32_t> column_name_id_map;
   for (auto el : tree_adapter_->GetColumnNameMap()) {
@@ -263,9 +274,8 @@ Status SaveToDisk::Save() {
     }
   } while (!row.empty());
 
-  mr_writer->Commit();
-  if (mindrecord::SUCCESS != mindrecord::ShardIndexGenerator::finalize(file_names)) {
-    RETURN_STATUS_UNEXPECTED("Error: failed to finalize ShardIndexGenerator.");
+  if (mindrecord::SUCCESS != mr_writer->Commit()) {
+    RETURN_STATUS_UNEXPECTED("Error: failed to commit ShardWriter.");
   }
   return Status::OK();
 }
@@ -79,6 +79,16 @@ class IteratorConsumer : public TreeConsumer {
   /// \return Status error code
   Status GetNextAsOrderedPair(std::vector<std::pair<std::string, std::shared_ptr<Tensor>>> *const vec);
 
+  /// Save the position of the iterator in the dataset
+  /// \param[out] out_json the checkpoint to pass to Restore
+  /// \return Status error code
+  Status GetCheckpoint(nlohmann::json *out_json);
+
+  /// Continue from a checkpoint saved by GetCheckpoint, it must be called before the first row is fetched
+  /// \param[in] checkpoint the checkpoint returned by GetCheckpoint on the same pipeline
+  /// \return Status error code
+  Status Restore(const nlohmann::json &checkpoint);
+
  protected:
   /// Method to return the name of the consumer
   /// \return string
@@ -93,6 +93,16 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
 }
 #endif
 
+bool BatchOp::GetFixedBatchSize(int32_t *batch_size) const {
+#ifdef ENABLE_PYTHON
+  if (batch_size_func_) {
+    return false;
+  }
+#endif
+  *batch_size = start_batch_size_;
+  return true;
+}
+
 Status BatchOp::operator()() {
   Status rc = LaunchThreadsAndInitOp();
   // Synchronize with TaskManager
@@ -167,7 +177,7 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
 }
 
 Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size) {
+                          dsize_t batch_size, const TensorRow &batched_cols) {
   if ((*src)->size() != batch_size) {
     RETURN_STATUS_UNEXPECTED("[Internal Batch ERROR] Source table size does not match the batch_size");
   }
@@ -175,16 +185,24 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
   if (batch_size == 1) {
     TensorRow row = std::move((*src)->front());
     (*src)->pop_front();
-    (*dest)->push_back(row);
-    for (const auto &tensor : (*dest)->front()) {
-      RETURN_IF_NOT_OK(tensor->ExpandDim(0));
+    for (size_t i = 0; i < row.size(); i++) {
+      if (i < batched_cols.size() && batched_cols[i] != nullptr) {
+        row[i] = batched_cols[i];  // padded in place, it has the batch dimension already
+      } else {
+        RETURN_IF_NOT_OK(row[i]->ExpandDim(0));
+      }
     }
+    (*dest)->push_back(std::move(row));
     return Status::OK();
   }
 
   TensorRow batched_row;
   auto num_columns = (*src)->front().size();
   for (size_t i = 0; i < num_columns; i++) {
+    if (i < batched_cols.size() && batched_cols[i] != nullptr) {
+      batched_row.emplace_back(batched_cols[i]);
+      continue;
+    }
     std::shared_ptr<Tensor> first_tensor = (*src)->at(0).at(i);  // first row, column i
     TensorShape first_shape = first_tensor->shape();
     DataType first_type = first_tensor->type();
@@ -192,11 +210,14 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
 
     std::shared_ptr<Tensor> new_tensor;
     if (first_type.IsNumeric()) {  // numeric tensor
+      // The batch tensor is allocated once, then every row is copied into its slot and dropped right away, so the
+      // memory of a column is not held twice until the whole batch is done.
       RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
+      first_tensor.reset();
       dsize_t j = 0;
-      for (auto row : **src) {
-        std::shared_ptr<Tensor> old_tensor = row.at(i);  // row j, column i
-        if (old_tensor->shape() == first_shape) {        // check the newly popped rows have the same dim as the first
+      for (auto &row : **src) {
+        std::shared_ptr<Tensor> old_tensor = std::move(row.at(i));  // row j, column i
+        if (old_tensor->shape() == first_shape) {                  // check the newly popped rows have the same dim
           if (new_shape.NumOfElements() != 0) {
             RETURN_IF_NOT_OK(new_tensor->InsertTensor({j++}, old_tensor));
           }
@@ -250,10 +271,12 @@ Status BatchOp::MakeBatchedBuffer(std::pair<std::unique_ptr<TensorQTable>, CBatc
 #ifdef ENABLE_PYTHON
   if (!in_col_names_.empty()) RETURN_IF_NOT_OK(MapColumns(&table_pair));  // pass it through pyfunc
 #endif
-  if (pad_) RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_));  // do padding if needed
+  TensorRow batched_cols;
+  // do padding if needed, the numeric columns are padded straight into their batch tensor
+  if (pad_) RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_, &batched_cols));
   (*db) = std::make_unique<DataBuffer>(table_pair.second.batch_num_, DataBuffer::kDeBFlagNone);
   std::unique_ptr<TensorQTable> dest_table = std::make_unique<TensorQTable>();
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size()));
+  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size(), batched_cols));
   (*db)->set_tensor_table(std::move(dest_table));
   return Status::OK();
 }
@@ -417,7 +440,8 @@ Status BatchOp::InvokeBatchMapFunc(TensorTable *input, TensorTable *output, CBat
 #endif
 
 Status BatchOp::PadColumns(std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
-                           const std::unordered_map<std::string, int32_t> &column_name_id_map) {
+                           const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                           TensorRow *batched_cols) {
   RETURN_UNEXPECTED_IF_NULL(table);  // placeholder for now, might need this in the future
   CHECK_FAIL_RETURN_UNEXPECTED(
     (*table)->front().size() == column_name_id_map.size(),
@@ -460,6 +484,24 @@ Status BatchOp::PadColumns(std::unique_ptr<TensorQTable> *table, const PadInfo &
     }
   }
 
+  // pad the numeric columns in place, every tensor is written once into its row of the batch tensor
+  if (batched_cols != nullptr) {
+    *batched_cols = TensorRow(column_name_id_map.size(), nullptr);
+    for (auto itr = pad_cols.begin(); itr != pad_cols.end();) {
+      size_t col_id = *itr;
+      if (!(*table)->front()[col_id]->type().IsNumeric()) {
+        ++itr;
+        continue;
+      }
+      TensorRow col;
+      for (TensorRow &row : **table) {
+        col.push_back(std::move(row[col_id]));
+      }
+      RETURN_IF_NOT_OK(PadEndBatch(col, &(*batched_cols)[col_id], pad_shapes[col_id], pad_vals[col_id]));
+      itr = pad_cols.erase(itr);
+    }
+  }
+
   // call pad on each tensor that needs to be padded
   for (TensorRow &row : **table) {
     for (size_t col_id : pad_cols) {
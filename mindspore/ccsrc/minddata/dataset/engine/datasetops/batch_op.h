@@ -209,21 +209,31 @@ class BatchOp : public ParallelOp {
   // @return Name of the current Op
   std::string Name() const override { return kBatchOp; }
 
-  // batch the rows in src table then put it to dest table
+  // Getter for the batch size when every batch but the last one of an epoch has the same number of rows
+  // @param int32_t *batch_size - the batch size
+  // @return - false if the batch size is given by a batch size function
+  bool GetFixedBatchSize(int32_t *batch_size) const;
+
+  // batch the rows in src table then put it to dest table. Every row is copied once into its slot of the batch
+  // tensor, and its tensors are released as soon as they are copied.
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
   // @param int32_t size - batch_size
-  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param const TensorRow &batched_cols - columns already batched by PadColumns, nullptr for the other columns
   // @return Status The status code returned
   static Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
-                          dsize_t batch_size);
+                          dsize_t batch_size, const TensorRow &batched_cols = TensorRow());
 
   // @param table
   // @param const PadInfo &pad_info pad info
   // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param TensorRow *batched_cols - if not nullptr, the numeric columns are padded in place, i.e. straight into
+  //     their batch tensor which is returned here, and BatchRows takes it from here. Otherwise every tensor of the
+  //     table is replaced by its padded copy.
   // @return Status The status code returned
   static Status PadColumns(std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
-                           const std::unordered_map<std::string, int32_t> &column_name_id_map);
+                           const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                           TensorRow *batched_cols = nullptr);
 
   int64_t GetTreeBatchSize() override;
 
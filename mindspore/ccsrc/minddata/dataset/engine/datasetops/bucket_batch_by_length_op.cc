@@ -202,11 +202,12 @@ Status BucketBatchByLengthOp::PadAndBatchBucket(int32_t bucket_index, int32_t ba
     }
   }
 
-  // PadColumns will change the data in bucket
-  RETURN_IF_NOT_OK(BatchOp::PadColumns(bucket, pad_info_copy, column_name_id_map_));
+  // PadColumns will change the data in bucket, the numeric columns are padded straight into their batch tensor
+  TensorRow batched_cols;
+  RETURN_IF_NOT_OK(BatchOp::PadColumns(bucket, pad_info_copy, column_name_id_map_, &batched_cols));
 
   std::unique_ptr<TensorQTable> batched_bucket = std::make_unique<TensorQTable>();
-  RETURN_IF_NOT_OK(BatchOp::BatchRows(bucket, &batched_bucket, batch_size));
+  RETURN_IF_NOT_OK(BatchOp::BatchRows(bucket, &batched_bucket, batch_size, batched_cols));
   (*bucket)->clear();
 
   std::unique_ptr<DataBuffer> batched_buffer = std::make_unique<DataBuffer>(batch_count_, DataBuffer::kDeBFlagNone);
@@ -183,6 +183,7 @@ Status BuildVocabOp::CollectorThread() {
   if (!special_first_) {
     for (const std::string &sp_tk : special_tokens_) vocab_->append_word(sp_tk);
   }
+  vocab_->BuildTrie();
 
   RETURN_IF_NOT_OK(out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)));
   RETURN_IF_NOT_OK(out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF)));
@@ -189,6 +189,9 @@ Status CacheOp::WaitForCachingAllRows() {
   MS_LOG(INFO) << "Number of rows cached in memory : " << stat.num_mem_cached;
   MS_LOG(INFO) << "Number of rows spilled to disk : " << stat.num_disk_cached;
   MS_LOG(INFO) << "Average cache size : " << stat.avg_cache_sz;
+  MS_LOG(INFO) << "Number of rows evicted to disk : " << stat.num_evicted;
+  MS_LOG(INFO) << "Number of rows promoted to memory : " << stat.num_promoted;
+  MS_LOG(INFO) << "Compression ratio : " << stat.compression_ratio;
   // Now all rows are cached and we have done a sync point check up. Next phase is
   // is pick up fetch input from sampler and pass up to the caller.
   RETURN_IF_NOT_OK(sampler_->HandshakeRandomAccessOp(this));
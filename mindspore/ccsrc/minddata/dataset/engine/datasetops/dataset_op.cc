@@ -23,6 +23,8 @@
 #include <string>
 #include <algorithm>
 
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/device_queue_op.h"
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
@@ -216,7 +218,8 @@ void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
   if (oc_queue_size_ > 0) {
     out_connector_ = std::make_unique<DbConnector>(num_producers,  // The number of producers
                                                    num_consumers,  // Only one consumer (the training App)
-                                                   oc_queue_size_);
+                                                   oc_queue_size_,
+                                                   GlobalContext::config_manager()->lock_free_connector());
   } else {
     // Some op's may choose not to have an output connector
     MS_LOG(DEBUG) << "Bypassed connector creation for tree operator: " << operator_id_ << ".";
@@ -224,6 +227,15 @@ void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
   }
 }
 
+// Change the capacity of each queue of the output connector while the tree is executing
+Status DatasetOp::SetConnectorQueueSize(int32_t queue_size) {
+  CHECK_FAIL_RETURN_UNEXPECTED(out_connector_ != nullptr && queue_size > 0,
+                               "Connector queue size of " + Name() + " can not be changed.");
+  RETURN_IF_NOT_OK(out_connector_->Resize(queue_size));
+  oc_queue_size_ = queue_size;
+  return Status::OK();
+}
+
 // A print method typically used for debugging.  showAll of true will recursively descend to child prints
 void DatasetOp::Print(std::ostream &out, bool show_all) const {
   // When show_all is false, we display a 1 liner piece of text for the op.
@@ -476,6 +488,20 @@ uint32_t DatasetOp::GenerateCRC(const std::shared_ptr<DatasetOp> &op) {
 }
 #endif
 
+Status DatasetOp::Resume(int64_t epoch, const nlohmann::json &state) {
+  CHECK_FAIL_RETURN_UNEXPECTED(epoch == 0 || op_num_repeats_per_epoch_ > 0,
+                               NameWithID() + " can not resume after the first epoch of an infinite repeat.");
+  CHECK_FAIL_RETURN_UNEXPECTED(op_total_repeats_ == kInfiniteRepeat || epoch < op_total_epochs(),
+                               "Invalid resume point, epoch " + std::to_string(epoch) + " of " + NameWithID() +
+                                 " is beyond the number of epochs.");
+  op_current_epochs_ = epoch;
+  op_current_repeats_ = epoch * op_num_repeats_per_epoch_;
+  if (sampler_ != nullptr) {
+    sampler_->SetResumePoint(op_current_repeats_, 0);
+  }
+  return Status::OK();
+}
+
 void DatasetOp::UpdateRepeatAndEpochCounter() {
   op_current_repeats_++;
   if (op_current_repeats_ % op_num_repeats_per_epoch_ == 0) op_current_epochs_++;
@@ -315,6 +315,15 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   /// \return connector capacity of child op
   int32_t ChildOpConnectorCapacity(int32_t child_index = 0) const { return child_[child_index]->ConnectorCapacity(); }
 
+  /// \brief Getter function
+  /// \return capacity of each queue of the output connector, 0 for an inlined op
+  int32_t ConnectorQueueSize() const { return oc_queue_size_; }
+
+  /// \brief Change the capacity of each queue of the output connector while the tree is executing
+  /// \param[in] queue_size The new capacity, it can not go below the number of buffers already in a queue
+  /// \return Status of the function
+  Status SetConnectorQueueSize(int32_t queue_size);
+
   /// \brief Children Getter
   /// \return Vector of Children
   std::vector<std::shared_ptr<DatasetOp>> Children() const { return child_; }
@@ -387,6 +396,19 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   /// \return Status
   virtual Status WaitForWorkers() { return Status::OK(); }
 
+  /// \brief Save the state the op needs to start an epoch of the pipeline again, see TreeAdapter::GetCheckpoint.
+  /// \param[in] epoch The epoch of the pipeline
+  /// \param[out] out_json The state of the op, left untouched if the op keeps no state across epochs
+  /// \return Status of the function
+  virtual Status SaveResumeState(int64_t epoch, nlohmann::json *out_json) { return Status::OK(); }
+
+  /// \brief Move the op to the beginning of an epoch of the pipeline, it is called before the tree is launched.
+  ///     The base class restores the repeat and epoch counters and skips the epochs of the sampler.
+  /// \param[in] epoch The epoch of the pipeline
+  /// \param[in] state The state saved by SaveResumeState
+  /// \return Status of the function
+  virtual Status Resume(int64_t epoch, const nlohmann::json &state);
+
   /// \brief Add callback to DatasetOp, only MapOp supports Callback at the moment
   void AddCallbacks(std::vector<std::shared_ptr<DSCallback>> callbacks) { callback_manager_.AddCallbacks(callbacks); }
 
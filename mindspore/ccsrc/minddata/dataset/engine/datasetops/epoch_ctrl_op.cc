@@ -104,6 +104,12 @@ Status EpochCtrlOp::EoeReceived(int32_t worker_id) {
   return Status::OK();
 }
 
+Status EpochCtrlOp::Resume(int64_t epoch, const nlohmann::json &state) {
+  RETURN_IF_NOT_OK(RepeatOp::Resume(epoch, state));
+  repeat_count_ = epoch;
+  return Status::OK();
+}
+
 // Pre-Visitor accept method for NodePass
 Status EpochCtrlOp::PreAccept(NodePass *p, bool *const modified) {
   // Downcast shared pointer then call the pre-visitation
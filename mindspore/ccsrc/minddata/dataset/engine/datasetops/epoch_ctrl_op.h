@@ -65,6 +65,12 @@ class EpochCtrlOp : public RepeatOp {
   // @param worker_id - The worker id
   Status EoeReceived(int32_t worker_id) override;
 
+  /// \brief Base-class override, the epoch count starts from the resumed epoch as well
+  /// \param[in] epoch The epoch of the pipeline
+  /// \param[in] state Not used
+  /// \return Status of the function
+  Status Resume(int64_t epoch, const nlohmann::json &state) override;
+
   /// \brief Base-class override for NodePass pre-visit acceptor
   /// \param[in] p The node to visit
   /// \param[out] modified Indicator if the node was modified
@@ -62,6 +62,13 @@ Status MapOp::Builder::Build(std::shared_ptr<MapOp> *ptr) {
 MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std::string> &out_col_names,
              std::vector<std::shared_ptr<TensorOp>> tensor_funcs, int32_t num_workers, int32_t op_connector_size)
     : ParallelOp(num_workers, op_connector_size),
+      work_stealing_((GlobalContext::config_manager()->map_work_stealing() && num_workers > 1) ||
+                     GlobalContext::config_manager()->enable_autotune()),
+      num_stolen_jobs_(0),
+      num_helper_jobs_(0),
+      num_helpers_(0),
+      num_helpers_launched_(0),
+      helpers_quit_(false),
       tfuncs_(std::move(tensor_funcs)),
       in_columns_(in_col_names),
       out_columns_(out_col_names) {
@@ -100,20 +107,155 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
   }
 }
 
-// A helper function that fetch worker map job from local queues and extract the data and map job list
-Status MapOp::FetchNextWork(uint32_t worker_id, std::unique_ptr<DataBuffer> *db,
-                            std::vector<std::shared_ptr<MapJob>> *job_list) {
-  std::unique_ptr<MapWorkerJob> worker_job;
+// A helper function that fetch worker map job from local queues, an idle worker steals work before it blocks.
+Status MapOp::FetchNextWork(uint32_t worker_id, std::shared_ptr<MapWorkerJob> *worker_job) {
+  bool stolen = work_stealing_;
+  while (stolen && local_queues_[worker_id]->empty()) {
+    RETURN_IF_NOT_OK(StealWork(worker_id, &stolen));
+  }
   // Fetch the next worker job and data buffer
-  RETURN_IF_NOT_OK(local_queues_[worker_id]->PopFront(&worker_job));
-  // Extract the databuffer and job list from the map worker job.
-  *db = std::move(worker_job->databuffer);
-  *job_list = std::move(worker_job->jobs);
+  RETURN_IF_NOT_OK(local_queues_[worker_id]->PopFront(worker_job));
+  return Status::OK();
+}
+
+Status MapOp::SendToWorker(int32_t worker_id, std::shared_ptr<MapWorkerJob> worker_job) {
+  if (work_stealing_) {
+    // Registered before it is queued, so it can be stolen while the master waits for room in a full queue.
+    std::unique_lock<std::mutex> lock(steal_mux_);
+    steal_lists_[worker_id].push_back(worker_job);
+    // The helpers share one CondVar, and one with an id beyond num_helpers_ would swallow a single notification.
+    if (num_helpers_ > 0) {
+      helper_cv_.NotifyAll();
+    }
+  }
+  return local_queues_[worker_id]->Add(std::move(worker_job));
+}
 
+Status MapOp::StealWork(int32_t worker_id, bool *stolen) {
+  std::shared_ptr<MapWorkerJob> worker_job;
+  {
+    std::unique_lock<std::mutex> lock(steal_mux_);
+    // The longest backlog is most likely the one behind a slow buffer.
+    int32_t victim = -1;
+    for (int32_t i = 0; i < num_workers_; i++) {
+      if (i != worker_id && !steal_lists_[i].empty() &&
+          (victim < 0 || steal_lists_[i].size() > steal_lists_[victim].size())) {
+        victim = i;
+      }
+    }
+    // Take from the back, i.e. the job its owner would get to last.
+    while (victim >= 0 && !steal_lists_[victim].empty() && worker_job == nullptr) {
+      if (steal_lists_[victim].back()->Claim()) {
+        worker_job = steal_lists_[victim].back();
+      }
+      steal_lists_[victim].pop_back();
+    }
+    num_stolen_jobs_ += (worker_job != nullptr) ? 1 : 0;
+    num_helper_jobs_ += (worker_job != nullptr && worker_id < 0) ? 1 : 0;
+  }
+  *stolen = (worker_job != nullptr);
+  if (*stolen) {
+    // A failure is reported by the owner, so that the error surfaces in order.
+    worker_job->rc = ComputeWorkerJob(worker_job.get());
+    {
+      std::unique_lock<std::mutex> lock(steal_mux_);
+      worker_job->state = kJobDone;
+    }
+    steal_cv_.NotifyAll();
+  }
   return Status::OK();
 }
 
-Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job) {
+Status MapOp::ClaimOrWait(int32_t worker_id, MapWorkerJob *worker_job) {
+  if (!work_stealing_) {
+    return ComputeWorkerJob(worker_job);
+  }
+  bool claimed = worker_job->Claim();
+  std::unique_lock<std::mutex> lock(steal_mux_);
+  // Drop the claimed jobs at the front of own list, the stolen ones are already removed by the thieves.
+  auto &steal_list = steal_lists_[worker_id];
+  while (!steal_list.empty() && steal_list.front()->state != kJobPending) {
+    steal_list.pop_front();
+  }
+  if (claimed) {
+    lock.unlock();
+    return ComputeWorkerJob(worker_job);
+  }
+  RETURN_IF_NOT_OK(steal_cv_.Wait(&lock, [worker_job]() { return worker_job->state == kJobDone; }));
+  return worker_job->rc;
+}
+
+bool MapOp::HasStealableWork() const {
+  return std::any_of(steal_lists_.begin(), steal_lists_.end(), [](const auto &steal_list) {
+    return !steal_list.empty() && steal_list.back()->state == kJobPending;
+  });
+}
+
+Status MapOp::HelperEntry(int32_t helper_id) {
+  TaskManager::FindMe()->Post();
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(steal_mux_);
+      RETURN_IF_NOT_OK(helper_cv_.Wait(&lock, [this, helper_id]() {
+        return helpers_quit_ || (helper_id < num_helpers_ && HasStealableWork());
+      }));
+      if (helpers_quit_) {
+        break;
+      }
+    }
+    // A helper owns no list, so -1 never matches a victim.
+    bool stolen = false;
+    RETURN_IF_NOT_OK(StealWork(-1, &stolen));
+  }
+  return Status::OK();
+}
+
+Status MapOp::SetNumHelperWorkers(int32_t num_helpers) {
+  CHECK_FAIL_RETURN_UNEXPECTED(work_stealing_ && num_helpers >= 0, "Invalid number of helper workers for " + Name());
+  int32_t num_launched = 0;
+  {
+    std::unique_lock<std::mutex> lock(steal_mux_);
+    CHECK_FAIL_RETURN_UNEXPECTED(!helpers_quit_ && steal_lists_.size() == num_workers_, Name() + " is not running.");
+    num_helpers_ = num_helpers;
+    num_launched = num_helpers_launched_;
+    num_helpers_launched_ = std::max(num_helpers_launched_, num_helpers);
+  }
+  for (int32_t helper_id = num_launched; helper_id < num_helpers; helper_id++) {
+    RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask(NameWithID() + " helper",
+                                                        std::bind(&MapOp::HelperEntry, this, helper_id)));
+  }
+  helper_cv_.NotifyAll();
+  MS_LOG(INFO) << NameWithID() << " runs with " << num_workers_ << " workers and " << num_helpers << " helpers.";
+  return Status::OK();
+}
+
+int32_t MapOp::NumHelperWorkers() {
+  std::unique_lock<std::mutex> lock(steal_mux_);
+  return num_helpers_;
+}
+
+int64_t MapOp::NumStolenJobs() {
+  std::unique_lock<std::mutex> lock(steal_mux_);
+  return num_stolen_jobs_;
+}
+
+int64_t MapOp::NumHelperJobs() {
+  std::unique_lock<std::mutex> lock(steal_mux_);
+  return num_helper_jobs_;
+}
+
+Status MapOp::ComputeWorkerJob(MapWorkerJob *worker_job) {
+  DataBuffer *in_buffer = worker_job->databuffer.get();
+  CHECK_FAIL_RETURN_UNEXPECTED(in_buffer->NumRows() * in_buffer->NumCols() != 0, "MapOp got an empty DataBuffer.");
+  std::unique_ptr<TensorQTable> new_tensor_table(std::make_unique<TensorQTable>());
+  // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
+  RETURN_IF_NOT_OK(WorkerCompute(in_buffer, new_tensor_table.get(), worker_job->jobs));
+  // Replace the TensorTable in DataBuffer with the new one.
+  in_buffer->set_tensor_table(std::move(new_tensor_table));
+  return Status::OK();
+}
+
+Status MapOp::GenerateWorkerJob(const std::shared_ptr<MapWorkerJob> *worker_job) {
   std::shared_ptr<MapJob> map_job = nullptr;
   MapTargetDevice prev_target;
   for (size_t i = 0; i < tfuncs_.size(); i++) {
@@ -146,10 +288,13 @@ Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job)
 Status MapOp::operator()() {
   // Create and register the local queues.
   local_queues_.Init(num_workers_, oc_queue_size_);
+  steal_lists_.resize(num_workers_);
   // init callback
   RETURN_IF_NOT_OK(callback_manager_.Init(this));
   Status rc = local_queues_.Register(tree_->AllTasks());
   RETURN_IF_NOT_OK(wait_for_workers_post_.Register(tree_->AllTasks()));
+  RETURN_IF_NOT_OK(steal_cv_.Register(tree_->AllTasks()->GetIntrpService()));
+  RETURN_IF_NOT_OK(helper_cv_.Register(tree_->AllTasks()->GetIntrpService()));
   if (rc.IsError()) {
     TaskManager::FindMe()->Post();
     return rc;
@@ -179,13 +324,13 @@ Status MapOp::operator()() {
 
       RETURN_IF_NOT_OK(callback_manager_.StepBegin(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
 
-      std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(buff));
+      std::shared_ptr<MapWorkerJob> worker_job = std::make_shared<MapWorkerJob>(std::move(buff));
 
       // Populate map worker job for a worker to execute
       RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
 
       // Push map worker job to the corresponding worker's queue
-      RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
+      RETURN_IF_NOT_OK(SendToWorker(num_buf++ % num_workers_, std::move(worker_job)));
 
       RETURN_IF_NOT_OK(callback_manager_.StepEnd(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
 
@@ -199,21 +344,27 @@ Status MapOp::operator()() {
       ep_step = 0;
     }
     // Propagate the eoe buffer to worker
-    std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(buff));
+    std::shared_ptr<MapWorkerJob> worker_job = std::make_shared<MapWorkerJob>(std::move(buff));
     RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(child_[0]->GetNextBuffer(&buff, 0));
   }
   // End() is commented out because it might never be called due to the lack of EOF when EpochCtrl is -1
   // Handle eof logic, this code might never be reached if epoch_ctrl = -1.
-  std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(buff));
+  std::shared_ptr<MapWorkerJob> worker_job = std::make_shared<MapWorkerJob>(std::move(buff));
   RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
 
   // Quit all workers, this code might never be reached if EpochCtrl is -1.
   for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
-    auto quit = std::make_unique<MapWorkerJob>(std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagQuit));
+    auto quit = std::make_shared<MapWorkerJob>(std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagQuit));
     RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(quit)));
   }
+  // Every job is queued, the workers finish the ones left to steal.
+  {
+    std::unique_lock<std::mutex> lock(steal_mux_);
+    helpers_quit_ = true;
+  }
+  helper_cv_.NotifyAll();
 
   return Status::OK();
 }
@@ -226,15 +377,15 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
   // Handshake with TaskManager that thread creation is successful.
   TaskManager::FindMe()->Post();
 
-  std::unique_ptr<DataBuffer> in_buffer;
-  std::vector<std::shared_ptr<MapJob>> job_list;
+  std::shared_ptr<MapWorkerJob> worker_job;
   // Fetch next data buffer and map job list
-  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_buffer, &job_list));
+  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &worker_job));
 
   // Now that init work is done, drop into the main fetching loop.
   // Map op does not use child iterator, and it needs to manually handle eoe and eof's itself
   // rather than use the base-class defaults.
   while (true) {
+    std::unique_ptr<DataBuffer> &in_buffer = worker_job->databuffer;
     // Handle special logic where buffer carries a ctrl flag.
     if (in_buffer->buffer_flags() != DataBuffer::kDeBFlagNone) {
       if (in_buffer->wait()) {
@@ -253,19 +404,15 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
       } else if (in_buffer->quit()) {
         break;
       }
-      RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_buffer, &job_list));
+      RETURN_IF_NOT_OK(FetchNextWork(worker_id, &worker_job));
       continue;
     }
-    CHECK_FAIL_RETURN_UNEXPECTED(in_buffer->NumRows() * in_buffer->NumCols() != 0, "MapOp got an empty DataBuffer.");
-    std::unique_ptr<TensorQTable> new_tensor_table(std::make_unique<TensorQTable>());
-    // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
-    RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), new_tensor_table.get(), job_list));
-    // Replace the TensorTable in DataBuffer with the new one.
-    in_buffer->set_tensor_table(std::move(new_tensor_table));
+    // Compute the buffer, unless a thief has taken it already.
+    RETURN_IF_NOT_OK(ClaimOrWait(worker_id, worker_job.get()));
     // Push the buffer onto the connector for next operator to consume.
     RETURN_IF_NOT_OK(out_connector_->Add(static_cast<int>(worker_id), std::move(in_buffer)));
     // Fetch next data buffer and map job list
-    RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_buffer, &job_list));
+    RETURN_IF_NOT_OK(FetchNextWork(worker_id, &worker_job));
   }
   return Status::OK();
 }
@@ -463,7 +610,7 @@ Status MapOp::WaitForWorkers() {
   for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
     // a special buffer (id=-1, empty, none flag) is used to signal that worker needs to pause.
     RETURN_IF_NOT_OK(local_queues_[wkr_id]->Add(
-      std::make_unique<MapWorkerJob>(std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagWait))));
+      std::make_shared<MapWorkerJob>(std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagWait))));
   }
   // wait until all workers are done processing their work in local_queue_
   RETURN_IF_NOT_OK(wait_for_workers_post_.Wait());
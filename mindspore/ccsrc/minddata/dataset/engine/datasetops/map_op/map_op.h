@@ -17,7 +17,9 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_MAP_OP_H_
 
 #include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -27,6 +29,7 @@
 #include "minddata/dataset/engine/datasetops/map_op/map_job.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/cond_var.h"
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/wait_post.h"
 
@@ -61,6 +64,14 @@ class ExecutionTree;
 //     for the Tensors produced by TensorOp Compute().
 // Remainder Columns : columns that exist in the dataset but are not mentioned in Input Columns.
 //     These columns will not be passed to TensorOp Compute(), but will be appended to the end of the Output Columns.
+//
+// Work stealing: the master thread hands the buffers to the workers round-robin, and the output connector expects
+// them back from the same workers in the same order. When ConfigManager::map_work_stealing() is on, a worker whose
+// queue is empty takes a pending buffer from the back of the longest backlog of the other workers and computes it.
+// The owner of the buffer still pushes it to the output connector when it gets there, waiting for the thief if
+// needed, so one slow buffer no longer holds up all the buffers queued behind it and the order is unchanged.
+// The same mechanism lets the auto tuner add or remove helper workers at runtime: a helper owns no queue and only
+// steals, so the number of threads doing the compute changes without touching the round-robin order.
 class MapOp : public ParallelOp {
  public:
   // The nested builder class inside of the MapOp is used to help manage all of
@@ -200,24 +211,94 @@ class MapOp : public ParallelOp {
 
   const auto &TFuncs() const { return tfuncs_; }
 
+  // Change the number of helper workers while the op is running. Helpers are launched on demand, and the ones
+  // beyond the new number go idle instead of exiting, so they can be reused later.
+  // @param num_helpers The number of helpers which steal the pending jobs of the workers.
+  // @return Status error code
+  Status SetNumHelperWorkers(int32_t num_helpers);
+
+  // Getter function
+  // @return The number of active helper workers
+  int32_t NumHelperWorkers();
+
+  // Getter
+  // @return The number of data buffers computed by a worker or helper other than their owner
+  int64_t NumStolenJobs();
+
+  // Getter
+  // @return The number of data buffers computed by the helper workers
+  int64_t NumHelperJobs();
+
  private:
+  // States of a MapWorkerJob
+  static constexpr int32_t kJobPending = 0;
+  static constexpr int32_t kJobRunning = 1;
+  static constexpr int32_t kJobDone = 2;
+
   // A unit of job for map worker thread.
   // MapWorkerJob holds a list of MapJob where each MapJob can be a CpuMapJob, GpuMapJob or DvppMapJob.
   struct MapWorkerJob {
-    explicit MapWorkerJob(std::unique_ptr<DataBuffer> db) : databuffer(std::move(db)) {}
+    explicit MapWorkerJob(std::unique_ptr<DataBuffer> db) : databuffer(std::move(db)), state(kJobPending) {}
     std::vector<std::shared_ptr<MapJob>> jobs;
     std::unique_ptr<DataBuffer> databuffer;
+    // With work stealing, the job is computed by whichever worker claims it first, its owner or a thief.
+    std::atomic<int32_t> state;
+    // Result of the compute done by a thief, to be returned by the owner.
+    Status rc;
+
+    bool Claim() {
+      int32_t expected = kJobPending;
+      return state.compare_exchange_strong(expected, kJobRunning);
+    }
   };
 
   // A helper function to create jobs for workers.
-  Status GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job);
+  Status GenerateWorkerJob(const std::shared_ptr<MapWorkerJob> *worker_job);
+
+  // A helper function that fetch worker map job from local queues, an idle worker steals work before it blocks.
+  Status FetchNextWork(uint32_t worker_id, std::shared_ptr<MapWorkerJob> *worker_job);
 
-  // A helper function that fetch worker map job from local queues and extract the data and map job list
-  Status FetchNextWork(uint32_t worker_id, std::unique_ptr<DataBuffer> *db,
-                       std::vector<std::shared_ptr<MapJob>> *job_list);
+  // Hand a data buffer to a worker, it is stealable by the other workers until its owner claims it.
+  Status SendToWorker(int32_t worker_id, std::shared_ptr<MapWorkerJob> worker_job);
+
+  // Compute the tensor ops of a data buffer and replace its tensor table with the result.
+  Status ComputeWorkerJob(MapWorkerJob *worker_job);
+
+  // Take a pending job from the longest backlog of the other workers and compute it.
+  // @param worker_id The id of the thief.
+  // @param[out] stolen Whether a job was found.
+  Status StealWork(int32_t worker_id, bool *stolen);
+
+  // Claim a job popped from the worker's own queue, or wait until the thief which claimed it is done.
+  Status ClaimOrWait(int32_t worker_id, MapWorkerJob *worker_job);
+
+  // Whether any worker has a pending job at the back of its list. It is called with steal_mux_ held.
+  bool HasStealableWork() const;
+
+  // Loop of a helper worker, it steals jobs while it is active and there is something to steal.
+  // @param helper_id The id of the helper, starting from 0.
+  Status HelperEntry(int32_t helper_id);
 
   // Local queues where worker threads get a job from
-  QueueList<std::unique_ptr<MapWorkerJob>> local_queues_;
+  QueueList<std::shared_ptr<MapWorkerJob>> local_queues_;
+
+  // Whether idle workers steal pending jobs of the other workers.
+  bool work_stealing_;
+
+  // The data jobs of each worker which are not claimed yet, in the order of its local queue.
+  std::vector<std::deque<std::shared_ptr<MapWorkerJob>>> steal_lists_;
+
+  // Guards steal_lists_ and the completion of stolen jobs.
+  std::mutex steal_mux_;
+  CondVar steal_cv_;
+  int64_t num_stolen_jobs_;
+  int64_t num_helper_jobs_;
+
+  // Helper workers, guarded by steal_mux_. Helpers with an id not less than num_helpers_ stay idle.
+  int32_t num_helpers_;
+  int32_t num_helpers_launched_;
+  bool helpers_quit_;
+  CondVar helper_cv_;
 
   //  Tensorops to be read and applied by worker threads
   std::vector<std::shared_ptr<TensorOp>> tfuncs_;
@@ -72,6 +72,9 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       shuffle_seed_(shuffle_seed),
       reshuffle_each_epoch_(reset_every_epoch),
       rng_(shuffle_seed),
+      rng_draws_(0),
+      pass_(0),
+      pass_draws_({{0, 0}}),
       buffer_counter_(0),
       rows_per_buffer_(rows_per_buffer),
       shuffle_buffer_(std::make_unique<TensorTable>()),
@@ -88,6 +91,7 @@ Status ShuffleOp::SelfReset() {
   // and all subsequent epochs will then keep on using the rng_ without resetting it
   if (!reshuffle_each_epoch_) {
     rng_ = std::mt19937_64(shuffle_seed_);
+    rng_draws_ = 0;
   }
 
   shuffle_buffer_ = std::make_unique<TensorTable>();
@@ -174,6 +178,7 @@ Status ShuffleOp::operator()() {
       // tensor table. We remove the data from the shuffle buffer, leaving that slot
       // in the table as an empty vector
       int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
+      rng_draws_++;
       new_buffer_table->push_back(std::move((*shuffle_buffer_)[random_slot]));
 
       // Step 3)
@@ -219,6 +224,15 @@ Status ShuffleOp::operator()() {
       }
     }
 
+    // The next pass is recorded before the EOE can reach a consumer saving a checkpoint at this point.
+    {
+      std::unique_lock<std::mutex> lock(pass_draws_mux_);
+      pass_draws_[++pass_] = reshuffle_each_epoch_ ? rng_draws_ : 0;
+      if (pass_draws_.size() > kMaxPassDraws) {
+        pass_draws_.erase(pass_draws_.begin());
+      }
+    }
+
     // Since we overloaded eoeReceived function, we are responsible to flow the EOE up the
     // pipeline manually now that we are done draining the shuffle buffer
     MS_LOG(DEBUG) << "Shuffle operator sending EOE.";
@@ -233,6 +247,31 @@ Status ShuffleOp::operator()() {
   return Status::OK();
 }
 
+Status ShuffleOp::SaveResumeState(int64_t epoch, nlohmann::json *out_json) {
+  int64_t pass = epoch * op_num_repeats_per_epoch();
+  std::unique_lock<std::mutex> lock(pass_draws_mux_);
+  auto itr = pass_draws_.find(pass);
+  CHECK_FAIL_RETURN_UNEXPECTED(itr != pass_draws_.end(),
+                               "The state of epoch " + std::to_string(epoch) + " is not kept by " + NameWithID() + ".");
+  (*out_json)["rng_draws"] = itr->second;
+  // Checkpoints only move forward, the passes before this one are not needed any more.
+  pass_draws_.erase(pass_draws_.begin(), itr);
+  return Status::OK();
+}
+
+Status ShuffleOp::Resume(int64_t epoch, const nlohmann::json &state) {
+  RETURN_IF_NOT_OK(PipelineOp::Resume(epoch, state));
+  CHECK_FAIL_RETURN_UNEXPECTED(state.find("rng_draws") != state.end(),
+                               "The resume state of " + NameWithID() + " has no rng_draws.");
+  rng_draws_ = state["rng_draws"].get<uint64_t>();
+  rng_ = std::mt19937_64(shuffle_seed_);
+  rng_.discard(rng_draws_);
+  pass_ = epoch * op_num_repeats_per_epoch();
+  std::unique_lock<std::mutex> lock(pass_draws_mux_);
+  pass_draws_ = {{pass_, rng_draws_}};
+  return Status::OK();
+}
+
 // Private function populate the shuffle buffer initially by fetching from the child output
 // connector until the shuffle buffer is full (or there is no more data coming).
 Status ShuffleOp::InitShuffleBuffer() {
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <random>
 #include <string>
@@ -51,6 +52,10 @@ class ShuffleOp : public PipelineOp {
   // Shuffle buffer is in a state of being drained
   static constexpr int32_t kShuffleStateDrain = 2;
 
+  // Number of passes whose rng state is kept for SaveResumeState. The consumer lags behind by the rows held in the
+  // connectors in between only, so older passes are never asked for.
+  static constexpr size_t kMaxPassDraws = 64;
+
  public:
   // The nested builder class inside of the ShuffleOp is used to help manage all of the arguments
   // for constructing it.  The shuffle op is fairly simple though, but the builder provides a
@@ -155,6 +160,19 @@ class ShuffleOp : public PipelineOp {
   // @return Status The status code returned
   Status EoeReceived(int32_t worker_id) override;
 
+  // Base-class override, the state is the number of random numbers drawn before the epoch. The rows in the shuffle
+  // buffer are not part of it, they are fetched again from the child once the rng is back to that point.
+  // @param epoch - The epoch of the pipeline
+  // @param out_json - The state of the op
+  // @return Status The status code returned
+  Status SaveResumeState(int64_t epoch, nlohmann::json *out_json) override;
+
+  // Base-class override, the rng is reseeded and moved to the state saved by SaveResumeState.
+  // @param epoch - The epoch of the pipeline
+  // @param state - The state saved by SaveResumeState
+  // @return Status The status code returned
+  Status Resume(int64_t epoch, const nlohmann::json &state) override;
+
   // Base-class override for NodePass visitor acceptor.
   // @param p - Pointer to the NodePass to be accepted.
   // @param modified - Whether this node visit modified the pipeline.
@@ -189,6 +207,11 @@ class ShuffleOp : public PipelineOp {
   // (ie uniform_int_distribution) because we will need to create up to |dataset| instances
   // of the distribution object in the common case of a perfect shuffle
   std::mt19937_64 rng_;
+  uint64_t rng_draws_;  // Number of random numbers drawn since rng_ is seeded
+  int64_t pass_;        // Number of passes over the child data, a pass is an epoch of the shuffle op
+  // Value of rng_draws_ at the beginning of each pass, SaveResumeState looks it up from another thread
+  std::map<int64_t, uint64_t> pass_draws_;
+  std::mutex pass_draws_mux_;
   int32_t buffer_counter_;   // For creating new buffer id's
   int32_t rows_per_buffer_;  // Number of rows to pack into output buffer
   // A single (potentially large) buffer of tensor rows for performing shuffling.
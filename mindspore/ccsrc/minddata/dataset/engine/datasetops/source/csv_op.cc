@@ -33,6 +33,8 @@ CsvOp::Builder::Builder()
       builder_num_devices_(1),
       builder_num_samples_(0),
       builder_shuffle_files_(false),
+      builder_shuffle_blocks_(false),
+      builder_shuffle_block_rows_(kShuffleBlockRows),
       builder_sampler_(nullptr) {
   std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
   builder_num_workers_ = config_manager->num_parallel_workers();
@@ -50,6 +52,9 @@ Status CsvOp::Builder::ValidateInputs() const {
            ? "Invalid parameter, num_shard must be greater than shard_id and greater than 0, got num_shard: " +
                std::to_string(builder_num_devices_) + ", shard_id: " + std::to_string(builder_device_id_) + ".\n"
            : "";
+  err += builder_shuffle_block_rows_ <= 0 ? "Invalid parameter, shuffle_block_rows must be greater than 0, but got " +
+                                              std::to_string(builder_shuffle_block_rows_) + ".\n"
+                                          : "";
   return err.empty() ? Status::OK() : Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, err);
 }
 
@@ -65,8 +70,8 @@ Status CsvOp::Builder::Build(std::shared_ptr<CsvOp> *op) {
   std::shared_ptr<CsvOp> csv_op = std::make_shared<CsvOp>(
     builder_csv_files_list_, builder_field_delim_, builder_column_default_list_, builder_column_name_list_,
     builder_num_workers_, builder_rows_per_buffer_, builder_num_samples_, builder_worker_connector_size_,
-    builder_op_connector_size_, builder_shuffle_files_, builder_num_devices_, builder_device_id_,
-    std::move(builder_sampler_));
+    builder_op_connector_size_, builder_shuffle_files_, builder_shuffle_blocks_, builder_shuffle_block_rows_,
+    builder_num_devices_, builder_device_id_, std::move(builder_sampler_));
   RETURN_IF_NOT_OK(csv_op->Init());
   *op = std::move(csv_op);
 
@@ -77,7 +82,8 @@ CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
              const std::vector<std::shared_ptr<BaseRecord>> &column_default,
              const std::vector<std::string> &column_name, int32_t num_workers, int64_t rows_per_buffer,
              int64_t num_samples, int32_t worker_connector_size, int32_t op_connector_size, bool shuffle_files,
-             int32_t num_device, int32_t device_id, std::shared_ptr<SamplerRT> sampler)
+             bool shuffle_blocks, int64_t shuffle_block_rows, int32_t num_device, int32_t device_id,
+             std::shared_ptr<SamplerRT> sampler)
     : ParallelOp(num_workers, op_connector_size, std::move(sampler)),
       csv_files_list_(std::move(csv_files_list)),
       field_delim_(field_delim),
@@ -90,6 +96,9 @@ CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
       filename_index_(std::make_unique<StringIndex>()),
       load_jagged_connector_(true),
       shuffle_files_(shuffle_files),
+      shuffle_blocks_(shuffle_blocks),
+      row_blocks_(shuffle_block_rows),
+      block_rng_(GetSeed()),
       finished_reading_dataset_(false),
       num_devices_(num_device),
       device_id_(device_id),
@@ -525,7 +534,14 @@ Status CsvOp::LoadFile(const std::string &file, const int64_t start_offset, cons
   if (!ifs.is_open()) {
     RETURN_STATUS_UNEXPECTED("Error opening file: " + file);
   }
-  if (column_name_list_.empty()) {
+  // Start from the block holding the first row rather than from the beginning of the file
+  int64_t byte_offset = 0;
+  int64_t first_row = 0;
+  row_blocks_.Seek(file, start_offset, &byte_offset, &first_row);
+  if (byte_offset > 0) {
+    (void)ifs.seekg(byte_offset);
+    csv_parser.SetTotalRows(first_row);
+  } else if (column_name_list_.empty()) {
     std::string tmp;
     getline(ifs, tmp);
   }
@@ -651,7 +667,8 @@ void CsvOp::Print(std::ostream &out, bool show_all) const {
     // Then show any custom derived-internal stuff
     out << "\nRows per buffer: " << rows_per_buffer_ << "\nSample count: " << num_samples_
         << "\nDevice id: " << device_id_ << "\nNumber of devices: " << num_devices_
-        << "\nShuffle files: " << ((shuffle_files_) ? "yes" : "no") << "\nCsv files list:\n";
+        << "\nShuffle files: " << ((shuffle_files_) ? "yes" : "no")
+        << "\nShuffle blocks: " << ((shuffle_blocks_) ? "yes" : "no") << "\nCsv files list:\n";
     for (int i = 0; i < csv_files_list_.size(); ++i) {
       out << " " << csv_files_list_[i];
     }
@@ -689,6 +706,7 @@ Status CsvOp::WaitToFillIOBlockQueue() {
     }
   }
   uint32_t seed = 0;
+  int64_t pass = 0;
   while (true) {
     RETURN_IF_NOT_OK(io_block_queue_wait_post_.Wait());
     io_block_queue_wait_post_.Clear();
@@ -697,7 +715,11 @@ Status CsvOp::WaitToFillIOBlockQueue() {
       break;
     }
 
-    if (shuffle_files_) {
+    // Seeded by the pass rather than carried over, so the order of a pass does not depend on how the earlier ones ended
+    block_rng_.seed(GetSeed() + static_cast<uint32_t>(pass++));
+    // The blocks of all the files are shuffled, so the file order only matters when it decides the rows of the shard
+    // of a device. Else the two orders would be drawn from the same seed and undo each other.
+    if (shuffle_files_ && (!shuffle_blocks_ || num_devices_ > 1)) {
       ShuffleKeys(&i_keys, num_devices_ == 1 ? GetSeed() : ++seed);
     }
     RETURN_IF_NOT_OK(FillIOBlockQueue(i_keys));
@@ -711,6 +733,7 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
   int64_t start_offset = 0;
   int64_t end_offset = 0;
   bool finish = false;
+  std::vector<RowBlockIndex::Block> blocks;
   while (!finish) {
     std::vector<std::pair<std::string, int64_t>> file_index;
     if (!i_keys.empty()) {
@@ -734,10 +757,14 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
     for (auto file_info : file_index) {
       if (NeedPushFileToBlockQueue(file_info.first, &start_offset, &end_offset, pre_count)) {
-        auto ioBlock =
-          std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-        RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-        queue_index = (queue_index + 1) % num_workers_;
+        if (shuffle_blocks_) {
+          row_blocks_.Split(file_info.second, start_offset, end_offset, &blocks);
+        } else {
+          auto ioBlock =
+            std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
+          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+          queue_index = (queue_index + 1) % num_workers_;
+        }
       }
 
       pre_count += filename_numrows_[file_info.first];
@@ -750,6 +777,9 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
   }
 
+  RETURN_IF_NOT_OK(RowBlockIndex::PushShuffled(
+    &blocks, &block_rng_, num_workers_, &queue_index,
+    std::bind(&CsvOp::PushIoBlockQueue, this, std::placeholders::_1, std::placeholders::_2)));
   RETURN_IF_NOT_OK(PostEndOfEpoch(queue_index));
   return Status::OK();
 }
@@ -804,7 +834,11 @@ Status CsvOp::PostEndOfEpoch(int32_t queue_index) {
 
 Status CsvOp::CalculateNumRowsPerShard() {
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    int64_t count = CountTotalRows(it.value());
+    std::vector<int64_t> block_offsets;
+    int64_t count = CountTotalRows(it.value(), shuffle_blocks_ ? &block_offsets : nullptr);
+    if (shuffle_blocks_) {
+      row_blocks_.AddFile(it.value(), std::move(block_offsets), count);
+    }
     filename_numrows_[it.value()] = count;
     all_num_rows_ += count;
   }
@@ -818,7 +852,7 @@ Status CsvOp::CalculateNumRowsPerShard() {
   return Status::OK();
 }
 
-int64_t CsvOp::CountTotalRows(const std::string &file) {
+int64_t CsvOp::CountTotalRows(const std::string &file, std::vector<int64_t> *block_offsets) {
   CsvParser csv_parser(0, jagged_buffer_connector_, rows_per_buffer_, field_delim_, column_default_list_, file);
   std::ifstream ifs;
   ifs.open(file, std::ifstream::in);
@@ -830,11 +864,24 @@ int64_t CsvOp::CountTotalRows(const std::string &file) {
     getline(ifs, tmp);
   }
   csv_parser.Reset();
+  // The first block starts after the header, which is skipped when reading from the beginning of the file
+  if (block_offsets != nullptr) {
+    block_offsets->push_back(0);
+  }
+  int64_t next_block_row = row_blocks_.block_rows();
   while (ifs.good()) {
     int chr = ifs.get();
     if (csv_parser.CountRows(chr) != 0) {
       break;
     }
+    if (block_offsets != nullptr && csv_parser.GetTotalRows() == next_block_row) {
+      // The row just ended, the next one starts a block
+      int64_t pos = static_cast<int64_t>(ifs.tellg());
+      if (pos > 0) {
+        block_offsets->push_back(pos);
+      }
+      next_block_row += row_blocks_.block_rows();
+    }
   }
 
   return csv_parser.GetTotalRows();
@@ -927,6 +974,7 @@ void CsvOp::MakeSimpleProducer() {
   device_id_ = 0;
   num_devices_ = 1;
   shuffle_files_ = false;
+  shuffle_blocks_ = false;
   num_samples_ = 0;
 }
 
@@ -22,10 +22,12 @@
 #include <map>
 #include <utility>
 #include <limits>
+#include <random>
 
 #include "minddata/dataset/util/auto_index.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/engine/datasetops/source/row_block_index.h"
 
 namespace mindspore {
 namespace dataset {
@@ -74,6 +76,9 @@ class CsvOp : public ParallelOp {
 
     void SetEndOffset(int64_t end_offset) { end_offset_ = end_offset; }
 
+    // Set the number of rows before the point the parsing starts from
+    void SetTotalRows(int64_t total_rows) { total_rows_ = total_rows; }
+
     int ProcessMessage(int c);
 
     int CountRows(int c);
@@ -213,6 +218,20 @@ class CsvOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetShuffleBlocks(bool shuffle_blocks) {
+      builder_shuffle_blocks_ = shuffle_blocks;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetShuffleBlockRows(int64_t shuffle_block_rows) {
+      builder_shuffle_block_rows_ = shuffle_block_rows;
+      return *this;
+    }
+
     // Setter method.
     // @return Builder - setter method returns reference to the builder.
     Builder &SetNumSamples(int64_t num_samples) {
@@ -259,6 +278,8 @@ class CsvOp : public ParallelOp {
     int32_t builder_worker_connector_size_;
     std::vector<std::string> builder_csv_files_list_;
     bool builder_shuffle_files_;
+    bool builder_shuffle_blocks_;
+    int64_t builder_shuffle_block_rows_;
     char builder_field_delim_;
     std::vector<std::shared_ptr<CsvOp::BaseRecord>> builder_column_default_list_;
     std::vector<std::string> builder_column_name_list_;
@@ -271,8 +292,8 @@ class CsvOp : public ParallelOp {
   CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
         const std::vector<std::shared_ptr<BaseRecord>> &column_default, const std::vector<std::string> &column_name,
         int32_t num_workers, int64_t rows_per_buffer, int64_t num_samples, int32_t worker_connector_size,
-        int32_t op_connector_size, bool shuffle_files, int32_t num_devices, int32_t device_id,
-        std::shared_ptr<SamplerRT> sampler);
+        int32_t op_connector_size, bool shuffle_files, bool shuffle_blocks, int64_t shuffle_block_rows,
+        int32_t num_devices, int32_t device_id, std::shared_ptr<SamplerRT> sampler);
 
   // Default destructor
   ~CsvOp() = default;
@@ -385,8 +406,9 @@ class CsvOp : public ParallelOp {
 
   // Count number of rows in each file.
   // @param filename - csv file name.
+  // @param block_offsets - optional, the byte offsets of the row blocks of the file are appended to it.
   // @return int64_t - the total number of rows in file.
-  int64_t CountTotalRows(const std::string &file);
+  int64_t CountTotalRows(const std::string &file, std::vector<int64_t> *block_offsets = nullptr);
 
   // Pushes a control indicator onto the IOBlockQueue for each worker to consume.
   // When the worker pops this control indicator, it will shut itself down gracefully.
@@ -405,6 +427,9 @@ class CsvOp : public ParallelOp {
 
   int32_t device_id_;
   bool shuffle_files_;
+  bool shuffle_blocks_;
+  RowBlockIndex row_blocks_;
+  std::mt19937 block_rng_;
   bool finished_reading_dataset_;
   int32_t num_devices_;
   int64_t rows_per_buffer_;
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <iomanip>
 #include <limits>
+#include <numeric>
 #include <utility>
 
 #include "utils/ms_utils.h"
@@ -124,6 +125,8 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
       operators_(operators),
       num_mind_record_workers_(num_mind_record_workers),
       num_rows_(0),
+      prefetch_window_(GlobalContext::config_manager()->io_prefetch_window()),
+      resume_passes_(0),
       buffers_needed_(0),
       buf_cnt_(0),
       ended_worker_(0),
@@ -138,6 +141,8 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
   shard_reader_ = std::make_unique<ShardReader>();
+  shard_reader_->SetUseMmap(GlobalContext::config_manager()->mindrecord_mmap());
+  shard_reader_->SetUsePrefetch(prefetch_window_ > 0);
   auto rc = shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_, operators_,
                                 num_padded_);
 
@@ -276,25 +281,49 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
                                          int32_t worker_id) {
   *fetched_buffer = std::make_unique<DataBuffer>(buffer_id, DataBuffer::kDeBFlagNone);
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
+  if (prefetch_window_ > 0) {
+    PrefetchRows(buffer_id);
+  }
   for (int32_t i = 0; i < rows_per_buffer_; ++i) {
     int32_t row_id = buffer_id * rows_per_buffer_ + i;
-    auto rc = shard_reader_->GetNextById(row_id, worker_id);
-    auto task_type = rc.first;
-    auto tupled_buffer = rc.second;
+    mindrecord::TaskType task_type;
+    ShardTuple tupled_buffer;
+    ShardSliceTuple sliced_buffer;
+    if (shard_reader_->GetUseMmap()) {
+      // blobs are parsed straight out of the mapped shard file, they are only copied once into the tensors
+      auto rc = shard_reader_->GetNextSliceById(row_id, worker_id);
+      task_type = rc.first;
+      sliced_buffer = std::move(rc.second);
+    } else {
+      auto rc = shard_reader_->GetNextById(row_id, worker_id);
+      task_type = rc.first;
+      tupled_buffer = std::move(rc.second);
+    }
     if (task_type == mindrecord::TaskType::kPaddedTask) {
       TensorRow tensor_row;
-      RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, {}, mindrecord::json(), task_type));
+      RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, nullptr, 0, mindrecord::json(), task_type));
       std::vector<std::string> file_path(tensor_row.size(), dataset_file_[0]);
       tensor_row.setPath(file_path);
       tensor_table->push_back(std::move(tensor_row));
     }
-    if (tupled_buffer.empty()) break;
+    if (tupled_buffer.empty() && sliced_buffer.empty()) break;
     if (task_type == mindrecord::TaskType::kCommonTask) {
       for (const auto &tupled_row : tupled_buffer) {
-        std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-        mindrecord::json columns_json = std::get<1>(tupled_row);
+        const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
+        const mindrecord::json &columns_json = std::get<1>(tupled_row);
+        TensorRow tensor_row;
+        RETURN_IF_NOT_OK(
+          LoadTensorRow(&tensor_row, columns_blob.data(), columns_blob.size(), columns_json, task_type));
+        std::vector<std::string> file_path(tensor_row.size(), dataset_file_[0]);
+        tensor_row.setPath(file_path);
+        tensor_table->push_back(std::move(tensor_row));
+      }
+      for (const auto &sliced_row : sliced_buffer) {
+        const mindrecord::BLOB_SLICE &columns_blob = std::get<0>(sliced_row);
+        const mindrecord::json &columns_json = std::get<1>(sliced_row);
         TensorRow tensor_row;
-        RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, columns_blob, columns_json, task_type));
+        RETURN_IF_NOT_OK(
+          LoadTensorRow(&tensor_row, columns_blob.first, columns_blob.second, columns_json, task_type));
         std::vector<std::string> file_path(tensor_row.size(), dataset_file_[0]);
         tensor_row.setPath(file_path);
         tensor_table->push_back(std::move(tensor_row));
@@ -307,7 +336,20 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+void MindRecordOp::PrefetchRows(int64_t buffer_id) {
+  // Rows [0, rows_per_buffer_) are read right away, the first buffer opens the window for the following ones
+  int64_t buffer_end = (buffer_id + 1) * rows_per_buffer_;
+  int64_t start = buffer_id == 0 ? buffer_end : std::max(buffer_id * rows_per_buffer_ + prefetch_window_, buffer_end);
+  int64_t end = std::min(buffer_end + prefetch_window_, static_cast<int64_t>(num_rows_));
+  if (start >= end) {
+    return;
+  }
+  std::vector<int64_t> row_ids(end - start);
+  std::iota(row_ids.begin(), row_ids.end(), start);
+  shard_reader_->Prefetch(row_ids);
+}
+
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
                                    const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
   for (uint32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
@@ -349,8 +391,8 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       }
     } else {
       auto has_column =
-        shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr, &n_bytes,
-                                           &column_data_type, &column_data_type_size, &column_shape);
+        shard_column->GetColumnValueByName(column_name, columns_blob, blob_size, columns_json, &data, &data_ptr,
+                                           &n_bytes, &column_data_type, &column_data_type_size, &column_shape);
       if (has_column == MSRStatus::FAILED) {
         RETURN_STATUS_UNEXPECTED("Invalid data, failed to retrieve data from mindrecord reader.");
       }
@@ -434,6 +476,12 @@ Status MindRecordOp::Reset() {
   return Status::OK();
 }
 
+Status MindRecordOp::Resume(int64_t epoch, const nlohmann::json &state) {
+  RETURN_IF_NOT_OK(ParallelOp::Resume(epoch, state));
+  resume_passes_ = epoch * op_num_repeats_per_epoch();
+  return Status::OK();
+}
+
 Status MindRecordOp::LaunchThreadAndInitOp() {
   if (tree_ == nullptr) {
     RETURN_STATUS_UNEXPECTED("Pipeline init failed, Execution tree not set.");
@@ -444,6 +492,10 @@ Status MindRecordOp::LaunchThreadAndInitOp() {
   if (shard_reader_->Launch(true) == MSRStatus::FAILED) {
     RETURN_STATUS_UNEXPECTED("MindRecordOp launch failed.");
   }
+  for (int64_t i = 0; i < resume_passes_; i++) {
+    shard_reader_->ShuffleTask();
+  }
+  resume_passes_ = 0;
   // Launch main workers that load DataBuffers by reading all images
   RETURN_IF_NOT_OK(
     tree_->LaunchWorkers(num_workers_, std::bind(&MindRecordOp::WorkerEntry, this, std::placeholders::_1)));
@@ -47,6 +47,8 @@ class DataBuffer;
 using mindrecord::ShardOperator;
 using mindrecord::ShardReader;
 using ShardTuple = std::vector<std::tuple<std::vector<uint8_t>, mindrecord::json>>;  // Row of data from ShardReader
+// Row of data borrowed from the memory-mapped shard files of ShardReader
+using ShardSliceTuple = std::vector<std::tuple<mindrecord::BLOB_SLICE, mindrecord::json>>;
 
 const int32_t LOG_INTERVAL = 19;
 
@@ -183,6 +185,13 @@ class MindRecordOp : public ParallelOp {
   // @return Status The status code returned
   Status Reset() override;
 
+  // Base-class override, the shard operators shuffle the rows again at every pass starting from the order of the
+  // previous one, so the passes before the epoch are shuffled again once the tasks exist, without reading any data.
+  // @param epoch - The epoch of the pipeline
+  // @param state - The state saved by SaveResumeState
+  // @return Status The status code returned
+  Status Resume(int64_t epoch, const nlohmann::json &state) override;
+
   // Getter method
   int32_t num_rows() const { return num_rows_; }
 
@@ -215,11 +224,17 @@ class MindRecordOp : public ParallelOp {
  private:
   Status GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_buffer, int64_t buffer_id, int32_t worker_id);
 
+  // Submits the rows which enter the prefetch window when a buffer is picked up, so that every row is submitted
+  // once per epoch and the reads complete while the workers are busy with earlier buffers
+  // @param buffer_id - the buffer which is about to be loaded
+  void PrefetchRows(int64_t buffer_id);
+
   // Parses a single cell and puts the data into a tensor
   // @param tensor_row - the tensor row to put the parsed data in
-  // @param columns_blob - the blob data received from the reader
+  // @param columns_blob - the blob data received from the reader, may be borrowed from a memory-mapped file
+  // @param blob_size - the size of the blob data
   // @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+  Status LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
                        const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
 
   // Private function for computing the assignment of the column name map.
@@ -235,6 +250,8 @@ class MindRecordOp : public ParallelOp {
   int32_t buffers_needed_;                                 // Counter for the buffers that were fetched
   int64_t buf_cnt_;                                        // Buffer counter
   int32_t num_rows_;                                       // One more than the last row id in the range for this cache
+  int32_t prefetch_window_;                                // Rows read asynchronously ahead of the workers
+  int64_t resume_passes_;                                  // Passes to shuffle again before the first one
   std::atomic<int32_t> ended_worker_;
 
   int64_t num_padded_;
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/row_block_index.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+void RowBlockIndex::AddFile(const std::string &file, std::vector<int64_t> offsets, int64_t num_rows) {
+  files_[file] = FileBlocks{std::move(offsets), num_rows};
+}
+
+int64_t RowBlockIndex::NumRows(const std::string &file) const {
+  auto it = files_.find(file);
+  return it == files_.end() ? 0 : it->second.num_rows;
+}
+
+void RowBlockIndex::Seek(const std::string &file, int64_t row, int64_t *byte_offset, int64_t *first_row) const {
+  *byte_offset = 0;
+  *first_row = 0;
+  auto it = files_.find(file);
+  if (it == files_.end() || it->second.offsets.empty() || row <= 0) {
+    return;
+  }
+  // Past the last block recorded, start from the last one
+  const std::vector<int64_t> &offsets = it->second.offsets;
+  size_t block = std::min(static_cast<size_t>(row / block_rows_), offsets.size() - 1);
+  *byte_offset = offsets[block];
+  *first_row = static_cast<int64_t>(block) * block_rows_;
+}
+
+void RowBlockIndex::Split(int64_t file_key, int64_t start_row, int64_t end_row, std::vector<Block> *blocks) const {
+  int64_t row = start_row;
+  while (row < end_row) {
+    int64_t block_end = std::min((row / block_rows_ + 1) * block_rows_, end_row);
+    blocks->push_back(Block{file_key, row, block_end});
+    row = block_end;
+  }
+}
+
+Status RowBlockIndex::PushShuffled(std::vector<Block> *blocks, std::mt19937 *rng, int32_t num_workers,
+                                   int32_t *queue_index,
+                                   const std::function<Status(int32_t, std::unique_ptr<FilenameBlock> &&)> &push) {
+  // The blocks of all the files of the shard are read in a random order
+  std::shuffle(blocks->begin(), blocks->end(), *rng);
+  for (const auto &block : *blocks) {
+    auto io_block =
+      std::make_unique<FilenameBlock>(block.file_key, block.start_row, block.end_row, IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(push(*queue_index, std::move(io_block)));
+    *queue_index = (*queue_index + 1) % num_workers;
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_ROW_BLOCK_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_ROW_BLOCK_INDEX_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Default number of rows of a block read as a whole by a source shuffling its row blocks
+constexpr int64_t kShuffleBlockRows = 1024;
+
+// The row blocks of the files of a streaming source. A file is cut into blocks of a fixed number of rows, and the
+// byte offset of the first row of every block is recorded when the rows of the file are counted. A source with a
+// global shuffle hands out the blocks of all its files in a random order and a worker seeks to its block instead of
+// reading the file from the beginning. A small shuffle buffer above the source then mixes the rows of the blocks.
+// The index is built before the workers start, it is only read afterwards.
+class RowBlockIndex {
+ public:
+  // A range of rows of a file
+  struct Block {
+    int64_t file_key;
+    int64_t start_row;
+    int64_t end_row;
+  };
+
+  explicit RowBlockIndex(int64_t block_rows = kShuffleBlockRows) : block_rows_(block_rows) {}
+
+  ~RowBlockIndex() = default;
+
+  int64_t block_rows() const { return block_rows_; }
+
+  bool empty() const { return files_.empty(); }
+
+  // Record the blocks of a file.
+  // @param file - the file
+  // @param offsets - offsets[i] is the byte offset of row i * block_rows
+  // @param num_rows - number of rows of the file
+  void AddFile(const std::string &file, std::vector<int64_t> offsets, int64_t num_rows);
+
+  // @return the number of rows of a file, 0 if the file is not indexed
+  int64_t NumRows(const std::string &file) const;
+
+  // Find where to start reading to reach a row of a file.
+  // @param file - the file
+  // @param row - the row to reach
+  // @param byte_offset - the byte offset of the first row of the block holding the row, 0 if the file is not indexed
+  // @param first_row - the first row of that block
+  void Seek(const std::string &file, int64_t row, int64_t *byte_offset, int64_t *first_row) const;
+
+  // Cut the rows [start_row, end_row) of a file at the block boundaries.
+  // @param file_key - key of the file
+  // @param start_row - the first row
+  // @param end_row - one past the last row
+  // @param blocks - the blocks are appended to it
+  void Split(int64_t file_key, int64_t start_row, int64_t end_row, std::vector<Block> *blocks) const;
+
+  // Put blocks into a random order and hand them out to the workers in turn.
+  // @param blocks - the blocks, shuffled in place
+  // @param rng - the random generator of the source
+  // @param num_workers - number of workers of the source
+  // @param queue_index - the worker queue of the first block, moved past the last one
+  // @param push - push an io block to a worker queue
+  // @return Status - the error code returned.
+  static Status PushShuffled(std::vector<Block> *blocks, std::mt19937 *rng, int32_t num_workers, int32_t *queue_index,
+                             const std::function<Status(int32_t, std::unique_ptr<FilenameBlock> &&)> &push);
+
+ private:
+  struct FileBlocks {
+    std::vector<int64_t> offsets;
+    int64_t num_rows;
+  };
+
+  int64_t block_rows_;
+  std::unordered_map<std::string, FileBlocks> files_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_ROW_BLOCK_INDEX_H_
@@ -86,6 +86,9 @@ Status DistributedSamplerRT::InitSampler() {
 }
 
 Status DistributedSamplerRT::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) {
+  if (TakeResumeBuffer(out_buffer)) {
+    return Status::OK();
+  }
   if (cnt_ > samples_per_buffer_) {
     RETURN_STATUS_UNEXPECTED(
       "Number of samples(cnt) that have already been filled in to buffer should be less than or "
@@ -66,6 +66,9 @@ Status PKSamplerRT::InitSampler() {
 }
 
 Status PKSamplerRT::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) {
+  if (TakeResumeBuffer(out_buffer)) {
+    return Status::OK();
+  }
   if (next_id_ > num_samples_ || num_samples_ == 0) {
     RETURN_STATUS_UNEXPECTED("Index must be less than or equal to num_samples, but got: " + std::to_string(next_id_));
   } else if (next_id_ == num_samples_) {
@@ -117,6 +120,9 @@ Status PKSamplerRT::HandshakeRandomAccessOp(const RandomAccessOp *op) {
   RETURN_UNEXPECTED_IF_NULL(op);
   RETURN_IF_NOT_OK(op->GetClassIds(&label_to_ids_));
   RETURN_IF_NOT_OK(InitSampler());
+  if (resume_epochs_ > 0 || resume_samples_ > 0) {
+    RETURN_IF_NOT_OK(FastForward());
+  }
   return Status::OK();
 }
 
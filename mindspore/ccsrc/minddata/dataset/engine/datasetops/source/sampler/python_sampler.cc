@@ -24,6 +24,9 @@ PythonSamplerRT::PythonSamplerRT(int64_t num_samples, py::object py_sampler_inst
     : SamplerRT(num_samples, samples_per_buffer), py_sampler_instance(py_sampler_instance), need_to_reset_(false) {}
 
 Status PythonSamplerRT::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) {
+  if (TakeResumeBuffer(out_buffer)) {
+    return Status::OK();
+  }
   if (need_to_reset_) {
     (*out_buffer) = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE);
   } else {
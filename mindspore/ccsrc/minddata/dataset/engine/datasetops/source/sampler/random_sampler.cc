@@ -32,6 +32,9 @@ RandomSamplerRT::RandomSamplerRT(int64_t num_samples, bool replacement, bool res
       reshuffle_each_epoch_(reshuffle_each_epoch) {}
 
 Status RandomSamplerRT::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) {
+  if (TakeResumeBuffer(out_buffer)) {
+    return Status::OK();
+  }
   if (next_id_ > num_samples_) {
     RETURN_STATUS_UNEXPECTED("RandomSampler Internal Error");
   } else if (next_id_ == num_samples_) {
@@ -38,7 +38,9 @@ SamplerRT::SamplerRT(int64_t num_samples, int64_t samples_per_buffer)
       num_samples_(num_samples),
       samples_per_buffer_(samples_per_buffer),
       col_desc_(nullptr),
-      is_initialized(false) {}
+      is_initialized(false),
+      resume_epochs_(0),
+      resume_samples_(0) {}
 
 Status SamplerRT::HandshakeRandomAccessOp(const RandomAccessOp *op) {
   std::shared_ptr<SamplerRT> child_sampler;
@@ -66,9 +68,61 @@ Status SamplerRT::HandshakeRandomAccessOp(const RandomAccessOp *op) {
   // Because some sampler only needs one of the arg (weighted_random_sampler)
   RETURN_IF_NOT_OK(InitSampler());  // init sampler after callback
 
+  if (resume_epochs_ > 0 || resume_samples_ > 0) {
+    RETURN_IF_NOT_OK(FastForward());
+  }
+
   return Status::OK();
 }
 
+Status SamplerRT::FastForward() {
+  MS_LOG(INFO) << "Sampler fast forwarding " << resume_epochs_ << " epochs and " << resume_samples_ << " samples.";
+  std::unique_ptr<DataBuffer> db;
+  // Only the ids are generated, so the epochs are skipped without reading any data. Drawing them rather than
+  // computing the position keeps the random state of every sampler the same as the one of the previous run.
+  for (int64_t i = 0; i < resume_epochs_; i++) {
+    do {
+      RETURN_IF_NOT_OK(GetNextSample(&db));
+    } while (!db->eoe());
+    RETURN_IF_NOT_OK(ResetSampler());
+  }
+
+  int64_t num_skip = resume_samples_;
+  while (num_skip > 0) {
+    RETURN_IF_NOT_OK(GetNextSample(&db));
+    CHECK_FAIL_RETURN_UNEXPECTED(!db->eoe(), "Invalid resume point, it is beyond the end of the epoch.");
+    TensorRow sample_row;
+    RETURN_IF_NOT_OK(db->PopRow(&sample_row));
+    std::shared_ptr<Tensor> sample_ids = sample_row[0];
+    int64_t num_ids = sample_ids->Size();
+    if (num_ids > num_skip) {
+      std::shared_ptr<Tensor> rest_ids;
+      RETURN_IF_NOT_OK(CreateSamplerTensor(&rest_ids, num_ids - num_skip));
+      auto in_itr = sample_ids->begin<int64_t>();
+      for (int64_t i = 0; i < num_skip; i++) {
+        ++in_itr;
+      }
+      for (auto out_itr = rest_ids->begin<int64_t>(); out_itr != rest_ids->end<int64_t>(); ++out_itr, ++in_itr) {
+        *out_itr = *in_itr;
+      }
+      resume_buffer_ = std::make_unique<DataBuffer>(db->id(), DataBuffer::kDeBFlagNone);
+      resume_buffer_->set_tensor_table(std::make_unique<TensorQTable>(1, TensorRow(1, rest_ids)));
+    }
+    num_skip -= std::min(num_skip, num_ids);
+  }
+  resume_epochs_ = 0;
+  resume_samples_ = 0;
+  return Status::OK();
+}
+
+bool SamplerRT::TakeResumeBuffer(std::unique_ptr<DataBuffer> *out_buffer) {
+  if (resume_buffer_ == nullptr) {
+    return false;
+  }
+  *out_buffer = std::move(resume_buffer_);
+  return true;
+}
+
 Status SamplerRT::CreateSamplerTensor(std::shared_ptr<Tensor> *sample_ids, int64_t num_elements) {
   if (num_elements == 0) {
     RETURN_STATUS_UNEXPECTED("Invalid data, num of elements cannot be 0.");
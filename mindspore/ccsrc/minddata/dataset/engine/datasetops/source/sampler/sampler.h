@@ -154,7 +154,27 @@ class SamplerRT {
   /// \return Status of the function
   virtual Status to_json(nlohmann::json *out_json) { return Status::OK(); }
 
+  // Move the sampler to a position of a previous run. The ids before that position are drawn and dropped once the
+  // sampler is initialized, so the leaf op never reads the rows behind them.
+  // @param int64_t num_epochs - number of complete epochs to skip
+  // @param int64_t num_samples - number of ids to skip in the epoch following them
+  void SetResumePoint(int64_t num_epochs, int64_t num_samples) {
+    resume_epochs_ = num_epochs;
+    resume_samples_ = num_samples;
+  }
+
  protected:
+  // Draw and drop the ids up to the resume point, the rest of the buffer holding the resume point is kept in
+  // resume_buffer_.
+  // @return Status The status code returned
+  Status FastForward();
+
+  // The derived classes call it first in GetNextSample, the ids left over by FastForward are handed out before any
+  // new id is drawn.
+  // @param std::unique_ptr<DataBuffer> out_buffer - the buffer of left over ids
+  // @return - true if out_buffer is filled
+  bool TakeResumeBuffer(std::unique_ptr<DataBuffer> *out_buffer);
+
   // Number of rows of data from the place this sampler is sampling from. If this sampler
   // has a child sampler, num_rows_ is the number of ids the child sampler will
   // output. Otherwise, num_rows_ is the number of rows in the dataset.
@@ -170,6 +190,9 @@ class SamplerRT {
   std::unique_ptr<ColDescriptor> col_desc_;
   std::vector<std::shared_ptr<SamplerRT>> child_;  // Child nodes
   std::unique_ptr<DataBuffer> child_ids_;
+  int64_t resume_epochs_;
+  int64_t resume_samples_;
+  std::unique_ptr<DataBuffer> resume_buffer_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -25,6 +25,9 @@ SequentialSamplerRT::SequentialSamplerRT(int64_t num_samples, int64_t start_inde
     : SamplerRT(num_samples, samples_per_buffer), current_id_(start_index), start_index_(start_index), id_count_(0) {}
 
 Status SequentialSamplerRT::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) {
+  if (TakeResumeBuffer(out_buffer)) {
+    return Status::OK();
+  }
   if (id_count_ > num_samples_) {
     RETURN_STATUS_UNEXPECTED("SequentialSampler Internal Error");
   } else if (id_count_ == num_samples_) {
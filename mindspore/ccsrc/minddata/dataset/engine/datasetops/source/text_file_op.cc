@@ -38,6 +38,8 @@ TextFileOp::Builder::Builder()
       builder_num_devices_(1),
       builder_total_rows_(0),
       builder_shuffle_files_(false),
+      builder_shuffle_blocks_(false),
+      builder_shuffle_block_rows_(kShuffleBlockRows),
       builder_sampler_(nullptr) {
   std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
   builder_num_workers_ = config_manager->num_parallel_workers();
@@ -55,6 +57,10 @@ Status TextFileOp::Builder::ValidateInputs() const {
                ? "Invalid parameter, num_shard must be greater than shard_id and greater than 0, got num_shard: " +
                    std::to_string(builder_num_devices_) + ", shard_id: " + std::to_string(builder_device_id_) + ".\n"
                : "";
+  err_msg += builder_shuffle_block_rows_ <= 0
+               ? "Invalid parameter, shuffle_block_rows must be greater than 0, but got " +
+                   std::to_string(builder_shuffle_block_rows_) + ".\n"
+               : "";
   return err_msg.empty() ? Status::OK() : Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, err_msg);
 }
 
@@ -74,7 +80,8 @@ Status TextFileOp::Builder::Build(std::shared_ptr<TextFileOp> *op) {
   std::shared_ptr<TextFileOp> text_file_op = std::make_shared<TextFileOp>(
     builder_num_workers_, builder_rows_per_buffer_, builder_total_rows_, builder_worker_connector_size_,
     std::move(builder_schema_), builder_text_files_list_, builder_op_connector_size_, builder_shuffle_files_,
-    builder_num_devices_, builder_device_id_, std::move(builder_sampler_));
+    builder_shuffle_blocks_, builder_shuffle_block_rows_, builder_num_devices_, builder_device_id_,
+    std::move(builder_sampler_));
   RETURN_IF_NOT_OK(text_file_op->Init());
   *op = std::move(text_file_op);
 
@@ -83,7 +90,8 @@ Status TextFileOp::Builder::Build(std::shared_ptr<TextFileOp> *op) {
 
 TextFileOp::TextFileOp(int32_t num_workers, int64_t rows_per_buffer, int64_t total_rows, int32_t worker_connector_size,
                        std::unique_ptr<DataSchema> schema, std::vector<std::string> text_files_list,
-                       int32_t op_connector_size, bool shuffle_files, int32_t num_device, int32_t device_id,
+                       int32_t op_connector_size, bool shuffle_files, bool shuffle_blocks,
+                       int64_t shuffle_block_rows, int32_t num_device, int32_t device_id,
                        std::shared_ptr<SamplerRT> sampler)
     : ParallelOp(num_workers, op_connector_size, std::move(sampler)),
       device_id_(device_id),
@@ -92,6 +100,9 @@ TextFileOp::TextFileOp(int32_t num_workers, int64_t rows_per_buffer, int64_t tot
       total_rows_(total_rows),
       text_files_list_(std::move(text_files_list)),
       shuffle_files_(shuffle_files),
+      shuffle_blocks_(shuffle_blocks),
+      row_blocks_(shuffle_block_rows),
+      block_rng_(GetSeed()),
       data_schema_(std::move(schema)),
       all_num_rows_(0),
       num_rows_per_shard_(0),
@@ -115,7 +126,7 @@ void TextFileOp::Print(std::ostream &out, bool show_all) const {
     // Then show any custom derived-internal stuff
     out << "\nRows per buffer: " << rows_per_buffer_ << "\nRow count: " << total_rows_ << "\nDevice id: " << device_id_
         << "\nNumber of devices: " << num_devices_ << "\nShuffle files: " << ((shuffle_files_) ? "yes" : "no")
-        << "\nText files list:\n";
+        << "\nShuffle blocks: " << ((shuffle_blocks_) ? "yes" : "no") << "\nText files list:\n";
     for (int i = 0; i < text_files_list_.size(); ++i) {
       out << " " << text_files_list_[i];
     }
@@ -162,6 +173,12 @@ Status TextFileOp::LoadFile(const std::string &file, const int64_t start_offset,
 
   int64_t rows_each_buffer = 0;
   int64_t rows_total = 0;
+  // Start from the block holding the first row rather than from the beginning of the file
+  int64_t byte_offset = 0;
+  row_blocks_.Seek(file, start_offset, &byte_offset, &rows_total);
+  if (byte_offset > 0) {
+    (void)handle.seekg(byte_offset);
+  }
   std::string line;
   std::unique_ptr<DataBuffer> cur_buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
@@ -310,6 +327,7 @@ Status TextFileOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
   int64_t start_offset = 0;
   int64_t end_offset = 0;
   bool finish = false;
+  std::vector<RowBlockIndex::Block> blocks;
   while (!finish) {
     std::vector<std::pair<std::string, int64_t>> file_index;
     if (!i_keys.empty()) {
@@ -333,10 +351,14 @@ Status TextFileOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
     for (auto file_info : file_index) {
       if (NeedPushFileToBlockQueue(file_info.first, &start_offset, &end_offset, pre_count)) {
-        auto ioBlock =
-          std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-        RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-        queue_index = (queue_index + 1) % num_workers_;
+        if (shuffle_blocks_) {
+          row_blocks_.Split(file_info.second, start_offset, end_offset, &blocks);
+        } else {
+          auto ioBlock =
+            std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
+          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+          queue_index = (queue_index + 1) % num_workers_;
+        }
       }
 
       pre_count += filename_numrows_[file_info.first];
@@ -349,6 +371,10 @@ Status TextFileOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
   }
 
+  RETURN_IF_NOT_OK(
+    RowBlockIndex::PushShuffled(&blocks, &block_rng_, num_workers_, &queue_index,
+                                std::bind(&TextFileOp::PushIoBlockQueue, this, std::placeholders::_1,
+                                          std::placeholders::_2)));
   RETURN_IF_NOT_OK(PostEndOfEpoch(queue_index));
   return Status::OK();
 }
@@ -364,6 +390,7 @@ Status TextFileOp::WaitToFillIOBlockQueue() {
     }
   }
   uint32_t seed = 0;
+  int64_t pass = 0;
   while (true) {
     RETURN_IF_NOT_OK(io_block_queue_wait_post_.Wait());
     io_block_queue_wait_post_.Clear();
@@ -372,7 +399,11 @@ Status TextFileOp::WaitToFillIOBlockQueue() {
       break;
     }
 
-    if (shuffle_files_) {
+    // Seeded by the pass rather than carried over, so the order of a pass does not depend on how the earlier ones ended
+    block_rng_.seed(GetSeed() + static_cast<uint32_t>(pass++));
+    // The blocks of all the files are shuffled, so the file order only matters when it decides the rows of the shard
+    // of a device. Else the two orders would be drawn from the same seed and undo each other.
+    if (shuffle_files_ && (!shuffle_blocks_ || num_devices_ > 1)) {
       ShuffleKeys(&i_keys, num_devices_ == 1 ? GetSeed() : ++seed);
     }
     RETURN_IF_NOT_OK(FillIOBlockQueue(i_keys));
@@ -448,7 +479,7 @@ Status TextFileOp::operator()() {
   return Status::OK();
 }
 
-int64_t TextFileOp::CountTotalRows(const std::string &file) {
+int64_t TextFileOp::CountTotalRows(const std::string &file, std::vector<int64_t> *block_offsets) {
   std::ifstream handle(file);
   if (!handle.is_open()) {
     MS_LOG(ERROR) << "Invalid file, failed to open file: " << file;
@@ -457,9 +488,16 @@ int64_t TextFileOp::CountTotalRows(const std::string &file) {
 
   std::string line;
   int64_t count = 0;
+  if (block_offsets != nullptr) {
+    block_offsets->push_back(0);
+  }
   while (getline(handle, line)) {
     if (!line.empty()) {
       count++;
+      // The next row starts a block, the empty lines before it are skipped when the block is read
+      if (block_offsets != nullptr && count % row_blocks_.block_rows() == 0 && handle.peek() != EOF) {
+        block_offsets->push_back(static_cast<int64_t>(handle.tellg()));
+      }
     }
   }
 
@@ -468,7 +506,11 @@ int64_t TextFileOp::CountTotalRows(const std::string &file) {
 
 Status TextFileOp::CalculateNumRowsPerShard() {
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    int64_t count = CountTotalRows(it.value());
+    std::vector<int64_t> block_offsets;
+    int64_t count = CountTotalRows(it.value(), shuffle_blocks_ ? &block_offsets : nullptr);
+    if (shuffle_blocks_) {
+      row_blocks_.AddFile(it.value(), std::move(block_offsets), count);
+    }
     filename_numrows_[it.value()] = count;
     all_num_rows_ += count;
   }
@@ -511,6 +553,7 @@ void TextFileOp::MakeSimpleProducer() {
   device_id_ = 0;
   num_devices_ = 1;
   shuffle_files_ = false;
+  shuffle_blocks_ = false;
   total_rows_ = 0;
 }
 
@@ -19,6 +19,7 @@
 #include <memory>
 #include <map>
 #include <mutex>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,6 +31,7 @@
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/wait_post.h"
 #include "minddata/dataset/engine/jagged_connector.h"
+#include "minddata/dataset/engine/datasetops/source/row_block_index.h"
 
 namespace mindspore {
 namespace dataset {
@@ -105,6 +107,20 @@ class TextFileOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetShuffleBlocks(bool shuffle_blocks) {
+      builder_shuffle_blocks_ = shuffle_blocks;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetShuffleBlockRows(int64_t shuffle_block_rows) {
+      builder_shuffle_block_rows_ = shuffle_block_rows;
+      return *this;
+    }
+
     // Setter method.
     // @return Builder - setter method returns reference to the builder.
     Builder &SetTotalRows(int64_t total_rows) {
@@ -130,6 +146,8 @@ class TextFileOp : public ParallelOp {
     int32_t builder_worker_connector_size_;
     std::vector<std::string> builder_text_files_list_;
     bool builder_shuffle_files_;
+    bool builder_shuffle_blocks_;
+    int64_t builder_shuffle_block_rows_;
     std::unique_ptr<DataSchema> builder_schema_;
     std::shared_ptr<SamplerRT> builder_sampler_;
   };
@@ -144,11 +162,14 @@ class TextFileOp : public ParallelOp {
   // @param op_connector_size - size of each queue in the connector that the child operator pulls from.
   // @param columns_to_load - the names of the columns to load data from.
   // @param shuffle_files - whether or not to shuffle the files before reading data.
+  // @param shuffle_blocks - whether or not to read the row blocks of all the files in a random order.
+  // @param shuffle_block_rows - number of rows of a block.
   // @param equal_rows_per_shard - whether or not to get equal rows for each process.
   // @param sampler - allow a sampler.  Only valid if a cache exists in ascendent tree nodes
   TextFileOp(int32_t num_workers, int64_t rows_per_buffer, int64_t total_rows, int32_t worker_connector_size,
              std::unique_ptr<DataSchema>, std::vector<std::string> text_files_list, int32_t op_connector_size,
-             bool shuffle_files, int32_t num_devices, int32_t device_id, std::shared_ptr<SamplerRT> sampler);
+             bool shuffle_files, bool shuffle_blocks, int64_t shuffle_block_rows, int32_t num_devices,
+             int32_t device_id, std::shared_ptr<SamplerRT> sampler);
 
   // Default destructor
   ~TextFileOp() = default;
@@ -226,8 +247,9 @@ class TextFileOp : public ParallelOp {
 
   // Count number of rows in each file.
   // @param filename - text file name.
+  // @param block_offsets - optional, the byte offsets of the row blocks of the file are appended to it.
   // @return int64_t - the total number of rows in file.
-  int64_t CountTotalRows(const std::string &file);
+  int64_t CountTotalRows(const std::string &file, std::vector<int64_t> *block_offsets = nullptr);
 
   // Notifies the thread which called FillIoBlockQueue to resume execution
   void NotifyToFillIOBlockQueue();
@@ -282,6 +304,9 @@ class TextFileOp : public ParallelOp {
   int64_t total_rows_;
   std::vector<std::string> text_files_list_;
   bool shuffle_files_;
+  bool shuffle_blocks_;
+  RowBlockIndex row_blocks_;
+  std::mt19937 block_rng_;
   std::unique_ptr<DataSchema> data_schema_;
   int64_t all_num_rows_;
   int64_t num_rows_per_shard_;
@@ -15,6 +15,10 @@
  */
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
 
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include <algorithm>
 #include <fstream>
 #include <future>
@@ -43,10 +47,61 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// Asks the kernel to read the part of a file which is about to be parsed, the reads are issued in batches and
+// complete in the background, so the parser mostly hits the page cache instead of blocking on the device.
+class FileReadAhead {
+ public:
+  FileReadAhead(const std::string &filename, int32_t window_rows) : window_rows_(window_rows) {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+    if (window_rows_ > 0) {
+      fd_ = open(filename.c_str(), O_RDONLY);
+    }
+    if (fd_ >= 0) {
+      (void)posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+  }
+
+  ~FileReadAhead() {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+    if (fd_ >= 0) {
+      (void)close(fd_);
+    }
+#endif
+  }
+
+  // @param position - the byte offset which the parser has reached
+  // @param rows - the number of rows parsed before the position, used to estimate the window in bytes
+  void Advance(int64_t position, int64_t rows) {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+    if (fd_ < 0 || position <= 0 || rows <= 0) {
+      return;
+    }
+    int64_t window_bytes = position / rows * window_rows_;
+    // refill once half of the window is consumed, so that every call submits a batch of reads
+    if (position + window_bytes / 2 < advised_end_) {
+      return;
+    }
+    int64_t start = std::max(position, advised_end_);
+    advised_end_ = position + window_bytes;
+    (void)posix_fadvise(fd_, start, advised_end_ - start, POSIX_FADV_WILLNEED);
+#endif
+  }
+
+ private:
+  int32_t window_rows_;
+  int fd_ = -1;
+  int64_t advised_end_ = 0;
+};
+}  // namespace
+
 TFReaderOp::Builder::Builder()
     : builder_device_id_(0),
       builder_num_devices_(1),
       builder_total_rows_(0),
+      builder_shuffle_blocks_(false),
+      builder_shuffle_block_rows_(kShuffleBlockRows),
       builder_equal_rows_per_shard_(false),
       builder_sampler_(nullptr) {
   std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
@@ -93,6 +148,11 @@ Status TFReaderOp::Builder::ValidateInputs() const {
                std::to_string(builder_num_devices_) + ", shard_id: " + std::to_string(builder_device_id_) + ".\n";
   }
 
+  if (builder_shuffle_block_rows_ <= 0) {
+    err_msg += "Invalid parameter, shuffle_block_rows must be greater than 0, but got " +
+               std::to_string(builder_shuffle_block_rows_) + ".\n";
+  }
+
   std::vector<std::string> invalid_files(builder_dataset_files_list_.size());
   auto it = std::copy_if(builder_dataset_files_list_.begin(), builder_dataset_files_list_.end(), invalid_files.begin(),
                          [](const std::string &filename) { return !ValidateFirstRowCrc(filename); });
@@ -122,8 +182,8 @@ Status TFReaderOp::Builder::Build(std::shared_ptr<TFReaderOp> *out_tf_reader_op)
   std::shared_ptr<TFReaderOp> new_tf_reader_op = std::make_shared<TFReaderOp>(
     builder_num_workers_, builder_worker_connector_size_, builder_rows_per_buffer_, builder_total_rows_,
     builder_dataset_files_list_, std::move(builder_data_schema_), builder_op_connector_size_, builder_columns_to_load_,
-    builder_shuffle_files_, builder_num_devices_, builder_device_id_, builder_equal_rows_per_shard_,
-    std::move(builder_sampler_));
+    builder_shuffle_files_, builder_shuffle_blocks_, builder_shuffle_block_rows_, builder_num_devices_,
+    builder_device_id_, builder_equal_rows_per_shard_, std::move(builder_sampler_));
 
   RETURN_IF_NOT_OK(new_tf_reader_op->Init());
   *out_tf_reader_op = std::move(new_tf_reader_op);
@@ -133,8 +193,9 @@ Status TFReaderOp::Builder::Build(std::shared_ptr<TFReaderOp> *out_tf_reader_op)
 TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64_t rows_per_buffer,
                        int64_t total_num_rows, std::vector<std::string> dataset_files_list,
                        std::unique_ptr<DataSchema> data_schema, int32_t op_connector_size,
-                       std::vector<std::string> columns_to_load, bool shuffle_files, int32_t num_device,
-                       int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<SamplerRT> sampler)
+                       std::vector<std::string> columns_to_load, bool shuffle_files, bool shuffle_blocks,
+                       int64_t shuffle_block_rows, int32_t num_device, int32_t device_id, bool equal_rows_per_shard,
+                       std::shared_ptr<SamplerRT> sampler)
     : ParallelOp(num_workers, op_connector_size, std::move(sampler)),
       device_id_(device_id),
       num_devices_(num_device),
@@ -144,13 +205,18 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
       columns_to_load_(std::move(columns_to_load)),
       finished_reading_dataset_(false),
       shuffle_files_(shuffle_files),
+      shuffle_blocks_(shuffle_blocks),
+      row_blocks_(shuffle_block_rows),
+      block_rng_(GetSeed()),
+      resume_passes_(0),
       data_schema_(std::move(data_schema)),
       filename_index_(std::make_unique<StringIndex>()),
       load_io_block_queue_(true),
       load_jagged_connector_(true),
       num_rows_(0),
       num_rows_per_shard_(0),
-      equal_rows_per_shard_(equal_rows_per_shard) {
+      equal_rows_per_shard_(equal_rows_per_shard),
+      prefetch_window_(GlobalContext::config_manager()->io_prefetch_window()) {
   worker_connector_size_ = worker_connector_size;
 }
 
@@ -167,6 +233,7 @@ void TFReaderOp::Print(std::ostream &out, bool show_all) const {
     // Then show any custom derived-internal stuff
     out << "\nRows per buffer: " << rows_per_buffer_ << "\nTotal rows: " << total_rows_ << "\nDevice id: " << device_id_
         << "\nNumber of devices: " << num_devices_ << "\nShuffle files: " << ((shuffle_files_) ? "yes" : "no")
+        << "\nShuffle blocks: " << ((shuffle_blocks_) ? "yes" : "no")
         << "\nDataset files list: Size: " << dataset_files_list_.size() << "\n";
     for (int i = 0; i < dataset_files_list_.size(); ++i) {
       out << " " << dataset_files_list_[i];
@@ -212,13 +279,26 @@ Status TFReaderOp::Init() {
 }
 
 Status TFReaderOp::CalculateNumRowsPerShard() {
+  if (shuffle_blocks_ && row_blocks_.empty()) {
+    // One pass over the record headers both counts the rows and cuts the files into blocks
+    for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
+      std::vector<int64_t> block_offsets;
+      int64_t num = IndexFile(it.value(), row_blocks_.block_rows(), &block_offsets);
+      row_blocks_.AddFile(it.value(), std::move(block_offsets), num);
+    }
+  }
   if (!equal_rows_per_shard_) {
     return Status::OK();
   }
 
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    std::vector<std::string> file(1, it.value());
-    int64_t num = CountTotalRowsSectioned(file, 0, 1);
+    int64_t num = 0;
+    if (shuffle_blocks_) {
+      num = row_blocks_.NumRows(it.value());
+    } else {
+      std::vector<std::string> file(1, it.value());
+      num = CountTotalRowsSectioned(file, 0, 1);
+    }
     filename_numrows_[it.value()] = num;
     num_rows_ += num;
   }
@@ -426,6 +506,7 @@ Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
   int64_t end_offset = 0;
   bool finish = false;
   bool end_of_epoch = false;
+  std::vector<RowBlockIndex::Block> blocks;
   while (!finish) {
     for (auto it = i_keys.begin(); it != i_keys.end(); ++it) {
       {
@@ -437,18 +518,27 @@ Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock = std::make_unique<FilenameBlock>(*it, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          if (shuffle_blocks_) {
+            row_blocks_.Split(*it, 0, row_blocks_.NumRows((*filename_index_)[*it]), &blocks);
+          } else {
+            auto ioBlock =
+              std::make_unique<FilenameBlock>(*it, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
+            RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+            queue_index = (queue_index + 1) % num_workers_;
+          }
         }
       } else {
         // Do an index lookup using that key to get the filename.
         std::string file_name = (*filename_index_)[*it];
         if (NeedPushFileToBlockQueue(file_name, &start_offset, &end_offset, pre_count)) {
-          auto ioBlock = std::make_unique<FilenameBlock>(*it, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          MS_LOG(DEBUG) << "File name " << *it << " start offset " << start_offset << " end_offset " << end_offset;
-          queue_index = (queue_index + 1) % num_workers_;
+          if (shuffle_blocks_) {
+            row_blocks_.Split(*it, start_offset, end_offset, &blocks);
+          } else {
+            auto ioBlock = std::make_unique<FilenameBlock>(*it, start_offset, end_offset, IOBlock::kDeIoBlockNone);
+            RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+            MS_LOG(DEBUG) << "File name " << *it << " start offset " << start_offset << " end_offset " << end_offset;
+            queue_index = (queue_index + 1) % num_workers_;
+          }
         }
 
         pre_count += filename_numrows_[file_name];
@@ -461,6 +551,9 @@ Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
       finish = true;
     }
   }
+  RETURN_IF_NOT_OK(RowBlockIndex::PushShuffled(
+    &blocks, &block_rng_, num_workers_, &queue_index,
+    std::bind(&TFReaderOp::PushIoBlockQueue, this, std::placeholders::_1, std::placeholders::_2)));
   RETURN_IF_NOT_OK(PostEndOfEpoch(queue_index));
   return Status::OK();
 }
@@ -473,6 +566,7 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
   int64_t end_offset = 0;
   bool finish = false;
   bool end_of_epoch = false;
+  std::vector<RowBlockIndex::Block> blocks;
   while (!finish) {
     // Iterate over all the keys and add one key to each block.
     for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
@@ -485,17 +579,26 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock =
-            std::make_unique<FilenameBlock>(it.key(), kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          if (shuffle_blocks_) {
+            row_blocks_.Split(it.key(), 0, row_blocks_.NumRows(it.value()), &blocks);
+          } else {
+            auto ioBlock =
+              std::make_unique<FilenameBlock>(it.key(), kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
+            RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+            queue_index = (queue_index + 1) % num_workers_;
+          }
         }
       } else {
         std::string file_name = it.value();
         if (NeedPushFileToBlockQueue(file_name, &start_offset, &end_offset, pre_count)) {
-          auto ioBlock = std::make_unique<FilenameBlock>(it.key(), start_offset, end_offset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          if (shuffle_blocks_) {
+            row_blocks_.Split(it.key(), start_offset, end_offset, &blocks);
+          } else {
+            auto ioBlock =
+              std::make_unique<FilenameBlock>(it.key(), start_offset, end_offset, IOBlock::kDeIoBlockNone);
+            RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+            queue_index = (queue_index + 1) % num_workers_;
+          }
         }
 
         pre_count += filename_numrows_[file_name];
@@ -509,6 +612,9 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
     }
   }
 
+  RETURN_IF_NOT_OK(RowBlockIndex::PushShuffled(
+    &blocks, &block_rng_, num_workers_, &queue_index,
+    std::bind(&TFReaderOp::PushIoBlockQueue, this, std::placeholders::_1, std::placeholders::_2)));
   RETURN_IF_NOT_OK(PostEndOfEpoch(queue_index));
   return Status::OK();
 }
@@ -525,7 +631,14 @@ Status TFReaderOp::WaitToFillIOBlockQueue() {
       i_keys.push_back(it.key());
     }
   }
+  // The blocks of all the files are shuffled, so the file order only matters when it decides the rows of the shard of
+  // a device. Else the two orders would be drawn from the same seed and undo each other.
+  bool shuffle_keys = shuffle_files_ && (!shuffle_blocks_ || num_devices_ > 1);
   uint32_t seed = 0;
+  for (int64_t i = 0; shuffle_keys && i < resume_passes_; i++) {
+    shuffleKeys(&i_keys, num_devices_ == 1 ? GetSeed() : ++seed);
+  }
+  int64_t pass = resume_passes_;
   while (true) {
     RETURN_IF_NOT_OK(io_block_queue_wait_post_.Wait());
     io_block_queue_wait_post_.Clear();
@@ -534,8 +647,12 @@ Status TFReaderOp::WaitToFillIOBlockQueue() {
       break;
     }
 
+    // Seeded by the pass rather than carried over from the previous one, so that a resumed pass has the same order
+    block_rng_.seed(GetSeed() + static_cast<uint32_t>(pass++));
     if (shuffle_files_) {
-      shuffleKeys(&i_keys, num_devices_ == 1 ? GetSeed() : ++seed);
+      if (shuffle_keys) {
+        shuffleKeys(&i_keys, num_devices_ == 1 ? GetSeed() : ++seed);
+      }
       RETURN_IF_NOT_OK(FillIOBlockShuffle(i_keys));
     } else {  // shuffle_files_ == false
       RETURN_IF_NOT_OK(FillIOBlockNoShuffle());
@@ -573,14 +690,30 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
 
   int64_t rows_read = 0;
   int64_t rows_total = 0;
+  if (start_offset != kInvalidOffset) {
+    // Start from the block holding the first row rather than from the beginning of the file
+    int64_t byte_offset = 0;
+    row_blocks_.Seek(filename, start_offset, &byte_offset, &rows_total);
+    if (byte_offset > 0) {
+      (void)reader.seekg(byte_offset);
+    }
+  }
   std::unique_ptr<DataBuffer> current_buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
   std::unique_ptr<TensorQTable> new_tensor_table = std::make_unique<TensorQTable>();
+  FileReadAhead read_ahead(filename, prefetch_window_);
 
   while (reader.peek() != EOF) {
     if (!load_jagged_connector_) {
       break;
     }
+    // Nothing left to read in the range of this block
+    if (start_offset != kInvalidOffset && rows_total >= end_offset) {
+      break;
+    }
     RETURN_IF_INTERRUPTED();
+    if (prefetch_window_ > 0) {
+      read_ahead.Advance(static_cast<int64_t>(reader.tellg()), rows_total);
+    }
 
     // read length
     int64_t record_length = 0;
@@ -723,6 +856,12 @@ Status TFReaderOp::Reset() {
   return Status::OK();
 }
 
+Status TFReaderOp::Resume(int64_t epoch, const nlohmann::json &state) {
+  RETURN_IF_NOT_OK(ParallelOp::Resume(epoch, state));
+  resume_passes_ = epoch * op_num_repeats_per_epoch();
+  return Status::OK();
+}
+
 Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
                                  int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   // kBytesList can map to the following DE types ONLY!
@@ -1025,6 +1164,29 @@ int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &file
   return rows_read;
 }
 
+int64_t TFReaderOp::IndexFile(const std::string &filename, int64_t block_rows, std::vector<int64_t> *block_offsets) {
+  std::ifstream reader;
+  reader.open(filename);
+  if (!reader) {
+    MS_LOG(DEBUG) << "TFReader operator failed to open file " << filename << ".";
+    return 0;
+  }
+
+  int64_t rows_read = 0;
+  while (reader.peek() != EOF) {
+    if (rows_read % block_rows == 0) {
+      block_offsets->push_back(static_cast<int64_t>(reader.tellg()));
+    }
+    // Only the length of a record is read, its crcs and contents are skipped
+    int64_t record_length = 0;
+    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t) + record_length + sizeof(int32_t)));
+    rows_read++;
+  }
+
+  return rows_read;
+}
+
 // Visitor accept method for NodePass
 Status TFReaderOp::Accept(NodePass *p, bool *const modified) {
   // Downcast shared pointer then call visitor
@@ -1051,6 +1213,7 @@ void TFReaderOp::MakeSimpleProducer() {
   num_devices_ = 1;
   total_rows_ = 0;
   shuffle_files_ = false;
+  shuffle_blocks_ = false;
   equal_rows_per_shard_ = false;
 }
 
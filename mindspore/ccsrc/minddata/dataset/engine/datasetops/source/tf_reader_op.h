@@ -20,6 +20,7 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <random>
 #include <string>
 #include <vector>
 #include <utility>
@@ -31,6 +32,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/datasetops/source/row_block_index.h"
 
 namespace dataengine {
 class Example;
@@ -146,6 +148,20 @@ class TFReaderOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetShuffleBlocks(bool shuffle_blocks) {
+      builder_shuffle_blocks_ = shuffle_blocks;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetShuffleBlockRows(int64_t shuffle_block_rows) {
+      builder_shuffle_block_rows_ = shuffle_block_rows;
+      return *this;
+    }
+
     // Setter method.
     // @return Builder - setter method returns reference to the builder.
     Builder &SetShardEqualRows(bool shard_equal_rows) {
@@ -174,6 +190,8 @@ class TFReaderOp : public ParallelOp {
     std::vector<std::string> builder_dataset_files_list_;
     std::vector<std::string> builder_columns_to_load_;
     bool builder_shuffle_files_;
+    bool builder_shuffle_blocks_;
+    int64_t builder_shuffle_block_rows_;
     bool builder_equal_rows_per_shard_;
   };
 
@@ -188,12 +206,15 @@ class TFReaderOp : public ParallelOp {
   // @param op_connector_size - size of each queue in the connector that the child operator pulls from.
   // @param columns_to_load - the names of the columns to load data from.
   // @param shuffle_files - whether or not to shuffle the files before reading data.
+  // @param shuffle_blocks - whether or not to read the row blocks of all the files in a random order.
+  // @param shuffle_block_rows - number of rows of a block.
   // @param equal_rows_per_shard - whether or not to get equal rows for each process.
   // @param sampler - allow a sampler.  Only valid if a cache exists in ascendent tree nodes
   TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64_t rows_per_buffer, int64_t total_num_rows,
              std::vector<std::string> dataset_files_list, std::unique_ptr<DataSchema> data_schema,
              int32_t op_connector_size, std::vector<std::string> columns_to_load, bool shuffle_files,
-             int32_t num_devices, int32_t device_id, bool equal_rows_per_shard, std::shared_ptr<SamplerRT> sampler);
+             bool shuffle_blocks, int64_t shuffle_block_rows, int32_t num_devices, int32_t device_id,
+             bool equal_rows_per_shard, std::shared_ptr<SamplerRT> sampler);
 
   // Default destructor
   ~TFReaderOp() = default;
@@ -218,6 +239,13 @@ class TFReaderOp : public ParallelOp {
   // @return Status - the error code returned.
   Status Reset() override;
 
+  // Base-class override, the files are shuffled again at every pass starting from the order of the previous one, so
+  // the keys are shuffled again for the passes before the epoch when the filler thread starts.
+  // @param epoch - The epoch of the pipeline
+  // @param state - The state saved by SaveResumeState
+  // @return Status - the error code returned.
+  Status Resume(int64_t epoch, const nlohmann::json &state) override;
+
   // Getter method
   int64_t rows_per_buffer() const { return rows_per_buffer_; }
 
@@ -366,6 +394,14 @@ class TFReaderOp : public ParallelOp {
   // @return int63_t - the total number of rows of files read.
   static int64_t CountTotalRowsSectioned(const std::vector<std::string> &filenames, const int64_t begin,
                                          const int64_t end);
+
+  // Count the rows of a tf file and record the byte offset of every row block.
+  // @param filename - the tf data filename.
+  // @param block_rows - number of rows of a block.
+  // @param block_offsets - the byte offsets of the row blocks of the file are appended to it.
+  // @return int64_t - the total number of rows of the file.
+  static int64_t IndexFile(const std::string &filename, int64_t block_rows, std::vector<int64_t> *block_offsets);
+
   // Fill IO block queue if shuffle is true
   // @param i_keys - shuffle keys.
   // @return Status - the error code returned.
@@ -403,6 +439,10 @@ class TFReaderOp : public ParallelOp {
   std::vector<std::string> columns_to_load_;
   bool finished_reading_dataset_;
   bool shuffle_files_;
+  bool shuffle_blocks_;
+  RowBlockIndex row_blocks_;
+  std::mt19937 block_rng_;
+  int64_t resume_passes_;
   std::unique_ptr<DataSchema> data_schema_;
   std::unique_ptr<StringIndex> filename_index_;
   bool load_io_block_queue_;
@@ -416,6 +456,7 @@ class TFReaderOp : public ParallelOp {
   int64_t num_rows_;
   int64_t num_rows_per_shard_;
   bool equal_rows_per_shard_;
+  int32_t prefetch_window_;  // rows read asynchronously ahead of the parser, 0 means disabled
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -34,8 +34,11 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each internal queue.
-  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity), end_of_file_(false) {}
+  // @param lock_free Use lock-free internal queues. The order is always kept since the consumers rely on the
+  //     position of eoe and eof buffers.
+  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false)
+      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity, lock_free),
+        end_of_file_(false) {}
 
   // Destructor of DbConnector
   ~DbConnector() = default;
@@ -61,13 +64,19 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "[ERROR] nullptr detected when getting data from db connector");
     } else {
-      std::unique_lock<std::mutex> lk(m_);
-      RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return (expect_consumer_ == worker_id) || end_of_file_; }));
+      // A single consumer in the lock-free mode has nobody to take turns with.
+      bool take_turns = !(lock_free_ && num_consumers_ == 1);
+      std::unique_lock<std::mutex> lk(m_, std::defer_lock);
+      if (take_turns) {
+        lk.lock();
+        RETURN_IF_NOT_OK(
+          cv_.Wait(&lk, [this, worker_id]() { return (expect_consumer_ == worker_id) || end_of_file_; }));
+      }
       // Once an EOF message is encountered this flag will be set and we can return early.
       if (end_of_file_) {
         *result = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
       } else {
-        RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+        RETURN_IF_NOT_OK(PopFrom(pop_from_, result));
         if (*result == nullptr) {
           return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                         "[ERROR] nullptr detected when getting data from db connector");
@@ -82,6 +91,10 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
       if (!((*result)->eoe() && retry_if_eoe)) {
         expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
       }
+      if (!take_turns) {
+        out_buffers_count_++;
+        return Status::OK();
+      }
     }
     out_buffers_count_++;
     cv_.NotifyAll();
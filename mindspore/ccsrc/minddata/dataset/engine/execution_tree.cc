@@ -190,6 +190,9 @@ Status ExecutionTree::Launch() {
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
 
+  // The tensor pool settings may have been changed since the previous pipeline was launched
+  GlobalContext::Instance()->ConfigureMemPool();
+
   // Profiling infrastructures need to be initialized before Op launching
   if (profiling_manager_->IsProfilingEnable()) {
     // Setup profiling manager
@@ -213,6 +216,12 @@ Status ExecutionTree::Launch() {
     }
   }
 
+  // The auto tuner watches the connectors the ops just started to fill
+  if (GlobalContext::config_manager()->enable_autotune()) {
+    autotune_ = std::make_unique<AutoTune>(this);
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("AutoTune", std::ref(*autotune_)));
+  }
+
   tree_state_ = kDeTStateExecuting;
 
   return Status::OK();
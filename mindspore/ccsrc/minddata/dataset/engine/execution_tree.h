@@ -29,6 +29,7 @@
 #endif
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/util/status.h"
+#include "mindspore/ccsrc/minddata/dataset/engine/perf/auto_tune.h"
 #include "mindspore/ccsrc/minddata/dataset/engine/perf/profiling.h"
 namespace mindspore {
 namespace dataset {
@@ -256,6 +257,7 @@ class ExecutionTree {
   TreeState tree_state_;                                 // Tracking the current tree state
   int32_t num_epochs_;                                   // Total number of epochs to run for this tree
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
+  std::unique_ptr<AutoTune> autotune_;                   // Tunes the running tree when enable_autotune is on
   bool partially_prepare_;                               // Temp: during migration to IR, if true, run remaining passes.
 #if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
   // This rank_id is for numa and device_queue, one process work with only one rank_id,
@@ -0,0 +1,373 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_csr.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+
+#include "./securec.h"
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+constexpr char kCsrMagic[] = "MSGNNCSR";
+constexpr int64_t kCsrVersion = 2;
+constexpr int64_t kMaxColumnRank = 8;
+constexpr size_t kAlignment = sizeof(int64_t);
+
+// Every section of the file starts at a multiple of 8 bytes, all the numbers of the headers take 8 bytes.
+struct FileHeader {
+  char magic[kAlignment];
+  int64_t version;
+  uint64_t source_fingerprint;
+  int64_t num_nodes;
+  int64_t num_adjacencies;
+  int64_t num_columns;
+};  // followed by the ids of the nodes
+
+struct AdjacencyHeader {
+  int64_t neighbor_type;
+  int64_t num_neighbors;
+};  // followed by num_nodes + 1 offsets and the neighbors
+
+struct ColumnHeader {
+  int64_t feature_type;
+  int64_t data_type;
+  int64_t rank;
+  int64_t dims[kMaxColumnRank];
+  int64_t row_bytes;
+};  // followed by the values of all the rows
+
+size_t Padded(size_t bytes) { return (bytes + kAlignment - 1) / kAlignment * kAlignment; }
+
+// Reads the sections of a csr one after another, a section out of the data is returned as nullptr.
+class CsrCursor {
+ public:
+  CsrCursor(const uint8_t *data, size_t size) : data_(data), size_(size), pos_(0) {}
+
+  template <typename T>
+  const T *Take(uint64_t count) {
+    if (count > (size_ - pos_) / sizeof(T) || Padded(count * sizeof(T)) > size_ - pos_) {
+      return nullptr;
+    }
+    const T *p = reinterpret_cast<const T *>(data_ + pos_);
+    pos_ += Padded(count * sizeof(T));
+    return p;
+  }
+
+  bool AtEnd() const { return pos_ == size_; }
+
+ private:
+  const uint8_t *data_;
+  size_t size_;
+  size_t pos_;
+};
+
+// Writes the sections of a csr one after another in a buffer of the right size.
+class CsrWriter {
+ public:
+  explicit CsrWriter(uint8_t *data) : data_(data), pos_(0) {}
+
+  template <typename T>
+  T *Put(uint64_t count) {
+    T *p = reinterpret_cast<T *>(data_ + pos_);
+    pos_ += Padded(count * sizeof(T));
+    return p;
+  }
+
+ private:
+  uint8_t *data_;
+  size_t pos_;
+};
+}  // namespace
+
+GraphCsr::~GraphCsr() { Clear(); }
+
+void GraphCsr::Clear() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (mapped_ && munmap(const_cast<uint8_t *>(data_), size_) != 0) {
+    MS_LOG(ERROR) << "Unmap graph csr failed, errno: " << errno;
+  }
+#endif
+  mapped_ = false;
+  loaded_ = false;
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  data_ = nullptr;
+  size_ = 0;
+  num_nodes_ = 0;
+  num_edges_ = 0;
+  source_fingerprint_ = 0;
+  node_ids_ = nullptr;
+  dense_ids_ = false;
+  adjacencies_.clear();
+  columns_.clear();
+}
+
+Status GraphCsr::Build(const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &nodes,
+                       const std::vector<std::pair<NodeIdType, NodeIdType>> &edges,
+                       const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_features,
+                       uint64_t source_fingerprint) {
+  Clear();
+  std::vector<NodeIdType> ids;
+  ids.reserve(nodes.size());
+  std::transform(nodes.begin(), nodes.end(), std::back_inserter(ids), [](const auto &itr) { return itr.first; });
+  std::sort(ids.begin(), ids.end());
+  auto num_nodes = static_cast<int64_t>(ids.size());
+  auto row_of = [&ids](NodeIdType id) -> int64_t {
+    auto itr = std::lower_bound(ids.begin(), ids.end(), id);
+    return itr != ids.end() && *itr == id ? itr - ids.begin() : -1;
+  };
+
+  // The degrees of the rows, which become the offsets, per neighbor type
+  std::map<NodeType, std::vector<int64_t>> offsets;
+  for (const auto &edge : edges) {
+    int64_t row = row_of(edge.first);
+    auto dst_itr = nodes.find(edge.second);
+    CHECK_FAIL_RETURN_UNEXPECTED(row >= 0, "Invalid src_id:" + std::to_string(edge.first));
+    CHECK_FAIL_RETURN_UNEXPECTED(dst_itr != nodes.end(), "Invalid dst_id:" + std::to_string(edge.second));
+    std::vector<int64_t> &degrees = offsets[dst_itr->second->type()];
+    if (degrees.empty()) {
+      degrees.resize(num_nodes + 1, 0);
+    }
+    degrees[row + 1]++;
+  }
+
+  // A feature is kept in a column only if all its values can be copied as they are
+  std::vector<std::shared_ptr<Feature>> defaults;
+  for (const auto &itr : default_features) {
+    defaults.push_back(itr.second);
+  }
+  std::sort(defaults.begin(), defaults.end(), [](const auto &a, const auto &b) { return a->type() < b->type(); });
+  bool columnar = std::all_of(defaults.begin(), defaults.end(), [](const std::shared_ptr<Feature> &feature) {
+    DataType type = feature->Value()->type();
+    return type.value() != DataType::DE_UNKNOWN && type.IsNumeric() &&
+           feature->Value()->shape().Rank() <= kMaxColumnRank;
+  });
+  for (auto itr = nodes.begin(); columnar && itr != nodes.end(); ++itr) {
+    for (const auto &default_feature : defaults) {
+      std::shared_ptr<Feature> feature;
+      if (itr->second->GetFeatures(default_feature->type(), &feature).IsOk() &&
+          (feature->Value()->type() != default_feature->Value()->type() ||
+           feature->Value()->shape() != default_feature->Value()->shape())) {
+        MS_LOG(INFO) << "Node features are not kept in columns, the shapes of feature " << default_feature->type()
+                     << " are different.";
+        columnar = false;
+        break;
+      }
+    }
+  }
+  if (!columnar) {
+    defaults.clear();
+  }
+
+  size_t size = sizeof(FileHeader) + Padded(ids.size() * sizeof(NodeIdType));
+  for (const auto &itr : offsets) {
+    size += sizeof(AdjacencyHeader) + Padded((num_nodes + 1) * sizeof(int64_t));
+    size += Padded(std::accumulate(itr.second.begin(), itr.second.end(), int64_t(0)) * sizeof(NodeIdType));
+  }
+  for (const auto &feature : defaults) {
+    size += sizeof(ColumnHeader) + Padded(num_nodes * feature->Value()->SizeInBytes());
+  }
+  buffer_.assign(size / kAlignment, 0);
+  CsrWriter writer(reinterpret_cast<uint8_t *>(buffer_.data()));
+
+  auto *header = writer.Put<FileHeader>(1);
+  std::copy(kCsrMagic, kCsrMagic + kAlignment, header->magic);
+  header->version = kCsrVersion;
+  header->source_fingerprint = source_fingerprint;
+  header->num_nodes = num_nodes;
+  header->num_adjacencies = static_cast<int64_t>(offsets.size());
+  header->num_columns = static_cast<int64_t>(defaults.size());
+  std::copy(ids.begin(), ids.end(), writer.Put<NodeIdType>(ids.size()));
+
+  // The offsets serve as the positions to put the next neighbor of every row at
+  std::map<NodeType, NodeIdType *> neighbors;
+  for (auto &itr : offsets) {
+    std::vector<int64_t> &cursors = itr.second;
+    std::partial_sum(cursors.begin(), cursors.end(), cursors.begin());
+    auto *adjacency_header = writer.Put<AdjacencyHeader>(1);
+    adjacency_header->neighbor_type = itr.first;
+    adjacency_header->num_neighbors = cursors.back();
+    std::copy(cursors.begin(), cursors.end(), writer.Put<int64_t>(cursors.size()));
+    neighbors[itr.first] = writer.Put<NodeIdType>(cursors.back());
+  }
+  for (const auto &edge : edges) {
+    NodeType neighbor_type = nodes.at(edge.second)->type();
+    neighbors[neighbor_type][offsets[neighbor_type][row_of(edge.first)]++] = edge.second;
+  }
+
+  for (const auto &default_feature : defaults) {
+    const std::shared_ptr<Tensor> &default_value = default_feature->Value();
+    auto *column_header = writer.Put<ColumnHeader>(1);
+    column_header->feature_type = default_feature->type();
+    column_header->data_type = default_value->type().value();
+    column_header->rank = default_value->shape().Rank();
+    for (int64_t i = 0; i < column_header->rank; i++) {
+      column_header->dims[i] = default_value->shape()[i];
+    }
+    column_header->row_bytes = default_value->SizeInBytes();
+    uint8_t *data = writer.Put<uint8_t>(num_nodes * column_header->row_bytes);
+    for (int64_t row = 0; row < num_nodes; row++) {
+      std::shared_ptr<Feature> feature;
+      if (!nodes.at(ids[row])->GetFeatures(default_feature->type(), &feature).IsOk()) {
+        feature = default_feature;
+      }
+      int64_t row_bytes = column_header->row_bytes;
+      if (row_bytes > 0) {
+        int ret_code = memcpy_s(data + row * row_bytes, row_bytes, feature->Value()->GetBuffer(), row_bytes);
+        CHECK_FAIL_RETURN_UNEXPECTED(ret_code == 0, "Failed to copy the node feature: " + std::to_string(ret_code));
+      }
+    }
+  }
+
+  data_ = reinterpret_cast<const uint8_t *>(buffer_.data());
+  size_ = size;
+  Status rc = Parse();
+  if (rc.IsError()) {
+    Clear();
+  }
+  return rc;
+}
+
+Status GraphCsr::Save(const std::string &file) const {
+  CHECK_FAIL_RETURN_UNEXPECTED(!empty(), "The graph csr is not built.");
+  std::ofstream out(file, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(out.good(), "Failed to open graph csr file: " + file);
+  out.write(reinterpret_cast<const char *>(data_), static_cast<std::streamsize>(size_));
+  out.close();
+  CHECK_FAIL_RETURN_UNEXPECTED(out.good(), "Failed to write graph csr file: " + file);
+  return Status::OK();
+}
+
+Status GraphCsr::Load(const std::string &file) {
+  Clear();
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = ::open(file.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Failed to open graph csr file: " + file);
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    (void)::close(fd);
+    RETURN_STATUS_UNEXPECTED("Invalid graph csr file: " + file);
+  }
+  size_t size = static_cast<size_t>(file_stat.st_size);
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  (void)::close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED(addr != MAP_FAILED, "Failed to map graph csr file: " + file);
+  data_ = static_cast<const uint8_t *>(addr);
+  size_ = size;
+  mapped_ = true;
+#else
+  std::ifstream in(file, std::ios::in | std::ios::binary | std::ios::ate);
+  CHECK_FAIL_RETURN_UNEXPECTED(in.good(), "Failed to open graph csr file: " + file);
+  std::streamoff size = in.tellg();
+  CHECK_FAIL_RETURN_UNEXPECTED(size > 0, "Invalid graph csr file: " + file);
+  buffer_.assign(Padded(size) / kAlignment, 0);
+  in.seekg(0);
+  in.read(reinterpret_cast<char *>(buffer_.data()), size);
+  CHECK_FAIL_RETURN_UNEXPECTED(in.good(), "Failed to read graph csr file: " + file);
+  data_ = reinterpret_cast<const uint8_t *>(buffer_.data());
+  size_ = static_cast<size_t>(size);
+#endif
+  Status rc = Parse();
+  if (rc.IsError()) {
+    Clear();
+    RETURN_STATUS_UNEXPECTED("Invalid graph csr file: " + file + ", " + rc.GetErrDescription());
+  }
+  loaded_ = true;
+  MS_LOG(INFO) << "Load graph csr file: " << file << ", nodes: " << num_nodes_ << ", edges: " << num_edges_
+               << ", feature columns: " << columns_.size();
+  return Status::OK();
+}
+
+Status GraphCsr::Parse() {
+  CsrCursor cursor(data_, size_);
+  const auto *header = cursor.Take<FileHeader>(1);
+  CHECK_FAIL_RETURN_UNEXPECTED(header != nullptr && std::equal(kCsrMagic, kCsrMagic + kAlignment, header->magic),
+                               "Graph csr data is corrupted.");
+  CHECK_FAIL_RETURN_UNEXPECTED(header->version == kCsrVersion,
+                               "Unsupported graph csr version: " + std::to_string(header->version));
+  CHECK_FAIL_RETURN_UNEXPECTED(header->num_nodes >= 0 && header->num_adjacencies >= 0 && header->num_columns >= 0,
+                               "Graph csr data is corrupted.");
+  source_fingerprint_ = header->source_fingerprint;
+  num_nodes_ = header->num_nodes;
+  node_ids_ = cursor.Take<NodeIdType>(num_nodes_);
+  CHECK_FAIL_RETURN_UNEXPECTED(node_ids_ != nullptr, "Graph csr data is corrupted.");
+  const NodeIdType *node_ids_end = node_ids_ + num_nodes_;
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    std::adjacent_find(node_ids_, node_ids_end, std::greater_equal<NodeIdType>()) == node_ids_end,
+    "Graph csr data is corrupted, the node ids are not ascending.");
+  dense_ids_ = num_nodes_ > 0 && static_cast<int64_t>(node_ids_[num_nodes_ - 1]) - node_ids_[0] + 1 == num_nodes_;
+
+  for (int64_t i = 0; i < header->num_adjacencies; i++) {
+    const auto *adjacency_header = cursor.Take<AdjacencyHeader>(1);
+    CHECK_FAIL_RETURN_UNEXPECTED(adjacency_header != nullptr && adjacency_header->num_neighbors >= 0 &&
+                                   adjacency_header->neighbor_type >= std::numeric_limits<NodeType>::min() &&
+                                   adjacency_header->neighbor_type <= std::numeric_limits<NodeType>::max(),
+                                 "Graph csr data is corrupted.");
+    Adjacency adjacency{static_cast<NodeType>(adjacency_header->neighbor_type),
+                        cursor.Take<int64_t>(num_nodes_ + 1), nullptr};
+    // The offsets must be ascending, so that the neighbors of every row lie in the neighbors section
+    CHECK_FAIL_RETURN_UNEXPECTED(adjacency.offsets != nullptr && adjacency.offsets[0] == 0 &&
+                                   adjacency.offsets[num_nodes_] == adjacency_header->num_neighbors &&
+                                   std::is_sorted(adjacency.offsets, adjacency.offsets + num_nodes_ + 1),
+                                 "Graph csr data is corrupted.");
+    adjacency.neighbors = cursor.Take<NodeIdType>(adjacency_header->num_neighbors);
+    CHECK_FAIL_RETURN_UNEXPECTED(adjacency.neighbors != nullptr, "Graph csr data is corrupted.");
+    num_edges_ += adjacency_header->num_neighbors;
+    adjacencies_.push_back(adjacency);
+  }
+
+  for (int64_t i = 0; i < header->num_columns; i++) {
+    const auto *column_header = cursor.Take<ColumnHeader>(1);
+    CHECK_FAIL_RETURN_UNEXPECTED(column_header != nullptr && column_header->rank >= 0 &&
+                                   column_header->rank <= kMaxColumnRank &&
+                                   column_header->data_type > DataType::DE_UNKNOWN &&
+                                   column_header->data_type < DataType::DE_STRING,
+                                 "Graph csr data is corrupted.");
+    Column column{static_cast<FeatureType>(column_header->feature_type),
+                  DataType(static_cast<DataType::Type>(column_header->data_type)),
+                  TensorShape(std::vector<dsize_t>(column_header->dims, column_header->dims + column_header->rank)),
+                  column_header->row_bytes, nullptr};
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      std::all_of(column_header->dims, column_header->dims + column_header->rank, [](int64_t d) { return d >= 0; }) &&
+        column.row_bytes == column.shape.NumOfElements() * column.data_type.SizeInBytes(),
+      "Graph csr data is corrupted.");
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      column.row_bytes == 0 || num_nodes_ <= std::numeric_limits<int64_t>::max() / column.row_bytes,
+      "Graph csr data is corrupted.");
+    column.data = cursor.Take<uint8_t>(num_nodes_ * column.row_bytes);
+    CHECK_FAIL_RETURN_UNEXPECTED(column.data != nullptr, "Graph csr data is corrupted.");
+    columns_.push_back(column);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(cursor.AtEnd(), "Graph csr data is corrupted.");
+  return Status::OK();
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/core/tensor_shape.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+// The adjacency of a graph in compressed sparse row form, and the features of the nodes in columns.
+// The rows are the nodes in the ascending order of their ids. There is one csr per neighbor type, the neighbors of
+// row r are neighbors[offsets[r], offsets[r + 1]) in the order the edges were loaded.
+// A node feature is kept in a column of one value per row, the default value is filled in for the nodes without it.
+// Everything lies in one buffer with the layout of the preprocessed file, so the file is mapped rather than read and
+// its pages are shared by all the processes loading the same graph.
+class GraphCsr {
+ public:
+  // The values of a node feature, the value of row r is data[r * row_bytes, (r + 1) * row_bytes)
+  struct Column {
+    FeatureType feature_type;
+    DataType data_type;
+    TensorShape shape;
+    int64_t row_bytes;
+    const uint8_t *data;
+  };
+
+  GraphCsr() = default;
+
+  ~GraphCsr();
+
+  GraphCsr(const GraphCsr &) = delete;
+
+  GraphCsr &operator=(const GraphCsr &) = delete;
+
+  // Build the csr of a graph, the previous content is dropped.
+  // The columns are built only if the values of every feature have the shape and type of the default value.
+  // @param nodes - all the nodes of the graph
+  // @param edges - the source and destination node of all the edges of the graph
+  // @param default_features - the default value of the node features to keep in columns, may be empty
+  // @param source_fingerprint - identifies the version of the dataset files the graph is loaded from
+  // @return Status The status code returned
+  Status Build(const std::unordered_map<NodeIdType, std::shared_ptr<Node>> &nodes,
+               const std::vector<std::pair<NodeIdType, NodeIdType>> &edges,
+               const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &default_features,
+               uint64_t source_fingerprint);
+
+  // Write the csr to a file which Load maps later.
+  // @param file - path of the file
+  // @return Status The status code returned
+  Status Save(const std::string &file) const;
+
+  // Map a file written by Save, the previous content is dropped.
+  // @param file - path of the file
+  // @return Status The status code returned
+  Status Load(const std::string &file);
+
+  void Clear();
+
+  bool empty() const { return data_ == nullptr; }
+
+  // @return whether the csr is read from a file rather than built
+  bool loaded() const { return loaded_; }
+
+  uint64_t source_fingerprint() const { return source_fingerprint_; }
+
+  int64_t num_nodes() const { return num_nodes_; }
+
+  // @return the number of neighbors of all the neighbor types, i.e. the number of edges of the graph
+  int64_t num_edges() const { return num_edges_; }
+
+  const std::vector<Column> &columns() const { return columns_; }
+
+  // @return the row of a node, or -1 if there is no such node
+  int64_t Row(NodeIdType id) const {
+    if (dense_ids_) {
+      int64_t row = static_cast<int64_t>(id) - node_ids_[0];
+      return row >= 0 && row < num_nodes_ ? row : -1;
+    }
+    const NodeIdType *itr = std::lower_bound(node_ids_, node_ids_ + num_nodes_, id);
+    return itr != node_ids_ + num_nodes_ && *itr == id ? itr - node_ids_ : -1;
+  }
+
+  // @return the neighbors of a row of a neighbor type as the range [first, second)
+  std::pair<const NodeIdType *, const NodeIdType *> Neighbors(int64_t row, NodeType neighbor_type) const {
+    for (const auto &adjacency : adjacencies_) {
+      if (adjacency.neighbor_type == neighbor_type) {
+        return {adjacency.neighbors + adjacency.offsets[row], adjacency.neighbors + adjacency.offsets[row + 1]};
+      }
+    }
+    return {nullptr, nullptr};
+  }
+
+  // @return the column of a feature, or nullptr if the feature is not kept in a column
+  const Column *FindColumn(FeatureType feature_type) const {
+    for (const auto &column : columns_) {
+      if (column.feature_type == feature_type) {
+        return &column;
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  struct Adjacency {
+    NodeType neighbor_type;
+    const int64_t *offsets;
+    const NodeIdType *neighbors;
+  };
+
+  // Set up the arrays from the content of data_, the content is validated first.
+  Status Parse();
+
+  std::vector<int64_t> buffer_;  // the content when built, int64_t for the alignment of all the sections
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+  bool loaded_ = false;
+  uint64_t source_fingerprint_ = 0;
+  int64_t num_nodes_ = 0;
+  int64_t num_edges_ = 0;
+  const NodeIdType *node_ids_ = nullptr;
+  bool dense_ids_ = false;  // the ids are consecutive, the row of an id is id - node_ids_[0]
+  std::vector<Adjacency> adjacencies_;
+  std::vector<Column> columns_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
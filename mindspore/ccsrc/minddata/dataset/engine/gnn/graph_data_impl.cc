@@ -23,7 +23,9 @@
 
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
+#include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
 namespace mindspore {
 namespace dataset {
 namespace gnn {
@@ -31,10 +33,10 @@ namespace gnn {
 GraphDataImpl::GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode)
     : dataset_file_(dataset_file),
       num_workers_(num_workers),
-      rnd_(GetRandomDevice()),
+      seed_(GetSeed()),
+      sample_calls_(0),
       random_walk_(this),
       server_mode_(server_mode) {
-  rnd_.seed(GetSeed());
   MS_LOG(INFO) << "num_workers:" << num_workers;
 }
 
@@ -77,24 +79,6 @@ Status GraphDataImpl::CreateTensorByVector(const std::vector<std::vector<T>> &da
   return Status::OK();
 }
 
-template <typename T>
-Status GraphDataImpl::ComplementVector(std::vector<std::vector<T>> *data, size_t max_size, T default_value) {
-  if (!data || data->empty()) {
-    RETURN_STATUS_UNEXPECTED("Input data is empty");
-  }
-  for (std::vector<T> &vec : *data) {
-    size_t size = vec.size();
-    if (size > max_size) {
-      RETURN_STATUS_UNEXPECTED("The max_size parameter is abnormal");
-    } else {
-      for (size_t i = 0; i < (max_size - size); ++i) {
-        vec.push_back(default_value);
-      }
-    }
-  }
-  return Status::OK();
-}
-
 Status GraphDataImpl::GetAllEdges(EdgeType edge_type, std::shared_ptr<Tensor> *out) {
   auto itr = edge_type_map_.find(edge_type);
   if (itr == edge_type_map_.end()) {
@@ -133,19 +117,31 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   CHECK_FAIL_RETURN_UNEXPECTED(!node_list.empty(), "Input node_list is empty.");
   RETURN_IF_NOT_OK(CheckNeighborType(neighbor_type));
 
-  std::vector<std::vector<NodeIdType>> neighbors;
+  // Find the neighbors of the whole batch first, then copy them into the output tensor row by row
+  std::vector<std::pair<const NodeIdType *, const NodeIdType *>> neighbors(node_list.size());
   size_t max_neighbor_num = 0;
-  neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
-    max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
+    int64_t row = -1;
+    RETURN_IF_NOT_OK(GetNodeRow(node_list[i], &row));
+    neighbors[i] = csr_.Neighbors(row, neighbor_type);
+    max_neighbor_num = std::max(max_neighbor_num, static_cast<size_t>(neighbors[i].second - neighbors[i].first));
   }
 
-  RETURN_IF_NOT_OK(ComplementVector<NodeIdType>(&neighbors, max_neighbor_num, kDefaultNodeId));
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors, DataType(DataType::DE_INT32), out));
-
+  // The node itself comes first, and the rest of the row is filled with kDefaultNodeId
+  size_t row_size = max_neighbor_num + 1;
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(
+    TensorShape({static_cast<dsize_t>(node_list.size()), static_cast<dsize_t>(row_size)}),
+    DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *out_ids = &*tensor->begin<NodeIdType>();
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    NodeIdType *out_row = out_ids + i * row_size;
+    out_row[0] = node_list[i];
+    NodeIdType *end = std::copy(neighbors[i].first, neighbors[i].second, out_row + 1);
+    std::fill(end, out_row + row_size, kDefaultNodeId);
+  }
+  tensor->Squeeze();
+  *out = std::move(tensor);
   return Status::OK();
 }
 
@@ -181,36 +177,95 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   for (const auto &type : neighbor_types) {
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
-  std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
+  std::vector<int64_t> rows(node_list.size());
+  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
+    RETURN_IF_NOT_OK(GetNodeRow(node_list[node_idx], &rows[node_idx]));
+  }
+
+  // A row of the output holds the node, then the neighbors of every hop. A hop samples the neighbors of the nodes
+  // of the previous hop, which are already in the row.
+  dsize_t row_size = 1;
+  dsize_t hop_size = 1;
+  for (const auto &num : neighbor_nums) {
+    hop_size *= num;
+    row_size += hop_size;
+  }
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(node_list.size()), row_size}),
+                                       DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *out_ids = &*tensor->begin<NodeIdType>();
+  SampleScratch scratch;
+  scratch.rnd = NewGenerator();
   for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
+    NodeIdType *input = out_ids + node_idx * row_size;
+    input[0] = node_list[node_idx];
+    dsize_t input_size = 1;
     for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
-      neighbors.reserve(input_list.size() * neighbor_nums[i]);
-      for (const auto &node_id : input_list) {
-        if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            neighbors.emplace_back(kDefaultNodeId);
-          }
-        } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], &out));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
+      NodeIdType *output = input + input_size;
+      for (dsize_t j = 0; j < input_size; ++j) {
+        NodeIdType *samples = output + j * neighbor_nums[i];
+        if (input[j] == kDefaultNodeId) {
+          std::fill(samples, samples + neighbor_nums[i], kDefaultNodeId);
+          continue;
         }
+        int64_t row = (i == 0) ? rows[node_idx] : csr_.Row(input[j]);
+        auto neighbors = csr_.Neighbors(row, neighbor_types[i]);
+        SampleNeighbors(neighbors.first, neighbors.second, neighbor_nums[i], samples, &scratch);
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
+      input = output;
+      input_size *= neighbor_nums[i];
     }
   }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
+  tensor->Squeeze();
+  *out = std::move(tensor);
   return Status::OK();
 }
 
+void GraphDataImpl::SampleNeighbors(const NodeIdType *first, const NodeIdType *last, int32_t samples_num,
+                                    NodeIdType *out, SampleScratch *scratch) {
+  int64_t num_neighbors = last - first;
+  if (num_neighbors == 0) {
+    // If there are no neighbors, they are filled with kDefaultNodeId
+    std::fill(out, out + samples_num, kDefaultNodeId);
+    return;
+  }
+  // Each round is a partial Fisher-Yates shuffle, the neighbors repeat only once all of them are taken.
+  // With many more neighbors than samples, only the displaced indices are kept so a draw costs O(1) rather than the
+  // O(neighbors) of setting up all the indices.
+  bool sparse = num_neighbors > 2 * static_cast<int64_t>(samples_num);
+  if (!sparse) {
+    scratch->indices.resize(num_neighbors);
+  }
+  int32_t filled = 0;
+  while (filled < samples_num) {
+    int64_t num = std::min<int64_t>(samples_num - filled, num_neighbors);
+    if (sparse) {
+      scratch->displaced.clear();
+      for (int64_t k = 0; k < num; ++k) {
+        std::uniform_int_distribution<int64_t> distribution(k, num_neighbors - 1);
+        int64_t j = distribution(scratch->rnd);
+        auto itr_j = scratch->displaced.find(j);
+        int64_t picked = itr_j == scratch->displaced.end() ? j : itr_j->second;
+        auto itr_k = scratch->displaced.find(k);
+        scratch->displaced[j] = itr_k == scratch->displaced.end() ? k : itr_k->second;
+        out[filled++] = first[picked];
+      }
+      continue;
+    }
+    std::iota(scratch->indices.begin(), scratch->indices.end(), 0);
+    for (int64_t k = 0; k < num; ++k) {
+      std::uniform_int_distribution<int64_t> distribution(k, num_neighbors - 1);
+      std::swap(scratch->indices[k], scratch->indices[distribution(scratch->rnd)]);
+      out[filled++] = first[scratch->indices[k]];
+    }
+  }
+}
+
+std::mt19937 GraphDataImpl::NewGenerator() {
+  std::seed_seq seq{seed_, sample_calls_.fetch_add(1, std::memory_order_relaxed)};
+  return std::mt19937(seq);
+}
+
 Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
                                      size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data,
                                      int32_t samples_num, std::vector<NodeIdType> *out_samples) {
@@ -239,22 +294,22 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   const std::vector<NodeIdType> &all_nodes = node_type_map_[neg_neighbor_type];
   std::vector<NodeIdType> shuffled_id(all_nodes.size());
   std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
-  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
+  std::mt19937 rnd = NewGenerator();
+  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd);
   size_t start_index = 0;
   bool need_shuffle = false;
 
   std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
   neg_neighbors_vec.resize(node_list.size());
   for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
     std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
+    RETURN_IF_NOT_OK(GetNeighbors(node_list[node_idx], neg_neighbor_type, &neighbors));
+    neighbors.push_back(node_list[node_idx]);
     std::unordered_set<NodeIdType> exclude_nodes;
     std::transform(neighbors.begin(), neighbors.end(),
                    std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
                    [](const NodeIdType node) { return node; });
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
+    neg_neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
     if (all_nodes.size() > exclude_nodes.size()) {
       while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
         RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
@@ -265,7 +320,7 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
         }
       }
     } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
+      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node_list[node_idx]
                     << " neg_neighbor_type:" << neg_neighbor_type;
       // If there are no negative neighbors, they are filled with kDefaultNodeId
       for (int32_t i = 0; i < samples_num; ++i) {
@@ -273,7 +328,7 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
       }
     }
     if (need_shuffle) {
-      std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
+      std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd);
       start_index = 0;
       need_shuffle = false;
     }
@@ -285,7 +340,8 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
 Status GraphDataImpl::RandomWalk(const std::vector<NodeIdType> &node_list, const std::vector<NodeType> &meta_path,
                                  float step_home_param, float step_away_param, NodeIdType default_node,
                                  std::shared_ptr<Tensor> *out) {
-  RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
+  RETURN_IF_NOT_OK(
+    random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node, 1, num_workers_));
   std::vector<std::vector<NodeIdType>> walks;
   RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
@@ -333,8 +389,28 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
+    const GraphCsr::Column *column = GetFeatureColumn(f_type);
     dsize_t index = 0;
-    for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+    for (auto node_itr = nodes->begin<NodeIdType>(); column != nullptr && node_itr != nodes->end<NodeIdType>();
+         ++node_itr) {
+      // Copy the value from the column, the batch is written to the output tensor without a tensor per node
+      const uint8_t *value = default_feature->Value()->GetBuffer();
+      if (*node_itr != kDefaultNodeId) {
+        int64_t row = -1;
+        RETURN_IF_NOT_OK(GetNodeRow(*node_itr, &row));
+        value = column->data + row * column->row_bytes;
+      }
+      if (column->row_bytes > 0) {
+        uchar *slot = nullptr;
+        TensorShape remaining = TensorShape::CreateUnknownRankShape();
+        RETURN_IF_NOT_OK(fea_tensor->StartAddrOfIndex({index}, &slot, &remaining));
+        int ret_code = memcpy_s(slot, column->row_bytes, value, column->row_bytes);
+        CHECK_FAIL_RETURN_UNEXPECTED(ret_code == 0, "Failed to copy the node feature: " + std::to_string(ret_code));
+      }
+      index++;
+    }
+    for (auto node_itr = nodes->begin<NodeIdType>(); column == nullptr && node_itr != nodes->end<NodeIdType>();
+         ++node_itr) {
       std::shared_ptr<Feature> feature;
       if (*node_itr == kDefaultNodeId) {
         feature = default_feature;
@@ -537,11 +613,119 @@ Status GraphDataImpl::GraphInfo(py::dict *out) {
 #endif
 
 Status GraphDataImpl::LoadNodeAndEdge() {
-  GraphLoader gl(this, dataset_file_, num_workers_, server_mode_);
-  // ask graph_loader to load everything into memory
-  RETURN_IF_NOT_OK(gl.InitAndLoad());
-  // get all maps
-  RETURN_IF_NOT_OK(gl.GetNodesAndEdges());
+  std::string csr_file = dataset_file_ + kGraphCsrSuffix;
+  bool use_csr_file = Path(csr_file).Exists();
+  while (true) {
+    GraphLoader gl(this, dataset_file_, num_workers_, server_mode_);
+    RETURN_IF_NOT_OK(gl.Init());
+    if (use_csr_file) {
+      Status rc = MapCsr(gl, csr_file);
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "Graph csr file is not used, it is built again. " << rc.GetErrDescription();
+        csr_.Clear();
+      }
+    }
+    // ask graph_loader to load everything into memory, but what the mapped csr holds. In server mode the node
+    // features are never read from the columns, everything is loaded.
+    bool csr_mapped = !csr_.empty() && !server_mode_;
+    RETURN_IF_NOT_OK(gl.Load(csr_mapped));
+    // get all maps
+    RETURN_IF_NOT_OK(gl.GetNodesAndEdges());
+    if (!csr_.empty()) {
+      Status rc = CheckCsr();
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "Graph csr file is not used, it is built again. " << rc.GetErrDescription();
+        csr_.Clear();
+        if (csr_mapped) {
+          // The adjacency and some node features were skipped, the graph is loaded again without the csr file
+          ClearGraph();
+          use_csr_file = false;
+          continue;
+        }
+      }
+    }
+    if (csr_.empty()) {
+      RETURN_IF_NOT_OK(gl.BuildCsr(&csr_));
+    }
+    break;
+  }
+  // Once all the node features are in columns, the nodes don't need to keep them
+  bool all_in_columns =
+    !default_node_feature_map_.empty() &&
+    std::all_of(default_node_feature_map_.begin(), default_node_feature_map_.end(),
+                [this](const auto &itr) { return GetFeatureColumn(itr.first) != nullptr; });
+  if (all_in_columns) {
+    for (auto &itr : node_id_map_) {
+      RETURN_IF_NOT_OK(itr.second->ClearFeatures());
+    }
+  }
+  return Status::OK();
+}
+
+Status GraphDataImpl::MapCsr(const GraphLoader &loader, const std::string &csr_file) {
+  uint64_t source_fingerprint = 0;
+  RETURN_IF_NOT_OK(loader.GetSourceFingerprint(&source_fingerprint));
+  RETURN_IF_NOT_OK(csr_.Load(csr_file));
+  CHECK_FAIL_RETURN_UNEXPECTED(csr_.source_fingerprint() == source_fingerprint,
+                               "The dataset files are changed after the csr file was saved.");
+  return Status::OK();
+}
+
+Status GraphDataImpl::CheckCsr() const {
+  CHECK_FAIL_RETURN_UNEXPECTED(csr_.num_nodes() == static_cast<int64_t>(node_id_map_.size()) &&
+                                 csr_.num_edges() == static_cast<int64_t>(edge_id_map_.size()),
+                               "The numbers of nodes and edges are different from the dataset.");
+  CHECK_FAIL_RETURN_UNEXPECTED(std::all_of(node_id_map_.begin(), node_id_map_.end(),
+                                           [this](const auto &itr) { return csr_.Row(itr.first) >= 0; }),
+                               "The nodes are different from the dataset.");
+  for (const auto &column : csr_.columns()) {
+    auto itr = default_node_feature_map_.find(column.feature_type);
+    CHECK_FAIL_RETURN_UNEXPECTED(itr != default_node_feature_map_.end() &&
+                                   itr->second->Value()->type() == column.data_type &&
+                                   itr->second->Value()->shape() == column.shape,
+                                 "The node feature " + std::to_string(column.feature_type) +
+                                   " is different from the dataset.");
+  }
+  return Status::OK();
+}
+
+void GraphDataImpl::ClearGraph() {
+  node_type_map_.clear();
+  node_id_map_.clear();
+  edge_type_map_.clear();
+  edge_id_map_.clear();
+  node_feature_map_.clear();
+  edge_feature_map_.clear();
+  default_node_feature_map_.clear();
+  default_edge_feature_map_.clear();
+}
+
+Status GraphDataImpl::SaveCsr(const std::string &csr_file) const {
+  RETURN_IF_NOT_OK(csr_.Save(csr_file));
+  MS_LOG(INFO) << "Save graph csr file: " << csr_file;
+  return Status::OK();
+}
+
+Status GraphDataImpl::GetNodeRow(NodeIdType id, int64_t *row) const {
+  *row = csr_.Row(id);
+  if (*row < 0) {
+    std::string err_msg = "Invalid node id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+const GraphCsr::Column *GraphDataImpl::GetFeatureColumn(FeatureType feature_type) const {
+  // In server mode the values of the node features are offsets in the shared memory, they are never in columns
+  return server_mode_ ? nullptr : csr_.FindColumn(feature_type);
+}
+
+Status GraphDataImpl::GetNeighbors(NodeIdType id, NodeType neighbor_type,
+                                   std::vector<NodeIdType> *out_neighbors) const {
+  int64_t row = -1;
+  RETURN_IF_NOT_OK(GetNodeRow(id, &row));
+  auto neighbors = csr_.Neighbors(row, neighbor_type);
+  out_neighbors->assign(neighbors.first, neighbors.second);
   return Status::OK();
 }
 
@@ -568,7 +752,15 @@ Status GraphDataImpl::GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge
 }
 
 GraphDataImpl::RandomWalkBase::RandomWalkBase(GraphDataImpl *graph)
-    : graph_(graph), step_home_param_(1.0), step_away_param_(1.0), default_node_(-1), num_walks_(1), num_workers_(1) {}
+    : graph_(graph),
+      step_home_param_(1.0),
+      step_away_param_(1.0),
+      default_node_(-1),
+      num_walks_(1),
+      num_workers_(1),
+      alias_shards_(kNumAliasShards),
+      num_alias_entries_(0),
+      rnd_(GetSeed()) {}
 
 Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_list,
                                             const std::vector<NodeType> &meta_path, float step_home_param,
@@ -603,6 +795,10 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
     std::string err_msg = "Failed, num_workers parameter required to be greater than 0";
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
+  // The cached alias tables hold the transition probabilities of the previous parameters
+  if (step_home_param != step_home_param_ || step_away_param != step_away_param_) {
+    ClearAliasTables();
+  }
   step_home_param_ = step_home_param;
   step_away_param_ = step_away_param;
   default_node_ = default_node;
@@ -611,36 +807,38 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd,
+                                                   std::vector<NodeIdType> *walk_path) {
   // Simulate a random walk starting from start node.
   auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
   // walk simulate
   while (walk.size() - 1 < meta_path_.size()) {
-    // current nodE
+    // current node
     auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
 
-    // current neighbors
-    std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
-    std::sort(cur_neighbors.begin(), cur_neighbors.end());
+    // current neighbors, in the order of the csr which the alias tables follow
+    int64_t row = -1;
+    RETURN_IF_NOT_OK(graph_->GetNodeRow(cur_node_id, &row));
+    auto cur_neighbors = graph_->csr_.Neighbors(row, meta_path_[walk.size() - 1]);
+    int64_t num_neighbors = cur_neighbors.second - cur_neighbors.first;
 
     // break if no neighbors
-    if (cur_neighbors.empty()) {
+    if (num_neighbors == 0) {
       break;
     }
 
-    // walk by the fist node, then by the previous 2 nodes
-    std::shared_ptr<StochasticIndex> stochastic_index;
+    // walk by the fist node, all its neighbors are equally likely, then by the previous 2 nodes
+    int64_t next_index = 0;
     if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
+      std::uniform_int_distribution<int64_t> distribution(0, num_neighbors - 1);
+      next_index = distribution(*rnd);
     } else {
       NodeIdType prev_node_id = walk[walk.size() - 2];
+      std::shared_ptr<const StochasticIndex> stochastic_index;
       RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+      next_index = WalkToNextNode(*stochastic_index, rnd);
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
-    walk.push_back(next_node_id);
+    walk.push_back(cur_neighbors.first[next_index]);
   }
 
   while (walk.size() - 1 < meta_path_.size()) {
@@ -652,53 +850,65 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
 }
 
 Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
-  for (int32_t i = 0; i < num_walks_; ++i) {
-    for (const auto &node : node_list_) {
-      std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
-    }
-  }
+  RETURN_UNEXPECTED_IF_NULL(walks);
+  size_t num = static_cast<size_t>(num_walks_) * node_list_.size();
+  walks->assign(num, {});
+  // Every worker has its own generator seeded from rnd_, so a graph created with a given seed gives the same walks
+  // while the walks of the successive calls differ
+  size_t num_workers = std::min<size_t>(num_workers_, (num + kMinWalksPerWorker - 1) / kMinWalksPerWorker);
+  if (num_workers <= 1) {
+    return WalkRange(0, num, rnd_(), false, walks);
+  }
+  TaskGroup vg;
+  for (size_t i = 0; i < num_workers; ++i) {
+    RETURN_IF_NOT_OK(vg.CreateAsyncTask("RandomWalk", std::bind(&RandomWalkBase::WalkRange, this, num * i / num_workers,
+                                                                num * (i + 1) / num_workers, rnd_(), true, walks)));
+  }
+  vg.join_all(Task::WaitFlag::kBlocking);
+  RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                                                         std::shared_ptr<StochasticIndex> *node_probability) {
-  // Generate alias nodes
-  std::shared_ptr<Node> node;
-  graph_->GetNodeByNodeId(node_id, &node);
-  std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
-  std::sort(neighbors.begin(), neighbors.end());
-  auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
-  *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+Status GraphDataImpl::RandomWalkBase::WalkRange(size_t begin, size_t end, uint32_t seed, bool is_task,
+                                                std::vector<std::vector<NodeIdType>> *walks) {
+  if (is_task) {
+    TaskManager::FindMe()->Post();
+  }
+  std::mt19937 rnd(seed);
+  for (size_t i = begin; i < end; ++i) {
+    RETURN_IF_NOT_OK(Node2vecWalk(node_list_[i % node_list_.size()], &rnd, &(*walks)[i]));
+  }
   return Status::OK();
 }
 
 Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
                                                          uint32_t meta_path_index,
-                                                         std::shared_ptr<StochasticIndex> *edge_probability) {
+                                                         std::shared_ptr<const StochasticIndex> *edge_probability) {
+  EdgeKey key{src, dst, meta_path_[meta_path_index], meta_path_[meta_path_index + 1]};
+  AliasShard &shard = alias_shards_[EdgeKeyHash()(key) % alias_shards_.size()];
+  {
+    std::unique_lock<std::mutex> lock(shard.mux);
+    auto itr = shard.tables.find(key);
+    if (itr != shard.tables.end()) {
+      *edge_probability = itr->second;
+      return Status::OK();
+    }
+  }
+
   // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  graph_->GetNodeByNodeId(src, &src_node);
   std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
-
-  std::shared_ptr<Node> dst_node;
-  graph_->GetNodeByNodeId(dst, &dst_node);
-  std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighbors(src, key.src_type, &src_neighbors));
+  std::sort(src_neighbors.begin(), src_neighbors.end());
 
-  std::sort(dst_neighbors.begin(), dst_neighbors.end());
+  int64_t dst_row = -1;
+  RETURN_IF_NOT_OK(graph_->GetNodeRow(dst, &dst_row));
+  auto dst_neighbors = graph_->csr_.Neighbors(dst_row, key.dst_type);
   std::vector<float> non_normalized_probability;
-  for (const auto &dst_nbr : dst_neighbors) {
-    if (dst_nbr == src) {
+  non_normalized_probability.reserve(dst_neighbors.second - dst_neighbors.first);
+  for (const NodeIdType *dst_nbr = dst_neighbors.first; dst_nbr != dst_neighbors.second; ++dst_nbr) {
+    if (*dst_nbr == src) {
       non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
-      continue;
-    }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
+    } else if (std::binary_search(src_neighbors.begin(), src_neighbors.end(), *dst_nbr)) {
       // stay close, this node connect both src and dst
       non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
     } else {
@@ -706,25 +916,37 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
       non_normalized_probability.push_back(1.0 / step_away_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
     }
   }
+  auto table =
+    std::make_shared<const StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
 
-  *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+  // Past the budget the tables are still built for the walk, but no longer kept
+  int64_t size = static_cast<int64_t>(non_normalized_probability.size());
+  if (num_alias_entries_ + size <= kMaxAliasCacheEntries) {
+    std::unique_lock<std::mutex> lock(shard.mux);
+    if (shard.tables.emplace(key, table).second) {
+      num_alias_entries_ += size;
+    }
+  }
+  *edge_probability = std::move(table);
   return Status::OK();
 }
 
+void GraphDataImpl::RandomWalkBase::ClearAliasTables() {
+  for (auto &shard : alias_shards_) {
+    std::unique_lock<std::mutex> lock(shard.mux);
+    shard.tables.clear();
+  }
+  num_alias_entries_ = 0;
+}
+
 StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
   uint32_t K = probability.size();
   std::vector<int32_t> switch_to_large_index(K, 0);
   std::vector<float> weight(K, .0);
   std::vector<int32_t> smaller;
   std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
-  float accumulate_threshold = 0.0;
   for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
-    accumulate_threshold += threshold_one;
-    weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
+    weight[i] = probability[i] * K;
     weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
   }
 
@@ -737,21 +959,27 @@ StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::ve
     weight[large] = weight[large] + weight[small] - 1.0;
     weight[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
   }
+  // What is left is 1 up to the rounding errors, it never switches
+  for (int32_t i : smaller) {
+    weight[i] = 1.0;
+  }
+  for (int32_t i : larger) {
+    weight[i] = 1.0;
+  }
   return StochasticIndex(switch_to_large_index, weight);
 }
 
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
+uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rnd) {
+  const auto &switch_to_large_index = stochastic_index.first;
+  const auto &weight = stochastic_index.second;
   const uint32_t size_of_index = switch_to_large_index.size();
 
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(0.0, 1.0);
-
   // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
+  std::uniform_int_distribution<uint32_t> index_distribution(0, size_of_index - 1);
+  std::uniform_real_distribution<float> distribution(0.0, 1.0);
+  uint32_t random_idx = index_distribution(*rnd);
 
-  if (distribution(random_device) < weight[random_idx]) {
+  if (distribution(*rnd) < weight[random_idx]) {
     return random_idx;
   }
   return switch_to_large_index[random_idx];
@@ -759,8 +987,7 @@ uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &st
 
 template <typename T>
 std::vector<float> GraphDataImpl::RandomWalkBase::Normalize(const std::vector<T> &non_normalized_probability) {
-  float sum_probability =
-    1.0 * std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0);
+  float sum_probability = std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0.0f);
   if (sum_probability < kGnnEpsilon) {
     sum_probability = 1.0;
   }
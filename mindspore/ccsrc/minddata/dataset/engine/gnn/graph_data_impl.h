@@ -17,14 +17,18 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_DATA_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <map>
+#include <mutex>
+#include <random>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/graph_csr.h"
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
@@ -37,8 +41,14 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
+const char kGraphCsrSuffix[] = ".csr";
+const int32_t kNumAliasShards = 64;
+const int64_t kMaxAliasCacheEntries = 1 << 24;  // number of neighbors over all the cached alias tables
+const int64_t kMinWalksPerWorker = 64;
 using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
 
+class GraphLoader;
+
 class GraphDataImpl : public GraphData {
  public:
   // Constructor
@@ -154,6 +164,15 @@ class GraphDataImpl : public GraphData {
 
   std::string GetDataSchema() { return data_schema_.dump(); }
 
+  // Write the adjacency and the node feature columns of the graph to a file. The file named dataset_file + ".csr"
+  // is mapped by Init instead of building them again, as long as the dataset is not changed.
+  // @param std::string csr_file - path of the file
+  // @return Status The status code returned
+  Status SaveCsr(const std::string &csr_file) const;
+
+  // @return whether the csr is mapped from the preprocessed file rather than built from the dataset
+  bool IsCsrLoaded() const { return csr_.loaded(); }
+
 #if !defined(_WIN32) && !defined(_WIN64)
   key_t GetSharedMemoryKey() { return graph_shared_memory_->memory_key(); }
 
@@ -172,20 +191,55 @@ class GraphDataImpl : public GraphData {
 
     ~RandomWalkBase() = default;
 
+    // Simulate the walks, they are split into contiguous ranges among num_workers threads
+    // @param std::vector<std::vector<NodeIdType>> *walks - Returned walks, num_walks rounds over node_list
+    // @return Status The status code returned
     Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
-
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                              std::shared_ptr<StochasticIndex> *node_probability);
-
+    // The edge a walk has come along, the alias table of the next step only depends on it and on the meta path
+    struct EdgeKey {
+      NodeIdType src;
+      NodeIdType dst;
+      NodeType src_type;
+      NodeType dst_type;
+
+      bool operator==(const EdgeKey &other) const {
+        return src == other.src && dst == other.dst && src_type == other.src_type && dst_type == other.dst_type;
+      }
+    };
+
+    struct EdgeKeyHash {
+      size_t operator()(const EdgeKey &key) const {
+        uint64_t ids = (static_cast<uint64_t>(static_cast<uint32_t>(key.src)) << 32) | static_cast<uint32_t>(key.dst);
+        uint64_t types = (static_cast<uint64_t>(static_cast<uint16_t>(key.src_type)) << 16) |
+                         static_cast<uint16_t>(key.dst_type);
+        return std::hash<uint64_t>()(ids ^ (types * 0x9E3779B97F4A7C15ULL));
+      }
+    };
+
+    // The alias tables are built on first use and shared by the walks and the worker threads
+    struct AliasShard {
+      std::mutex mux;
+      std::unordered_map<EdgeKey, std::shared_ptr<const StochasticIndex>, EdgeKeyHash> tables;
+    };
+
+    // Simulate the walks [begin, end) of SimulateWalk
+    Status WalkRange(size_t begin, size_t end, uint32_t seed, bool is_task,
+                     std::vector<std::vector<NodeIdType>> *walks);
+
+    Status Node2vecWalk(const NodeIdType &start_node, std::mt19937 *rnd, std::vector<NodeIdType> *walk_path);
+
+    // Get the alias table of the step after the edge src -> dst, the table follows the order of the neighbors of dst
+    // in the csr
     Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
+                              std::shared_ptr<const StochasticIndex> *edge_probability);
+
+    void ClearAliasTables();
 
     static StochasticIndex GenerateProbability(const std::vector<float> &probability);
 
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
+    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rnd);
 
     template <typename T>
     std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
@@ -199,6 +253,10 @@ class GraphDataImpl : public GraphData {
 
     int32_t num_walks_;    // Number of walks per source. Default is 1
     int32_t num_workers_;  // The number of worker threads. Default is 1
+
+    std::vector<AliasShard> alias_shards_;
+    std::atomic<int64_t> num_alias_entries_;
+    std::mt19937 rnd_;  // seeded once, draws the seeds of the workers of every SimulateWalk
   };
 
   // Load graph data from mindrecord file
@@ -213,14 +271,6 @@ class GraphDataImpl : public GraphData {
   template <typename T>
   Status CreateTensorByVector(const std::vector<std::vector<T>> &data, DataType type, std::shared_ptr<Tensor> *out);
 
-  // Complete vector
-  // @param std::vector<std::vector<T>> *data - To be completed vector
-  // @param size_t max_size - The size of the completed vector
-  // @param T default_value - Filled default
-  // @return Status The status code returned
-  template <typename T>
-  Status ComplementVector(std::vector<std::vector<T>> *data, size_t max_size, T default_value);
-
   // Get the default feature of a node
   // @param FeatureType feature_type -
   // @param std::shared_ptr<Feature> *out_feature - Returned feature
@@ -233,6 +283,59 @@ class GraphDataImpl : public GraphData {
   // @return Status The status code returned
   Status GetEdgeDefaultFeature(FeatureType feature_type, std::shared_ptr<Feature> *out_feature);
 
+  // Map the preprocessed csr file of the dataset if it is made from the same version of the dataset files
+  // @param GraphLoader &loader - the loader which has opened the dataset files
+  // @param std::string &csr_file - path of the csr file
+  // @return Status The status code returned
+  Status MapCsr(const GraphLoader &loader, const std::string &csr_file);
+
+  // Check the mapped csr file matches the loaded graph
+  // @return Status The status code returned
+  Status CheckCsr() const;
+
+  // Drop the loaded nodes and edges, before they are loaded again
+  void ClearGraph();
+
+  // The shuffled indices of SampleNeighbors, all of them for a few neighbors, else only the displaced ones, and the
+  // generator of the call
+  struct SampleScratch {
+    std::vector<int64_t> indices;
+    std::unordered_map<int64_t, int64_t> displaced;
+    std::mt19937 rnd;
+  };
+
+  // A generator for one sampling call, seeded from the seed of the graph and the rank of the call, as the calls may
+  // come from several threads of the server
+  // @return std::mt19937 - the generator
+  std::mt19937 NewGenerator();
+
+  // Sample the neighbors of a node, a neighbor is taken again only once all of them are taken
+  // @param const NodeIdType *first - the first neighbor
+  // @param const NodeIdType *last - past the last neighbor
+  // @param int32_t samples_num - Number of neighbors to be sampled
+  // @param NodeIdType *out - Returned sampled neighbors, filled with kDefaultNodeId if there are no neighbors
+  // @param SampleScratch *scratch - scratch buffers reused between the calls
+  void SampleNeighbors(const NodeIdType *first, const NodeIdType *last, int32_t samples_num, NodeIdType *out,
+                       SampleScratch *scratch);
+
+  // Find the row of a node in the csr
+  // @param NodeIdType id -
+  // @param int64_t *row - Returned row
+  // @return Status The status code returned
+  Status GetNodeRow(NodeIdType id, int64_t *row) const;
+
+  // Find the column of a node feature, nullptr if the feature is kept by the nodes
+  // @param FeatureType feature_type -
+  // @return const GraphCsr::Column * - the column
+  const GraphCsr::Column *GetFeatureColumn(FeatureType feature_type) const;
+
+  // Get the neighbors of a node, the node itself is not included
+  // @param NodeIdType id -
+  // @param NodeType neighbor_type -
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
+  // @return Status The status code returned
+  Status GetNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors) const;
+
   // Find node object using node id
   // @param NodeIdType id -
   // @param std::shared_ptr<Node> *node - Returned node object
@@ -261,7 +364,8 @@ class GraphDataImpl : public GraphData {
 
   std::string dataset_file_;
   int32_t num_workers_;  // The number of worker threads
-  std::mt19937 rnd_;
+  uint32_t seed_;
+  std::atomic<uint32_t> sample_calls_;  // the number of sampling calls, which seeds their generators
   RandomWalkBase random_walk_;
   mindrecord::json data_schema_;
   bool server_mode_;
@@ -270,6 +374,7 @@ class GraphDataImpl : public GraphData {
 #endif
   std::unordered_map<NodeType, std::vector<NodeIdType>> node_type_map_;
   std::unordered_map<NodeIdType, std::shared_ptr<Node>> node_id_map_;
+  GraphCsr csr_;  // the neighbors of the nodes, and the node features if they fit in columns
 
   std::unordered_map<EdgeType, std::vector<EdgeIdType>> edge_type_map_;
   std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> edge_id_map_;
@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 
+#include <sys/stat.h>
 #include <future>
 #include <tuple>
 #include <utility>
@@ -36,6 +37,7 @@ GraphLoader::GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int
     : graph_impl_(graph_impl),
       mr_path_(mr_filepath),
       num_workers_(num_workers),
+      csr_mapped_(false),
       row_id_(0),
       shard_reader_(nullptr),
       graph_feature_parser_(nullptr),
@@ -62,7 +64,9 @@ Status GraphLoader::GetNodesAndEdges() {
       CHECK_FAIL_RETURN_UNEXPECTED(src_itr != n_id_map->end(), "invalid src_id:" + std::to_string(src_itr->first));
       CHECK_FAIL_RETURN_UNEXPECTED(dst_itr != n_id_map->end(), "invalid src_id:" + std::to_string(dst_itr->first));
       RETURN_IF_NOT_OK(edge_ptr->SetNode({src_itr->second, dst_itr->second}));
-      RETURN_IF_NOT_OK(src_itr->second->AddNeighbor(dst_itr->second));
+      if (!csr_mapped_) {
+        adjacency_.emplace_back(src_itr->first, dst_itr->first);
+      }
       e_id_map->insert({edge_ptr->id(), edge_ptr});  // add edge to edge_id_map_
       graph_impl_->edge_type_map_[edge_ptr->type()].push_back(edge_ptr->id());
       dq.pop_front();
@@ -76,17 +80,47 @@ Status GraphLoader::GetNodesAndEdges() {
   return Status::OK();
 }
 
-Status GraphLoader::InitAndLoad() {
-  CHECK_FAIL_RETURN_UNEXPECTED(num_workers_ > 0, "num_reader can't be < 1\n");
-  CHECK_FAIL_RETURN_UNEXPECTED(row_id_ == 0, "InitAndLoad Can only be called once!\n");
-  n_deques_.resize(num_workers_);
-  e_deques_.resize(num_workers_);
-  n_feature_maps_.resize(num_workers_);
-  e_feature_maps_.resize(num_workers_);
-  default_node_feature_maps_.resize(num_workers_);
-  default_edge_feature_maps_.resize(num_workers_);
-  TaskGroup vg;
+Status GraphLoader::BuildCsr(GraphCsr *csr) {
+  // In server mode the values of the node features are offsets in the shared memory, they are not put in columns
+  DefaultNodeFeatureMap no_columns;
+  uint64_t fingerprint = 0;
+  RETURN_IF_NOT_OK(GetSourceFingerprint(&fingerprint));
+  RETURN_IF_NOT_OK(csr->Build(graph_impl_->node_id_map_, adjacency_,
+                              graph_impl_->server_mode_ ? no_columns : graph_impl_->default_node_feature_map_,
+                              fingerprint));
+  adjacency_.clear();
+  adjacency_.shrink_to_fit();
+  return Status::OK();
+}
+
+Status GraphLoader::GetSourceFingerprint(uint64_t *fingerprint) const {
+  RETURN_UNEXPECTED_IF_NULL(fingerprint);
+  CHECK_FAIL_RETURN_UNEXPECTED(shard_reader_ != nullptr, "The mindrecord files are not opened.");
+  // FNV-1a over the names, sizes and modification times, the directory may move without changing the fingerprint
+  const uint64_t kFnvPrime = 1099511628211ULL;
+  uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash, kFnvPrime](const void *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ static_cast<const uint8_t *>(data)[i]) * kFnvPrime;
+    }
+  };
+  for (const auto &file : shard_reader_->GetFilePaths()) {
+    struct stat file_stat;
+    CHECK_FAIL_RETURN_UNEXPECTED(stat(file.c_str(), &file_stat) == 0, "Failed to stat mindrecord file: " + file);
+    std::string name = file.substr(file.find_last_of("/\\") + 1);
+    auto size = static_cast<int64_t>(file_stat.st_size);
+    auto mtime = static_cast<int64_t>(file_stat.st_mtime);
+    mix(name.data(), name.size());
+    mix(&size, sizeof(size));
+    mix(&mtime, sizeof(mtime));
+  }
+  *fingerprint = hash;
+  return Status::OK();
+}
 
+Status GraphLoader::Init() {
+  CHECK_FAIL_RETURN_UNEXPECTED(num_workers_ > 0, "num_reader can't be < 1\n");
+  CHECK_FAIL_RETURN_UNEXPECTED(shard_reader_ == nullptr, "Init Can only be called once!\n");
   shard_reader_ = std::make_unique<ShardReader>();
   CHECK_FAIL_RETURN_UNEXPECTED(shard_reader_->Open({mr_path_}, true, num_workers_) == MSRStatus::SUCCESS,
                                "Fail to open" + mr_path_);
@@ -112,6 +146,20 @@ Status GraphLoader::InitAndLoad() {
   }
 
   graph_feature_parser_ = std::make_unique<GraphFeatureParser>(*shard_reader_->GetShardColumn());
+  return Status::OK();
+}
+
+Status GraphLoader::Load(bool csr_mapped) {
+  CHECK_FAIL_RETURN_UNEXPECTED(shard_reader_ != nullptr, "The mindrecord files are not opened.");
+  CHECK_FAIL_RETURN_UNEXPECTED(row_id_ == 0, "Load Can only be called once!\n");
+  csr_mapped_ = csr_mapped;
+  n_deques_.resize(num_workers_);
+  e_deques_.resize(num_workers_);
+  n_feature_maps_.resize(num_workers_);
+  e_feature_maps_.resize(num_workers_);
+  default_node_feature_maps_.resize(num_workers_);
+  default_edge_feature_maps_.resize(num_workers_);
+  TaskGroup vg;
 
   // launching worker threads
   for (int wkr_id = 0; wkr_id < num_workers_; ++wkr_id) {
@@ -152,6 +200,18 @@ Status GraphLoader::LoadNode(const std::vector<uint8_t> &col_blob, const mindrec
 #endif
   } else {
     for (int32_t ind : indices) {
+      // The values of a feature in a column of the mapped csr are read from there, only the default value is made
+      const GraphCsr::Column *column = csr_mapped_ ? graph_impl_->csr_.FindColumn(ind) : nullptr;
+      if (column != nullptr) {
+        (*feature_map)[node_type].insert(ind);
+        if ((*default_feature)[ind] == nullptr) {
+          std::shared_ptr<Tensor> zero_tensor;
+          RETURN_IF_NOT_OK(Tensor::CreateEmpty(column->shape, column->data_type, &zero_tensor));
+          RETURN_IF_NOT_OK(zero_tensor->Zero());
+          (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
+        }
+        continue;
+      }
       std::shared_ptr<Tensor> tensor;
       RETURN_IF_NOT_OK(
         graph_feature_parser_->LoadFeatureTensor("node_feature_" + std::to_string(ind), col_blob, &tensor));
@@ -28,6 +28,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/gnn/edge.h"
 #include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/graph_csr.h"
 #include "minddata/dataset/engine/gnn/graph_feature_parser.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
@@ -59,9 +60,15 @@ class GraphLoader {
   GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int32_t num_workers = 4, bool server_mode = false);
 
   ~GraphLoader() = default;
-  // Init mindrecord and load everything into memory multi-threaded
+  // Init mindrecord, the files are opened but nothing is read yet
   // @return Status - the status code
-  Status InitAndLoad();
+  Status Init();
+
+  // Load everything into memory multi-threaded, but the adjacency and the node features which the csr of the graph
+  // keeps in columns if the csr is mapped from the csr file
+  // @param bool csr_mapped - whether the csr of the graph is mapped from the csr file
+  // @return Status - the status code
+  Status Load(bool csr_mapped);
 
   // this function will query mindrecord and construct all nodes and edges
   // nodes and edges are added to map without any connection. That's because there nodes and edges are read in
@@ -69,6 +76,16 @@ class GraphLoader {
   // features attached to each node and edge are expected to be filled correctly
   Status GetNodesAndEdges();
 
+  // Build the adjacency of the graph from the edges, and the columns of the node features
+  // @param GraphCsr *csr - return value
+  // @return Status - the status code
+  Status BuildCsr(GraphCsr *csr);
+
+  // Identify the version of the mindrecord files by their names, sizes and modification times
+  // @param uint64_t *fingerprint - return value
+  // @return Status - the status code
+  Status GetSourceFingerprint(uint64_t *fingerprint) const;
+
  private:
   //
   // worker thread that reads mindrecord file
@@ -101,6 +118,7 @@ class GraphLoader {
   GraphDataImpl *graph_impl_;
   std::string mr_path_;
   const int32_t num_workers_;
+  bool csr_mapped_;
   std::atomic_int row_id_;
   std::unique_ptr<ShardReader> shard_reader_;
   std::unique_ptr<GraphFeatureParser> graph_feature_parser_;
@@ -110,6 +128,7 @@ class GraphLoader {
   std::vector<EdgeFeatureMap> e_feature_maps_;
   std::vector<DefaultNodeFeatureMap> default_node_feature_maps_;
   std::vector<DefaultEdgeFeatureMap> default_edge_feature_maps_;
+  std::vector<std::pair<NodeIdType, NodeIdType>> adjacency_;  // source and destination of the edges in load order
   const std::vector<std::string> keys_;
 };
 }  // namespace gnn
@@ -52,31 +52,15 @@ class Node {
   // @return Status The status code returned
   virtual Status GetFeatures(FeatureType feature_type, std::shared_ptr<Feature> *out_feature) = 0;
 
-  // Get the all neighbors of a node
-  // @param NodeType neighbor_type - type of neighbor
-  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
-  // @return Status The status code returned
-  virtual Status GetAllNeighbors(NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
-                                 bool exclude_itself = false) = 0;
-
-  // Get the sampled neighbors of a node
-  // @param NodeType neighbor_type - type of neighbor
-  // @param int32_t samples_num - Number of neighbors to be acquired
-  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
-  // @return Status The status code returned
-  virtual Status GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num,
-                                     std::vector<NodeIdType> *out_neighbors) = 0;
-
-  // Add neighbor of node
-  // @param std::shared_ptr<Node> node -
-  // @return Status The status code returned
-  virtual Status AddNeighbor(const std::shared_ptr<Node> &node) = 0;
-
   // Update feature of node
   // @param std::shared_ptr<Feature> feature -
   // @return Status The status code returned
   virtual Status UpdateFeature(const std::shared_ptr<Feature> &feature) = 0;
 
+  // Drop all the features of node, e.g. once the graph keeps them in columns
+  // @return Status The status code returned
+  virtual Status ClearFeatures() = 0;
+
  protected:
   NodeIdType id_;
   NodeType type_;
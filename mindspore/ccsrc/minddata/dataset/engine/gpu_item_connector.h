@@ -55,7 +55,7 @@ class GpuItemConnector : public Connector<std::vector<device::DataItemGpu>> {
         RETURN_STATUS_UNEXPECTED(errMsg);
       }
 
-      RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+      RETURN_IF_NOT_OK(PopFrom(pop_from_, result));
       if ((*result).empty()) {
         is_queue_finished_[pop_from_] = true;
       }
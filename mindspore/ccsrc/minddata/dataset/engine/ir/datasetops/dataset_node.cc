@@ -68,6 +68,17 @@ Status AddShuffleOp(int64_t num_files, int64_t num_devices, int64_t num_rows, in
   return Status::OK();
 }
 
+// Helper function to add the shuffle op above a source which already reads its row blocks in a random order
+Status AddBlockShuffleOp(int32_t num_workers, int64_t block_rows, int32_t connector_que_size, int32_t rows_per_buffer,
+                         std::shared_ptr<DatasetOp> *shuffle_op) {
+  // The buffer only has to mix the blocks the workers read at the same time, a few of them per worker is enough
+  const int64_t blocks_per_worker = 4;
+  int64_t shuffle_size = block_rows * blocks_per_worker * std::max(num_workers, 1);
+  MS_LOG(INFO) << "Dataset::AddBlockShuffleOp - shuffle_size: " << shuffle_size;
+  *shuffle_op = std::make_shared<ShuffleOp>(shuffle_size, GetSeed(), connector_que_size, true, rows_per_buffer);
+  return Status::OK();
+}
+
 // Helper function to validate dataset directory parameter
 Status ValidateDatasetDirParam(const std::string &dataset_name, std::string dataset_dir) {
   if (dataset_dir.empty()) {
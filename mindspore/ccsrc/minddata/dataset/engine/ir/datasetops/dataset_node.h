@@ -89,6 +89,10 @@ constexpr char kVOCNode[] = "VOCDataset";
 Status AddShuffleOp(int64_t num_files, int64_t num_devices, int64_t num_rows, int64_t total_rows,
                     int32_t connector_que_size, int32_t rows_per_buffer, std::shared_ptr<DatasetOp> *shuffle_op);
 
+// Helper function to add the shuffle op above a source which already reads its row blocks in a random order
+Status AddBlockShuffleOp(int32_t num_workers, int64_t block_rows, int32_t connector_que_size, int32_t rows_per_buffer,
+                         std::shared_ptr<DatasetOp> *shuffle_op);
+
 // Helper function to validate dataset files parameter
 Status ValidateDatasetFilesParam(const std::string &dataset_name, const std::vector<std::string> &dataset_files);
 
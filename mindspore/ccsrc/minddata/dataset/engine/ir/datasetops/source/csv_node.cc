@@ -119,24 +119,22 @@ Status CSVNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
     }
   }
 
-  std::shared_ptr<CsvOp> csv_op =
-    std::make_shared<CsvOp>(sorted_dataset_files, field_delim_, column_default_list, column_names_, num_workers_,
-                            rows_per_buffer_, num_samples_, worker_connector_size_, connector_que_size_, shuffle_files,
-                            num_shards_, shard_id_, std::move(sampler_->SamplerBuild()));
+  bool shuffle_blocks = cache_ == nullptr && shuffle_ == ShuffleMode::kGlobal && !IsDescendantOfCache();
+
+  std::shared_ptr<CsvOp> csv_op = std::make_shared<CsvOp>(
+    sorted_dataset_files, field_delim_, column_default_list, column_names_, num_workers_, rows_per_buffer_,
+    num_samples_, worker_connector_size_, connector_que_size_, shuffle_files, shuffle_blocks, kShuffleBlockRows,
+    num_shards_, shard_id_, std::move(sampler_->SamplerBuild()));
 
   RETURN_IF_NOT_OK(csv_op->Init());
 
-  if (cache_ == nullptr && shuffle_ == ShuffleMode::kGlobal && !IsDescendantOfCache()) {
+  if (shuffle_blocks) {
     // Inject ShuffleOp
     std::shared_ptr<DatasetOp> shuffle_op = nullptr;
-    int64_t num_rows = 0;
-
-    // First, get the number of rows in the dataset
-    RETURN_IF_NOT_OK(CsvOp::CountAllFileRows(sorted_dataset_files, column_names_.empty(), &num_rows));
 
     // Add the shuffle op after this op
-    RETURN_IF_NOT_OK(AddShuffleOp(sorted_dataset_files.size(), num_shards_, num_rows, 0, connector_que_size_,
-                                  rows_per_buffer_, &shuffle_op));
+    RETURN_IF_NOT_OK(
+      AddBlockShuffleOp(num_workers_, kShuffleBlockRows, connector_que_size_, rows_per_buffer_, &shuffle_op));
 
     node_ops->push_back(shuffle_op);
   }
@@ -87,23 +87,22 @@ Status TextFileNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_o
   auto schema = std::make_unique<DataSchema>();
   RETURN_IF_NOT_OK(schema->AddColumn(ColDescriptor("text", DataType(DataType::DE_UINT8), TensorImpl::kFlexible, 1)));
 
+  bool shuffle_blocks = cache_ == nullptr && shuffle_ == ShuffleMode::kGlobal && !IsDescendantOfCache();
+
   // Create and initalize TextFileOp
   std::shared_ptr<TextFileOp> text_file_op = std::make_shared<TextFileOp>(
     num_workers_, rows_per_buffer_, num_samples_, worker_connector_size_, std::move(schema), sorted_dataset_files,
-    connector_que_size_, shuffle_files, num_shards_, shard_id_, std::move(sampler_->SamplerBuild()));
+    connector_que_size_, shuffle_files, shuffle_blocks, kShuffleBlockRows, num_shards_, shard_id_,
+    std::move(sampler_->SamplerBuild()));
   RETURN_IF_NOT_OK(text_file_op->Init());
 
-  if (cache_ == nullptr && shuffle_ == ShuffleMode::kGlobal && !IsDescendantOfCache()) {
+  if (shuffle_blocks) {
     // Inject ShuffleOp
     std::shared_ptr<DatasetOp> shuffle_op = nullptr;
-    int64_t num_rows = 0;
-
-    // First, get the number of rows in the dataset
-    RETURN_IF_NOT_OK(TextFileOp::CountAllFileRows(sorted_dataset_files, &num_rows));
 
     // Add the shuffle op after this op
-    RETURN_IF_NOT_OK(AddShuffleOp(sorted_dataset_files.size(), num_shards_, num_rows, 0, connector_que_size_,
-                                  rows_per_buffer_, &shuffle_op));
+    RETURN_IF_NOT_OK(
+      AddBlockShuffleOp(num_workers_, kShuffleBlockRows, connector_que_size_, rows_per_buffer_, &shuffle_op));
     node_ops->push_back(shuffle_op);
   }
   RETURN_IF_NOT_OK(AddCacheOp(node_ops));
@@ -127,26 +127,24 @@ Status TFRecordNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_o
   // That is why we save the sampler here in a leaf node that does not use sampling.
   std::shared_ptr<SamplerObj> sampler_ = SelectSampler(num_samples_, shuffle_files, num_shards_, shard_id_);
 
+  bool shuffle_blocks = cache_ == nullptr && shuffle_ == ShuffleMode::kGlobal && !IsDescendantOfCache();
+
   // Create and initialize TFReaderOp
-  std::shared_ptr<TFReaderOp> tf_reader_op =
-    std::make_shared<TFReaderOp>(num_workers_, worker_connector_size_, rows_per_buffer_, num_samples_, sorted_dir_files,
-                                 std::move(data_schema), connector_que_size_, columns_list_, shuffle_files, num_shards_,
-                                 shard_id_, shard_equal_rows_, std::move(sampler_->SamplerBuild()));
+  std::shared_ptr<TFReaderOp> tf_reader_op = std::make_shared<TFReaderOp>(
+    num_workers_, worker_connector_size_, rows_per_buffer_, num_samples_, sorted_dir_files, std::move(data_schema),
+    connector_que_size_, columns_list_, shuffle_files, shuffle_blocks, kShuffleBlockRows, num_shards_, shard_id_,
+    shard_equal_rows_, std::move(sampler_->SamplerBuild()));
 
   RETURN_IF_NOT_OK(tf_reader_op->Init());
 
-  if (cache_ == nullptr && shuffle_ == ShuffleMode::kGlobal && !IsDescendantOfCache()) {
+  if (shuffle_blocks) {
     // Inject ShuffleOp
 
     std::shared_ptr<DatasetOp> shuffle_op = nullptr;
-    int64_t num_rows = 0;
-
-    // First, get the number of rows in the dataset
-    RETURN_IF_NOT_OK(TFReaderOp::CountTotalRows(&num_rows, sorted_dir_files));
 
     // Add the shuffle op after this op
-    RETURN_IF_NOT_OK(AddShuffleOp(sorted_dir_files.size(), num_shards_, num_rows, 0, connector_que_size_,
-                                  rows_per_buffer_, &shuffle_op));
+    RETURN_IF_NOT_OK(
+      AddBlockShuffleOp(num_workers_, kShuffleBlockRows, connector_que_size_, rows_per_buffer_, &shuffle_op));
     node_ops->push_back(shuffle_op);
   }
   RETURN_IF_NOT_OK(AddCacheOp(node_ops));
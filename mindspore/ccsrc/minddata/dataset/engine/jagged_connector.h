@@ -52,7 +52,7 @@ class JaggedConnector : public Connector<std::unique_ptr<DataBuffer>> {
         RETURN_STATUS_UNEXPECTED(errMsg);
       }
 
-      RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+      RETURN_IF_NOT_OK(PopFrom(pop_from_, result));
       if ((*result)->eoe()) {
         is_queue_finished_[pop_from_] = true;
       }
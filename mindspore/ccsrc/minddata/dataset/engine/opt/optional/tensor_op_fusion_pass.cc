@@ -23,19 +23,87 @@
 #include "minddata/dataset/include/transforms.h"
 #include "minddata/dataset/include/vision.h"
 #include "minddata/dataset/include/vision_lite.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+using TensorOperationList = std::vector<std::shared_ptr<TensorOperation>>;
+
+// Find the chain of Decode, RandomResizedCrop, RandomHorizontalFlip, Normalize and HwcToChw, the flip is optional.
+// @param ops The tensor operations of the map node
+// @param names The names of the five ops in this order
+// @param[out] length The number of ops in the chain which is found
+// @return The position of Decode, or ops->end() if there is no such chain
+TensorOperationList::iterator FindNormalizeChain(TensorOperationList *ops, std::vector<std::string> names,
+                                                 size_t *length) {
+  auto match = [](const std::shared_ptr<TensorOperation> &op, const std::string &nm) { return op->Name() == nm; };
+  auto itr = std::search(ops->begin(), ops->end(), names.begin(), names.end(), match);
+  if (itr == ops->end()) {
+    names.erase(names.begin() + 2);
+    itr = std::search(ops->begin(), ops->end(), names.begin(), names.end(), match);
+  }
+  *length = names.size();
+  return itr;
+}
+
+// Whether an op casts to float16, the fused op writes its planes in float16 directly when the chain is followed by it.
+bool IsFloat16Cast(const std::shared_ptr<TensorOperation> &op) {
+  if (op->Name() == kTypeCastOperation) {
+    auto *cast_op = dynamic_cast<transforms::TypeCastOperation *>(op.get());
+    return cast_op != nullptr && cast_op->data_type() == "float16";
+  }
+  if (op->Name() == kTypeCastOp) {
+    std::vector<DataType> outputs;
+    return op->Build()->OutputType({DataType(DataType::DE_FLOAT32)}, outputs).IsOk() && outputs.size() == 1 &&
+           outputs[0] == DataType(DataType::DE_FLOAT16);
+  }
+  return false;
+}
+}  // namespace
 
 Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
+  size_t length = 0;
 
   // start temporary code, to deal with pre-built TensorOperation
+  auto itr = FindNormalizeChain(
+    &ops, {kDecodeOp, kRandomCropAndResizeOp, kRandomHorizontalFlipOp, kNormalizeOp, kHwcToChwOp}, &length);
+  if (itr != ops.end()) {
+    MS_LOG(INFO) << "Fusing pre-build Decode, RandomCropResize, Normalize and HwcToChw into one pre-build.";
+    auto crop_op = std::dynamic_pointer_cast<RandomCropAndResizeOp>((*(itr + 1))->Build());
+    auto normalize_op = std::dynamic_pointer_cast<NormalizeOp>((*(itr + length - 2))->Build());
+    RETURN_UNEXPECTED_IF_NULL(crop_op);
+    RETURN_UNEXPECTED_IF_NULL(normalize_op);
+    float flip_probability = 0.0;
+    if (length == 5) {
+      auto flip_op = std::dynamic_pointer_cast<RandomHorizontalFlipOp>((*(itr + 2))->Build());
+      RETURN_UNEXPECTED_IF_NULL(flip_op);
+      flip_probability = flip_op->probability();
+    }
+    std::vector<float> mean;
+    std::vector<float> std;
+    RETURN_IF_NOT_OK(normalize_op->GetMeanStd(&mean, &std));
+    std::string dtype = "float32";
+    if (itr + length != ops.end() && IsFloat16Cast(*(itr + length))) {
+      dtype = "float16";
+      length++;
+    }
+    (*itr) = std::make_shared<transforms::PreBuiltOperation>(
+      std::make_shared<RandomCropDecodeResizeNormalizeOp>(*crop_op, mean, std, flip_probability, dtype));
+    ops.erase(itr + 1, itr + length);
+    node->setOperations(ops);
+    *modified = true;
+    return Status::OK();
+  }
+
   std::vector<std::string> pattern = {kDecodeOp, kRandomCropAndResizeOp};
-  auto itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
-                         [](auto op, const std::string &nm) { return op->Name() == nm; });
+  itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+                    [](auto op, const std::string &nm) { return op->Name() == nm; });
   if (itr != ops.end()) {
     MS_LOG(WARNING) << "Fusing pre-build Decode and RandomCropResize into one pre-build.";
     auto op = dynamic_cast<RandomCropAndResizeOp *>((*(itr + 1))->Build().get());
@@ -47,6 +115,35 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   }  // end of temporary code, needs to be deleted when tensorOperation's pybind completes
 
   // logic below is for non-prebuilt TensorOperation
+  itr = FindNormalizeChain(&ops,
+                           {vision::kDecodeOperation, vision::kRandomResizedCropOperation,
+                            vision::kRandomHorizontalFlipOperation, vision::kNormalizeOperation,
+                            vision::kHwcToChwOperation},
+                           &length);
+  if (itr != ops.end()) {
+    auto *crop_op = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
+    auto *normalize_op = dynamic_cast<vision::NormalizeOperation *>((itr + length - 2)->get());
+    RETURN_UNEXPECTED_IF_NULL(crop_op);
+    RETURN_UNEXPECTED_IF_NULL(normalize_op);
+    float flip_probability = 0.0;
+    if (length == 5) {
+      auto *flip_op = dynamic_cast<vision::RandomHorizontalFlipOperation *>((itr + 2)->get());
+      RETURN_UNEXPECTED_IF_NULL(flip_op);
+      flip_probability = flip_op->probability();
+    }
+    std::string dtype = "float32";
+    if (itr + length != ops.end() && IsFloat16Cast(*(itr + length))) {
+      dtype = "float16";
+      length++;
+    }
+    (*itr) = std::make_shared<vision::RandomCropDecodeResizeNormalizeOperation>(
+      *crop_op, normalize_op->mean(), normalize_op->std_dev(), flip_probability, dtype);
+    ops.erase(itr + 1, itr + length);
+    node->setOperations(ops);
+    *modified = true;
+    return Status::OK();
+  }
+
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
   itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op->Name() == nm; });
@@ -0,0 +1,172 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/engine/datasetops/dataset_op.h"
+#include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+double Usage(int32_t size, int32_t capacity) { return capacity > 0 ? static_cast<double>(size) / capacity : 0.0; }
+}  // namespace
+
+AutoTune::AutoTune(ExecutionTree *tree) : tree_(tree), feed_op_(nullptr), feed_sum_(0.0), num_samples_(0) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  interval_ = cfg->autotune_interval();
+  max_threads_ = cfg->num_cpu_threads();
+}
+
+Status AutoTune::operator()() {
+  // Register this thread with TaskManager to receive proper interrupt signal.
+  TaskManager::FindMe()->Post();
+
+  feed_op_ = tree_->root().get();
+  if (feed_op_->Name() == kDeviceQueueOp && !feed_op_->Children().empty()) {
+    feed_op_ = feed_op_->Children()[0].get();
+  }
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    DatasetOp &op = *itr;
+    // DeviceQueueOp is a special op, it is not inlined but its output queue is invalid.
+    if (op.inlined() || op.Name() == kDeviceQueueOp) {
+      continue;
+    }
+    OpUsage usage{&op, dynamic_cast<MapOp *>(&op), 0.0, 0.0, false, false, op.ConnectorQueueSize()};
+    usages_.push_back(usage);
+  }
+
+  int32_t stable_rounds = 0;
+  while (!this_thread::is_interrupted() && !(tree_->isFinished()) && stable_rounds < kStableRounds) {
+    Sample();
+    if (num_samples_ == kSamplesPerRound) {
+      bool changed = false;
+      if (feed_sum_ / num_samples_ < kHighUsage) {
+        // A tuning failure never fails the pipeline, it only stops the tuning.
+        Status rc = Tune(&changed);
+        if (rc.IsError()) {
+          MS_LOG(WARNING) << "AutoTune stopped: " << rc.ToString();
+          return Status::OK();
+        }
+      }
+      stable_rounds = changed ? 0 : stable_rounds + 1;
+      ResetRound();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_));
+  }
+
+  for (auto &usage : usages_) {
+    MS_LOG(INFO) << "AutoTune result of " << usage.op->NameWithID() << ": connector queue size "
+                 << usage.op->ConnectorQueueSize()
+                 << (usage.map_op != nullptr ? ", helper workers " + std::to_string(usage.map_op->NumHelperWorkers())
+                                             : "");
+  }
+  return Status::OK();
+}
+
+void AutoTune::Sample() {
+  for (auto &usage : usages_) {
+    int32_t size = usage.op->ConnectorSize();
+    int32_t capacity = usage.op->ConnectorCapacity();
+    usage.out_sum += Usage(size, capacity);
+    usage.out_empty = usage.out_empty || size == 0;
+    usage.out_full = usage.out_full || size >= capacity;
+    if (usage.map_op != nullptr) {
+      usage.in_sum += Usage(usage.op->ChildOpConnectorSize(), usage.op->ChildOpConnectorCapacity());
+    }
+  }
+  feed_sum_ += Usage(feed_op_->ConnectorSize(), feed_op_->ConnectorCapacity());
+  num_samples_++;
+}
+
+Status AutoTune::Tune(bool *changed) {
+  RETURN_IF_NOT_OK(TuneWorkers(changed));
+  RETURN_IF_NOT_OK(TuneConnectors(changed));
+  return Status::OK();
+}
+
+Status AutoTune::TuneWorkers(bool *changed) {
+  int32_t num_threads = 0;
+  for (auto &usage : usages_) {
+    num_threads += usage.op->num_workers();
+    if (usage.map_op != nullptr) {
+      num_threads += usage.map_op->NumHelperWorkers();
+    }
+  }
+  // Only the MapOp with the widest gap is changed in a round, the others see the effect in the next round.
+  OpUsage *target = nullptr;
+  double max_gap = 0.0;
+  for (auto &usage : usages_) {
+    if (usage.map_op == nullptr) {
+      continue;
+    }
+    double in_usage = usage.in_sum / num_samples_;
+    double out_usage = usage.out_sum / num_samples_;
+    bool add = in_usage >= kHighUsage && out_usage <= kLowUsage && num_threads < max_threads_;
+    bool remove = in_usage <= kLowUsage && out_usage >= kHighUsage && usage.map_op->NumHelperWorkers() > 0;
+    if ((add || remove) && std::abs(in_usage - out_usage) > max_gap) {
+      max_gap = std::abs(in_usage - out_usage);
+      target = &usage;
+    }
+  }
+  if (target != nullptr) {
+    int32_t num_helpers = target->map_op->NumHelperWorkers();
+    num_helpers += (target->in_sum > target->out_sum) ? 1 : -1;
+    RETURN_IF_NOT_OK(target->map_op->SetNumHelperWorkers(num_helpers));
+    *changed = true;
+  }
+  return Status::OK();
+}
+
+Status AutoTune::TuneConnectors(bool *changed) {
+  for (auto &usage : usages_) {
+    int32_t queue_size = usage.op->ConnectorQueueSize();
+    if (!usage.out_empty || !usage.out_full || usage.init_queue_size == 0 ||
+        queue_size >= usage.init_queue_size * kMaxGrowth) {
+      continue;
+    }
+    int32_t new_size = std::max(queue_size + queue_size / 2, queue_size + 1);
+    new_size = std::min(new_size, usage.init_queue_size * kMaxGrowth);
+    Status rc = usage.op->SetConnectorQueueSize(new_size);
+    if (rc.IsError()) {
+      // e.g. a lock free connector, leave it as it is from now on.
+      MS_LOG(INFO) << "AutoTune can not resize the connector of " << usage.op->NameWithID() << ": " << rc.ToString();
+      usage.init_queue_size = 0;
+      continue;
+    }
+    MS_LOG(INFO) << "AutoTune resized the connector of " << usage.op->NameWithID() << " to " << new_size << ".";
+    *changed = true;
+  }
+  return Status::OK();
+}
+
+void AutoTune::ResetRound() {
+  for (auto &usage : usages_) {
+    usage.in_sum = 0.0;
+    usage.out_sum = 0.0;
+    usage.out_empty = false;
+    usage.out_full = false;
+  }
+  feed_sum_ = 0.0;
+  num_samples_ = 0;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+
+#include <cstdint>
+#include <vector>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetOp;
+class ExecutionTree;
+class MapOp;
+
+// AutoTune adjusts a running pipeline until the host side keeps up with its consumer. It samples the occupancy of
+// the output connectors, the same numbers ConnectorSize records for profiling, and after every round of samples:
+//   - a MapOp whose input is mostly full while its output is mostly empty is the bottleneck, it gets one more
+//     helper worker as long as there are cpu threads left; a MapOp in the opposite situation gives one back;
+//   - a connector which ran both empty and full within the round is too small to absorb the bursts of its
+//     producer, its capacity is grown by half, up to kMaxGrowth times the initial size.
+// The tuning stops once the connector feeding the consumer stays full, or nothing changed, for kStableRounds rounds.
+class AutoTune {
+ public:
+  // AutoTune object constructor
+  // @param tree The execution tree to tune, it must outlive the AutoTune task
+  explicit AutoTune(ExecutionTree *tree);
+
+  ~AutoTune() = default;
+
+  // Functor for the AutoTune main loop.
+  // This function will be the entry point of mindspore::Dataset::Task
+  Status operator()();
+
+ private:
+  // Usage of the connectors around one op, accumulated over a round
+  struct OpUsage {
+    DatasetOp *op;
+    MapOp *map_op;  // nullptr if the op is not a MapOp
+    double in_sum;
+    double out_sum;
+    bool out_empty;
+    bool out_full;
+    int32_t init_queue_size;  // 0 if the output connector can not be resized
+  };
+
+  static constexpr int32_t kSamplesPerRound = 10;
+  static constexpr int32_t kStableRounds = 5;
+  static constexpr int32_t kMaxGrowth = 4;
+  static constexpr double kHighUsage = 0.8;
+  static constexpr double kLowUsage = 0.2;
+
+  // Add one sample of every connector to the current round.
+  void Sample();
+
+  // Apply the changes of a round.
+  // @param[out] changed Whether the configuration of the pipeline is changed
+  Status Tune(bool *changed);
+
+  // Change the helpers of the MapOp with the largest gap between its input and output usage.
+  Status TuneWorkers(bool *changed);
+
+  // Grow the output connector of the ops which ran both empty and full.
+  Status TuneConnectors(bool *changed);
+
+  // Clear the accumulated samples for the next round.
+  void ResetRound();
+
+  ExecutionTree *tree_;
+  int32_t interval_;
+  int32_t max_threads_;
+  DatasetOp *feed_op_;  // the op whose output is consumed by the device queue or the iterator
+  double feed_sum_;
+  int32_t num_samples_;
+  std::vector<OpUsage> usages_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
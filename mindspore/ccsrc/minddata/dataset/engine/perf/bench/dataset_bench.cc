@@ -0,0 +1,40 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifdef USE_GLOG
+#include <glog/logging.h>
+#endif
+#include <iostream>
+#include "minddata/dataset/engine/perf/bench/dataset_bench_run.h"
+namespace ds = mindspore::dataset;
+
+int main(int argc, char **argv) {
+#ifdef USE_GLOG
+  FLAGS_log_dir = "/tmp";
+  FLAGS_minloglevel = google::WARNING;
+  google::InitGoogleLogging(argv[0]);
+#endif
+  ds::DatasetBenchRun datasetBenchRun;
+  if (datasetBenchRun.ProcessArgs(argc, argv) == 0) {
+    std::cerr << datasetBenchRun << std::endl;
+    ds::Status rc = datasetBenchRun.Run();
+    if (rc.IsError()) {
+      std::cerr << rc.ToString() << std::endl;
+    }
+    return static_cast<int>(rc.get_code());
+  }
+  return 0;
+}
@@ -0,0 +1,604 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "minddata/dataset/engine/perf/bench/dataset_bench_run.h"
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <utility>
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/include/iterator.h"
+#include "minddata/dataset/include/transforms.h"
+#include "minddata/dataset/include/vision.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/recycling_pool.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double ElapsedUs(const Clock::time_point &start, const Clock::time_point &end) {
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// The counters of the pool are cumulative, a run reports what it added to them
+nlohmann::json StatsDelta(const nlohmann::json &before, const nlohmann::json &after) {
+  nlohmann::json delta = after;
+  for (const char *key : {"num_allocs", "num_thread_hits", "num_node_hits"}) {
+    delta[key] = after[key].get<uint64_t>() - before[key].get<uint64_t>();
+  }
+  auto num_allocs = delta["num_allocs"].get<uint64_t>();
+  auto num_hits = delta["num_thread_hits"].get<uint64_t>() + delta["num_node_hits"].get<uint64_t>();
+  delta["hit_rate"] = num_allocs == 0 ? 0.0 : static_cast<double>(num_hits) / num_allocs;
+  return delta;
+}
+
+nlohmann::json Throughput(int64_t rows, int64_t bytes, double total_us) {
+  nlohmann::json out;
+  out["rows"] = rows;
+  out["bytes"] = bytes;
+  out["total_ms"] = total_us / 1000;
+  out["rows_per_sec"] = total_us > 0 ? rows * 1e6 / total_us : 0.0;
+  out["bytes_per_sec"] = total_us > 0 ? bytes * 1e6 / total_us : 0.0;
+  return out;
+}
+
+// The numbers of the source alone, next to those of a pipeline built on it
+nlohmann::json SourceBaseline(const nlohmann::json &source, const nlohmann::json &result) {
+  nlohmann::json out;
+  out["total_ms"] = source["total_ms"];
+  out["rows_per_sec"] = source["rows_per_sec"];
+  out["bytes_per_sec"] = source["bytes_per_sec"];
+  auto rows_per_sec = result["rows_per_sec"].get<double>();
+  out["slowdown"] = rows_per_sec > 0 ? source["rows_per_sec"].get<double>() / rows_per_sec : 0.0;
+  return out;
+}
+}  // namespace
+
+void DatasetBenchRun::PrintHelp() {
+  std::cout << "Options:\n"
+               "    -h,--help:           Show this usage message\n"
+               "    -d,--dataset:        Set the source, random, image_folder or tfrecord. Default = "
+            << kDftBenchDataset
+            << "\n"
+               "    -p,--path:           Set the directory of image_folder, or the comma separated files of tfrecord\n"
+               "    -c,--column:         Set the column the ops apply to. Default = "
+            << kDftBenchColumn
+            << "\n"
+               "    -o,--ops:            Set the comma separated list of ops. Default = "
+            << kDftBenchOps
+            << "\n"
+               "                         decode is put in front of the default for image_folder. Known ops:";
+  for (const auto &factory : op_factories_) {
+    std::cout << " " << factory.first;
+  }
+  std::cout << "\n"
+               "    -s,--num_rows:       Set the sample size. Default = "
+            << kDftBenchNumRows
+            << " for random, all the rows otherwise\n"
+               "    -e,--epoch:          Set the number of epochs of every pipeline. Default = "
+            << kDftBenchNumberOfEpochs
+            << "\n"
+               "    -w,--workers:        Set the number of parallel workers. Default = "
+            << cfg_->num_parallel_workers()
+            << "\n"
+               "    -b,--batch_size:     Set the batch size. Default = "
+            << kDftBenchBatchSize
+            << "\n"
+               "       --image_size:     Set the height and width of the random images. Default = "
+            << kDftBenchImageSize
+            << "\n"
+               "       --crop_size:      Set the size of the crops. Default = "
+            << kDftBenchCropSize
+            << "\n"
+               "       --shuffle_size:   Set the shuffle buffer size. Default = "
+            << kDftBenchShuffleSize
+            << "\n"
+               "       --op_samples:     Set the number of rows each op is run on alone. Default = "
+            << kDftBenchOpSamples
+            << "\n"
+               "       --output:         Write the json report to a file instead of stdout\n";
+}
+
+int32_t DatasetBenchRun::ProcessArgs(int argc, char **argv) {
+  const int32_t image_size_opt = 1000;  // there is no short option for image_size
+  const int32_t crop_size_opt = 1001;   // there is no short option for crop_size
+  const int32_t shuffle_opt = 1002;     // there is no short option for shuffle_size
+  const int32_t samples_opt = 1003;     // there is no short option for op_samples
+  const int32_t output_opt = 1004;      // there is no short option for output
+
+  const char *const short_opts = ":d:p:c:o:s:e:w:b:h";
+  const option long_opts[] = {{"dataset", required_argument, nullptr, 'd'},
+                              {"path", required_argument, nullptr, 'p'},
+                              {"column", required_argument, nullptr, 'c'},
+                              {"ops", required_argument, nullptr, 'o'},
+                              {"num_rows", required_argument, nullptr, 's'},
+                              {"epoch", required_argument, nullptr, 'e'},
+                              {"workers", required_argument, nullptr, 'w'},
+                              {"batch_size", required_argument, nullptr, 'b'},
+                              {"image_size", required_argument, nullptr, image_size_opt},
+                              {"crop_size", required_argument, nullptr, crop_size_opt},
+                              {"shuffle_size", required_argument, nullptr, shuffle_opt},
+                              {"op_samples", required_argument, nullptr, samples_opt},
+                              {"output", required_argument, nullptr, output_opt},
+                              {"help", no_argument, nullptr, 'h'},
+                              {nullptr, no_argument, nullptr, 0}};
+
+  std::map<int32_t, int32_t> seen_opts;
+  int32_t rc = 0;
+  try {
+    while (rc == 0) {
+      int32_t option_indxex;
+      const auto opt = getopt_long(argc, argv, short_opts, long_opts, &option_indxex);
+
+      if (-1 == opt) {
+        if (optind < argc) {
+          rc = -1;
+          std::cerr << "Unknown arguments: ";
+          while (optind < argc) {
+            std::cerr << argv[optind++] << " ";
+          }
+          std::cerr << std::endl;
+        }
+        break;
+      }
+
+      if (opt > 0) {
+        seen_opts[opt]++;
+        if (seen_opts[opt] > 1) {
+          std::string long_name = long_opts[option_indxex].name;
+          std::cerr << "The " << long_name << " argument was given more than once." << std::endl;
+          rc = -1;
+          continue;
+        }
+      }
+
+      switch (opt) {
+        case 'd': {
+          dataset_ = optarg;
+          break;
+        }
+
+        case 'p': {
+          path_ = optarg;
+          break;
+        }
+
+        case 'c': {
+          column_ = optarg;
+          break;
+        }
+
+        case 'o': {
+          ops_ = optarg;
+          break;
+        }
+
+        case 's': {
+          num_rows_ = std::stol(optarg);
+          break;
+        }
+
+        case 'e': {
+          num_epoches_ = std::stoi(optarg);
+          break;
+        }
+
+        case 'w': {
+          cfg_->set_num_parallel_workers(std::stoi(optarg));
+          break;
+        }
+
+        case 'b': {
+          batch_size_ = std::stoi(optarg);
+          break;
+        }
+
+        case image_size_opt: {
+          image_size_ = std::stoi(optarg);
+          break;
+        }
+
+        case crop_size_opt: {
+          crop_size_ = std::stoi(optarg);
+          break;
+        }
+
+        case shuffle_opt: {
+          shuffle_size_ = std::stoi(optarg);
+          break;
+        }
+
+        case samples_opt: {
+          op_samples_ = std::stoi(optarg);
+          break;
+        }
+
+        case output_opt: {
+          output_ = optarg;
+          break;
+        }
+
+        case 'h':  // -h or --help
+          PrintHelp();
+          rc = -1;
+          break;
+
+        case ':':
+          std::cerr << "Missing argument for option " << char(optopt) << std::endl;
+          rc = -1;
+          break;
+
+        case '?':  // Unrecognized option
+        default:
+          std::cerr << "Unknown option " << char(optopt) << std::endl;
+          PrintHelp();
+          rc = -1;
+          break;
+      }
+    }
+  } catch (const std::exception &e) {
+    PrintHelp();
+    rc = -1;
+  }
+
+  if (rc < 0) {
+    return rc;
+  }
+
+  if (dataset_ != "random" && dataset_ != "image_folder" && dataset_ != "tfrecord") {
+    std::cerr << "Unknown dataset " << dataset_ << "." << std::endl;
+    return -1;
+  }
+
+  if (dataset_ != "random" && path_.empty()) {
+    std::cerr << "Missing path of the " << dataset_ << " dataset." << std::endl;
+    return -1;
+  }
+
+  // Images on disk are encoded
+  if (dataset_ == "image_folder" && seen_opts.find('o') == seen_opts.end()) {
+    ops_ = std::string("decode,") + kDftBenchOps;
+  }
+
+  if (dataset_ == "random" && num_rows_ < 0) {
+    num_rows_ = kDftBenchNumRows;
+  }
+
+  if (seen_opts.find('s') != seen_opts.end() && num_rows_ <= 0) {
+    std::cerr << "Sample size must be positive." << std::endl;
+    return -1;
+  }
+
+  if (num_epoches_ <= 0) {
+    std::cerr << "Number of epoches must be positive." << std::endl;
+    return -1;
+  }
+
+  if (image_size_ <= 0 || crop_size_ <= 0 || crop_size_ > image_size_) {
+    std::cerr << "Image size and crop size must be positive, and the crop no larger than the image." << std::endl;
+    return -1;
+  }
+
+  if (batch_size_ <= 0 || shuffle_size_ <= 1 || op_samples_ <= 0) {
+    std::cerr << "Batch size and op samples must be positive, shuffle size greater than 1." << std::endl;
+    return -1;
+  }
+
+  std::stringstream ops_ss(ops_);
+  std::string s;
+  while (std::getline(ops_ss, s, ',')) {
+    if (s.empty()) {
+      continue;
+    }
+    if (op_factories_.find(s) == op_factories_.end()) {
+      std::cerr << "Unknown op " << s << "." << std::endl;
+      return -1;
+    }
+    op_names_.push_back(s);
+  }
+
+  return 0;
+}
+
+DatasetBenchRun::DatasetBenchRun()
+    : dataset_(kDftBenchDataset),
+      column_(kDftBenchColumn),
+      ops_(kDftBenchOps),
+      num_rows_(-1),
+      num_epoches_(kDftBenchNumberOfEpochs),
+      image_size_(kDftBenchImageSize),
+      crop_size_(kDftBenchCropSize),
+      batch_size_(kDftBenchBatchSize),
+      shuffle_size_(kDftBenchShuffleSize),
+      op_samples_(kDftBenchOpSamples),
+      cfg_(GlobalContext::config_manager()) {
+  InitOpFactories();
+}
+
+void DatasetBenchRun::InitOpFactories() {
+  // The sizes are read when the op is created, after the arguments are processed.
+  op_factories_["decode"] = []() { return vision::Decode(); };
+  op_factories_["resize"] = [this]() { return vision::Resize({image_size_}); };
+  op_factories_["center_crop"] = [this]() { return vision::CenterCrop({crop_size_}); };
+  op_factories_["random_crop"] = [this]() { return vision::RandomCrop({crop_size_}); };
+  op_factories_["random_resized_crop"] = [this]() { return vision::RandomResizedCrop({crop_size_}); };
+  op_factories_["random_horizontal_flip"] = []() { return vision::RandomHorizontalFlip(); };
+  op_factories_["normalize"] = []() { return vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0}); };
+  op_factories_["rescale"] = []() { return vision::Rescale(1.0 / 255.0, 0.0); };
+  op_factories_["hwc2chw"] = []() { return vision::HWC2CHW(); };
+  op_factories_["type_cast"] = []() { return transforms::TypeCast("float32"); };
+}
+
+Status DatasetBenchRun::CreateSource(std::shared_ptr<Dataset> *ds) {
+  RETURN_UNEXPECTED_IF_NULL(ds);
+  if (dataset_ == "random") {
+    std::shared_ptr<SchemaObj> schema = Schema();
+    RETURN_IF_NOT_OK(schema->add_column(column_, "uint8", {image_size_, image_size_, 3}));
+    RETURN_IF_NOT_OK(schema->add_column("label", "int32", {1}));
+    *ds = RandomData(static_cast<int32_t>(num_rows_), schema);
+  } else {
+    if (dataset_ == "image_folder") {
+      *ds = ImageFolder(path_, false, SequentialSampler());
+    } else {
+      std::vector<std::string> files;
+      std::stringstream files_ss(path_);
+      std::string s;
+      while (std::getline(files_ss, s, ',')) {
+        files.push_back(s);
+      }
+      *ds = TFRecord(files, nullptr, {}, 0, ShuffleMode::kFalse);
+    }
+    if (*ds != nullptr && num_rows_ > 0) {
+      *ds = (*ds)->Take(static_cast<int32_t>(num_rows_));
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(*ds != nullptr, "Fail to create the " + dataset_ + " dataset.");
+  return Status::OK();
+}
+
+Status DatasetBenchRun::CreateOps(std::vector<std::shared_ptr<TensorOperation>> *ops) {
+  RETURN_UNEXPECTED_IF_NULL(ops);
+  for (const auto &name : op_names_) {
+    auto op = op_factories_[name]();
+    CHECK_FAIL_RETURN_UNEXPECTED(op != nullptr, "Invalid parameters of op " + name + ".");
+    RETURN_IF_NOT_OK(op->ValidateParams());
+    ops->push_back(std::move(op));
+  }
+  return Status::OK();
+}
+
+nlohmann::json DatasetBenchRun::Latency::ToJson() {
+  nlohmann::json out;
+  if (samples.empty()) {
+    return out;
+  }
+  std::sort(samples.begin(), samples.end());
+  // Nearest rank
+  auto percentile = [this](double p) {
+    auto rank = static_cast<size_t>(std::ceil(p / 100 * samples.size()));
+    return samples[std::max<size_t>(rank, 1) - 1];
+  };
+  out["min"] = samples.front();
+  out["avg"] = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+  out["p50"] = percentile(50);
+  out["p90"] = percentile(90);
+  out["p99"] = percentile(99);
+  out["p999"] = percentile(99.9);
+  out["max"] = samples.back();
+  return out;
+}
+
+nlohmann::json DatasetBenchRun::AllocatorStats() {
+  nlohmann::json out;
+  RecyclingPool::Stats stats{0, 0, 0, 0};
+  auto pool = std::dynamic_pointer_cast<RecyclingPool>(GlobalContext::Instance()->mem_pool());
+  if (pool != nullptr) {
+    stats = pool->GetStats();
+  }
+  out["num_allocs"] = stats.num_allocs;
+  out["num_thread_hits"] = stats.num_thread_hits;
+  out["num_node_hits"] = stats.num_node_hits;
+  out["cached_bytes"] = stats.cached_bytes;
+  out["hit_rate"] = pool != nullptr ? pool->HitRate() : 0.0;
+  return out;
+}
+
+Status DatasetBenchRun::RunTensorOps(nlohmann::json *out) {
+  // Hold the input rows in memory so that an op is timed without the pipeline around it.
+  std::shared_ptr<Dataset> ds;
+  RETURN_IF_NOT_OK(CreateSource(&ds));
+  std::shared_ptr<Iterator> iter = ds->CreateIterator({column_}, 1);
+  CHECK_FAIL_RETURN_UNEXPECTED(iter != nullptr, "Fail to build the pipeline of the op inputs.");
+  std::vector<TensorRow> rows;
+  TensorVec row;
+  while (rows.size() < static_cast<size_t>(op_samples_)) {
+    if (!iter->GetNextRow(&row)) {
+      iter->Stop();
+      RETURN_STATUS_UNEXPECTED("Fail to fetch the op inputs.");
+    }
+    if (row.empty()) {
+      break;
+    }
+    rows.emplace_back(1, row[0]);
+  }
+  iter->Stop();
+  CHECK_FAIL_RETURN_UNEXPECTED(!rows.empty(), "The " + dataset_ + " dataset is empty.");
+
+  std::vector<std::shared_ptr<TensorOperation>> ops;
+  RETURN_IF_NOT_OK(CreateOps(&ops));
+  *out = nlohmann::json::array();
+  for (size_t i = 0; i < ops.size(); ++i) {
+    std::shared_ptr<TensorOp> op = ops[i]->Build();
+    CHECK_FAIL_RETURN_UNEXPECTED(op != nullptr, "Fail to build op " + op_names_[i] + ".");
+    Latency latency;
+    latency.samples.reserve(rows.size());
+    int64_t bytes = 0;
+    std::vector<TensorRow> outputs(rows.size());
+    auto allocator_before = AllocatorStats();
+    auto start = Clock::now();
+    for (size_t r = 0; r < rows.size(); ++r) {
+      auto row_start = Clock::now();
+      Status rc = op->Compute(rows[r], &outputs[r]);
+      latency.samples.push_back(ElapsedUs(row_start, Clock::now()));
+      if (rc.IsError()) {
+        RETURN_STATUS_UNEXPECTED("Op " + op_names_[i] + " failed: " + rc.ToString());
+      }
+      for (const auto &t : outputs[r]) {
+        bytes += t->SizeInBytes();
+      }
+    }
+    double total_us = ElapsedUs(start, Clock::now());
+    nlohmann::json result = Throughput(rows.size(), bytes, total_us);
+    result["name"] = op_names_[i];
+    result["latency_us"] = latency.ToJson();
+    result["allocator"] = StatsDelta(allocator_before, AllocatorStats());
+    out->push_back(std::move(result));
+    // The next op runs on what this one produced
+    rows = std::move(outputs);
+  }
+  return Status::OK();
+}
+
+Status DatasetBenchRun::RunPipeline(const std::string &name, const std::shared_ptr<Dataset> &ds, bool batched,
+                                    nlohmann::json *out) {
+  std::shared_ptr<Dataset> pipeline = ds;
+  if (num_epoches_ > 1) {
+    pipeline = ds->Repeat(num_epoches_);
+  }
+  auto allocator_before = AllocatorStats();
+  auto start = Clock::now();
+  std::shared_ptr<Iterator> iter = pipeline->CreateIterator({}, 1);
+  CHECK_FAIL_RETURN_UNEXPECTED(iter != nullptr, "Fail to build the " + name + " pipeline.");
+  auto launched = Clock::now();
+
+  // A row of a batch pipeline is a batch, the rows are counted by the outer dimension of its first column
+  Latency latency;
+  int64_t rows = 0;
+  int64_t batches = 0;
+  int64_t bytes = 0;
+  TensorVec row;
+  while (true) {
+    auto row_start = Clock::now();
+    if (!iter->GetNextRow(&row)) {
+      iter->Stop();
+      RETURN_STATUS_UNEXPECTED("The " + name + " pipeline failed.");
+    }
+    if (row.empty()) {
+      break;
+    }
+    latency.samples.push_back(ElapsedUs(row_start, Clock::now()));
+    if (batched) {
+      ++batches;
+      rows += row[0]->shape().Rank() > 0 ? row[0]->shape()[0] : 1;
+    } else {
+      ++rows;
+    }
+    for (const auto &t : row) {
+      bytes += t->SizeInBytes();
+    }
+  }
+  auto end = Clock::now();
+  iter->Stop();
+
+  double total_us = ElapsedUs(launched, end);
+  nlohmann::json result = Throughput(rows, bytes, total_us);
+  result["name"] = name;
+  result["launch_ms"] = ElapsedUs(start, launched) / 1000;
+  result["first_row_ms"] = latency.samples.empty() ? 0.0 : latency.samples.front() / 1000;
+  if (batched) {
+    result["batches"] = batches;
+    result["batches_per_sec"] = total_us > 0 ? batches * 1e6 / total_us : 0.0;
+    result["batch_latency_us"] = latency.ToJson();
+  } else {
+    result["latency_us"] = latency.ToJson();
+  }
+  result["allocator"] = StatsDelta(allocator_before, AllocatorStats());
+  out->push_back(std::move(result));
+  MS_LOG(INFO) << "Pipeline " << name << " returned " << rows << " rows in " << batches << " batches.";
+  return Status::OK();
+}
+
+Status DatasetBenchRun::Run() {
+  nlohmann::json report;
+  std::stringstream ss;
+  ss << *this;
+  report["config"]["description"] = ss.str();
+  report["config"]["num_parallel_workers"] = cfg_->num_parallel_workers();
+  report["config"]["op_connector_size"] = cfg_->op_connector_size();
+  report["config"]["rows_per_buffer"] = cfg_->rows_per_buffer();
+
+  RETURN_IF_NOT_OK(RunTensorOps(&report["tensor_ops"]));
+
+  // Each of the dataset ops runs alone on top of the source. A batch needs rows of the same shape, it is put
+  // after the map.
+  std::vector<std::shared_ptr<TensorOperation>> ops;
+  RETURN_IF_NOT_OK(CreateOps(&ops));
+  report["pipelines"] = nlohmann::json::array();
+  std::shared_ptr<Dataset> ds;
+  RETURN_IF_NOT_OK(CreateSource(&ds));
+  RETURN_IF_NOT_OK(RunPipeline("source", ds, false, &report["pipelines"]));
+  if (!ops.empty()) {
+    RETURN_IF_NOT_OK(CreateSource(&ds));
+    RETURN_IF_NOT_OK(RunPipeline("map", ds->Map(ops, {column_}), false, &report["pipelines"]));
+  }
+  RETURN_IF_NOT_OK(CreateSource(&ds));
+  RETURN_IF_NOT_OK(RunPipeline("shuffle", ds->Shuffle(shuffle_size_), false, &report["pipelines"]));
+  RETURN_IF_NOT_OK(CreateSource(&ds));
+  if (!ops.empty()) {
+    ds = ds->Map(ops, {column_});
+  }
+  RETURN_IF_NOT_OK(RunPipeline("batch", ds->Batch(batch_size_), true, &report["pipelines"]));
+
+  // All of them together
+  RETURN_IF_NOT_OK(CreateSource(&ds));
+  if (!ops.empty()) {
+    ds = ds->Map(ops, {column_});
+  }
+  ds = ds->Shuffle(shuffle_size_)->Batch(batch_size_);
+  RETURN_IF_NOT_OK(RunPipeline("end_to_end", ds, true, &report["pipelines"]));
+
+  // What each of them costs over reading the source alone
+  auto &pipelines = report["pipelines"];
+  for (size_t i = 1; i < pipelines.size(); ++i) {
+    pipelines[i]["source"] = SourceBaseline(pipelines[0], pipelines[i]);
+  }
+
+  report["allocator"] = AllocatorStats();
+  struct rusage usage {};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    report["max_rss_kb"] = usage.ru_maxrss;
+  }
+
+  if (output_.empty()) {
+    std::cout << report.dump(2) << std::endl;
+  } else {
+    std::ofstream ofs(output_);
+    CHECK_FAIL_RETURN_UNEXPECTED(ofs.is_open(), "Fail to open " + output_ + ".");
+    ofs << report.dump(2) << std::endl;
+    CHECK_FAIL_RETURN_UNEXPECTED(ofs.good(), "Fail to write " + output_ + ".");
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,124 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_BENCH_DATASET_BENCH_RUN_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_BENCH_DATASET_BENCH_RUN_H_
+
+#include <getopt.h>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/include/datasets.h"
+#include "minddata/dataset/util/status.h"
+#include "nlohmann/json.hpp"
+
+namespace mindspore {
+namespace dataset {
+
+constexpr int64_t kDftBenchNumRows = 10000;
+constexpr int32_t kDftBenchNumberOfEpochs = 1;
+constexpr int32_t kDftBenchImageSize = 256;
+constexpr int32_t kDftBenchCropSize = 224;
+constexpr int32_t kDftBenchBatchSize = 32;
+constexpr int32_t kDftBenchShuffleSize = 1024;
+constexpr int32_t kDftBenchOpSamples = 1000;
+const char kDftBenchDataset[] = "random";
+const char kDftBenchColumn[] = "image";
+const char kDftBenchOps[] = "resize,center_crop,random_horizontal_flip,normalize,hwc2chw";
+
+/// \brief Benchmark of the dataset pipelines built through the C++ api. The source is either synthetic rows from
+/// RandomData, or image folder and TFRecord data on disk. Every TensorOp of the list is run alone on rows held in
+/// memory, then the source, map, shuffle and batch are run alone on top of the source, and finally all of them as
+/// one pipeline. The throughput, the latency percentiles and the counters of the tensor memory pool of every run
+/// are written as one json document.
+class DatasetBenchRun {
+ public:
+  DatasetBenchRun();
+  ~DatasetBenchRun() = default;
+  void PrintHelp();
+  int32_t ProcessArgs(int argc, char **argv);
+
+  void Print(std::ostream &out) const {
+    out << "Dataset: " << dataset_ << "\n"
+        << "Number of epochs: " << num_epoches_ << "\n"
+        << "Sample size: " << num_rows_ << "\n"
+        << "Image size: " << image_size_ << "\n"
+        << "Batch size: " << batch_size_ << "\n"
+        << "Shuffle size: " << shuffle_size_ << "\n"
+        << "Ops: " << ops_;
+  }
+
+  friend std::ostream &operator<<(std::ostream &out, const DatasetBenchRun &br) {
+    br.Print(out);
+    return out;
+  }
+
+  Status Run();
+
+ private:
+  /// \brief Latencies of a run, in microseconds
+  struct Latency {
+    std::vector<double> samples;
+    /// \return The min, average, percentiles and max as json
+    nlohmann::json ToJson();
+  };
+
+  using OpFactory = std::function<std::shared_ptr<TensorOperation>()>;
+
+  std::string dataset_;
+  std::string path_;
+  std::string column_;
+  std::string ops_;
+  std::string output_;
+  int64_t num_rows_;
+  int32_t num_epoches_;
+  int32_t image_size_;
+  int32_t crop_size_;
+  int32_t batch_size_;
+  int32_t shuffle_size_;
+  int32_t op_samples_;
+  std::shared_ptr<ConfigManager> cfg_;
+  std::map<std::string, OpFactory> op_factories_;
+  std::vector<std::string> op_names_;
+
+  /// \brief Register the TensorOps which can be named on the command line
+  void InitOpFactories();
+
+  /// \brief Build a new source, each run has its own pipeline
+  Status CreateSource(std::shared_ptr<Dataset> *ds);
+
+  /// \brief Build the TensorOperations of the op list
+  Status CreateOps(std::vector<std::shared_ptr<TensorOperation>> *ops);
+
+  /// \brief Run every TensorOp of the op list alone, each op is given the output of the previous one
+  Status RunTensorOps(nlohmann::json *out);
+
+  /// \brief Pull every row of a pipeline and time each of them
+  /// \param[in] batched The pipeline returns batches, they are counted apart from the rows in them
+  Status RunPipeline(const std::string &name, const std::shared_ptr<Dataset> &ds, bool batched, nlohmann::json *out);
+
+  /// \brief Counters of the tensor memory pool, all zero if the pool keeps no counters
+  static nlohmann::json AllocatorStats();
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_BENCH_DATASET_BENCH_RUN_H_
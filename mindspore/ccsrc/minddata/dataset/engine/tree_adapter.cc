@@ -17,6 +17,8 @@
 #include "minddata/dataset/engine/tree_adapter.h"
 
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/engine/datasetops/batch_op.h"
+#include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
 #include "minddata/dataset/engine/ir/datasetops/root_node.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/pass.h"
@@ -34,7 +36,8 @@
 namespace mindspore {
 namespace dataset {
 
-TreeAdapter::TreeAdapter(UsageFlag usage) : usage_(usage), tree_state_(kCompileStateInit) {
+TreeAdapter::TreeAdapter(UsageFlag usage)
+    : usage_(usage), cur_epoch_(0), rows_in_epoch_(0), skip_rows_(0), tree_state_(kCompileStateInit) {
   optimize_ = common::GetEnv("OPTIMIZE") == "true";
 
   // Initialize profiling parameters
@@ -43,6 +46,14 @@ TreeAdapter::TreeAdapter(UsageFlag usage) : usage_(usage), tree_state_(kCompileS
   cur_connector_capacity_ = 0;
 }
 
+TreeAdapter::~TreeAdapter() {
+  if (tree_ != nullptr) {
+    // Destroy the ops first, the tensors they still hold are freed into the pool before it is trimmed.
+    tree_.reset();
+    GlobalContext::Instance()->TrimMemPool();
+  }
+}
+
 Status TreeAdapter::PrePass(std::shared_ptr<DatasetNode> ir) {
   // Vector of actions in pre-pass phase
   std::vector<std::unique_ptr<IRPass>> actions;
@@ -197,6 +208,23 @@ Status TreeAdapter::Compile(std::shared_ptr<DatasetNode> input_ir, int32_t num_e
 }
 
 Status TreeAdapter::GetNext(TensorRow *row) {
+  // Drop the rows in front of a restored checkpoint which are not skipped by a sampler.
+  while (skip_rows_ > 0) {
+    RETURN_IF_NOT_OK(GetNextRow(row));
+    CHECK_FAIL_RETURN_UNEXPECTED(!row->empty(), "Invalid checkpoint, it is beyond the end of the epoch.");
+    skip_rows_--;
+  }
+  RETURN_IF_NOT_OK(GetNextRow(row));
+  if (row->empty()) {
+    cur_epoch_++;
+    rows_in_epoch_ = 0;
+  } else {
+    rows_in_epoch_++;
+  }
+  return Status::OK();
+}
+
+Status TreeAdapter::GetNextRow(TensorRow *row) {
   RETURN_UNEXPECTED_IF_NULL(tree_);
   RETURN_UNEXPECTED_IF_NULL(row);
   row->clear();  // make sure row is empty
@@ -250,6 +278,90 @@ Status TreeAdapter::GetNext(TensorRow *row) {
   return Status::OK();
 }
 
+Status TreeAdapter::GetCheckpoint(nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  CHECK_FAIL_RETURN_UNEXPECTED(tree_ != nullptr, "Tree is a nullptr.");
+  nlohmann::json ops = nlohmann::json::object();
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    DatasetOp &op = *itr;
+    nlohmann::json state;
+    RETURN_IF_NOT_OK(op.SaveResumeState(cur_epoch_, &state));
+    if (!state.is_null()) {
+      state["name"] = op.Name();
+      ops[std::to_string(op.id())] = state;
+    }
+  }
+  (*out_json)["epoch"] = cur_epoch_;
+  (*out_json)["rows_in_epoch"] = rows_in_epoch_;
+  (*out_json)["ops"] = ops;
+  return Status::OK();
+}
+
+Status TreeAdapter::Restore(const nlohmann::json &checkpoint) {
+  CHECK_FAIL_RETURN_UNEXPECTED(tree_ != nullptr && tree_state_ == kCompileStateReady && cur_db_ == nullptr,
+                               "Restore must be called after Compile and before the first GetNext.");
+  CHECK_FAIL_RETURN_UNEXPECTED(checkpoint.find("epoch") != checkpoint.end() &&
+                                 checkpoint.find("rows_in_epoch") != checkpoint.end(),
+                               "Invalid checkpoint, epoch and rows_in_epoch are required.");
+  int64_t epoch = checkpoint["epoch"].get<int64_t>();
+  int64_t num_rows = checkpoint["rows_in_epoch"].get<int64_t>();
+  CHECK_FAIL_RETURN_UNEXPECTED(epoch >= 0 && num_rows >= 0, "Invalid checkpoint, negative position.");
+  nlohmann::json ops = checkpoint.find("ops") != checkpoint.end() ? checkpoint["ops"] : nlohmann::json::object();
+
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    DatasetOp &op = *itr;
+    nlohmann::json state = nlohmann::json::object();
+    auto state_itr = ops.find(std::to_string(op.id()));
+    if (state_itr != ops.end()) {
+      state = *state_itr;
+      CHECK_FAIL_RETURN_UNEXPECTED(state["name"] == op.Name(), "Invalid checkpoint, the state of " + op.NameWithID() +
+                                                                  " is saved from a different pipeline.");
+    }
+    RETURN_IF_NOT_OK(op.Resume(epoch, state));
+  }
+
+  int64_t num_leaf_rows = 0;
+  DatasetOp *leaf = FindSkippingLeaf(num_rows, &num_leaf_rows);
+  if (leaf != nullptr) {
+    leaf->sampler()->SetResumePoint(epoch * leaf->op_num_repeats_per_epoch(), num_leaf_rows);
+    skip_rows_ = 0;
+  } else {
+    skip_rows_ = num_rows;
+  }
+  MS_LOG(INFO) << "Restored to row " << num_rows << " of epoch " << epoch << ", "
+               << (leaf != nullptr ? "rows are skipped by the sampler of " + leaf->NameWithID() : "rows are dropped.");
+  cur_epoch_ = epoch;
+  rows_in_epoch_ = num_rows;
+  return Status::OK();
+}
+
+DatasetOp *TreeAdapter::FindSkippingLeaf(int64_t num_rows, int64_t *num_leaf_rows) {
+  DatasetOp *op = tree_->root().get();
+  int64_t rows = num_rows;
+  while (op != nullptr && !op->IsLeaf()) {
+    std::string name = op->Name();
+    if (name == kBatchOp) {
+      int32_t batch_size = 0;
+      if (!dynamic_cast<BatchOp *>(op)->GetFixedBatchSize(&batch_size)) {
+        return nullptr;
+      }
+      rows *= batch_size;
+    } else if (name != kMapOp && name != kProjectOp && name != kRenameOp && name != kEpochCtrlOp) {
+      // A RepeatOp would need the number of rows of an epoch of its child, leave it to the fetching as well.
+      return nullptr;
+    }
+    if (op->Children().size() != 1) {
+      return nullptr;
+    }
+    op = op->Children()[0].get();
+  }
+  if (op == nullptr || op->sampler() == nullptr) {
+    return nullptr;
+  }
+  *num_leaf_rows = rows;
+  return op;
+}
+
 Status TreeAdapter::Launch() const {
   CHECK_FAIL_RETURN_UNEXPECTED(tree_ != nullptr, "Tree is a nullptr.");
   return tree_->Launch();
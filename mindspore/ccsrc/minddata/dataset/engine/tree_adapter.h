@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include <nlohmann/json.hpp>
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
 #include "minddata/dataset/engine/perf/dataset_iterator_tracing.h"
@@ -40,7 +41,8 @@ class TreeAdapter {
 
   explicit TreeAdapter(UsageFlag flag = kDeIterator);
 
-  ~TreeAdapter() = default;
+  // The free tensor buffers kept for the pipeline are given back once its ops are destroyed.
+  ~TreeAdapter();
 
   // This function performs syntax checking, semantics checking, optimizes, and then builds
   // the Execution tree.
@@ -54,6 +56,16 @@ class TreeAdapter {
   // 2. GetNext will return empty row when eoe/eof is obtained
   Status GetNext(TensorRow *);
 
+  // Save the position of the consumer, i.e. the epoch and the number of rows GetNext returned in it, together with
+  // the state the ops need to start that epoch again.
+  Status GetCheckpoint(nlohmann::json *out_json);
+
+  // Continue from a checkpoint saved by GetCheckpoint on a tree compiled from the same pipeline. It must be called
+  // after Compile() and before the first GetNext(). The epochs before the checkpoint are skipped by the samplers
+  // without reading data. The rows before it within its epoch are skipped by the sampler of the leaf as well when
+  // every op above the leaf outputs a fixed number of rows per input row, otherwise they are fetched and dropped.
+  Status Restore(const nlohmann::json &checkpoint);
+
   // unique_ptr overloads operator bool(), will return false if it doesn't manage an object
   std::weak_ptr<DatasetOp> GetRoot() { return tree_ ? tree_->root() : nullptr; }
 
@@ -88,6 +100,14 @@ class TreeAdapter {
   // This RECURSIVE function walks the (optimized) IR tree in DFS to build its corresponding Execution tree.
   Status BuildExecutionTreeRecur(std::shared_ptr<DatasetNode> ir, std::shared_ptr<DatasetOp> *op);
 
+  // Fetch the next row from the root op, GetNext wraps it to keep track of the position.
+  Status GetNextRow(TensorRow *row);
+
+  // Find the leaf whose sampler can skip the rows in front of num_rows rows of the root.
+  // Return nullptr if the path from the root to the leaf has an op which does not output a fixed number of rows
+  // per input row, e.g. a shuffle, a filter or an op with more than one child.
+  DatasetOp *FindSkippingLeaf(int64_t num_rows, int64_t *num_leaf_rows);
+
   std::unique_ptr<DataBuffer> cur_db_;
   std::unordered_map<std::string, int32_t> column_name_map_;
   std::shared_ptr<DatasetNode> root_ir_;
@@ -98,6 +118,9 @@ class TreeAdapter {
   int32_t cur_connector_size_;                       // current connector size of root op, used for profiling
   int32_t cur_connector_capacity_;                   // current connector capacity of root op, used for profiling
   UsageFlag usage_;                                  // usage of this tree adapter (type of consumer)
+  int64_t cur_epoch_;                                // current epoch of the consumer
+  int64_t rows_in_epoch_;                            // number of rows returned by GetNext in the current epoch
+  int64_t skip_rows_;                                // number of rows to drop to reach a restored checkpoint
   // State flags for the lifecycle of the tree
   enum CompileState {
     kCompileStateInit = 0,      // The freshly initialized state
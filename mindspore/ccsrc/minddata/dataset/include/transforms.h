@@ -277,6 +277,8 @@ class TypeCastOperation : public TensorOperation {
 
   std::string Name() const override { return kTypeCastOperation; }
 
+  std::string data_type() const { return data_type_; }
+
  private:
   std::string data_type_;
 };
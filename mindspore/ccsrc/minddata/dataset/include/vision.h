@@ -49,6 +49,7 @@ constexpr char kRandomAffineOperation[] = "RandomAffine";
 constexpr char kRandomColorAdjustOperation[] = "RandomColorAdjust";
 constexpr char kRandomColorOperation[] = "RandomColor";
 constexpr char kRandomCropDecodeResizeOperation[] = "RandomCropDecodeResize";
+constexpr char kRandomCropDecodeResizeNormalizeOperation[] = "RandomCropDecodeResizeNormalize";
 constexpr char kRandomCropOperation[] = "RandomCrop";
 constexpr char kRandomCropWithBBoxOperation[] = "RandomCropWithBBox";
 constexpr char kRandomHorizontalFlipWithBBoxOperation[] = "RandomHorizontalFlipWithBBox";
@@ -89,6 +90,7 @@ class RandomColorOperation;
 class RandomColorAdjustOperation;
 class RandomCropOperation;
 class RandomCropDecodeResizeOperation;
+class RandomCropDecodeResizeNormalizeOperation;
 class RandomCropWithBBoxOperation;
 class RandomHorizontalFlipOperation;
 class RandomHorizontalFlipWithBBoxOperation;
@@ -804,6 +806,27 @@ class RandomCropDecodeResizeOperation : public RandomResizedCropOperation {
   std::string Name() const override { return kRandomCropDecodeResizeOperation; }
 };
 
+/// \brief Fused Decode, RandomResizedCrop, RandomHorizontalFlip, Normalize, HwcToChw and a cast to float16,
+///     created by TensorOpFusionPass, there is no public function to create it.
+class RandomCropDecodeResizeNormalizeOperation : public RandomCropDecodeResizeOperation {
+ public:
+  RandomCropDecodeResizeNormalizeOperation(const RandomResizedCropOperation &base, std::vector<float> mean,
+                                           std::vector<float> std, float flip_probability,
+                                           std::string dtype = "float32");
+
+  ~RandomCropDecodeResizeNormalizeOperation() = default;
+
+  std::shared_ptr<TensorOp> Build() override;
+
+  std::string Name() const override { return kRandomCropDecodeResizeNormalizeOperation; }
+
+ private:
+  std::vector<float> mean_;
+  std::vector<float> std_;
+  float flip_probability_;
+  std::string dtype_;
+};
+
 class RandomCropWithBBoxOperation : public TensorOperation {
  public:
   RandomCropWithBBoxOperation(std::vector<int32_t> size, std::vector<int32_t> padding = {0, 0, 0, 0},
@@ -838,6 +861,8 @@ class RandomHorizontalFlipOperation : public TensorOperation {
 
   std::string Name() const override { return kRandomHorizontalFlipOperation; }
 
+  float probability() const { return probability_; }
+
  private:
   float probability_;
 };
@@ -159,6 +159,10 @@ class NormalizeOperation : public TensorOperation {
 
   Status to_json(nlohmann::json *out_json) override;
 
+  const std::vector<float> &mean() const { return mean_; }
+
+  const std::vector<float> &std_dev() const { return std_; }
+
  private:
   std::vector<float> mean_;
   std::vector<float> std_;
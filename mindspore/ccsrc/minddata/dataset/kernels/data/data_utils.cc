@@ -392,41 +392,47 @@ Status PadEndNumeric(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor>
   } else {
     CHECK_FAIL_RETURN_UNEXPECTED(src->Rank() == pad_shape.size(), "PadEnd: invalid pad shape.");
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(pad_shape), src->type(), dst));
-    auto tensor_type = src->type().value();
-    if (pad_val == 0) {  // if pad with zero, don't care what type it is
-      RETURN_IF_NOT_OK((*dst)->Zero());
-    } else if (tensor_type == DataType::DE_INT8) {
-      RETURN_IF_NOT_OK((*dst)->Fill<int8_t>(pad_val));
-    } else if (tensor_type == DataType::DE_BOOL) {
-      RETURN_IF_NOT_OK((*dst)->Fill<bool>(pad_val));
-    } else if (tensor_type == DataType::DE_UINT8) {
-      RETURN_IF_NOT_OK((*dst)->Fill<uint8_t>(pad_val));
-    } else if (tensor_type == DataType::DE_INT16) {
-      RETURN_IF_NOT_OK((*dst)->Fill<int16_t>(pad_val));
-    } else if (tensor_type == DataType::DE_FLOAT16) {
-      RETURN_IF_NOT_OK((*dst)->Fill<float16>(static_cast<float16>(pad_val)));
-    } else if (tensor_type == DataType::DE_UINT16) {
-      RETURN_IF_NOT_OK((*dst)->Fill<uint16_t>(pad_val));
-    } else if (tensor_type == DataType::DE_INT32) {
-      RETURN_IF_NOT_OK((*dst)->Fill<int32_t>(pad_val));
-    } else if (tensor_type == DataType::DE_UINT32) {
-      RETURN_IF_NOT_OK((*dst)->Fill<uint32_t>(pad_val));
-    } else if (tensor_type == DataType::DE_INT64) {
-      RETURN_IF_NOT_OK((*dst)->Fill<int64_t>(pad_val));
-    } else if (tensor_type == DataType::DE_UINT64) {
-      RETURN_IF_NOT_OK((*dst)->Fill<uint64_t>(pad_val));
-    } else if (tensor_type == DataType::DE_FLOAT32) {
-      RETURN_IF_NOT_OK((*dst)->Fill<float>(pad_val));
-    } else if (tensor_type == DataType::DE_FLOAT64) {
-      RETURN_IF_NOT_OK((*dst)->Fill<double>(pad_val));
-    } else {
-      RETURN_STATUS_UNEXPECTED("PadEnd: Incorrect/Unknown datatype");
-    }
+    RETURN_IF_NOT_OK(FillPadValue(*dst, pad_val));
     std::vector<dsize_t> cur_ind(src->Rank(), 0);
     RETURN_IF_NOT_OK(PadEndNumericHelper(src, *dst, cur_ind, 0));
   }
   return Status::OK();
 }
+
+Status FillPadValue(const std::shared_ptr<Tensor> &dst, float pad_val) {
+  auto tensor_type = dst->type().value();
+  if (pad_val == 0) {  // if pad with zero, don't care what type it is
+    RETURN_IF_NOT_OK(dst->Zero());
+  } else if (tensor_type == DataType::DE_INT8) {
+    RETURN_IF_NOT_OK(dst->Fill<int8_t>(pad_val));
+  } else if (tensor_type == DataType::DE_BOOL) {
+    RETURN_IF_NOT_OK(dst->Fill<bool>(pad_val));
+  } else if (tensor_type == DataType::DE_UINT8) {
+    RETURN_IF_NOT_OK(dst->Fill<uint8_t>(pad_val));
+  } else if (tensor_type == DataType::DE_INT16) {
+    RETURN_IF_NOT_OK(dst->Fill<int16_t>(pad_val));
+  } else if (tensor_type == DataType::DE_FLOAT16) {
+    RETURN_IF_NOT_OK(dst->Fill<float16>(static_cast<float16>(pad_val)));
+  } else if (tensor_type == DataType::DE_UINT16) {
+    RETURN_IF_NOT_OK(dst->Fill<uint16_t>(pad_val));
+  } else if (tensor_type == DataType::DE_INT32) {
+    RETURN_IF_NOT_OK(dst->Fill<int32_t>(pad_val));
+  } else if (tensor_type == DataType::DE_UINT32) {
+    RETURN_IF_NOT_OK(dst->Fill<uint32_t>(pad_val));
+  } else if (tensor_type == DataType::DE_INT64) {
+    RETURN_IF_NOT_OK(dst->Fill<int64_t>(pad_val));
+  } else if (tensor_type == DataType::DE_UINT64) {
+    RETURN_IF_NOT_OK(dst->Fill<uint64_t>(pad_val));
+  } else if (tensor_type == DataType::DE_FLOAT32) {
+    RETURN_IF_NOT_OK(dst->Fill<float>(pad_val));
+  } else if (tensor_type == DataType::DE_FLOAT64) {
+    RETURN_IF_NOT_OK(dst->Fill<double>(pad_val));
+  } else {
+    RETURN_STATUS_UNEXPECTED("PadEnd: Incorrect/Unknown datatype");
+  }
+  return Status::OK();
+}
+
 Status PadEndNumericHelper(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor> dst,
                            std::vector<dsize_t> cur_ind, size_t cur_dim) {
   if (cur_dim == src->Rank() - 1) {  // if this is the last dimension, copy the data
@@ -441,6 +447,67 @@ Status PadEndNumericHelper(const std::shared_ptr<Tensor> &src, std::shared_ptr<T
   return Status::OK();
 }
 
+Status PadEndBatch(const TensorRow &src, std::shared_ptr<Tensor> *dst, const std::vector<dsize_t> &pad_shape,
+                   const std::shared_ptr<Tensor> &pad_val) {
+  CHECK_FAIL_RETURN_UNEXPECTED(src.size() > 0 && dst != nullptr, "PadEnd: input or output can't be empty");
+  DataType type = src[0]->type();
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "PadEnd: only numeric tensors can be padded into a batch.");
+  float val = 0;
+  if (pad_val != nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(pad_val->type().IsNumeric(), "PadEnd: Source and pad_value are not of the same type.");
+    std::shared_ptr<Tensor> float_pad_value;
+    RETURN_IF_NOT_OK(TypeCast(pad_val, &float_pad_value, DataType(DataType::DE_FLOAT32)));
+    RETURN_IF_NOT_OK(float_pad_value->GetItemAt<float>(&val, {}));
+  }
+  TensorShape row_shape(pad_shape);
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(row_shape.PrependDim(static_cast<dsize_t>(src.size())), type, dst));
+  if ((*dst)->Size() == 0) {
+    return Status::OK();
+  }
+  // The pad value is only written when a row is smaller than the pad shape
+  for (size_t j = 0; j < src.size(); j++) {
+    if (!(src[j]->shape() == row_shape)) {
+      RETURN_IF_NOT_OK(FillPadValue(*dst, val));
+      break;
+    }
+  }
+  dsize_t type_size = type.SizeInBytes();
+  for (size_t j = 0; j < src.size(); j++) {
+    const std::shared_ptr<Tensor> &row = src[j];
+    CHECK_FAIL_RETURN_UNEXPECTED(row->type() == type, "PadEnd: tensors to be batched must have the same type.");
+    CHECK_FAIL_RETURN_UNEXPECTED(row->Rank() == pad_shape.size(), "PadEnd: invalid pad shape.");
+    uchar *slot = nullptr;
+    TensorShape remaining = TensorShape::CreateUnknownRankShape();
+    RETURN_IF_NOT_OK((*dst)->StartAddrOfIndex({static_cast<dsize_t>(j)}, &slot, &remaining));
+    if (row->shape() == row_shape) {
+      dsize_t len = row->SizeInBytes();
+      CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(slot, len, row->GetBuffer(), len) == 0, "PadEnd: memcpy error.");
+    } else {
+      RETURN_IF_NOT_OK(PadEndBatchHelper(row->GetBuffer(), row->shape(), slot, row_shape, type_size, 0));
+    }
+  }
+  return Status::OK();
+}
+
+Status PadEndBatchHelper(const uchar *src, const TensorShape &src_shape, uchar *dst, const TensorShape &dst_shape,
+                         dsize_t type_size, size_t cur_dim) {
+  dsize_t min_ind = std::min(dst_shape[cur_dim], src_shape[cur_dim]);
+  if (cur_dim == src_shape.Rank() - 1) {  // if this is the last dimension, copy the data
+    dsize_t len = min_ind * type_size;
+    if (len > 0) {
+      CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(dst, len, src, len) == 0, "PadEnd: memcpy error.");
+    }
+    return Status::OK();
+  }
+  dsize_t src_stride = src_shape.Strides()[cur_dim] * type_size;
+  dsize_t dst_stride = dst_shape.Strides()[cur_dim] * type_size;
+  for (dsize_t i = 0; i < min_ind; i++) {
+    RETURN_IF_NOT_OK(PadEndBatchHelper(src + i * src_stride, src_shape, dst + i * dst_stride, dst_shape, type_size,
+                                       cur_dim + 1));
+  }
+  return Status::OK();
+}
+
 Status PadEndString(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor> *dst,
                     const std::vector<dsize_t> &pad_shape, const std::string &pad_val) {
   CHECK_FAIL_RETURN_UNEXPECTED(src != nullptr && dst != nullptr, "tensor can't be nullptr");
@@ -102,6 +102,33 @@ Status PadEndNumeric(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor>
 Status PadEndNumericHelper(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor> dst,
                            std::vector<dsize_t> cur_ind, size_t cur_dim = 0);
 
+// Fill a numeric tensor with the pad value, used before the data is copied into the padded tensor.
+// @param std::shared_ptr<Tensor> dst - tensor to fill
+// @param float pad_val - value to pad with
+// @return Status The status code returned
+Status FillPadValue(const std::shared_ptr<Tensor> &dst, float pad_val);
+
+// Pad numeric tensors of the same rank to pad_shape and stack them into one tensor of shape <n, pad_shape>.
+// Every tensor is padded straight into its row of the output, no padded copy of a single tensor is made.
+// @param TensorRow src - tensors to pad from, one per row of the output
+// @param std::shared_ptr<Tensor> *dst - return tensor padded and batched
+// @param std::vector<dsize_t> pad_shape - shape to pad every tensor to
+// @param std::shared_ptr<Tensor> pad_val - value to pad with in Tensor format, 0 if nullptr
+// @return Status The status code returned
+Status PadEndBatch(const TensorRow &src, std::shared_ptr<Tensor> *dst, const std::vector<dsize_t> &pad_shape,
+                   const std::shared_ptr<Tensor> &pad_val);
+
+// recursive helper function of PadEndBatch, copies the part of src which fits in dst_shape.
+// @param const uchar *src - data of the tensor to pad from
+// @param TensorShape src_shape - shape of the tensor to pad from
+// @param uchar *dst - row of the output to pad to
+// @param TensorShape dst_shape - shape of a row of the output
+// @param dsize_t type_size - size of an element in bytes
+// @param size_t cur_dim - recursion helper
+// @return Status The status code returned
+Status PadEndBatchHelper(const uchar *src, const TensorShape &src_shape, uchar *dst, const TensorShape &dst_shape,
+                         dsize_t type_size, size_t cur_dim = 0);
+
 // Pad input string tensor according pad_shape, need to have same rank.
 // @param std::shared_ptr<Tensor> src - tensor to pad from
 // @param std::shared_ptr<Tensor> *dst - return tensor padded
@@ -653,6 +653,62 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   }
 }
 
+// Each row is read once from the interleaved input and written to the three planes of the output. The factors are
+// kept in locals and the loop has a unit stride on the output side, so the compiler vectorizes it with
+// de-interleaving loads instead of a per channel pass over the image.
+template <typename T>
+static void NormalizeImageToChw(const uint8_t *input, int height, int width, const float *scale, const float *shift,
+                                bool flip, T *output) {
+  const float scale_r = scale[0], scale_g = scale[1], scale_b = scale[2];
+  const float shift_r = shift[0], shift_g = shift[1], shift_b = shift[2];
+  const size_t plane_size = static_cast<size_t>(height) * width;
+  for (int y = 0; y < height; y++) {
+    const uint8_t *in_row = input + static_cast<size_t>(y) * width * 3;
+    T *out_r = output + static_cast<size_t>(y) * width;
+    T *out_g = out_r + plane_size;
+    T *out_b = out_g + plane_size;
+    for (int x = 0; x < width; x++) {
+      const uint8_t *pixel = in_row + (flip ? (width - 1 - x) : x) * 3;
+      out_r[x] = static_cast<T>(pixel[0] * scale_r + shift_r);
+      out_g[x] = static_cast<T>(pixel[1] * scale_g + shift_g);
+      out_b[x] = static_cast<T>(pixel[2] * scale_b + shift_b);
+    }
+  }
+}
+
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::vector<float> &mean, const std::vector<float> &std, bool flip,
+                         const std::string &dtype) {
+  if (input->Rank() != 3 || input->shape()[2] != 3 || input->type() != DataType::DE_UINT8) {
+    RETURN_STATUS_UNEXPECTED("NormalizeHwcToChw: input should be a RGB image of shape <H,W,3> and type uint8.");
+  }
+  if (mean.size() != 3 || std.size() != 3) {
+    std::string err_msg = "NormalizeHwcToChw: mean and std should be of size 3.";
+    return Status(StatusCode::kShapeMisMatch, err_msg);
+  }
+  float scale[3];
+  float shift[3];
+  for (int i = 0; i < 3; i++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(std[i] != 0, "NormalizeHwcToChw: std should not be zero.");
+    scale[i] = 1.0f / std[i];
+    shift[i] = -mean[i] / std[i];
+  }
+  int height = input->shape()[0];
+  int width = input->shape()[1];
+  DataType type = dtype == "float16" ? DataType(DataType::DE_FLOAT16) : DataType(DataType::DE_FLOAT32);
+  std::shared_ptr<Tensor> output_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({3, height, width}), type, &output_tensor));
+  if (type == DataType::DE_FLOAT16) {
+    NormalizeImageToChw(input->GetBuffer(), height, width, scale, shift, flip,
+                        reinterpret_cast<float16 *>(output_tensor->GetMutableBuffer()));
+  } else {
+    NormalizeImageToChw(input->GetBuffer(), height, width, scale, shift, flip,
+                        reinterpret_cast<float *>(output_tensor->GetMutableBuffer()));
+  }
+  *output = std::move(output_tensor);
+  return Status::OK();
+}
+
 Status NormalizePad(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                     const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std, const std::string &dtype) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
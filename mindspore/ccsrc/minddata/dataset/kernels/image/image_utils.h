@@ -185,6 +185,18 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                  const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std);
 
+/// \brief Returns Normalized image in CHW layout, optionally flipped horizontally, computed in a single pass.
+///     It gives the same result as Normalize, HorizontalFlip and HwcToChw, without the intermediate images.
+/// \param input: Tensor of shape <H,W,3> in RGB order and type DE_UINT8.
+/// \param mean: mean of each channel in RGB order
+/// \param std: std of each channel in RGB order
+/// \param flip: whether the image is flipped horizontally
+/// \param dtype: output dtype, float32 or float16
+/// \param output: Normalized image Tensor of shape <3,H,W>
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::vector<float> &mean, const std::vector<float> &std, bool flip,
+                         const std::string &dtype = "float32");
+
 /// \brief Returns Normalized and paded image
 /// \param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param mean: Tensor of shape <3> and type DE_FLOAT32 which are mean of each channel in RGB order
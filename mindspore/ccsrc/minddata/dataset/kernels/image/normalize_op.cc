@@ -43,6 +43,18 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
   return Normalize(input, output, mean_, std_);
 }
 
+Status NormalizeOp::GetMeanStd(std::vector<float> *mean, std::vector<float> *std) const {
+  mean->clear();
+  std->clear();
+  for (auto itr = mean_->begin<float>(); itr != mean_->end<float>(); ++itr) {
+    mean->push_back(*itr);
+  }
+  for (auto itr = std_->begin<float>(); itr != std_->end<float>(); ++itr) {
+    std->push_back(*itr);
+  }
+  return Status::OK();
+}
+
 void NormalizeOp::Print(std::ostream &out) const {
   out << "NormalizeOp, mean: " << *(mean_.get()) << std::endl << "std: " << *(std_.get()) << std::endl;
 }
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -37,6 +38,9 @@ class NormalizeOp : public TensorOp {
 
   std::string Name() const override { return kNormalizeOp; }
 
+  // Getter of the mean and std of each channel
+  Status GetMeanStd(std::vector<float> *mean, std::vector<float> *std) const;
+
  private:
   std::shared_ptr<Tensor> mean_;
   std::shared_ptr<Tensor> std_;
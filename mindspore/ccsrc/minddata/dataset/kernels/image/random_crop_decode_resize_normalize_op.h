@@ -0,0 +1,67 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Fused Decode, RandomResizedCrop, RandomHorizontalFlip, Normalize and HwcToChw, the usual preprocessing of an
+// ImageNet training pipeline. Only the crop region of a jpeg is decoded, and after the resize a single pass
+// flips, normalizes and splits the channels into planes, instead of a full pass over the image for each op.
+class RandomCropDecodeResizeNormalizeOp : public RandomCropDecodeResizeOp {
+ public:
+  // @param rhs The crop and resize parameters
+  // @param mean Mean of each channel in RGB order
+  // @param std Std of each channel in RGB order
+  // @param flip_probability Probability of the horizontal flip, 0 if there is no flip in the fused ops
+  // @param dtype Output type, float32 or float16
+  RandomCropDecodeResizeNormalizeOp(const RandomCropAndResizeOp &rhs, std::vector<float> mean, std::vector<float> std,
+                                    float flip_probability = 0.0, std::string dtype = "float32");
+
+  ~RandomCropDecodeResizeNormalizeOp() override = default;
+
+  void Print(std::ostream &out) const override {
+    out << Name() << ": " << target_height_ << " " << target_width_ << ", flip probability " << flip_probability_;
+  }
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kRandomCropDecodeResizeNormalizeOp; }
+
+ private:
+  std::vector<float> mean_;
+  std::vector<float> std_;
+  float flip_probability_;
+  std::bernoulli_distribution flip_distribution_;
+  std::string dtype_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_RANDOM_CROP_DECODE_RESIZE_NORMALIZE_OP_H_
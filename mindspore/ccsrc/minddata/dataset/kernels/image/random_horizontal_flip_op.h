@@ -49,6 +49,8 @@ class RandomHorizontalFlipOp : public TensorOp {
 
   std::string Name() const override { return kRandomHorizontalFlipOp; }
 
+  float probability() const { return distribution_.p(); }
+
  private:
   std::mt19937 rnd_;
   std::bernoulli_distribution distribution_;
@@ -70,6 +70,7 @@ constexpr char kRandomColorAdjustOp[] = "RandomColorAdjustOp";
 constexpr char kRandomCropAndResizeOp[] = "RandomCropAndResizeOp";
 constexpr char kRandomCropAndResizeWithBBoxOp[] = "RandomCropAndResizeWithBBoxOp";
 constexpr char kRandomCropDecodeResizeOp[] = "RandomCropDecodeResizeOp";
+constexpr char kRandomCropDecodeResizeNormalizeOp[] = "RandomCropDecodeResizeNormalizeOp";
 constexpr char kRandomCropOp[] = "RandomCropOp";
 constexpr char kRandomCropWithBBoxOp[] = "RandomCropWithBBoxOp";
 constexpr char kRandomHorizontalFlipWithBBoxOp[] = "RandomHorizontalFlipWithBBoxOp";
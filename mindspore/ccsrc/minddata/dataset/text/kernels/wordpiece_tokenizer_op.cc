@@ -39,6 +39,30 @@ Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const Ru
                                         bool *out_found, int *out_end) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "WordpieceTokenizer: LookupWord Out of range");
   *out_found = false;
+  const WordTrie *trie = vocab_->trie();
+  if (trie != nullptr) {
+    // One walk down the trie from start finds every word which is a prefix of the rest of the token, the last one
+    // which ends at the end of a rune is the longest match.
+    WordTrie::State state = WordTrie::kRoot;
+    if (start > 0 && !trie->Walk(&state, suffix_indicator_)) {
+      return Status::OK();
+    }
+    size_t i = 0;
+    while (i < runes.size() && static_cast<int>(runes[i].offset) < start) {
+      i++;
+    }
+    for (; i < runes.size(); i++) {
+      std::string_view rune(input_token.data() + runes[i].offset, runes[i].len);
+      if (!trie->Walk(&state, rune)) {
+        break;
+      }
+      if (trie->Value(state) != WordTrie::kNoWord) {
+        *out_found = true;
+        *out_end = runes[i].offset + runes[i].len;
+      }
+    }
+    return Status::OK();
+  }
   for (int i = runes.size() - 1; i >= 0; i--) {
     *out_end = runes[i].offset + runes[i].len;
     int len = *out_end - start;
@@ -28,13 +28,27 @@
 
 namespace mindspore {
 namespace dataset {
-Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) { word2id_ = std::move(word2id); }
+Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) {
+  word2id_ = std::move(word2id);
+  BuildTrie();
+}
 
-WordIdType Vocab::Lookup(const WordType &word) const {
-  auto itr = word2id_.find(word);
+WordIdType Vocab::Lookup(std::string_view word) const {
+  if (!trie_.empty()) {
+    return trie_.Find(word);
+  }
+  auto itr = word2id_.find(std::string(word));
   return itr == word2id_.end() ? kNoTokenExists : itr->second;
 }
 
+void Vocab::BuildTrie() {
+  Status rc = trie_.Build(word2id_);
+  if (rc.IsError()) {
+    // The lookups fall back to the map
+    MS_LOG(WARNING) << "Vocab: failed to build the trie of the words, " << rc.ToString();
+  }
+}
+
 #ifdef ENABLE_PYTHON
 Status Vocab::BuildFromPyList(const py::list &words, const py::list &special_tokens, bool prepend_special,
                               std::shared_ptr<Vocab> *vocab) {
@@ -71,6 +85,7 @@ Status Vocab::BuildFromPyDict(const py::dict &words, std::shared_ptr<Vocab> *voc
 void Vocab::append_word(const std::string &word) {
   if (word2id_.find(word) == word2id_.end()) {
     word2id_[word] = word2id_.size();
+    trie_ = WordTrie();
   }
 }
 
@@ -18,10 +18,12 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_H_
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include "minddata/dataset/text/word_trie.h"
 #include "minddata/dataset/util/status.h"
 #ifdef ENABLE_PYTHON
 #include "pybind11/pybind11.h"
@@ -92,10 +94,18 @@ class Vocab {
                                  std::shared_ptr<Vocab> *vocab);
 
   // Lookup the id of a word, if word doesn't exist in vocab, return default_id
-  // @param const WordType word - word to look up
+  // @param std::string_view word - word to look up
   // @param WordIdType default_id - word id to return to user when its not in the vocab
   // @return WordIdType, word_id
-  WordIdType Lookup(const WordType &word) const;
+  WordIdType Lookup(std::string_view word) const;
+
+  // The trie of the words, for the walks which match several prefixes of a string at once.
+  // @return nullptr if the vocab has changed since the trie was built
+  const WordTrie *trie() const { return trie_.empty() ? nullptr : &trie_; }
+
+  // Build the trie of the words, the lookups use it from now on. The constructor builds it already, only a vocab
+  // filled by append_word needs this.
+  void BuildTrie();
 
   // constructor, shouldn't be called directly, can't be private due to std::make_unique()
   // @param std::unordered_map<WordType, WordIdType> map - sanitized word2id map
@@ -103,7 +113,7 @@ class Vocab {
 
   Vocab() = default;
 
-  // add one word to vocab, increment it's index automatically
+  // add one word to vocab, increment it's index automatically, the trie is dropped until BuildTrie is called again
   // @param std::string & word - word to be added will skip if word already exists
   void append_word(const std::string &word);
 
@@ -117,6 +127,7 @@ class Vocab {
 
  private:
   std::unordered_map<WordType, WordIdType> word2id_;
+  WordTrie trie_;  // the same words in a double-array trie, empty if not built
 };
 
 }  // namespace dataset
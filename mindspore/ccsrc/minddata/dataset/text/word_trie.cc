@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/word_trie.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+Status WordTrie::Build(const std::unordered_map<std::string, int32_t> &words) {
+  WordList sorted(words.begin(), words.end());
+  // std::string_view compares the bytes as unsigned char, the same order as the labels
+  std::sort(sorted.begin(), sorted.end());
+  base_.assign(1, 0);
+  check_.assign(1, -1);
+  ids_.clear();
+  ids_.reserve(sorted.size());
+  next_free_ = 1;
+  Status rc = Insert(sorted, 0, sorted.size(), 0, kRoot);
+  if (rc.IsError()) {
+    base_.clear();
+    check_.clear();
+    ids_.clear();
+    return rc;
+  }
+  base_.shrink_to_fit();
+  check_.shrink_to_fit();
+  return Status::OK();
+}
+
+Status WordTrie::Insert(const WordList &words, size_t lo, size_t hi, size_t depth, State state) {
+  // The children in the order of their labels, a word which ends here comes first since the words are sorted.
+  std::vector<int32_t> labels;
+  std::vector<size_t> starts;
+  for (size_t i = lo; i < hi; i++) {
+    int32_t label = words[i].first.size() == depth ? 0 : static_cast<uint8_t>(words[i].first[depth]) + 1;
+    if (labels.empty() || labels.back() != label) {
+      labels.push_back(label);
+      starts.push_back(i);
+    }
+  }
+  starts.push_back(hi);
+
+  int32_t base = FindBase(labels);
+  CHECK_FAIL_RETURN_UNEXPECTED(base >= 0, "Vocab: too many words to build the trie.");
+  base_[state] = base;
+  for (int32_t label : labels) {
+    check_[base + label] = state;
+  }
+  for (size_t k = 0; k < labels.size(); k++) {
+    State child = base + labels[k];
+    if (labels[k] == 0) {
+      base_[child] = -static_cast<int32_t>(ids_.size()) - 1;
+      ids_.push_back(words[starts[k]].second);
+    } else {
+      RETURN_IF_NOT_OK(Insert(words, starts[k], starts[k + 1], depth + 1, child));
+    }
+  }
+  return Status::OK();
+}
+
+int32_t WordTrie::FindBase(const std::vector<int32_t> &labels) {
+  while (next_free_ < check_.size() && check_[next_free_] != -1) {
+    next_free_++;
+  }
+  int32_t first = labels.empty() ? 0 : labels.front();
+  size_t base = std::max<size_t>(1, next_free_ > static_cast<size_t>(first) ? next_free_ - first : 1);
+  for (;; base++) {
+    // Every slot at or beyond the end of the arrays is free
+    bool fits = std::all_of(labels.begin(), labels.end(), [this, base](int32_t label) {
+      return base + label >= check_.size() || check_[base + label] == -1;
+    });
+    if (fits) {
+      break;
+    }
+  }
+  if (base + kNumLabels > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return -1;
+  }
+  // The arrays always reach past the last label of any base, so Value needs no bound check
+  if (check_.size() < base + kNumLabels) {
+    base_.resize(base + kNumLabels, 0);
+    check_.resize(base + kNumLabels, -1);
+  }
+  return static_cast<int32_t>(base);
+}
+}  // namespace dataset
+}  // namespace mindspore
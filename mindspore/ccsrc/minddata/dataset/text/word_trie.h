@@ -0,0 +1,106 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_WORD_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_WORD_TRIE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// An immutable double-array trie over the bytes of the words of a vocab.
+// A state of the trie is an index in two flat arrays, the child of state s for byte c is t = base_[s] + c + 1 which
+// belongs to s only if check_[t] == s. A lookup costs two array reads per byte, and there is no string to build,
+// a walk can stop at every word which is a prefix of the input, e.g. for the longest-prefix match of WordPiece.
+class WordTrie {
+ public:
+  using State = int32_t;
+  static constexpr State kRoot = 0;
+  static constexpr int32_t kNoWord = -1;
+
+  WordTrie() = default;
+
+  ~WordTrie() = default;
+
+  // Build the trie, the previous content is dropped.
+  // @param const std::unordered_map<std::string, int32_t> &words - words and their ids
+  // @return Status The status code returned
+  Status Build(const std::unordered_map<std::string, int32_t> &words);
+
+  // @return true if the trie has not been built
+  bool empty() const { return base_.empty(); }
+
+  // Follow the edge of one byte.
+  // @param State *state - the state to move from, it is moved only if the edge exists
+  // @param uint8_t c - the byte
+  // @return false if no word continues with this byte
+  bool Next(State *state, uint8_t c) const {
+    int32_t t = base_[*state] + c + 1;
+    if (t < static_cast<int32_t>(check_.size()) && check_[t] == *state) {
+      *state = t;
+      return true;
+    }
+    return false;
+  }
+
+  // Follow the edges of a sequence of bytes, the state is left where the walk stopped.
+  // @return false if no word continues with these bytes
+  bool Walk(State *state, std::string_view bytes) const {
+    for (char c : bytes) {
+      if (!Next(state, static_cast<uint8_t>(c))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // @return the id of the word which ends at state, or kNoWord
+  int32_t Value(State state) const {
+    int32_t t = base_[state];
+    return check_[t] == state ? ids_[-base_[t] - 1] : kNoWord;
+  }
+
+  // @return the id of a word, or kNoWord
+  int32_t Find(std::string_view word) const {
+    State state = kRoot;
+    return Walk(&state, word) ? Value(state) : kNoWord;
+  }
+
+ private:
+  using WordList = std::vector<std::pair<std::string_view, int32_t>>;
+
+  static constexpr int32_t kNumLabels = 257;  // the end of a word and the 256 bytes
+
+  // Place the children of a state, then the sub tries of the children, words[lo, hi) share the first depth bytes.
+  Status Insert(const WordList &words, size_t lo, size_t hi, size_t depth, State state);
+
+  // Find a base at which all the labels are free slots
+  int32_t FindBase(const std::vector<int32_t> &labels);
+
+  std::vector<int32_t> base_;   // base of the children, or -(index in ids_ + 1) for the end of a word
+  std::vector<int32_t> check_;  // the parent of a slot, -1 if the slot is free
+  std::vector<int32_t> ids_;
+  size_t next_free_ = 1;  // no free slot before this one
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_WORD_TRIE_H_
@@ -149,6 +149,25 @@ class Queue {
     tail_ = 0;
   }
 
+  // Change the capacity while producers and consumers are active. The elements in the queue keep their order,
+  // and the capacity can not go below the number of elements in the queue.
+  Status Resize(int sz) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    CHECK_FAIL_RETURN_UNEXPECTED(sz > 0 && static_cast<size_t>(sz) >= size(),
+                                 "Queue can not be resized to " + std::to_string(sz) + ".");
+    MemGuard<T, Allocator<T>> arr(Services::GetAllocator<T>());
+    RETURN_IF_NOT_OK(arr.allocate(sz));
+    for (auto i = head_; i < tail_; ++i) {
+      *(arr[i - head_]) = std::move(*(arr_[i % sz_]));
+    }
+    arr_ = std::move(arr);
+    tail_ -= head_;
+    head_ = 0;
+    sz_ = sz;
+    full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
   Status Register(TaskGroup *vg) {
     Status rc1 = empty_cv_.Register(vg->GetIntrpService());
     Status rc2 = full_cv_.Register(vg->GetIntrpService());
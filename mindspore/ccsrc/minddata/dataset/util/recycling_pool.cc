@@ -0,0 +1,353 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/recycling_pool.h"
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+#include <sched.h>
+#endif
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "./securec.h"
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+std::atomic<uint64_t> g_next_pool_id(0);
+
+// The pools alive. A thread cache is given back at the exit of the thread only if its pool is still in here.
+std::mutex &LivePoolsMutex() {
+  static std::mutex mux;
+  return mux;
+}
+
+std::unordered_map<uint64_t, RecyclingPool *> &LivePools() {
+  static std::unordered_map<uint64_t, RecyclingPool *> pools;
+  return pools;
+}
+
+// The caches of the calling thread, one per pool the thread has used.
+struct ThreadCaches {
+  ~ThreadCaches() {
+    std::unique_lock<std::mutex> lock(LivePoolsMutex());
+    for (auto &entry : caches) {
+      auto itr = LivePools().find(entry.first);
+      if (itr != LivePools().end()) {
+        itr->second->ReleaseThreadCache(entry.second);
+      }
+    }
+  }
+
+  std::vector<std::pair<uint64_t, RecyclingPool::ThreadCache *>> caches;
+};
+
+thread_local ThreadCaches g_thread_caches;
+}  // namespace
+
+RecyclingPool::RecyclingPool(std::shared_ptr<MemoryPool> backing, uint64_t max_cached_bytes)
+    : backing_(std::move(backing)),
+      enabled_(true),
+      max_cached_bytes_(max_cached_bytes),
+      id_(g_next_pool_id++),
+      num_allocs_(0),
+      num_thread_hits_(0),
+      num_node_hits_(0) {
+  InitNumaNodes();
+  int32_t num_nodes = cpu_to_node_.empty() ? 1 : *std::max_element(cpu_to_node_.begin(), cpu_to_node_.end()) + 1;
+  for (int32_t i = 0; i < num_nodes; i++) {
+    nodes_.push_back(std::make_unique<NodeCache>());
+  }
+  std::unique_lock<std::mutex> lock(LivePoolsMutex());
+  LivePools()[id_] = this;
+}
+
+RecyclingPool::~RecyclingPool() {
+  {
+    std::unique_lock<std::mutex> lock(LivePoolsMutex());
+    LivePools().erase(id_);
+  }
+  for (auto &cache : thread_caches_) {
+    ReleaseAll(&cache->blocks);
+  }
+  for (auto &node : nodes_) {
+    ReleaseAll(&node->blocks);
+  }
+}
+
+int32_t RecyclingPool::SizeClass(size_t n) {
+  if (n < kMinBlockSize) {
+    return kNotPooled;
+  }
+  if (n == kMinBlockSize) {
+    return 0;
+  }
+  // Class c holds (4 + c % 4) << (c / 4 + 10) bytes, i.e. the two bits below the highest bit of n - 1 pick one of
+  // the 4 classes of a power of two, and the carry of the last one moves to the next power of two.
+  uint64_t m = n - 1;
+  int32_t shift = kMinBlockShift;
+  while ((m >> (shift + 1)) != 0) {
+    shift++;
+  }
+  int32_t sub = static_cast<int32_t>(m >> (shift - 2)) - kClassesPerShift + 1;
+  int32_t size_class = (shift - kMinBlockShift) * kClassesPerShift + sub;
+  return size_class < kNumClasses ? size_class : kNotPooled;
+}
+
+size_t RecyclingPool::ClassSize(int32_t size_class) {
+  return static_cast<size_t>(kClassesPerShift + size_class % kClassesPerShift)
+         << (kMinBlockShift + size_class / kClassesPerShift - 2);
+}
+
+void RecyclingPool::InitNumaNodes() {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+  // Same as the cache server, the cpu list of a node is read from sysfs rather than from libnuma.
+  for (int32_t node = 0;; node++) {
+    std::ifstream fs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (fs.fail()) {
+      break;
+    }
+    std::string cpu_list;
+    std::getline(fs, cpu_list);
+    std::stringstream ss(cpu_list);
+    std::string range;
+    // The list is in the form of 0-15,32-47
+    while (std::getline(ss, range, ',')) {
+      if (range.empty()) {
+        continue;
+      }
+      auto pos = range.find('-');
+      int32_t cpu_min = std::stoi(range.substr(0, pos));
+      int32_t cpu_max = pos == std::string::npos ? cpu_min : std::stoi(range.substr(pos + 1));
+      if (cpu_to_node_.size() <= static_cast<size_t>(cpu_max)) {
+        cpu_to_node_.resize(cpu_max + 1, 0);
+      }
+      std::fill(cpu_to_node_.begin() + cpu_min, cpu_to_node_.begin() + cpu_max + 1, node);
+    }
+  }
+#endif
+}
+
+int32_t RecyclingPool::CurrentNode() const {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+  int cpu = sched_getcpu();
+  if (cpu >= 0 && static_cast<size_t>(cpu) < cpu_to_node_.size()) {
+    return cpu_to_node_[cpu];
+  }
+#endif
+  return 0;
+}
+
+RecyclingPool::ThreadCache *RecyclingPool::GetThreadCache() {
+  for (auto &entry : g_thread_caches.caches) {
+    if (entry.first == id_) {
+      return entry.second;
+    }
+  }
+  std::unique_lock<std::mutex> lock(thread_caches_mux_);
+  thread_caches_.push_back(std::make_unique<ThreadCache>());
+  ThreadCache *cache = thread_caches_.back().get();
+  g_thread_caches.caches.emplace_back(id_, cache);
+  return cache;
+}
+
+void RecyclingPool::ReleaseThreadCache(ThreadCache *cache) {
+  {
+    std::unique_lock<std::mutex> cache_lock(cache->mux);
+    for (auto &blocks : cache->blocks) {
+      for (void *p : blocks) {
+        ReleaseToNode(p);
+      }
+    }
+  }
+  std::unique_lock<std::mutex> lock(thread_caches_mux_);
+  auto itr = std::find_if(thread_caches_.begin(), thread_caches_.end(),
+                          [cache](const std::unique_ptr<ThreadCache> &c) { return c.get() == cache; });
+  if (itr != thread_caches_.end()) {
+    thread_caches_.erase(itr);
+  }
+}
+
+void RecyclingPool::ReleaseToNode(void *p) {
+  BlockHeader *header = Header(p);
+  size_t size = ClassSize(header->size_class);
+  NodeCache *node = nodes_[header->node].get();
+  if (enabled_) {
+    std::unique_lock<std::mutex> lock(node->mux);
+    if (node->bytes + size <= max_cached_bytes_) {
+      node->blocks[header->size_class].push_back(p);
+      node->bytes += size;
+      return;
+    }
+  }
+  backing_->Deallocate(header);
+}
+
+void RecyclingPool::ReleaseAll(FreeLists *blocks) {
+  for (auto &list : *blocks) {
+    for (void *p : list) {
+      backing_->Deallocate(Header(p));
+    }
+    list.clear();
+  }
+}
+
+void RecyclingPool::SetLimits(bool enabled, uint64_t max_cached_bytes) {
+  bool shrink = (enabled_ && !enabled) || max_cached_bytes < max_cached_bytes_;
+  enabled_ = enabled;
+  max_cached_bytes_ = max_cached_bytes;
+  if (shrink) {
+    Trim();
+  }
+}
+
+void RecyclingPool::Trim() {
+  {
+    std::unique_lock<std::mutex> lock(thread_caches_mux_);
+    for (auto &cache : thread_caches_) {
+      std::unique_lock<std::mutex> cache_lock(cache->mux);
+      ReleaseAll(&cache->blocks);
+      cache->bytes = 0;
+    }
+  }
+  for (auto &node : nodes_) {
+    std::unique_lock<std::mutex> lock(node->mux);
+    ReleaseAll(&node->blocks);
+    node->bytes = 0;
+  }
+}
+
+Status RecyclingPool::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  // A disabled pool still puts the header in front, the block may be freed after the pool is enabled again.
+  int32_t size_class = enabled_ ? SizeClass(n) : kNotPooled;
+  if (size_class == kNotPooled) {
+    void *q = nullptr;
+    RETURN_IF_NOT_OK(backing_->Allocate(n + sizeof(BlockHeader), &q));
+    auto *header = static_cast<BlockHeader *>(q);
+    header->size_class = kNotPooled;
+    header->node = 0;
+    *p = header + 1;
+    return Status::OK();
+  }
+
+  num_allocs_++;
+  size_t size = ClassSize(size_class);
+  ThreadCache *cache = GetThreadCache();
+  {
+    std::unique_lock<std::mutex> cache_lock(cache->mux);
+    auto &thread_blocks = cache->blocks[size_class];
+    if (!thread_blocks.empty()) {
+      *p = thread_blocks.back();
+      thread_blocks.pop_back();
+      cache->bytes -= size;
+      num_thread_hits_++;
+      return Status::OK();
+    }
+  }
+
+  int32_t node_id = CurrentNode();
+  NodeCache *node = nodes_[node_id].get();
+  {
+    std::unique_lock<std::mutex> lock(node->mux);
+    auto &node_blocks = node->blocks[size_class];
+    if (!node_blocks.empty()) {
+      *p = node_blocks.back();
+      node_blocks.pop_back();
+      node->bytes -= size;
+      num_node_hits_++;
+      return Status::OK();
+    }
+  }
+
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(backing_->Allocate(size + sizeof(BlockHeader), &q));
+  auto *header = static_cast<BlockHeader *>(q);
+  header->size_class = size_class;
+  header->node = node_id;
+  *p = header + 1;
+  return Status::OK();
+}
+
+Status RecyclingPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  int32_t size_class = Header(*p)->size_class;
+  if (size_class != kNotPooled && ClassSize(size_class) >= new_sz) {
+    return Status::OK();
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  errno_t err = memcpy_s(q, new_sz, *p, std::min(old_sz, new_sz));
+  if (err) {
+    Deallocate(q);
+    RETURN_STATUS_UNEXPECTED(std::to_string(err));
+  }
+  Deallocate(*p);
+  *p = q;
+  return Status::OK();
+}
+
+void RecyclingPool::Deallocate(void *p) {
+  BlockHeader *header = Header(p);
+  if (header->size_class == kNotPooled || !enabled_) {
+    backing_->Deallocate(header);
+    return;
+  }
+  size_t size = ClassSize(header->size_class);
+  ThreadCache *cache = GetThreadCache();
+  {
+    std::unique_lock<std::mutex> cache_lock(cache->mux);
+    auto &thread_blocks = cache->blocks[header->size_class];
+    if (header->node == CurrentNode() && thread_blocks.size() < static_cast<size_t>(kThreadCacheBlocks) &&
+        cache->bytes + size <= kThreadCacheBytes) {
+      thread_blocks.push_back(p);
+      cache->bytes += size;
+      return;
+    }
+  }
+  ReleaseToNode(p);
+}
+
+RecyclingPool::Stats RecyclingPool::GetStats() const {
+  Stats stats{num_allocs_, num_thread_hits_, num_node_hits_, 0};
+  for (auto &node : nodes_) {
+    std::unique_lock<std::mutex> lock(node->mux);
+    stats.cached_bytes += node->bytes;
+  }
+  std::unique_lock<std::mutex> lock(thread_caches_mux_);
+  for (auto &cache : thread_caches_) {
+    std::unique_lock<std::mutex> cache_lock(cache->mux);
+    stats.cached_bytes += cache->bytes;
+  }
+  return stats;
+}
+
+double RecyclingPool::HitRate() const {
+  uint64_t num_allocs = num_allocs_;
+  return num_allocs == 0 ? 0.0 : static_cast<double>(num_thread_hits_ + num_node_hits_) / num_allocs;
+}
+
+std::ostream &operator<<(std::ostream &os, const RecyclingPool &s) {
+  RecyclingPool::Stats stats = s.GetStats();
+  os << "Recycling pool: " << stats.num_allocs << " allocations, " << stats.num_thread_hits << " thread cache hits, "
+     << stats.num_node_hits << " numa node hits, hit rate " << s.HitRate() << ", " << s.nodes_.size()
+     << " numa node(s), keeping " << stats.cached_bytes << " free bytes" << (s.enabled() ? "" : ", disabled");
+  return os;
+}
+}  // namespace dataset
+}  // namespace mindspore
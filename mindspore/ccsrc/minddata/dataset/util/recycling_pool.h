@@ -0,0 +1,163 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RECYCLING_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RECYCLING_POOL_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+// A MemoryPool which keeps the freed blocks to hand them out again instead of returning them to the backing pool.
+// A pipeline allocates and frees buffers of the same few sizes for every row, so once the pool is warm almost all
+// the requests of a tensor buffer are served without going to the system allocator.
+//   - The requests are rounded up to size classes, 4 per power of two from 4K to 224M,
+//     so a block wastes less than a quarter of its size. Other sizes go straight to the backing pool.
+//   - Every thread keeps a few freed blocks for itself, the rest goes to the free lists of the numa node the block
+//     was first allocated on, the pages of a block stay on that node.
+//   - The free memory kept for a numa node is bounded by max_cached_bytes, beyond it the blocks are released.
+//   - A disabled pool passes every request to the backing pool, Trim() gives all the free blocks back to it.
+class RecyclingPool : public MemoryPool {
+ public:
+  // Counters of the requests of the pooled sizes
+  struct Stats {
+    uint64_t num_allocs;       // number of requests of a pooled size
+    uint64_t num_thread_hits;  // served by the cache of the thread
+    uint64_t num_node_hits;    // served by the free lists of the numa node
+    uint64_t cached_bytes;     // free memory kept in the free lists of the numa nodes and the thread caches
+  };
+
+  static constexpr int32_t kNumClasses = 64;  // 16 powers of two from 4K, the largest class is 224M
+
+  using FreeLists = std::array<std::vector<void *>, kNumClasses>;
+
+  // The blocks kept by a thread. It is owned by the pool, and given back to the pool when the thread exits.
+  // The mutex is only contended when the pool is trimmed.
+  struct ThreadCache {
+    std::mutex mux;
+    FreeLists blocks;
+    uint64_t bytes = 0;
+  };
+
+  // Constructor
+  // @param backing - the pool the blocks are allocated from
+  // @param max_cached_bytes - the free memory kept per numa node
+  RecyclingPool(std::shared_ptr<MemoryPool> backing, uint64_t max_cached_bytes);
+
+  ~RecyclingPool() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override { return backing_->get_max_size(); }
+
+  int PercentFree() const override { return backing_->PercentFree(); }
+
+  // Getter of the counters
+  Stats GetStats() const;
+
+  // Fraction of the requests of a pooled size served without the backing pool
+  double HitRate() const;
+
+  // Move the blocks of a thread cache to the free lists of their nodes and drop the cache.
+  void ReleaseThreadCache(ThreadCache *cache);
+
+  // Change the settings of the pool, all the free blocks are released if it is disabled or the limit is lowered.
+  // @param enabled - whether freed blocks are kept at all
+  // @param max_cached_bytes - the free memory kept per numa node
+  void SetLimits(bool enabled, uint64_t max_cached_bytes);
+
+  bool enabled() const { return enabled_; }
+
+  uint64_t max_cached_bytes() const { return max_cached_bytes_; }
+
+  // Give the free blocks of the numa nodes and of the caches of the threads still alive back to the backing pool,
+  // e.g. when a pipeline is torn down and its threads are idle.
+  void Trim();
+
+  // Unique id of the pool, ids are never reused.
+  uint64_t id() const { return id_; }
+
+  friend std::ostream &operator<<(std::ostream &os, const RecyclingPool &s);
+
+ private:
+  static constexpr size_t kMinBlockSize = 4096;
+  static constexpr int32_t kMinBlockShift = 12;
+  static constexpr int32_t kClassesPerShift = 4;
+  static constexpr int32_t kThreadCacheBlocks = 2;  // per size class
+  static constexpr uint64_t kThreadCacheBytes = 64 * 1024 * 1024;
+  static constexpr int32_t kNotPooled = -1;
+
+  // Put in front of every block, it keeps the 16 bytes alignment of malloc.
+  struct alignas(16) BlockHeader {
+    int32_t size_class;
+    int32_t node;
+  };
+
+  struct NodeCache {
+    std::mutex mux;
+    FreeLists blocks;
+    uint64_t bytes = 0;
+  };
+
+  // @return the size class of a request, or kNotPooled if the request goes to the backing pool
+  static int32_t SizeClass(size_t n);
+
+  static size_t ClassSize(int32_t size_class);
+
+  static BlockHeader *Header(void *p) { return reinterpret_cast<BlockHeader *>(p) - 1; }
+
+  // Read the cpu list of every numa node, cpu_to_node_ is left empty if there is no numa information.
+  void InitNumaNodes();
+
+  // The numa node of the cpu the calling thread is running on.
+  int32_t CurrentNode() const;
+
+  // Find the cache of the calling thread, it is created on the first use.
+  ThreadCache *GetThreadCache();
+
+  // Give a block back to the free lists of its node, or to the backing pool if the node keeps enough already.
+  void ReleaseToNode(void *p);
+
+  // Give the blocks of the free lists back to the backing pool.
+  void ReleaseAll(FreeLists *blocks);
+
+  std::shared_ptr<MemoryPool> backing_;
+  std::atomic<bool> enabled_;
+  std::atomic<uint64_t> max_cached_bytes_;
+  uint64_t id_;
+  std::vector<int32_t> cpu_to_node_;
+  std::vector<std::unique_ptr<NodeCache>> nodes_;
+  mutable std::mutex thread_caches_mux_;
+  std::vector<std::unique_ptr<ThreadCache>> thread_caches_;
+  std::atomic<uint64_t> num_allocs_;
+  std::atomic<uint64_t> num_thread_hits_;
+  std::atomic<uint64_t> num_node_hits_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RECYCLING_POOL_H_
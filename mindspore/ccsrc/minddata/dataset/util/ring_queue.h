@@ -0,0 +1,281 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/services.h"
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+// A bounded multi-producer multi-consumer queue on a fixed size ring of slots.
+// Every slot carries a sequence number which tells whether it is ready to be written or read for a given lap,
+// so producers and consumers only race on one atomic position each and never take a lock on the fast path.
+// A blocking Add/PopFront spins for a while and then parks on a condition variable; the parked threads are
+// counted, so the other side only takes the lock to notify when somebody is actually parked.
+// The interface follows Queue, so the two can be used interchangeably.
+template <typename T>
+class RingQueue {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+
+  explicit RingQueue(int sz)
+      : sz_(sz),
+        slots_(std::make_unique<Slot[]>(sz)),
+        enqueue_pos_(0),
+        dequeue_pos_(0),
+        push_waiters_(0),
+        pop_waiters_(0),
+        my_name_(Services::GetUniqueID()) {
+    for (size_t i = 0; i < sz_; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MS_LOG(DEBUG) << "Create ring queue with uuid " << my_name_ << " of size " << sz_ << ".";
+  }
+
+  virtual ~RingQueue() { ResetQue(); }
+
+  size_t size() const {
+    size_t head = dequeue_pos_.load(std::memory_order_acquire);
+    size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? std::min(tail - head, sz_) : 0;
+  }
+
+  size_t capacity() const { return sz_; }
+
+  bool empty() const { return size() == 0; }
+
+  void Reset() { ResetQue(); }
+
+  // Non-blocking producer. The element is moved into the queue only if it returns true.
+  bool TryPush(T *ele) noexcept {
+    if (!Enqueue(ele)) {
+      return false;
+    }
+    WakeUp(&pop_waiters_, &empty_cv_);
+    return true;
+  }
+
+  // Non-blocking consumer.
+  bool TryPop(pointer p) noexcept {
+    if (!Dequeue(p)) {
+      return false;
+    }
+    WakeUp(&push_waiters_, &full_cv_);
+    return true;
+  }
+
+  // Producer, blocks when full
+  Status Add(const_reference ele) noexcept {
+    T copy(ele);
+    return Add(std::move(copy));
+  }
+
+  Status Add(T &&ele) noexcept {
+    for (int i = 0; i < kSpinCount; ++i) {
+      if (TryPush(&ele)) {
+        return Status::OK();
+      }
+      Backoff(i);
+    }
+    RETURN_IF_NOT_OK(Park(&push_waiters_, &full_cv_, &empty_cv_, [this, &ele]() -> bool { return Enqueue(&ele); }));
+    WakeUp(&pop_waiters_, &empty_cv_);
+    return Status::OK();
+  }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    return Add(T(std::forward<Ts>(args)...));
+  }
+
+  // Consumer, blocks when empty
+  Status PopFront(pointer p) {
+    for (int i = 0; i < kSpinCount; ++i) {
+      if (TryPop(p)) {
+        return Status::OK();
+      }
+      Backoff(i);
+    }
+    RETURN_IF_NOT_OK(Park(&pop_waiters_, &empty_cv_, &full_cv_, [this, p]() -> bool { return Dequeue(p); }));
+    WakeUp(&push_waiters_, &full_cv_);
+    return Status::OK();
+  }
+
+  // Push all the elements of the vector in order, the parked consumers are notified once per batch
+  // unless the queue gets full in the middle.
+  Status AddBatch(std::vector<T> *eles) noexcept {
+    for (auto &ele : *eles) {
+      if (!Enqueue(&ele)) {
+        WakeUp(&pop_waiters_, &empty_cv_);
+        RETURN_IF_NOT_OK(Add(std::move(ele)));
+      }
+    }
+    eles->clear();
+    WakeUp(&pop_waiters_, &empty_cv_);
+    return Status::OK();
+  }
+
+  // Pop at least one and at most max_count elements to the end of eles, it only blocks when the queue is empty.
+  Status PopFrontBatch(std::vector<T> *eles, size_t max_count) {
+    T ele;
+    RETURN_IF_NOT_OK(PopFront(&ele));
+    eles->push_back(std::move(ele));
+    size_t count = 1;
+    while (count < max_count && Dequeue(&ele)) {
+      eles->push_back(std::move(ele));
+      count++;
+    }
+    if (count > 1) {
+      WakeUp(&push_waiters_, &full_cv_);
+    }
+    return Status::OK();
+  }
+
+  // Not thread safe, same as Queue it is called when neither side is active.
+  void ResetQue() noexcept {
+    // Every popped element is released when it is overwritten by the next one or val goes out of scope.
+    T val;
+    while (Dequeue(&val)) {
+    }
+    empty_cv_.ResetIntrpState();
+    full_cv_.ResetIntrpState();
+  }
+
+  Status Register(TaskGroup *vg) {
+    Status rc1 = empty_cv_.Register(vg->GetIntrpService());
+    Status rc2 = full_cv_.Register(vg->GetIntrpService());
+    if (rc1.IsOk()) {
+      return rc2;
+    } else {
+      return rc1;
+    }
+  }
+
+ private:
+  // Number of attempts before a blocking call parks, the second half of them yield the cpu.
+  static constexpr int kSpinCount = 64;
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Slot {
+    std::atomic<size_t> seq;
+    T data;
+  };
+
+  bool Enqueue(T *ele) noexcept {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    while (true) {
+      slot = &slots_[pos % sz_];
+      size_t seq = slot->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The slot still holds the element of the previous lap, i.e. the queue is full.
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->data = std::move(*ele);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool Dequeue(pointer p) noexcept {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    while (true) {
+      slot = &slots_[pos % sz_];
+      size_t seq = slot->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The slot is not written yet in this lap, i.e. the queue is empty.
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    *p = std::move(slot->data);
+    slot->seq.store(pos + sz_, std::memory_order_release);
+    return true;
+  }
+
+  static void Backoff(int attempt) {
+    if (attempt >= kSpinCount / 2) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Wait on cv until op succeeds. The waiter is counted before op is retried under the lock, and the other side
+  // checks the count after its own update, so one of them always sees the other.
+  template <typename F>
+  Status Park(std::atomic<int32_t> *waiters, CondVar *cv, CondVar *peer_cv, F &&op) {
+    std::unique_lock<std::mutex> lock(mux_);
+    waiters->fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Status rc = cv->Wait(&lock, op);
+    waiters->fetch_sub(1);
+    if (rc.IsError()) {
+      peer_cv->Interrupt();
+    }
+    return rc;
+  }
+
+  void WakeUp(std::atomic<int32_t> *waiters, CondVar *cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters->load(std::memory_order_relaxed) > 0) {
+      std::unique_lock<std::mutex> lock(mux_);
+      cv->NotifyAll();
+    }
+  }
+
+  size_t sz_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(kCacheLineSize) std::atomic<size_t> enqueue_pos_;
+  alignas(kCacheLineSize) std::atomic<size_t> dequeue_pos_;
+  alignas(kCacheLineSize) std::atomic<int32_t> push_waiters_;
+  std::atomic<int32_t> pop_waiters_;
+  std::string my_name_;
+  std::mutex mux_;
+  CondVar empty_cv_;
+  CondVar full_cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
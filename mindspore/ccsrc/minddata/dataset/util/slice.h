@@ -93,6 +93,7 @@ class WritableSlice : public ReadableSlice {
   friend class StorageContainer;
   friend class CacheService;
   friend class CacheServer;
+  friend class CacheCodec;
   /// \brief Default constructor
   WritableSlice() : ReadableSlice(), mutable_data_(nullptr) {}
   /// \brief This form of a constructor takes a pointer and its size.
@@ -66,7 +66,18 @@ const int kUnsignedInt4 = 4;
 enum LabelCategory { kSchemaLabel, kStatisticsLabel, kIndexLabel };
 
 const char kVersion[] = "3.0";
-const std::vector<std::string> kSupportedVersion = {"2.0", kVersion};
+// files with columnar raw pages or compressed blob pages carry their own version, so that older libraries
+// refuse to read them
+const char kExtendedVersion[] = "3.1";
+const std::vector<std::string> kSupportedVersion = {"2.0", kVersion, kExtendedVersion};
+
+// layout of the rows in raw data page
+const char kRawLayoutRow[] = "row";        // each row is a msgpack document
+const char kRawLayoutColumn[] = "column";  // each row is laid out by ShardColumn::SerializeRawRow
+
+// codec of the rows in blob data page
+const char kCodecNone[] = "none";
+const char kCodecZlib[] = "zlib";
 
 enum ShardType {
   kNLP = 0,
@@ -114,6 +125,9 @@ const int kMaxSchemaCount = 1;
 const int kMaxThreadCount = 32;
 const int kMaxFieldCount = 100;
 
+// batches written but not yet flushed in streaming mode, one being flushed and one waiting
+const size_t kMaxPendingBatches = 2;
+
 // Minimum free disk size
 const int kMinFreeDiskSize = 10;  // 10M
 
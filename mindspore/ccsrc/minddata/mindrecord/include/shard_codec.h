@@ -0,0 +1,58 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_CODEC_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_CODEC_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief block codec of the rows in blob data page
+/// every encoded row starts with a one byte method and the big-endian 8 bytes size of the decoded row,
+/// rows which do not shrink are stored as is, so incompressible data (e.g. jpeg) costs only the prefix
+class __attribute__((visibility("default"))) ShardCodec {
+ public:
+  virtual ~ShardCodec() = default;
+
+  /// \brief create codec by name
+  /// \param[in] name name of the codec, e.g. kCodecZlib
+  /// \return the codec, nullptr if the codec is unknown or not built in
+  static std::shared_ptr<ShardCodec> Create(const std::string &name);
+
+  /// \brief encode one row of blob data
+  MSRStatus Encode(const std::vector<uint8_t> &input, std::vector<uint8_t> *output) const;
+
+  /// \brief decode one row of blob data encoded by Encode
+  MSRStatus Decode(const std::vector<uint8_t> &input, std::vector<uint8_t> *output) const;
+
+ protected:
+  /// \brief compress input into output, output is resized to the compressed size
+  virtual MSRStatus Compress(const uint8_t *input, uint64_t input_size, std::vector<uint8_t> *output) const = 0;
+
+  /// \brief decompress input into output, which is already sized to the original size
+  virtual MSRStatus Decompress(const uint8_t *input, uint64_t input_size, std::vector<uint8_t> *output) const = 0;
+
+  /// \brief upper bound of decompressed size / compressed size, used to reject corrupt rows
+  virtual uint64_t MaxRatio() const = 0;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_CODEC_H_
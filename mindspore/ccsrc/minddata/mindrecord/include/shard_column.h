@@ -33,6 +33,7 @@ const uint64_t kNumDataOfByte = 4;
 const uint64_t kBytesOfColumnLen = 4;
 const uint64_t kDataTypeBitMask = 3;
 const uint64_t kDataTypes = 6;
+const uint64_t kBytesOfRawNumber = 8;  // numbers in columnar raw row are stored as int64 or float64
 
 enum IntegerType { kInt8Type = 0, kInt16Type, kInt32Type, kInt64Type };
 
@@ -71,6 +72,14 @@ class __attribute__((visibility("default"))) ShardColumn {
                                  ColumnDataType *column_data_type, uint64_t *column_data_type_size,
                                  std::vector<int64_t> *column_shape);
 
+  /// \brief get column value by column name, the blob is given as an address and size so that it can be borrowed
+  ///        from memory which is not owned by a vector, e.g. a memory-mapped shard file
+  MSRStatus GetColumnValueByName(const std::string &column_name, const unsigned char *columns_blob,
+                                 const uint64_t &blob_size, const json &columns_json, const unsigned char **data,
+                                 std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes,
+                                 ColumnDataType *column_data_type, uint64_t *column_data_type_size,
+                                 std::vector<int64_t> *column_shape);
+
   /// \brief compress blob
   std::vector<uint8_t> CompressBlob(const std::vector<uint8_t> &blob, int64_t *compression_size);
 
@@ -94,6 +103,11 @@ class __attribute__((visibility("default"))) ShardColumn {
                               const unsigned char **data, std::unique_ptr<unsigned char[]> *data_ptr,
                               uint64_t *const n_bytes);
 
+  /// \brief get column value from blob given by address and size
+  MSRStatus GetColumnFromBlob(const std::string &column_name, const unsigned char *columns_blob,
+                              const uint64_t &blob_size, const unsigned char **data,
+                              std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes);
+
   /// \brief get column type
   std::pair<MSRStatus, ColumnCategory> GetColumnTypeByName(const std::string &column_name,
                                                            ColumnDataType *column_data_type,
@@ -104,6 +118,22 @@ class __attribute__((visibility("default"))) ShardColumn {
   MSRStatus GetColumnFromJson(const std::string &column_name, const json &columns_json,
                               std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *n_bytes);
 
+  /// \brief serialize the raw columns (the ones not in blob) of a row in columnar layout:
+  ///        [number of raw columns][numbers, 8 bytes each][end offsets of strings, 4 bytes each][string data]
+  /// \param[in] row json of the row which contains all raw columns
+  /// \param[out] output serialized row
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus SerializeRawRow(const json &row, std::vector<uint8_t> *output);
+
+  /// \brief deserialize the raw columns of a row in columnar layout, the other columns are not decoded
+  /// \param[in] raw_row address of the serialized row
+  /// \param[in] row_size size of the serialized row
+  /// \param[in] columns raw columns to be decoded, all raw columns if empty, other columns are skipped
+  /// \param[out] row json of the decoded columns
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus DeserializeRawRow(const unsigned char *raw_row, const uint64_t &row_size,
+                              const std::vector<std::string> &columns, json *row);
+
  private:
   /// \brief intialization
   void Init(const json &schema_json, bool compress_integer = true);
@@ -117,8 +147,8 @@ class __attribute__((visibility("default"))) ShardColumn {
   MSRStatus GetInt(std::unique_ptr<unsigned char[]> *data_ptr, const json &json_column_value);
 
   /// \brief get column offset address and size from blob
-  MSRStatus GetColumnAddressInBlock(const uint64_t &column_id, const std::vector<uint8_t> &columns_blob,
-                                    uint64_t *num_bytes, uint64_t *shift_idx);
+  MSRStatus GetColumnAddressInBlock(const uint64_t &column_id, const unsigned char *columns_blob,
+                                    const uint64_t &blob_size, uint64_t *num_bytes, uint64_t *shift_idx);
 
   /// \brief check if column name is available
   ColumnCategory CheckColumnName(const std::string &column_name);
@@ -129,15 +159,14 @@ class __attribute__((visibility("default"))) ShardColumn {
   /// \brief uncompress integer array column
   template <typename T>
   static MSRStatus UncompressInt(const uint64_t &column_id, std::unique_ptr<unsigned char[]> *const data_ptr,
-                                 const std::vector<uint8_t> &columns_blob, uint64_t *num_bytes, uint64_t shift_idx);
+                                 const unsigned char *columns_blob, uint64_t *num_bytes, uint64_t shift_idx);
 
   /// \brief convert big-endian bytes to unsigned int
   /// \param bytes_array bytes array
   /// \param pos shift address in bytes array
   /// \param i_type integer type
   /// \return unsigned int
-  static uint64_t BytesBigToUInt64(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
-                                   const IntegerType &i_type);
+  static uint64_t BytesBigToUInt64(const unsigned char *bytes_array, const uint64_t &pos, const IntegerType &i_type);
 
   /// \brief convert unsigned int to big-endian bytes
   /// \param value integer value
@@ -157,7 +186,7 @@ class __attribute__((visibility("default"))) ShardColumn {
   /// \param src_i_type source integer typ0e
   /// \param dst_i_type (output), destination integer type
   /// \return integer
-  static int64_t BytesLittleToMinIntType(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
+  static int64_t BytesLittleToMinIntType(const unsigned char *bytes_array, const uint64_t &pos,
                                          const IntegerType &src_i_type, IntegerType *dst_i_type = nullptr);
 
  private:
@@ -169,6 +198,10 @@ class __attribute__((visibility("default"))) ShardColumn {
   std::unordered_map<std::string, uint64_t> blob_column_id_;  // blob column name id map
   bool has_compress_blob_;                                    // if has compress blob
   uint64_t num_blob_column_;                                  // number of blob columns
+
+  std::vector<std::string> raw_column_;                                 // raw column list
+  std::unordered_map<std::string, uint64_t> raw_number_column_offset_;  // number offset in columnar raw row
+  std::unordered_map<std::string, uint64_t> raw_string_column_id_;      // string id in columnar raw row
 };
 }  // namespace mindrecord
 }  // namespace mindspore
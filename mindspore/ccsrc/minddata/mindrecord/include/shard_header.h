@@ -121,12 +121,20 @@ class __attribute__((visibility("default"))) ShardHeader {
 
   uint64_t GetCompressionSize() const { return compression_size_; }
 
+  std::string GetRawLayout() const { return raw_layout_; }
+
+  std::string GetPageCodec() const { return page_codec_; }
+
   void SetHeaderSize(const uint64_t &header_size) { header_size_ = header_size; }
 
   void SetPageSize(const uint64_t &page_size) { page_size_ = page_size; }
 
   void SetCompressionSize(const uint64_t &compression_size) { compression_size_ = compression_size; }
 
+  void SetRawLayout(const std::string &raw_layout) { raw_layout_ = raw_layout; }
+
+  void SetPageCodec(const std::string &page_codec) { page_codec_ = page_codec; }
+
   std::vector<std::string> SerializeHeader();
 
   MSRStatus PagesToFile(const std::string dump_file_name);
@@ -187,6 +195,8 @@ class __attribute__((visibility("default"))) ShardHeader {
   uint64_t header_size_;
   uint64_t page_size_;
   uint64_t compression_size_;
+  std::string raw_layout_;
+  std::string page_codec_;
 
   std::shared_ptr<Index> index_;
   std::vector<std::string> shard_addresses_;
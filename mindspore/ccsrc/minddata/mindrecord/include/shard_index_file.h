@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_FILE_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+const char kIndexFileSuffix[] = ".idx";
+
+/// \brief location of one row, same as the columns of table INDEXES
+struct IndexFileRow {
+  uint64_t row_group_id;
+  uint64_t page_id_raw;
+  uint64_t page_offset_raw;
+  uint64_t page_offset_raw_end;
+  uint64_t page_id_blob;
+  uint64_t page_offset_blob;
+  uint64_t page_offset_blob_end;
+};
+
+/// \brief one row to be written into index file
+struct IndexFileEntry {
+  uint64_t row_id;
+  IndexFileRow row;
+  std::vector<std::string> values;  // values of index fields, in the order of field names
+};
+
+/// \brief sorted index file written next to each shard file, a compact replacement of the sqlite index
+/// layout, all numbers are uint64 in host byte order:
+///   magic | row count | field count | field names | rows ordered by row id |
+///   per field: value end offsets | row ids sorted by (value, blob page id) | values
+class __attribute__((visibility("default"))) ShardIndexFile {
+ public:
+  ShardIndexFile() = default;
+
+  ~ShardIndexFile();
+
+  ShardIndexFile(const ShardIndexFile &) = delete;
+
+  ShardIndexFile &operator=(const ShardIndexFile &) = delete;
+
+  /// \brief write index file
+  /// \param[in] file_path path of the index file
+  /// \param[in] field_names names of index fields as the columns of table INDEXES, e.g. label_0
+  /// \param[in] entries rows of the shard, row ids must be 0 ~ n-1 in any order
+  /// \return MSRStatus the status of MSRStatus
+  static MSRStatus Write(const std::string &file_path, const std::vector<std::string> &field_names,
+                         std::vector<IndexFileEntry> *entries);
+
+  /// \brief map index file into memory and check its layout
+  MSRStatus Open(const std::string &file_path);
+
+  uint64_t GetRowCount() const { return row_count_; }
+
+  /// \brief get field id by field name, -1 if the field is not indexed
+  int GetFieldId(const std::string &field_name) const;
+
+  /// \brief get location of row by row id
+  const IndexFileRow &GetRow(uint64_t row_id) const { return rows_[row_id]; }
+
+  /// \brief get value of field in row, as it is stored in table INDEXES
+  std::string_view GetValue(int field_id, uint64_t row_id) const;
+
+  /// \brief get ids of the rows in blob page whose field equals value, by binary search
+  std::vector<uint64_t> FindRows(int field_id, const std::string &value, uint64_t page_id_blob) const;
+
+  /// \brief get distinct values of field
+  std::vector<std::string> GetDistinctValues(int field_id) const;
+
+ private:
+  struct Field {
+    const uint64_t *value_ends;
+    const uint64_t *sorted_rows;
+    const char *values;
+  };
+
+  void Close();
+
+  const uint8_t *data_ = nullptr;
+  uint64_t size_ = 0;
+  bool mapped_ = false;
+  std::vector<uint8_t> buffer_;  // file content where mmap is not available
+  uint64_t row_count_ = 0;
+  const IndexFileRow *rows_ = nullptr;
+  std::vector<std::string> field_names_;
+  std::vector<Field> fields_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_FILE_H_
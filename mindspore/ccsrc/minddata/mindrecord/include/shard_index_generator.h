@@ -25,13 +25,23 @@
 #include <tuple>
 #include <utility>
 #include <vector>
+#include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_header.h"
+#include "minddata/mindrecord/include/shard_index_file.h"
 #include "./sqlite3.h"
 
 namespace mindspore {
 namespace mindrecord {
 using INDEX_FIELDS = std::pair<MSRStatus, std::vector<std::tuple<std::string, std::string, std::string>>>;
 using ROW_DATA = std::pair<MSRStatus, std::vector<std::vector<std::tuple<std::string, std::string, std::string>>>>;
+
+/// \brief size and index fields of one row, collected by ShardWriter as the pages are flushed
+struct RowIndexInfo {
+  uint64_t raw_size;               // size of the row in raw page, including the size prefixes
+  uint64_t blob_size;              // size of the row in blob page, including the size prefix
+  std::vector<json> index_detail;  // index fields of the row, one json per schema
+};
+
 class __attribute__((visibility("default"))) ShardIndexGenerator {
  public:
   explicit ShardIndexGenerator(const std::string &file_path, bool append = false);
@@ -54,6 +64,13 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
   /// \return the type of field
   static std::string TakeFieldType(const std::string &field_path, json schema);
 
+  /// \brief use the rows collected by ShardWriter instead of reading them back from the shard files
+  /// \param[in] row_index_info rows of each shard ordered by row id, a shard is read from file if they do not
+  ///        cover all of its rows
+  void SetRowIndexInfo(std::vector<std::vector<RowIndexInfo>> row_index_info) {
+    row_index_info_ = std::move(row_index_info);
+  }
+
   /// \brief create databases for indexes
   MSRStatus WriteToDatabase();
 
@@ -81,7 +98,7 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
   /// \param in
   /// \return field name, db type, field value
   ROW_DATA GenerateRowData(int shard_no, const std::map<int, int> &blob_id_to_page_id, int raw_page_id,
-                           std::fstream &in);
+                           std::fstream &in, const std::vector<RowIndexInfo> *row_index_info);
   ///
   /// \param db
   /// \param sql
@@ -94,7 +111,15 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
   INDEX_FIELDS GenerateIndexFields(const std::vector<json> &schema_detail);
 
   MSRStatus ExecuteTransaction(const int &shard_no, std::pair<MSRStatus, sqlite3 *> &db,
-                               const std::vector<int> &raw_page_ids, const std::map<int, int> &blob_id_to_page_id);
+                               const std::vector<int> &raw_page_ids, const std::map<int, int> &blob_id_to_page_id,
+                               const std::vector<RowIndexInfo> *row_index_info);
+
+  /// \brief convert the row data bound to table INDEXES into an entry of index file
+  std::pair<MSRStatus, IndexFileEntry> GenerateIndexFileEntry(
+    const std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
+
+  /// \brief write the sorted index file next to shard file, readers fall back to sqlite if it fails
+  void WriteIndexFile(const std::string &shard_address, std::vector<IndexFileEntry> *entries);
 
   MSRStatus CreateShardNameTable(sqlite3 *db, const std::string &shard_name);
 
@@ -116,6 +141,8 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
+  std::shared_ptr<ShardColumn> shard_column_;  // decoder for columnar raw pages
+  std::vector<std::vector<RowIndexInfo>> row_index_info_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
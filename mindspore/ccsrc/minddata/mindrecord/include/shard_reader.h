@@ -22,12 +22,16 @@
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
 #include <sys/prctl.h>
 #endif
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#endif
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -44,9 +48,11 @@
 #include <vector>
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_category.h"
+#include "minddata/mindrecord/include/shard_codec.h"
 #include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_index_file.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
@@ -63,7 +69,13 @@ using ROW_GROUP_BRIEF =
   std::tuple<MSRStatus, std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_RETURN_CONTENT =
   std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>>;
-const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
+// address and size of a blob which is borrowed from a memory-mapped shard file
+using BLOB_SLICE = std::pair<const uint8_t *, uint64_t>;
+using TASK_SLICE_CONTENT = std::pair<TaskType, std::vector<std::tuple<BLOB_SLICE, json>>>;
+const int kNumBatchInMap = 1000;     // iterator buffer size in row-reader mode
+const int kMmapReadAheadTasks = 16;  // number of tasks to page in ahead of the consumer in mmap read mode
+const int kNumPrefetchThreads = 4;   // number of threads which read blobs of prefetched tasks
+const int kMaxPrefetchTasks = 1024;  // maximum number of blobs which are queued or cached by prefetch threads
 
 class __attribute__((visibility("default"))) ShardReader {
  public:
@@ -125,6 +137,10 @@ class __attribute__((visibility("default"))) ShardReader {
   /// \return # of shards
   int GetShardCount() const;
 
+  /// \brief get the paths of the shard files
+  /// \return the paths of the shard files
+  std::vector<std::string> GetFilePaths() const { return file_paths_; }
+
   /// \brief get the number of rows in database
   /// \param[in] file_paths the path of ONE file, any file in dataset is fine or file list
   /// \param[in] load_dataset load dataset from single file or not
@@ -186,6 +202,17 @@ class __attribute__((visibility("default"))) ShardReader {
   std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> GetNextById(const int64_t &task_id,
                                                                                        const int32_t &consumer_id);
 
+  /// \brief return a row by id as slices of the memory-mapped shard file, mmap read mode only
+  /// \note the slices are borrowed from the mapping and stay valid until the reader is closed
+  /// \return a batch of image slices and image data
+  TASK_SLICE_CONTENT GetNextSliceById(const int64_t &task_id, const int32_t &consumer_id);
+
+  /// \brief submit a batch of tasks which will be read soon, their blobs are read asynchronously by the prefetch
+  ///        threads and completed out of order, GetNextById picks them up without touching the file again
+  /// \param[in] task_ids ids of the tasks to prefetch, ids out of range are ignored
+  /// \return null
+  void Prefetch(const std::vector<int64_t> &task_ids);
+
   /// \brief return a batch, given that one is ready, python API
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<std::vector<uint8_t>>, pybind11::object>> GetNextPy();
@@ -202,6 +229,17 @@ class __attribute__((visibility("default"))) ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief set flag of mmap read mode, it should be called before Open
+  /// \return null
+  void SetUseMmap(bool use_mmap) { use_mmap_ = use_mmap; }
+
+  /// \brief get flag of mmap read mode, false if the shard files could not be mapped or their pages are encoded
+  bool GetUseMmap() const { return use_mmap_; }
+
+  /// \brief set flag of asynchronous prefetch, it should be called before Open
+  /// \return null
+  void SetUsePrefetch(bool use_prefetch) { use_prefetch_ = use_prefetch; }
+
   /// \brief get all classes
   MSRStatus GetAllClasses(const std::string &category_field, std::set<std::string> &categories);
 
@@ -230,6 +268,24 @@ class __attribute__((visibility("default"))) ShardReader {
                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
                                std::vector<std::vector<json>> &column_values);
 
+  /// \brief read rows [row_begin, row_end) of one shard from its sorted index file
+  MSRStatus ReadRowsInIndexFile(int shard_id, uint64_t row_begin, uint64_t row_end,
+                                const std::vector<std::string> &columns,
+                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                                std::vector<std::vector<json>> &column_values);
+
+  /// \brief read the selected columns of one row from raw data page
+  MSRStatus ReadLabelFromRawPage(const std::shared_ptr<std::fstream> &fs, uint64_t raw_page_id, uint64_t label_start,
+                                 uint64_t label_end, const std::vector<std::string> &columns, json *label);
+
+  /// \brief open the sorted index files next to shard files, shards without a valid one use index db
+  void LoadIndexFiles(const std::vector<std::tuple<int, int, int, uint64_t>> &row_group_summary);
+
+  /// \brief find the rows in blob page matching criteria by the sorted index file
+  /// \return false if the shard has no index file or the criteria is empty
+  bool FindRowsInIndexFile(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                           std::vector<uint64_t> *row_ids);
+
   /// \brief initialize reader
   MSRStatus Init(const std::vector<std::string> &file_paths, bool load_dataset);
 
@@ -278,6 +334,37 @@ class __attribute__((visibility("default"))) ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
+  /// \brief map all shard files into memory, shared by all consumers
+  MSRStatus MmapShardFiles();
+
+  /// \brief unmap all shard files
+  void MunmapShardFiles();
+
+  /// \brief locate the blob of one task in its shard file
+  /// \param[in] task_index index of the task in task list, i.e. the task id after permutation
+  MSRStatus GetTaskBlobAddress(uint32_t task_index, TaskType *task_type, uint32_t *shard_id, uint64_t *file_offset,
+                               uint64_t *blob_size, json *var_fields);
+
+  /// \brief read the blob of one task by file stream
+  MSRStatus ReadTaskBlob(uint32_t stream_id, uint32_t shard_id, uint64_t file_offset, uint64_t blob_size,
+                         std::vector<uint8_t> *blob);
+
+  /// \brief read blobs of the tasks submitted by Prefetch
+  MSRStatus PrefetchByRow(int prefetch_id, uint32_t stream_id);
+
+  /// \brief take the blob of one task from prefetch cache, wait for it if it is being read
+  /// \return false if the task was not prefetched
+  bool TakePrefetchedTask(uint32_t task_index, std::vector<uint8_t> *blob, json *var_fields);
+
+  /// \brief stop and join prefetch threads
+  void StopPrefetch();
+
+  /// \brief drop all prefetched tasks and wait for the ones being read, so that tasks_ can be changed afterwards
+  void ClearPrefetch();
+
+  /// \brief advise the kernel to page in the blob of a task which will be read soon
+  void WillNeedTask(int task_id);
+
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
@@ -288,6 +375,9 @@ class __attribute__((visibility("default"))) ShardReader {
   /// \brief get classes in one shard
   void GetClassesInShard(sqlite3 *db, int shard_id, const std::string sql, std::set<std::string> &categories);
 
+  /// \brief get classes in one shard by its sorted index file, false if the shard has no index file
+  bool GetClassesInIndexFile(int shard_id, const std::string &field_name, std::set<std::string> &categories);
+
   /// \brief get number of classes
   int64_t GetNumClasses(const std::string &category_field);
 
@@ -298,16 +388,22 @@ class __attribute__((visibility("default"))) ShardReader {
   std::pair<MSRStatus, std::vector<std::vector<uint8_t>>> UnCompressBlob(const std::vector<uint8_t> &raw_blob_data);
 
  protected:
+  /// \brief decode the blob of one task by the codec of blob data page
+  MSRStatus DecodeBlob(std::vector<uint8_t> *blob) const;
+
   uint64_t header_size_;                       // header size
   uint64_t page_size_;                         // page size
   int shard_count_;                            // number of shards
   std::shared_ptr<ShardHeader> shard_header_;  // shard header
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
+  std::shared_ptr<ShardCodec> page_codec_;     // codec of blob data page, nullptr if not compressed
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardIndexFile>> index_files_;                     // nullptr if shard has no index file
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::pair<uint8_t *, uint64_t>> file_mmaps_;                       // mapped address and size of files
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -318,8 +414,10 @@ class __attribute__((visibility("default"))) ShardReader {
   std::mutex shard_locker_;                                // locker of shard
 
   // flags
-  bool all_in_index_ = true;  // if all columns are stored in index-table
-  bool interrupt_ = false;    // reader interrupted
+  bool all_in_index_ = true;   // if all columns are stored in index-table
+  bool interrupt_ = false;     // reader interrupted
+  bool use_mmap_ = false;      // read blobs from memory-mapped shard files
+  bool use_prefetch_ = false;  // read blobs of upcoming tasks asynchronously
 
   int num_padded_;  // number of padding samples
 
@@ -337,6 +435,23 @@ class __attribute__((visibility("default"))) ShardReader {
   std::unordered_map<int, std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>>> delivery_map_;
   // Delivery/Iterator mode end
 
+  // Prefetch mode begin
+  const std::string kPrefetchThreadName = "THRD_PREFETCH_";  // prefix of prefetch thread name
+  std::vector<std::thread> prefetch_threads_;                // prefetch thread list
+  std::mutex mtx_prefetch_;                                  // locker for prefetch
+  std::condition_variable cv_prefetch_;                      // conditional variable for prefetch threads
+  std::condition_variable cv_prefetch_done_;                 // conditional variable for consumers waiting a blob
+  bool prefetch_stop_ = false;                               // prefetch threads should quit
+  uint64_t prefetch_generation_ = 0;                         // bumped when prefetched tasks are dropped
+  int prefetch_in_flight_ = 0;                               // number of tasks being read by prefetch threads
+  // task index and generation to be read
+  std::deque<std::pair<uint32_t, uint64_t>> prefetch_queue_;
+  // task index which is queued (false) or being read (true)
+  std::unordered_map<uint32_t, bool> prefetch_pending_;
+  // task index : blob and scalar variable fields read by prefetch threads
+  std::unordered_map<uint32_t, std::pair<std::vector<uint8_t>, json>> prefetch_cache_;
+  // Prefetch mode end
+
   // all metadata in the index is not loaded during initialization
   bool lazy_load_;
 
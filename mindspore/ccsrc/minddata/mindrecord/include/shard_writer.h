@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <functional>
@@ -36,10 +38,12 @@
 #include <utility>
 #include <vector>
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_codec.h"
 #include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "minddata/mindrecord/include/shard_index.h"
+#include "minddata/mindrecord/include/shard_index_generator.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 #include "utils/log_adapter.h"
@@ -83,6 +87,26 @@ class __attribute__((visibility("default"))) ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   MSRStatus SetShardHeader(std::shared_ptr<ShardHeader> header_data);
 
+  /// \brief Set layout of raw data page, columnar rows let readers decode only the columns they load
+  /// \param[in] columnar lay out raw columns of each row by column instead of as a msgpack document
+  ///        WARNING, only called after SetShardHeader and before any raw data is written
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus SetColumnarRawPage(bool columnar);
+
+  /// \brief Set codec of the rows in blob data page
+  /// \param[in] codec kCodecNone or the name of a codec supported by ShardCodec, e.g. kCodecZlib
+  ///        WARNING, only called after SetShardHeader and before any raw data is written
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus SetPageCodec(const std::string &codec);
+
+  /// \brief Set streaming mode, the rows are cut into pages and flushed by a background thread while the next
+  ///        rows are serialized, and Commit generates the index from the rows collected as the pages are flushed
+  /// \param[in] streaming write in streaming mode or not
+  ///        WARNING, ShardIndexGenerator must not be run after Commit in streaming mode, and parallel_writer of
+  ///        WriteRawData is not supported
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus SetStreamingMode(bool streaming);
+
   /// \brief write raw data by group size
   /// \param[in] raw_data the vector of raw json data, vector format
   /// \param[in] blob_data the vector of image data
@@ -116,9 +140,42 @@ class __attribute__((visibility("default"))) ShardWriter {
                               const std::vector<std::string> &file_names);
 
  private:
+  /// \brief rows serialized by WriteRawData, to be cut into pages and flushed
+  struct RowBatch {
+    uint32_t row_count = 0;
+    uint32_t schema_count = 0;
+    std::vector<std::vector<uint8_t>> bin_raw_data;
+    std::vector<std::vector<uint8_t>> blob_data;
+    std::vector<uint64_t> raw_data_size;
+    std::vector<uint64_t> blob_data_size;
+    std::vector<std::vector<json>> index_detail;  // index fields of each row, only collected in streaming mode
+  };
+
   /// \brief write shard header data to disk
   MSRStatus WriteShardHeader();
 
+  /// \brief validate and serialize raw data into batch
+  MSRStatus SerializeBatch(std::map<uint64_t, std::vector<json>> &raw_data,
+                           std::vector<std::vector<uint8_t>> &blob_data, bool sign, RowBatch *batch);
+
+  /// \brief collect index fields of the rows for generating index in Commit
+  void CollectIndexDetail(const std::map<uint64_t, std::vector<json>> &raw_data, RowBatch *batch);
+
+  /// \brief cut batch into pages and write them to disk
+  MSRStatus FlushBatch(const std::shared_ptr<RowBatch> &batch);
+
+  /// \brief queue batch to be flushed by background thread in streaming mode
+  MSRStatus PushBatch(const std::shared_ptr<RowBatch> &batch);
+
+  /// \brief background thread of streaming mode, flushes batches in the order they are pushed
+  void FlushWorker();
+
+  /// \brief wait until all batches queued in streaming mode are flushed
+  MSRStatus WaitForFlush();
+
+  /// \brief generate index from the rows collected in streaming mode
+  MSRStatus WriteIndex();
+
   /// \brief erase error data
   void DeleteErrorData(std::map<uint64_t, std::vector<json>> &raw_data, std::vector<std::vector<uint8_t>> &blob_data);
 
@@ -137,13 +194,20 @@ class __attribute__((visibility("default"))) ShardWriter {
   void FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,
                  std::vector<std::vector<uint8_t>> &bin_data);
 
+  /// \brief encode blob data by page codec in multiple thread run
+  void EncodeBlobArray(int start, int end, std::vector<std::vector<uint8_t>> &blob_data);
+
+  /// \brief encode blob data by page codec
+  MSRStatus EncodeBlobData(std::vector<std::vector<uint8_t>> &blob_data);
+
   /// \brief serialized raw data
   MSRStatus SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                              std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count);
 
   /// \brief write all data parallel
   MSRStatus ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
-                              const std::vector<std::vector<uint8_t>> &bin_raw_data);
+                              const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                              const std::vector<std::pair<int, int>> &shards);
 
   /// \brief write data shard by shard
   MSRStatus WriteByShard(int shard_id, int start_row, int end_row, const std::vector<std::vector<uint8_t>> &blob_data,
@@ -193,10 +257,10 @@ class __attribute__((visibility("default"))) ShardWriter {
   std::vector<std::pair<int, int>> BreakIntoShards();
 
   /// \brief calculate raw data size row by row
-  MSRStatus SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data);
+  MSRStatus SetRawDataSize(RowBatch *batch);
 
   /// \brief calculate blob data size row by row
-  MSRStatus SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data);
+  MSRStatus SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data, RowBatch *batch);
 
   /// \brief populate last raw page pointer
   void SetLastRawPage(const int &shard_id, std::shared_ptr<Page> &last_raw_page);
@@ -252,12 +316,23 @@ class __attribute__((visibility("default"))) ShardWriter {
   std::vector<std::shared_ptr<std::fstream>> file_streams_;  // file handles
   std::shared_ptr<ShardHeader> shard_header_;                // shard header
   std::shared_ptr<ShardColumn> shard_column_;                // shard columns
+  std::shared_ptr<ShardCodec> page_codec_;                   // codec of blob rows, nullptr if not compressed
 
   std::map<uint64_t, std::map<int, std::string>> err_mg_;  // used for storing error raw_data info
 
   std::mutex check_mutex_;  // mutex for data check
   std::atomic<bool> flag_{false};
   std::atomic<int64_t> compression_size_;
+
+  bool append_ = false;
+  bool streaming_ = false;
+  std::thread flush_thread_;                              // flushes batches in streaming mode
+  std::deque<std::shared_ptr<RowBatch>> pending_batches_;  // batches being flushed or waiting to be flushed
+  std::mutex flush_mutex_;
+  std::condition_variable flush_cv_;
+  bool flush_stop_ = false;
+  std::atomic<bool> flush_failed_{false};
+  std::vector<std::vector<RowIndexInfo>> row_index_info_;  // rows of each shard, collected in streaming mode
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,285 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_index_file.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <tuple>
+
+#include "utils/ms_utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const char kIndexFileMagic[kInt64Len] = {'M', 'R', 'I', 'D', 'X', '0', '0', '1'};
+const uint64_t kRowFieldCount = sizeof(IndexFileRow) / kInt64Len;
+
+uint64_t AlignUp(uint64_t size) { return (size + kInt64Len - 1) / kInt64Len * kInt64Len; }
+
+void WriteNumber(std::ofstream &out, uint64_t value) { out.write(reinterpret_cast<const char *>(&value), kInt64Len); }
+
+void WritePadding(std::ofstream &out, uint64_t size) {
+  const char padding[kInt64Len] = {0};
+  out.write(padding, AlignUp(size) - size);
+}
+
+// reads the sections of index file with bounds checking
+class IndexFileCursor {
+ public:
+  IndexFileCursor(const uint8_t *data, uint64_t size) : data_(data), size_(size), offset_(0) {}
+
+  const uint8_t *Take(uint64_t size) {
+    if (size > size_ - offset_) {
+      return nullptr;
+    }
+    const uint8_t *ptr = data_ + offset_;
+    offset_ += AlignUp(size) < size_ - offset_ ? AlignUp(size) : size_ - offset_;
+    return ptr;
+  }
+
+  bool TakeNumber(uint64_t *value) {
+    const uint8_t *ptr = Take(kInt64Len);
+    if (ptr == nullptr) {
+      return false;
+    }
+    *value = *reinterpret_cast<const uint64_t *>(ptr);
+    return true;
+  }
+
+  bool AtEnd() const { return offset_ == size_; }
+
+ private:
+  const uint8_t *data_;
+  uint64_t size_;
+  uint64_t offset_;
+};
+}  // namespace
+
+ShardIndexFile::~ShardIndexFile() { Close(); }
+
+MSRStatus ShardIndexFile::Write(const std::string &file_path, const std::vector<std::string> &field_names,
+                                std::vector<IndexFileEntry> *entries) {
+  std::sort(entries->begin(), entries->end(),
+            [](const IndexFileEntry &a, const IndexFileEntry &b) { return a.row_id < b.row_id; });
+  uint64_t row_count = entries->size();
+  for (uint64_t i = 0; i < row_count; ++i) {
+    if ((*entries)[i].row_id != i || (*entries)[i].values.size() != field_names.size()) {
+      MS_LOG(ERROR) << "Invalid data, row id " << (*entries)[i].row_id << " or its index fields are unexpected.";
+      return FAILED;
+    }
+  }
+
+  // written to a temporary file first, so that readers never see a partial index file
+  std::string tmp_path = file_path + ".tmp";
+  std::ofstream out(common::SafeCStr(tmp_path), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out.good()) {
+    MS_LOG(ERROR) << "Invalid file, failed to open file: " << tmp_path;
+    return FAILED;
+  }
+  out.write(kIndexFileMagic, kInt64Len);
+  WriteNumber(out, row_count);
+  WriteNumber(out, field_names.size());
+  for (const auto &name : field_names) {
+    WriteNumber(out, name.size());
+    out.write(name.data(), name.size());
+    WritePadding(out, name.size());
+  }
+  for (const auto &entry : *entries) {
+    out.write(reinterpret_cast<const char *>(&entry.row), sizeof(IndexFileRow));
+  }
+
+  std::vector<uint64_t> sorted_rows(row_count);
+  for (uint64_t field_id = 0; field_id < field_names.size(); ++field_id) {
+    uint64_t value_end = 0;
+    WriteNumber(out, value_end);
+    for (const auto &entry : *entries) {
+      value_end += entry.values[field_id].size();
+      WriteNumber(out, value_end);
+    }
+
+    std::iota(sorted_rows.begin(), sorted_rows.end(), 0);
+    std::sort(sorted_rows.begin(), sorted_rows.end(), [entries, field_id](uint64_t a, uint64_t b) {
+      const auto &entry_a = (*entries)[a];
+      const auto &entry_b = (*entries)[b];
+      return std::tie(entry_a.values[field_id], entry_a.row.page_id_blob, a) <
+             std::tie(entry_b.values[field_id], entry_b.row.page_id_blob, b);
+    });
+    out.write(reinterpret_cast<const char *>(sorted_rows.data()), row_count * kInt64Len);
+
+    for (const auto &entry : *entries) {
+      out.write(entry.values[field_id].data(), entry.values[field_id].size());
+    }
+    WritePadding(out, value_end);
+  }
+  out.close();
+  if (out.fail()) {
+    MS_LOG(ERROR) << "File write failed: " << tmp_path;
+    (void)remove(common::SafeCStr(tmp_path));
+    return FAILED;
+  }
+  if (rename(common::SafeCStr(tmp_path), common::SafeCStr(file_path)) != 0) {
+    MS_LOG(ERROR) << "Failed to rename file: " << tmp_path << " to " << file_path;
+    (void)remove(common::SafeCStr(tmp_path));
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardIndexFile::Open(const std::string &file_path) {
+  Close();
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = ::open(common::SafeCStr(file_path), O_RDONLY);
+  if (fd < 0) {
+    return FAILED;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    (void)::close(fd);
+    return FAILED;
+  }
+  size_ = static_cast<uint64_t>(file_stat.st_size);
+  void *addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  (void)::close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Failed to map file: " << file_path << ", errno: " << errno;
+    return FAILED;
+  }
+  data_ = static_cast<const uint8_t *>(addr);
+  mapped_ = true;
+#else
+  std::ifstream in(common::SafeCStr(file_path), std::ios::in | std::ios::binary);
+  if (!in.good()) {
+    return FAILED;
+  }
+  buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+
+  IndexFileCursor cursor(data_, size_);
+  const uint8_t *magic = cursor.Take(kInt64Len);
+  uint64_t field_count = 0;
+  if (magic == nullptr || !std::equal(kIndexFileMagic, kIndexFileMagic + kInt64Len, magic) ||
+      !cursor.TakeNumber(&row_count_) || !cursor.TakeNumber(&field_count) || row_count_ > size_ ||
+      field_count > kMaxFieldCount) {
+    MS_LOG(ERROR) << "Invalid file, index file is corrupted: " << file_path;
+    Close();
+    return FAILED;
+  }
+  for (uint64_t i = 0; i < field_count; ++i) {
+    uint64_t name_size = 0;
+    const uint8_t *name = cursor.TakeNumber(&name_size) ? cursor.Take(name_size) : nullptr;
+    if (name == nullptr) {
+      MS_LOG(ERROR) << "Invalid file, index file is corrupted: " << file_path;
+      Close();
+      return FAILED;
+    }
+    field_names_.emplace_back(reinterpret_cast<const char *>(name), name_size);
+  }
+  rows_ = reinterpret_cast<const IndexFileRow *>(cursor.Take(row_count_ * kRowFieldCount * kInt64Len));
+  bool valid = rows_ != nullptr;
+  for (uint64_t i = 0; valid && i < field_count; ++i) {
+    Field field;
+    field.value_ends = reinterpret_cast<const uint64_t *>(cursor.Take((row_count_ + 1) * kInt64Len));
+    field.sorted_rows = reinterpret_cast<const uint64_t *>(cursor.Take(row_count_ * kInt64Len));
+    valid = field.value_ends != nullptr && field.sorted_rows != nullptr;
+    if (valid) {
+      // value ends must be ascending, so that every value lies in the values section
+      valid = std::is_sorted(field.value_ends, field.value_ends + row_count_ + 1) && field.value_ends[0] == 0;
+      field.values = valid ? reinterpret_cast<const char *>(cursor.Take(field.value_ends[row_count_])) : nullptr;
+      valid = valid && field.values != nullptr &&
+              std::all_of(field.sorted_rows, field.sorted_rows + row_count_,
+                          [this](uint64_t row_id) { return row_id < row_count_; });
+    }
+    fields_.push_back(field);
+  }
+  if (!valid || !cursor.AtEnd()) {
+    MS_LOG(ERROR) << "Invalid file, index file is corrupted: " << file_path;
+    Close();
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Open index file successfully, rows: " << row_count_ << ", fields: " << field_count;
+  return SUCCESS;
+}
+
+void ShardIndexFile::Close() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (mapped_ && munmap(const_cast<uint8_t *>(data_), size_) != 0) {
+    MS_LOG(ERROR) << "Unmap index file failed, errno: " << errno;
+  }
+#endif
+  mapped_ = false;
+  buffer_.clear();
+  data_ = nullptr;
+  size_ = 0;
+  row_count_ = 0;
+  rows_ = nullptr;
+  field_names_.clear();
+  fields_.clear();
+}
+
+int ShardIndexFile::GetFieldId(const std::string &field_name) const {
+  auto it = std::find(field_names_.begin(), field_names_.end(), field_name);
+  return it == field_names_.end() ? -1 : static_cast<int>(it - field_names_.begin());
+}
+
+std::string_view ShardIndexFile::GetValue(int field_id, uint64_t row_id) const {
+  const Field &field = fields_[field_id];
+  return std::string_view(field.values + field.value_ends[row_id],
+                          field.value_ends[row_id + 1] - field.value_ends[row_id]);
+}
+
+std::vector<uint64_t> ShardIndexFile::FindRows(int field_id, const std::string &value, uint64_t page_id_blob) const {
+  const Field &field = fields_[field_id];
+  auto key = std::make_pair(std::string_view(value), page_id_blob);
+  auto less_than_key = [this, field_id](uint64_t row_id, const std::pair<std::string_view, uint64_t> &key) {
+    return std::make_pair(GetValue(field_id, row_id), rows_[row_id].page_id_blob) < key;
+  };
+  auto greater_than_key = [this, field_id](const std::pair<std::string_view, uint64_t> &key, uint64_t row_id) {
+    return key < std::make_pair(GetValue(field_id, row_id), rows_[row_id].page_id_blob);
+  };
+  auto begin = std::lower_bound(field.sorted_rows, field.sorted_rows + row_count_, key, less_than_key);
+  auto end = std::upper_bound(begin, field.sorted_rows + row_count_, key, greater_than_key);
+  return std::vector<uint64_t>(begin, end);
+}
+
+std::vector<std::string> ShardIndexFile::GetDistinctValues(int field_id) const {
+  const Field &field = fields_[field_id];
+  std::vector<std::string> values;
+  for (uint64_t i = 0; i < row_count_; ++i) {
+    auto value = GetValue(field_id, field.sorted_rows[i]);
+    if (values.empty() || values.back() != value) {
+      values.emplace_back(value);
+    }
+  }
+  return values;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
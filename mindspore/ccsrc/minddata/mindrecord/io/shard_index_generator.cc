@@ -56,6 +56,9 @@ MSRStatus ShardIndexGenerator::Build() {
     return FAILED;
   }
   shard_header_ = header;
+  if (shard_header_.GetRawLayout() == kRawLayoutColumn && !shard_header_.GetSchemas().empty()) {
+    shard_column_ = std::make_shared<ShardColumn>(shard_header_.GetSchemas()[0]->GetSchema());
+  }
   MS_LOG(INFO) << "Init header from mindrecord file for index successfully.";
   return SUCCESS;
 }
@@ -285,7 +288,27 @@ std::pair<MSRStatus, std::vector<json>> ShardIndexGenerator::GetSchemaDetails(co
         return {FAILED, {}};
       }
 
-      schema_details.emplace_back(json::from_msgpack(std::string(schema_detail.begin(), schema_detail.end())));
+      if (shard_column_ == nullptr) {
+        schema_details.emplace_back(json::from_msgpack(std::string(schema_detail.begin(), schema_detail.end())));
+        continue;
+      }
+
+      // columnar raw page: only decode the index fields
+      std::vector<std::string> index_columns;
+      for (const auto &field : fields_) {
+        if (field.first == static_cast<uint64_t>(sc)) {
+          index_columns.emplace_back(field.second);
+        }
+      }
+      json row = json::object();
+      if (!index_columns.empty() &&
+          shard_column_->DeserializeRawRow(reinterpret_cast<const unsigned char *>(schema_detail.data()),
+                                           schema_lens[sc], index_columns, &row) != SUCCESS) {
+        MS_LOG(ERROR) << "Failed to decode columnar raw data.";
+        in.close();
+        return {FAILED, {}};
+      }
+      schema_details.emplace_back(std::move(row));
     }
   }
 
@@ -414,7 +437,8 @@ void ShardIndexGenerator::AddIndexFieldByRawData(
 }
 
 ROW_DATA ShardIndexGenerator::GenerateRowData(int shard_no, const std::map<int, int> &blob_id_to_page_id,
-                                              int raw_page_id, std::fstream &in) {
+                                              int raw_page_id, std::fstream &in,
+                                              const std::vector<RowIndexInfo> *row_index_info) {
   std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> full_data;
 
   // current raw data page
@@ -440,6 +464,20 @@ ROW_DATA ShardIndexGenerator::GenerateRowData(int shard_no, const std::map<int,
       // raw data start
       row_data.emplace_back(":PAGE_OFFSET_RAW", "INTEGER", std::to_string(cur_raw_page_offset));
 
+      // sizes and index fields are known by the writer, no need to read them back
+      if (row_index_info != nullptr) {
+        const RowIndexInfo &info = (*row_index_info)[i];
+        cur_raw_page_offset += info.raw_size;
+        row_data.emplace_back(":PAGE_OFFSET_RAW_END", "INTEGER", std::to_string(cur_raw_page_offset));
+        row_data.emplace_back(":PAGE_ID_BLOB", "INTEGER", std::to_string(cur_blob_page->GetPageID()));
+        row_data.emplace_back(":PAGE_OFFSET_BLOB", "INTEGER", std::to_string(cur_blob_page_offset));
+        cur_blob_page_offset += info.blob_size;
+        row_data.emplace_back(":PAGE_OFFSET_BLOB_END", "INTEGER", std::to_string(cur_blob_page_offset));
+        AddIndexFieldByRawData(info.index_detail, row_data);
+        full_data.push_back(std::move(row_data));
+        continue;
+      }
+
       // calculate raw data end
       auto &io_seekg =
         in.seekg(page_size_ * (cur_raw_page->GetPageID()) + header_size_ + cur_raw_page_offset, std::ios::beg);
@@ -518,7 +556,8 @@ INDEX_FIELDS ShardIndexGenerator::GenerateIndexFields(const std::vector<json> &s
 
 MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair<MSRStatus, sqlite3 *> &db,
                                                   const std::vector<int> &raw_page_ids,
-                                                  const std::map<int, int> &blob_id_to_page_id) {
+                                                  const std::map<int, int> &blob_id_to_page_id,
+                                                  const std::vector<RowIndexInfo> *row_index_info) {
   // Add index data to database
   std::string shard_address = shard_header_.GetShardAddressByID(shard_no);
   if (shard_address.empty()) {
@@ -532,6 +571,10 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
     MS_LOG(ERROR) << "Invalid file, failed to open file: " << shard_address;
     return FAILED;
   }
+  // an index file left by the last build is stale from now on
+  (void)remove(common::SafeCStr(shard_address + kIndexFileSuffix));
+  std::vector<IndexFileEntry> entries;
+  bool index_file_valid = true;
   (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   for (int raw_page_id : raw_page_ids) {
     auto sql = GenerateRawSQL(fields_);
@@ -539,7 +582,7 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
       MS_LOG(ERROR) << "Generate raw SQL failed";
       return FAILED;
     }
-    auto data = GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in);
+    auto data = GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in, row_index_info);
     if (data.first != SUCCESS) {
       MS_LOG(ERROR) << "Generate raw data failed";
       return FAILED;
@@ -549,9 +592,19 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
       return FAILED;
     }
     MS_LOG(INFO) << "Insert " << data.second.size() << " rows to index db.";
+    for (size_t i = 0; index_file_valid && i < data.second.size(); ++i) {
+      auto entry = GenerateIndexFileEntry(data.second[i]);
+      index_file_valid = entry.first == SUCCESS;
+      if (index_file_valid) {
+        entries.push_back(std::move(entry.second));
+      }
+    }
   }
   (void)sqlite3_exec(db.second, "END TRANSACTION;", nullptr, nullptr, nullptr);
   in.close();
+  if (index_file_valid) {
+    WriteIndexFile(shard_address, &entries);
+  }
 
   // Close database
   if (sqlite3_close(db.second) != SQLITE_OK) {
@@ -562,6 +615,67 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
   return SUCCESS;
 }
 
+std::pair<MSRStatus, IndexFileEntry> ShardIndexGenerator::GenerateIndexFileEntry(
+  const std::vector<std::tuple<std::string, std::string, std::string>> &row_data) {
+  IndexFileEntry entry;
+  std::string type;
+  auto get_column = [&row_data, &type](const std::string &name, std::string *value) {
+    auto it = std::find_if(row_data.begin(), row_data.end(),
+                           [&name](const std::tuple<std::string, std::string, std::string> &column) {
+                             return std::get<0>(column) == ":" + name;
+                           });
+    if (it == row_data.end()) {
+      return false;
+    }
+    type = std::get<1>(*it);
+    *value = std::get<2>(*it);
+    return true;
+  };
+  std::vector<std::pair<std::string, uint64_t *>> numbers = {{"ROW_ID", &entry.row_id},
+                                                             {"ROW_GROUP_ID", &entry.row.row_group_id},
+                                                             {"PAGE_ID_RAW", &entry.row.page_id_raw},
+                                                             {"PAGE_OFFSET_RAW", &entry.row.page_offset_raw},
+                                                             {"PAGE_OFFSET_RAW_END", &entry.row.page_offset_raw_end},
+                                                             {"PAGE_ID_BLOB", &entry.row.page_id_blob},
+                                                             {"PAGE_OFFSET_BLOB", &entry.row.page_offset_blob},
+                                                             {"PAGE_OFFSET_BLOB_END", &entry.row.page_offset_blob_end}};
+  std::string value;
+  for (auto &number : numbers) {
+    if (!get_column(number.first, &value)) {
+      return {FAILED, {}};
+    }
+    *number.second = std::stoull(value);
+  }
+  for (const auto &field : fields_) {
+    auto field_name = GenerateFieldName(field);
+    if (field_name.first != SUCCESS || !get_column(field_name.second, &value)) {
+      return {FAILED, {}};
+    }
+    // keys are matched as text, so integers are kept in canonical form and a float field, whose text does not
+    // compare the way SQLite compares numbers, leaves the shard to the database
+    if (type == "INTEGER") {
+      value = std::to_string(std::stoll(value));
+    } else if (type != "TEXT") {
+      MS_LOG(INFO) << "Index field " << field_name.second << " is not a string or an integer, skip the index file.";
+      return {FAILED, {}};
+    }
+    entry.values.push_back(value);
+  }
+  return {SUCCESS, std::move(entry)};
+}
+
+void ShardIndexGenerator::WriteIndexFile(const std::string &shard_address, std::vector<IndexFileEntry> *entries) {
+  std::vector<std::string> field_names;
+  for (const auto &field : fields_) {
+    field_names.push_back(GenerateFieldName(field).second);
+  }
+  if (ShardIndexFile::Write(shard_address + kIndexFileSuffix, field_names, entries) != SUCCESS) {
+    MS_LOG(WARNING) << "Failed to write index file of shard: " << shard_address << ", readers will use index db.";
+    return;
+  }
+  MS_LOG(INFO) << "Write " << entries->size() << " rows to index file.";
+}
+
 MSRStatus ShardIndexGenerator::WriteToDatabase() {
   fields_ = shard_header_.GetFields();
   page_size_ = shard_header_.GetPageSize();
@@ -607,16 +721,24 @@ void ShardIndexGenerator::DatabaseWriter() {
 
     std::map<int, int> blob_id_to_page_id;
     std::vector<int> raw_page_ids;
+    uint64_t row_count = 0;
     for (uint64_t i = 0; i < total_pages; ++i) {
       std::shared_ptr<Page> cur_page = shard_header_.GetPage(shard_no, i).first;
       if (cur_page->GetPageType() == "RAW_DATA") {
         raw_page_ids.push_back(i);
       } else if (cur_page->GetPageType() == "BLOB_DATA") {
         blob_id_to_page_id[cur_page->GetPageTypeID()] = i;
+        row_count = std::max(row_count, cur_page->GetEndRowID());
       }
     }
 
-    if (ExecuteTransaction(shard_no, db, raw_page_ids, blob_id_to_page_id) != SUCCESS) {
+    // rows collected by the writer are used only if they cover the whole shard, e.g. not for appended files
+    const std::vector<RowIndexInfo> *row_index_info = nullptr;
+    if (shard_no < static_cast<int>(row_index_info_.size()) && row_index_info_[shard_no].size() == row_count) {
+      row_index_info = &row_index_info_[shard_no];
+    }
+
+    if (ExecuteTransaction(shard_no, db, raw_page_ids, blob_id_to_page_id, row_index_info) != SUCCESS) {
       write_success_ = false;
       return;
     }
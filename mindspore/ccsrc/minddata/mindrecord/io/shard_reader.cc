@@ -14,7 +14,12 @@
  * limitations under the License.
  */
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#endif
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <thread>
 
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
@@ -38,6 +43,23 @@ Type StringToNum(const std::string &str) {
   return num;
 }
 
+// convert the value of index field, which is stored as string, to base type by schema
+void AddIndexFieldToJson(const json &schema, const std::string &column, const std::string &value, json *label) {
+  auto it = schema.find(column);
+  std::string type = it != schema.end() && it->contains("type") ? (*it)["type"].get<std::string>() : "";
+  if (type == "int32") {
+    (*label)[column] = StringToNum<int32_t>(value);
+  } else if (type == "int64") {
+    (*label)[column] = StringToNum<int64_t>(value);
+  } else if (type == "float32") {
+    (*label)[column] = StringToNum<float>(value);
+  } else if (type == "float64") {
+    (*label)[column] = StringToNum<double>(value);
+  } else {
+    (*label)[column] = value;
+  }
+}
+
 ShardReader::ShardReader()
     : header_size_(0),
       page_size_(0),
@@ -145,11 +167,18 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
   } else {
     shard_column_ = std::make_shared<ShardColumn>(shard_header_, true);
   }
+  if (shard_header_->GetPageCodec() != kCodecNone) {
+    page_codec_ = ShardCodec::Create(shard_header_->GetPageCodec());
+    if (page_codec_ == nullptr) {
+      return FAILED;
+    }
+  }
   num_rows_ = 0;
   auto row_group_summary = ReadRowGroupSummary();
   for (const auto &rg : row_group_summary) {
     num_rows_ += std::get<3>(rg);
   }
+  LoadIndexFiles(row_group_summary);
 
   if (num_rows_ > LAZY_LOAD_THRESHOLD) {
     lazy_load_ = true;
@@ -206,10 +235,27 @@ MSRStatus ShardReader::Open() {
 }
 
 MSRStatus ShardReader::Open(int n_consumer) {
+  // slices point into the mapped file, where encoded blobs can not be handed out without a decoded copy
+  if (use_mmap_ && page_codec_ != nullptr) {
+    MS_LOG(INFO) << "Blob pages are encoded by " << shard_header_->GetPageCodec()
+                 << ", read shard files by file streams instead of memory mapping.";
+    use_mmap_ = false;
+  }
+  if (use_mmap_) {
+    if (MmapShardFiles() == SUCCESS) {
+      return SUCCESS;
+    }
+    MS_LOG(WARNING) << "Failed to map shard files into memory, fall back to read them by file streams.";
+    MunmapShardFiles();
+    use_mmap_ = false;
+  }
+  // prefetch threads own the streams after the ones of consumers
+  int n_prefetch = use_prefetch_ ? kNumPrefetchThreads : 0;
+  int n_stream = n_consumer + n_prefetch;
   file_streams_random_ =
-    std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_consumer, std::vector<std::shared_ptr<std::fstream>>());
+    std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_stream, std::vector<std::shared_ptr<std::fstream>>());
   for (const auto &file : file_paths_) {
-    for (int j = 0; j < n_consumer; ++j) {
+    for (int j = 0; j < n_stream; ++j) {
       std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
       fs->open(common::SafeCStr(file), std::ios::in | std::ios::binary);
       if (!fs->good()) {
@@ -221,7 +267,59 @@ MSRStatus ShardReader::Open(int n_consumer) {
     MS_LOG(INFO) << "Open shard file successfully.";
   }
 
+  for (int x = 0; x < n_prefetch; ++x) {
+    prefetch_threads_.emplace_back(&ShardReader::PrefetchByRow, this, x, static_cast<uint32_t>(n_consumer + x));
+  }
+
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::MmapShardFiles() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  // kernel readahead only pays off when blobs are consumed in file order, otherwise WillNeedTask does the job
+  bool has_shuffle = std::any_of(operators_.begin(), operators_.end(), [](const std::shared_ptr<ShardOperator> &op) {
+    return std::dynamic_pointer_cast<ShardShuffle>(op) != nullptr;
+  });
+  for (const auto &file : file_paths_) {
+    int fd = ::open(common::SafeCStr(file), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "Invalid file, failed to open file: " << file;
+      return FAILED;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      MS_LOG(ERROR) << "Invalid file, failed to get the size of file: " << file;
+      (void)::close(fd);
+      return FAILED;
+    }
+    auto file_size = static_cast<uint64_t>(file_stat.st_size);
+    void *addr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping holds its own reference to the file
+    (void)::close(fd);
+    if (addr == MAP_FAILED) {
+      MS_LOG(ERROR) << "Failed to map file: " << file << ", errno: " << errno;
+      return FAILED;
+    }
+    (void)madvise(addr, file_size, has_shuffle ? MADV_RANDOM : MADV_SEQUENTIAL);
+    file_mmaps_.emplace_back(static_cast<uint8_t *>(addr), file_size);
+    MS_LOG(INFO) << "Map shard file successfully.";
+  }
   return SUCCESS;
+#else
+  MS_LOG(WARNING) << "Mmap read mode is not supported on this platform.";
+  return FAILED;
+#endif
+}
+
+void ShardReader::MunmapShardFiles() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (auto &file_mmap : file_mmaps_) {
+    if (munmap(file_mmap.first, file_mmap.second) != 0) {
+      MS_LOG(ERROR) << "Unmap shard file failed, errno: " << errno;
+    }
+  }
+#endif
+  file_mmaps_.clear();
 }
 
 void ShardReader::FileStreamsOperator() {
@@ -237,6 +335,7 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+  MunmapShardFiles();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       auto ret = sqlite3_close(database_paths_[i]);
@@ -263,6 +362,7 @@ void ShardReader::Close() {
       i_thread.join();
     }
   }
+  StopPrefetch();
 
   FileStreamsOperator();
 }
@@ -312,11 +412,47 @@ MSRStatus ShardReader::GetTotalBlobSize(int64_t *total_blob_size) {
   return SUCCESS;
 }
 
+MSRStatus ShardReader::ReadLabelFromRawPage(const std::shared_ptr<std::fstream> &fs, uint64_t raw_page_id,
+                                            uint64_t label_start, uint64_t label_end,
+                                            const std::vector<std::string> &columns, json *label) {
+  auto len = label_end - label_start;
+  auto label_raw = std::vector<uint8_t>(len);
+  auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    MS_LOG(ERROR) << "File seekg failed";
+    fs->close();
+    return FAILED;
+  }
+
+  auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    MS_LOG(ERROR) << "File read failed";
+    fs->close();
+    return FAILED;
+  }
+  if (shard_header_->GetRawLayout() == kRawLayoutColumn) {
+    // only the selected columns are decoded
+    return shard_column_->DeserializeRawRow(label_raw.data(), len, columns, label);
+  }
+  json label_json = json::from_msgpack(label_raw);
+  if (!columns.empty()) {
+    for (auto &col : columns) {
+      if (label_json.find(col) != label_json.end()) {
+        (*label)[col] = label_json[col];
+      }
+    }
+  } else {
+    *label = std::move(label_json);
+  }
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels,
                                           std::shared_ptr<std::fstream> fs,
                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets, int shard_id,
                                           const std::vector<std::string> &columns,
                                           std::vector<std::vector<json>> &column_values) {
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
   for (int i = 0; i < static_cast<int>(labels.size()); ++i) {
     uint64_t group_id = std::stoull(labels[i][0]);
     uint64_t offset_start = std::stoull(labels[i][1]) + kInt64Len;
@@ -327,51 +463,17 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
       int raw_page_id = std::stoi(labels[i][3]);
       uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
       uint64_t label_end = std::stoull(labels[i][5]);
-      auto len = label_end - label_start;
-      auto label_raw = std::vector<uint8_t>(len);
-      auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-      if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-        MS_LOG(ERROR) << "File seekg failed";
-        fs->close();
-        return FAILED;
-      }
-
-      auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-      if (!io_read.good() || io_read.fail() || io_read.bad()) {
-        MS_LOG(ERROR) << "File read failed";
+      json tmp;
+      if (ReadLabelFromRawPage(fs, raw_page_id, label_start, label_end, columns, &tmp) != SUCCESS) {
         fs->close();
         return FAILED;
       }
-      json label_json = json::from_msgpack(label_raw);
-      json tmp;
-      if (!columns.empty()) {
-        for (auto &col : columns) {
-          if (label_json.find(col) != label_json.end()) {
-            tmp[col] = label_json[col];
-          }
-        }
-      } else {
-        tmp = label_json;
-      }
       column_values[shard_id].emplace_back(tmp);
     } else {
       json construct_json;
       for (unsigned int j = 0; j < columns.size(); ++j) {
         // construct json "f1": value
-        auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
-
-        // convert the string to base type by schema
-        if (schema[columns[j]]["type"] == "int32") {
-          construct_json[columns[j]] = StringToNum<int32_t>(labels[i][j + 3]);
-        } else if (schema[columns[j]]["type"] == "int64") {
-          construct_json[columns[j]] = StringToNum<int64_t>(labels[i][j + 3]);
-        } else if (schema[columns[j]]["type"] == "float32") {
-          construct_json[columns[j]] = StringToNum<float>(labels[i][j + 3]);
-        } else if (schema[columns[j]]["type"] == "float64") {
-          construct_json[columns[j]] = StringToNum<double>(labels[i][j + 3]);
-        } else {
-          construct_json[columns[j]] = std::string(labels[i][j + 3]);
-        }
+        AddIndexFieldToJson(schema, columns[j], labels[i][j + 3], &construct_json);
       }
       column_values[shard_id].emplace_back(construct_json);
     }
@@ -409,6 +511,106 @@ MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql,
   return ConvertLabelToJson(labels, fs, offsets, shard_id, columns, column_values);
 }
 
+MSRStatus ShardReader::ReadRowsInIndexFile(int shard_id, uint64_t row_begin, uint64_t row_end,
+                                           const std::vector<std::string> &columns,
+                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                                           std::vector<std::vector<json>> &column_values) {
+  const auto &index_file = index_files_[shard_id];
+  if (row_end > index_file->GetRowCount() || row_begin > row_end) {
+    MS_LOG(ERROR) << "Rows [" << row_begin << ", " << row_end << ") are out of index file of shard " << shard_id;
+    return FAILED;
+  }
+  std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
+  std::vector<int> field_ids;
+  if (!all_in_index_) {
+    fs->open(common::SafeCStr(file_paths_[shard_id]), std::ios::in | std::ios::binary);
+    if (!fs->good()) {
+      MS_LOG(ERROR) << "Invalid file, failed to open file: " << file_paths_[shard_id];
+      return FAILED;
+    }
+  } else {
+    for (const auto &column : columns) {
+      auto field_name = ShardIndexGenerator::GenerateFieldName(std::make_pair(column_schema_id_.at(column), column));
+      int field_id = field_name.first == SUCCESS ? index_file->GetFieldId(field_name.second) : -1;
+      if (field_id < 0) {
+        MS_LOG(ERROR) << "Index field " << column << " does not exist in index file of shard " << shard_id;
+        return FAILED;
+      }
+      field_ids.push_back(field_id);
+    }
+  }
+
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+  offsets[shard_id].reserve(offsets[shard_id].size() + row_end - row_begin);
+  column_values[shard_id].reserve(column_values[shard_id].size() + row_end - row_begin);
+  for (uint64_t row_id = row_begin; row_id < row_end; ++row_id) {
+    const auto &row = index_file->GetRow(row_id);
+    offsets[shard_id].emplace_back(std::vector<uint64_t>{static_cast<uint64_t>(shard_id), row.row_group_id,
+                                                         row.page_offset_blob + kInt64Len, row.page_offset_blob_end});
+    json label;
+    if (!all_in_index_) {
+      if (ReadLabelFromRawPage(fs, row.page_id_raw, row.page_offset_raw + kInt64Len, row.page_offset_raw_end, columns,
+                               &label) != SUCCESS) {
+        return FAILED;
+      }
+    } else {
+      for (size_t j = 0; j < columns.size(); ++j) {
+        AddIndexFieldToJson(schema, columns[j], std::string(index_file->GetValue(field_ids[j], row_id)), &label);
+      }
+    }
+    column_values[shard_id].emplace_back(std::move(label));
+  }
+  MS_LOG(INFO) << "Get " << row_end - row_begin << " records from shard " << shard_id << " index file.";
+  return SUCCESS;
+}
+
+void ShardReader::LoadIndexFiles(const std::vector<std::tuple<int, int, int, uint64_t>> &row_group_summary) {
+  std::vector<uint64_t> shard_rows(file_paths_.size(), 0);
+  for (const auto &rg : row_group_summary) {
+    shard_rows[std::get<0>(rg)] += std::get<3>(rg);
+  }
+  index_files_.assign(file_paths_.size(), nullptr);
+  for (size_t shard_id = 0; shard_id < file_paths_.size(); ++shard_id) {
+    auto index_file = std::make_shared<ShardIndexFile>();
+    if (index_file->Open(file_paths_[shard_id] + kIndexFileSuffix) != SUCCESS) {
+      continue;
+    }
+    // the index file is stale if shard file is appended by an older library
+    if (index_file->GetRowCount() != shard_rows[shard_id]) {
+      MS_LOG(WARNING) << "Index file of shard " << file_paths_[shard_id] << " is stale, use index db instead.";
+      continue;
+    }
+    index_files_[shard_id] = index_file;
+  }
+}
+
+bool ShardReader::FindRowsInIndexFile(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                                      std::vector<uint64_t> *row_ids) {
+  if (criteria.first.empty() || index_files_.empty() || index_files_[shard_id] == nullptr) {
+    return false;
+  }
+  auto field_name = ShardIndexGenerator::GenerateFieldName(
+    std::make_pair(column_schema_id_[criteria.first], criteria.first));
+  int field_id = field_name.first == SUCCESS ? index_files_[shard_id]->GetFieldId(field_name.second) : -1;
+  if (field_id < 0) {
+    return false;
+  }
+  // integer keys are stored in canonical form, a criteria that is not a plain integer, like "1.0", is left to SQLite
+  std::string value = criteria.second;
+  auto type = shard_header_->GetSchemas()[0]->GetSchema()["schema"][criteria.first]["type"];
+  if (type == "int32" || type == "int64") {
+    char *end = nullptr;
+    errno = 0;
+    auto number = std::strtoll(value.c_str(), &end, 10);
+    if (value.empty() || errno != 0 || *end != '\0') {
+      return false;
+    }
+    value = std::to_string(number);
+  }
+  *row_ids = index_files_[shard_id]->FindRows(field_id, value, page_id);
+  return true;
+}
+
 MSRStatus ShardReader::GetAllClasses(const std::string &category_field, std::set<std::string> &categories) {
   std::map<std::string, uint64_t> index_columns;
   for (auto &field : GetShardHeader()->GetFields()) {
@@ -425,15 +627,35 @@ MSRStatus ShardReader::GetAllClasses(const std::string &category_field, std::set
   std::string sql = "SELECT DISTINCT " + ret.second + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
+    if (GetClassesInIndexFile(x, ret.second, categories)) {
+      continue;
+    }
     threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, std::ref(categories));
   }
 
   for (int x = 0; x < shard_count_; x++) {
-    threads[x].join();
+    if (threads[x].joinable()) {
+      threads[x].join();
+    }
   }
   return SUCCESS;
 }
 
+bool ShardReader::GetClassesInIndexFile(int shard_id, const std::string &field_name,
+                                        std::set<std::string> &categories) {
+  if (shard_id >= static_cast<int>(index_files_.size()) || index_files_[shard_id] == nullptr) {
+    return false;
+  }
+  int field_id = index_files_[shard_id]->GetFieldId(field_name);
+  if (field_id < 0) {
+    return false;
+  }
+  auto values = index_files_[shard_id]->GetDistinctValues(field_id);
+  std::lock_guard<std::mutex> lck(shard_locker_);
+  categories.insert(values.begin(), values.end());
+  return true;
+}
+
 void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string sql,
                                     std::set<std::string> &categories) {
   if (nullptr == db) {
@@ -477,6 +699,11 @@ ROW_GROUPS ShardReader::ReadAllRowGroup(std::vector<std::string> &columns) {
 
   std::vector<std::thread> thread_read_db = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
+    if (index_files_[x] != nullptr) {
+      thread_read_db[x] = std::thread(&ShardReader::ReadRowsInIndexFile, this, x, 0, index_files_[x]->GetRowCount(),
+                                      columns, std::ref(offsets), std::ref(column_values));
+      continue;
+    }
     thread_read_db[x] =
       std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, std::ref(offsets), std::ref(column_values));
   }
@@ -507,7 +734,10 @@ ROW_GROUPS ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::
 
   std::string sql = "SELECT " + fields + " FROM INDEXES WHERE ROW_ID = " + std::to_string(sample_id);
 
-  if (ReadAllRowsInShard(shard_id, sql, columns, offsets, column_values) != SUCCESS) {
+  auto ret = index_files_[shard_id] != nullptr
+               ? ReadRowsInIndexFile(shard_id, sample_id, sample_id + 1, columns, offsets, column_values)
+               : ReadAllRowsInShard(shard_id, sql, columns, offsets, column_values);
+  if (ret != SUCCESS) {
     MS_LOG(ERROR) << "Read shard id: " << shard_id << ", sample id: " << sample_id << " from index failed.";
     return std::make_tuple(FAILED, std::move(offsets), std::move(column_values));
   }
@@ -572,6 +802,16 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
+  std::vector<uint64_t> row_ids;
+  if (FindRowsInIndexFile(page_id, shard_id, criteria, &row_ids)) {
+    std::vector<std::vector<uint64_t>> res;
+    for (auto row_id : row_ids) {
+      const auto &row = index_files_[shard_id]->GetRow(row_id);
+      res.emplace_back(std::vector<uint64_t>{row.page_offset_blob + kInt64Len, row.page_offset_blob_end});
+    }
+    return res;
+  }
+
   auto db = database_paths_[shard_id];
 
   std::string sql =
@@ -705,6 +945,15 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromBinaryFile(
       return {FAILED, {}};
     }
 
+    if (shard_header_->GetRawLayout() == kRawLayoutColumn) {
+      // only the selected columns are decoded, all of them if none is selected
+      if (shard_column_->DeserializeRawRow(label_raw.data(), len, columns, &res[i]) != SUCCESS) {
+        fs->close();
+        return {FAILED, {}};
+      }
+      continue;
+    }
+
     json label_json = json::from_msgpack(label_raw);
     json tmp = label_json;
     for (auto &col : columns) {
@@ -725,7 +974,14 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromPage(
   std::string sql = "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
                     std::to_string(page_id);
   std::vector<std::vector<std::string>> label_offsets;
-  if (!criteria.first.empty()) {
+  std::vector<uint64_t> row_ids;
+  if (FindRowsInIndexFile(page_id, shard_id, criteria, &row_ids)) {
+    for (auto row_id : row_ids) {
+      const auto &row = index_files_[shard_id]->GetRow(row_id);
+      label_offsets.push_back({std::to_string(row.page_id_raw), std::to_string(row.page_offset_raw),
+                               std::to_string(row.page_offset_raw_end)});
+    }
+  } else if (!criteria.first.empty()) {
     sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = :criteria";
     if (QueryWithCriteria(db, sql, criteria.second, label_offsets) == FAILED) {
       return {FAILED, {}};
@@ -762,7 +1018,25 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabels(int page_id, int
     if (fields.empty()) fields = "*";
     std::vector<std::vector<std::string>> labels;
     std::string sql = "SELECT " + fields + " FROM INDEXES WHERE PAGE_ID_BLOB = " + std::to_string(page_id);
-    if (!criteria.first.empty()) {
+    std::vector<uint64_t> row_ids;
+    if (FindRowsInIndexFile(page_id, shard_id, criteria, &row_ids)) {
+      const auto &index_file = index_files_[shard_id];
+      std::vector<int> field_ids;
+      for (const auto &column : columns) {
+        field_ids.push_back(index_file->GetFieldId(column + "_" + std::to_string(column_schema_id_[column])));
+        if (field_ids.back() < 0) {
+          MS_LOG(ERROR) << "Index field " << column << " does not exist in index file of shard " << shard_id;
+          return {FAILED, {}};
+        }
+      }
+      for (auto row_id : row_ids) {
+        std::vector<std::string> label;
+        for (auto field_id : field_ids) {
+          label.emplace_back(index_file->GetValue(field_id, row_id));
+        }
+        labels.push_back(std::move(label));
+      }
+    } else if (!criteria.first.empty()) {
       sql += " AND " + criteria.first + "_" + std::to_string(column_schema_id_[criteria.first]) + " = " + ":criteria";
       if (QueryWithCriteria(db, sql, criteria.second, labels) == FAILED) {
         return {FAILED, {}};
@@ -782,26 +1056,14 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabels(int page_id, int
       }
       sqlite3_free(errmsg);
     }
+    auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
     std::vector<json> ret;
     for (unsigned int i = 0; i < labels.size(); ++i) ret.emplace_back(json{});
     for (unsigned int i = 0; i < labels.size(); ++i) {
       json construct_json;
       for (unsigned int j = 0; j < columns.size(); ++j) {
         // construct json "f1": value
-        auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
-
-        // convert the string to base type by schema
-        if (schema[columns[j]]["type"] == "int32") {
-          construct_json[columns[j]] = StringToNum<int32_t>(labels[i][j]);
-        } else if (schema[columns[j]]["type"] == "int64") {
-          construct_json[columns[j]] = StringToNum<int64_t>(labels[i][j]);
-        } else if (schema[columns[j]]["type"] == "float32") {
-          construct_json[columns[j]] = StringToNum<float>(labels[i][j]);
-        } else if (schema[columns[j]]["type"] == "float64") {
-          construct_json[columns[j]] = StringToNum<double>(labels[i][j]);
-        } else {
-          construct_json[columns[j]] = std::string(labels[i][j]);
-        }
+        AddIndexFieldToJson(schema, columns[j], labels[i][j], &construct_json);
       }
       ret[i] = construct_json;
     }
@@ -836,6 +1098,9 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count);
   std::set<std::string> categories;
   for (int x = 0; x < shard_count; x++) {
+    if (GetClassesInIndexFile(x, ret.second, categories)) {
+      continue;
+    }
     sqlite3 *db = nullptr;
     int rc = sqlite3_open_v2(common::SafeCStr(file_paths_[x] + ".db"), &db, SQLITE_OPEN_READONLY, nullptr);
     if (SQLITE_OK != rc) {
@@ -847,7 +1112,9 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   }
 
   for (int x = 0; x < shard_count; x++) {
-    threads[x].join();
+    if (threads[x].joinable()) {
+      threads[x].join();
+    }
   }
   return categories.size();
 }
@@ -1208,82 +1475,162 @@ MSRStatus ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, u
   return SUCCESS;
 }
 
-TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
-  // All tasks are done
-  if (task_id >= static_cast<int>(tasks_.Size())) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
-  }
-
-  uint32_t shard_id = 0;
+MSRStatus ShardReader::GetTaskBlobAddress(uint32_t task_index, TaskType *task_type, uint32_t *shard_id,
+                                          uint64_t *file_offset, uint64_t *blob_size, json *var_fields) {
   uint32_t group_id = 0;
-  uint32_t blob_start = 0;
-  uint32_t blob_end = 0;
-  json var_fields;
+  uint64_t blob_start = 0;
+  uint64_t blob_end = 0;
 
   // Pick up task from task list
-  auto task = tasks_.GetTaskByID(tasks_.permutation_[task_id]);
+  const auto &task = tasks_.GetTaskByID(task_index);
 
   // check task type
-  auto task_type = std::get<0>(task);
-  if (task_type == TaskType::kPaddedTask) {
-    return std::make_pair(SUCCESS,
-                          std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  *task_type = std::get<0>(task);
+  if (*task_type == TaskType::kPaddedTask) {
+    return SUCCESS;
   }
 
-  shard_id = std::get<0>(std::get<1>(task));  // shard id
+  *shard_id = std::get<0>(std::get<1>(task));  // shard id
 
   if (lazy_load_ == false) {
     group_id = std::get<1>(std::get<1>(task));  // group id
     blob_start = std::get<2>(task)[0];          // blob start
     blob_end = std::get<2>(task)[1];            // blob end
-    var_fields = std::get<3>(task);             // scalar variable field
+    *var_fields = std::get<3>(task);            // scalar variable field
   } else {
     // get scalar variable fields by sample id
     uint32_t sample_id_in_shard = std::get<1>(std::get<1>(task));
 
     // read the meta from index
-    auto row_meta = ReadRowGroupByShardIDAndSampleID(selected_columns_, shard_id, sample_id_in_shard);
+    auto row_meta = ReadRowGroupByShardIDAndSampleID(selected_columns_, *shard_id, sample_id_in_shard);
     if (std::get<0>(row_meta) != SUCCESS) {
-      return std::make_pair(
-        FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+      return FAILED;
     }
     auto &offsets = std::get<1>(row_meta);
     auto &local_columns = std::get<2>(row_meta);
 
-    group_id = offsets[shard_id][0][1];       // group_id
-    blob_start = offsets[shard_id][0][2];     // blob start
-    blob_end = offsets[shard_id][0][3];       // blob end
-    var_fields = local_columns[shard_id][0];  // scalar variable field
+    group_id = offsets[*shard_id][0][1];        // group_id
+    blob_start = offsets[*shard_id][0][2];      // blob start
+    blob_end = offsets[*shard_id][0][3];        // blob end
+    *var_fields = local_columns[*shard_id][0];  // scalar variable field
   }
 
-  // read the blob from data file
-  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  // locate the blob in data file
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, *shard_id);
   if (SUCCESS != ret.first) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return FAILED;
   }
   const std::shared_ptr<Page> &page = ret.second;
+  *file_offset = header_size_ + page_size_ * (page->GetPageID()) + blob_start;
+  *blob_size = blob_end - blob_start;
+  return SUCCESS;
+}
 
-  // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + blob_start;
+void ShardReader::WillNeedTask(int task_id) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  // the blob address is only known without querying the index in non-lazy mode
+  if (lazy_load_ || task_id >= static_cast<int>(tasks_.Size())) {
+    return;
+  }
+  const auto &task = tasks_.GetTaskByID(tasks_.permutation_[task_id]);
+  if (std::get<0>(task) == TaskType::kPaddedTask) {
+    return;
+  }
+  auto shard_id = std::get<0>(std::get<1>(task));
+  const auto &ret = shard_header_->GetPageByGroupId(std::get<1>(std::get<1>(task)), shard_id);
+  if (SUCCESS != ret.first) {
+    return;
+  }
+  uint64_t page_offset = header_size_ + page_size_ * (ret.second->GetPageID());
+  uint64_t blob_start = page_offset + std::get<2>(task)[0];
+  uint64_t blob_end = page_offset + std::get<2>(task)[1];
+  if (blob_end > file_mmaps_[shard_id].second) {
+    return;
+  }
+
+  // madvise requires an address aligned to system page
+  static const uint64_t sys_page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t aligned_start = blob_start - blob_start % sys_page_size;
+  (void)madvise(file_mmaps_[shard_id].first + aligned_start, blob_end - aligned_start, MADV_WILLNEED);
+#endif
+}
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+MSRStatus ShardReader::ReadTaskBlob(uint32_t stream_id, uint32_t shard_id, uint64_t file_offset, uint64_t blob_size,
+                                    std::vector<uint8_t> *blob) {
+  blob->resize(blob_size);
+  auto &io_seekg = file_streams_random_[stream_id][shard_id]->seekg(file_offset, std::ios::beg);
   if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
     MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    file_streams_random_[stream_id][shard_id]->close();
+    return FAILED;
   }
 
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
+  auto &io_read = file_streams_random_[stream_id][shard_id]->read(reinterpret_cast<char *>(blob->data()), blob_size);
   if (!io_read.good() || io_read.fail() || io_read.bad()) {
     MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
+    file_streams_random_[stream_id][shard_id]->close();
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::DecodeBlob(std::vector<uint8_t> *blob) const {
+  if (page_codec_ == nullptr) {
+    return SUCCESS;
+  }
+  std::vector<uint8_t> decoded;
+  if (page_codec_->Decode(*blob, &decoded) != SUCCESS) {
+    return FAILED;
+  }
+  *blob = std::move(decoded);
+  return SUCCESS;
+}
+
+TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
+  // All tasks are done
+  if (task_id >= static_cast<int>(tasks_.Size())) {
     return std::make_pair(FAILED,
-                          std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  }
+  uint32_t task_index = tasks_.permutation_[task_id];
+
+  // Pack image list
+  std::vector<uint8_t> images;
+  json var_fields;
+  if (use_prefetch_ && TakePrefetchedTask(task_index, &images, &var_fields)) {
+    std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
+    batch.emplace_back(std::move(images), std::move(var_fields));
+    return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
+  }
+
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  if (GetTaskBlobAddress(task_index, &task_type, &shard_id, &file_offset, &blob_size, &var_fields) != SUCCESS) {
+    return std::make_pair(FAILED,
+                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  }
+  if (task_type == TaskType::kPaddedTask) {
+    return std::make_pair(SUCCESS,
+                          std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  }
+
+  if (use_mmap_) {
+    if (file_offset + blob_size > file_mmaps_[shard_id].second) {
+      MS_LOG(ERROR) << "Blob is out of mapped file, offset: " << file_offset << ", size: " << blob_size;
+      return std::make_pair(
+        FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    }
+    images.assign(file_mmaps_[shard_id].first + file_offset, file_mmaps_[shard_id].first + file_offset + blob_size);
+  } else if (ReadTaskBlob(consumer_id, shard_id, file_offset, blob_size, &images) != SUCCESS) {
+    return std::make_pair(FAILED,
+                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  }
+  // blobs are decoded in the consumer threads
+  if (DecodeBlob(&images) != SUCCESS) {
+    return std::make_pair(FAILED,
+                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
   }
 
   // Deliver batch data to output map
@@ -1366,6 +1713,190 @@ std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardRe
   return std::move(ret.second);
 }
 
+TASK_SLICE_CONTENT ShardReader::GetNextSliceById(const int64_t &task_id, const int32_t &consumer_id) {
+  if (interrupt_ || !use_mmap_) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BLOB_SLICE, json>>());
+  }
+
+  // Tasks are consumed in permutation order, so page in the blob of a later task before it is requested
+  WillNeedTask(task_id + kMmapReadAheadTasks);
+
+  // All tasks are done
+  if (task_id >= static_cast<int64_t>(tasks_.Size())) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BLOB_SLICE, json>>());
+  }
+
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  json var_fields;
+  if (GetTaskBlobAddress(tasks_.permutation_[task_id], &task_type, &shard_id, &file_offset, &blob_size,
+                         &var_fields) != SUCCESS) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BLOB_SLICE, json>>());
+  }
+  if (task_type == TaskType::kPaddedTask) {
+    return std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<BLOB_SLICE, json>>());
+  }
+  if (file_offset + blob_size > file_mmaps_[shard_id].second) {
+    MS_LOG(ERROR) << "Blob is out of mapped file, offset: " << file_offset << ", size: " << blob_size;
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BLOB_SLICE, json>>());
+  }
+
+  std::vector<std::tuple<BLOB_SLICE, json>> batch;
+  batch.emplace_back(BLOB_SLICE(file_mmaps_[shard_id].first + file_offset, blob_size), std::move(var_fields));
+  return std::make_pair(TaskType::kCommonTask, std::move(batch));
+}
+
+void ShardReader::Prefetch(const std::vector<int64_t> &task_ids) {
+  if (interrupt_) {
+    return;
+  }
+  // the kernel pages in the mapped file by itself
+  if (use_mmap_) {
+    for (const auto &task_id : task_ids) {
+      if (task_id >= 0) {
+        WillNeedTask(static_cast<int>(task_id));
+      }
+    }
+    return;
+  }
+  if (prefetch_threads_.empty()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    for (size_t i = 0; i < task_ids.size(); ++i) {
+      auto task_id = task_ids[i];
+      if (task_id < 0 || task_id >= static_cast<int64_t>(tasks_.Size())) {
+        continue;
+      }
+      if (prefetch_pending_.size() + prefetch_cache_.size() >= static_cast<size_t>(kMaxPrefetchTasks)) {
+        MS_LOG(INFO) << "Prefetch holds " << kMaxPrefetchTasks << " tasks already, " << task_ids.size() - i
+                     << " tasks are not prefetched.";
+        break;
+      }
+      uint32_t task_index = tasks_.permutation_[task_id];
+      if (std::get<0>(tasks_.GetTaskByID(task_index)) == TaskType::kPaddedTask ||
+          prefetch_pending_.count(task_index) > 0 || prefetch_cache_.count(task_index) > 0) {
+        continue;
+      }
+      prefetch_pending_[task_index] = false;
+      prefetch_queue_.emplace_back(task_index, prefetch_generation_);
+    }
+  }
+  cv_prefetch_.notify_all();
+}
+
+MSRStatus ShardReader::PrefetchByRow(int prefetch_id, uint32_t stream_id) {
+  // Set thread name
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+  auto thread_id = kPrefetchThreadName + std::to_string(prefetch_id);
+  prctl(PR_SET_NAME, common::SafeCStr(thread_id), 0, 0, 0);
+#endif
+
+  for (;;) {
+    uint32_t task_index = 0;
+    uint64_t generation = 0;
+    {
+      std::unique_lock<std::mutex> lck(mtx_prefetch_);
+      cv_prefetch_.wait(lck, [this] { return prefetch_stop_ || !prefetch_queue_.empty(); });
+      if (prefetch_stop_) {
+        return SUCCESS;
+      }
+      std::tie(task_index, generation) = prefetch_queue_.front();
+      prefetch_queue_.pop_front();
+      // the task has been claimed by a consumer before it was read
+      auto it = prefetch_pending_.find(task_index);
+      if (it == prefetch_pending_.end() || generation != prefetch_generation_) {
+        continue;
+      }
+      it->second = true;
+      prefetch_in_flight_++;
+    }
+
+    TaskType task_type = TaskType::kCommonTask;
+    uint32_t shard_id = 0;
+    uint64_t file_offset = 0;
+    uint64_t blob_size = 0;
+    json var_fields;
+    std::vector<uint8_t> blob;
+    bool done = GetTaskBlobAddress(task_index, &task_type, &shard_id, &file_offset, &blob_size, &var_fields) == SUCCESS;
+    done = done && ReadTaskBlob(stream_id, shard_id, file_offset, blob_size, &blob) == SUCCESS;
+    done = done && DecodeBlob(&blob) == SUCCESS;
+    {
+      std::lock_guard<std::mutex> lck(mtx_prefetch_);
+      prefetch_in_flight_--;
+      // a failed read is left to the consumer, which reads the task again and reports the error
+      if (generation == prefetch_generation_) {
+        (void)prefetch_pending_.erase(task_index);
+        if (done) {
+          prefetch_cache_[task_index] = std::make_pair(std::move(blob), std::move(var_fields));
+        }
+      }
+    }
+    cv_prefetch_done_.notify_all();
+  }
+}
+
+bool ShardReader::TakePrefetchedTask(uint32_t task_index, std::vector<uint8_t> *blob, json *var_fields) {
+  std::unique_lock<std::mutex> lck(mtx_prefetch_);
+  auto it = prefetch_pending_.find(task_index);
+  if (it != prefetch_pending_.end()) {
+    if (it->second == false) {
+      // reading it here is faster than waiting behind the queue
+      (void)prefetch_pending_.erase(it);
+      return false;
+    }
+    cv_prefetch_done_.wait(lck, [task_index, this] {
+      return prefetch_stop_ || prefetch_pending_.count(task_index) == 0;
+    });
+  }
+  auto cached = prefetch_cache_.find(task_index);
+  if (cached == prefetch_cache_.end()) {
+    return false;
+  }
+  *blob = std::move(cached->second.first);
+  *var_fields = std::move(cached->second.second);
+  (void)prefetch_cache_.erase(cached);
+  return true;
+}
+
+void ShardReader::ClearPrefetch() {
+  {
+    std::unique_lock<std::mutex> lck(mtx_prefetch_);
+    prefetch_generation_++;
+    prefetch_queue_.clear();
+    prefetch_pending_.clear();
+    prefetch_cache_.clear();
+    // the reads in flight look up tasks_, which the caller is about to change
+    cv_prefetch_done_.wait(lck, [this] { return prefetch_in_flight_ == 0; });
+  }
+  cv_prefetch_done_.notify_all();
+}
+
+void ShardReader::StopPrefetch() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    prefetch_stop_ = true;
+  }
+  cv_prefetch_.notify_all();
+  cv_prefetch_done_.notify_all();
+
+  for (auto &i_thread : prefetch_threads_) {
+    if (i_thread.joinable()) {
+      i_thread.join();
+    }
+  }
+  prefetch_threads_.clear();
+  ClearPrefetch();
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    prefetch_stop_ = false;
+  }
+}
+
 std::pair<MSRStatus, std::vector<std::vector<uint8_t>>> ShardReader::UnCompressBlob(
   const std::vector<uint8_t> &raw_blob_data) {
   auto loaded_columns = selected_columns_.size() == 0 ? shard_column_->GetColumnName() : selected_columns_;
@@ -1413,6 +1944,9 @@ void ShardReader::Reset() {
 }
 
 void ShardReader::ShuffleTask() {
+  // prefetched tasks belong to the previous epoch
+  ClearPrefetch();
+
   // exist shuffle and distributed sampler in ops, skip shuffle
   bool has_sharding = false;
   for (const auto &op : operators_) {
@@ -228,6 +228,9 @@ std::pair<MSRStatus, std::vector<uint8_t>> ShardSegment::PackImages(int group_id
     file_streams_random_[0][shard_id]->close();
     return {FAILED, {}};
   }
+  if (DecodeBlob(&images) != SUCCESS) {
+    return {FAILED, {}};
+  }
 
   return {SUCCESS, std::move(images)};
 }
@@ -33,6 +33,7 @@ ShardWriter::ShardWriter()
 }
 
 ShardWriter::~ShardWriter() {
+  (void)WaitForFlush();
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
     file_streams_[i]->close();
   }
@@ -139,6 +140,7 @@ MSRStatus ShardWriter::InitLockFile() {
 
 MSRStatus ShardWriter::Open(const std::vector<std::string> &paths, bool append) {
   shard_count_ = paths.size();
+  append_ = append;
   if (shard_count_ > kMaxShardCount || shard_count_ == 0) {
     MS_LOG(ERROR) << "The Shard Count greater than max value(1000) or equal to 0, but got " << shard_count_;
     return FAILED;
@@ -206,10 +208,22 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
     return FAILED;
   }
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
+  if (shard_header_->GetPageCodec() != kCodecNone) {
+    page_codec_ = ShardCodec::Create(shard_header_->GetPageCodec());
+    if (page_codec_ == nullptr) {
+      return FAILED;
+    }
+  }
   return SUCCESS;
 }
 
 MSRStatus ShardWriter::Commit() {
+  // Wait for the pages being flushed in streaming mode
+  if (WaitForFlush() == FAILED) {
+    MS_LOG(ERROR) << "Flush data in streaming mode failed";
+    return FAILED;
+  }
+
   // Read pages file
   std::ifstream page_file(pages_file_.c_str());
   if (page_file.good()) {
@@ -232,6 +246,26 @@ MSRStatus ShardWriter::Commit() {
     return FAILED;
   }
 
+  if (streaming_ && WriteIndex() == FAILED) {
+    MS_LOG(ERROR) << "Write index failed";
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::WriteIndex() {
+  ShardIndexGenerator generator(file_paths_[0], append_);
+  if (generator.Build() == FAILED) {
+    MS_LOG(ERROR) << "Failed to build index generator.";
+    return FAILED;
+  }
+  generator.SetRowIndexInfo(std::move(row_index_info_));
+  row_index_info_.clear();
+  if (generator.WriteToDatabase() == FAILED) {
+    MS_LOG(ERROR) << "Failed to write to database.";
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Write index successfully.";
   return SUCCESS;
 }
 
@@ -275,6 +309,58 @@ MSRStatus ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data)
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::SetColumnarRawPage(bool columnar) {
+  if (shard_header_ == nullptr) {
+    MS_LOG(ERROR) << "Shard header is null, set shard header before setting layout of raw data page.";
+    return FAILED;
+  }
+  for (int shard_id = 0; shard_id < shard_count_; ++shard_id) {
+    if (shard_header_->GetLastPageIdByType(shard_id, kPageTypeRaw) >= 0) {
+      MS_LOG(ERROR) << "Layout of raw data page can not be changed after raw data is written.";
+      return FAILED;
+    }
+  }
+  if (columnar && shard_header_->GetSchemaCount() != 1) {
+    MS_LOG(ERROR) << "Columnar raw data page only supports one schema.";
+    return FAILED;
+  }
+  shard_header_->SetRawLayout(columnar ? kRawLayoutColumn : kRawLayoutRow);
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::SetPageCodec(const std::string &codec) {
+  if (shard_header_ == nullptr) {
+    MS_LOG(ERROR) << "Shard header is null, set shard header before setting codec of blob data page.";
+    return FAILED;
+  }
+  for (int shard_id = 0; shard_id < shard_count_; ++shard_id) {
+    if (shard_header_->GetLastPageIdByType(shard_id, kPageTypeBlob) >= 0) {
+      MS_LOG(ERROR) << "Codec of blob data page can not be changed after blob data is written.";
+      return FAILED;
+    }
+  }
+  std::shared_ptr<ShardCodec> page_codec = nullptr;
+  if (codec != kCodecNone) {
+    page_codec = ShardCodec::Create(codec);
+    if (page_codec == nullptr) {
+      return FAILED;
+    }
+  }
+  page_codec_ = page_codec;
+  shard_header_->SetPageCodec(codec);
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::SetStreamingMode(bool streaming) {
+  std::unique_lock<std::mutex> lock(flush_mutex_);
+  if (flush_thread_.joinable()) {
+    MS_LOG(ERROR) << "Streaming mode can not be changed while data is being flushed.";
+    return FAILED;
+  }
+  streaming_ = streaming;
+  return SUCCESS;
+}
+
 MSRStatus ShardWriter::SetHeaderSize(const uint64_t &header_size) {
   // header_size [16KB, 128MB]
   if (header_size < kMinHeaderSize || header_size > kMaxHeaderSize) {
@@ -457,20 +543,21 @@ MSRStatus ShardWriter::CheckData(const std::map<uint64_t, std::vector<json>> &ra
 std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                                              std::vector<std::vector<uint8_t>> &blob_data, bool sign) {
   auto rawdata_iter = raw_data.begin();
-  schema_count_ = raw_data.size();
+  // members are left to the rows being flushed, which may run in background in streaming mode
+  uint32_t schema_count = raw_data.size();
   std::tuple<MSRStatus, int, int> failed(FAILED, 0, 0);
-  if (schema_count_ == 0) {
+  if (schema_count == 0) {
     MS_LOG(ERROR) << "Data size is zero";
     return failed;
   }
 
   // keep schema_id
   std::set<int64_t> schema_ids;
-  row_count_ = (rawdata_iter->second).size();
-  MS_LOG(DEBUG) << "Schema count is " << schema_count_;
+  uint32_t row_count = (rawdata_iter->second).size();
+  MS_LOG(DEBUG) << "Schema count is " << schema_count;
 
   // Determine if the number of schemas is the same
-  if (shard_header_->GetSchemas().size() != schema_count_) {
+  if (shard_header_->GetSchemas().size() != schema_count) {
     MS_LOG(ERROR) << "Data size is not equal with the schema size";
     return failed;
   }
@@ -483,7 +570,7 @@ std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t,
 
   // Determine whether the number of samples corresponding to each schema is the same
   for (rawdata_iter = raw_data.begin(); rawdata_iter != raw_data.end(); ++rawdata_iter) {
-    if (row_count_ != rawdata_iter->second.size()) {
+    if (row_count != rawdata_iter->second.size()) {
       MS_LOG(ERROR) << "Data size is not equal";
       return failed;
     }
@@ -499,22 +586,22 @@ std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t,
   }
 
   if (!sign) {
-    std::tuple<MSRStatus, int, int> success(SUCCESS, schema_count_, row_count_);
+    std::tuple<MSRStatus, int, int> success(SUCCESS, schema_count, row_count);
     return success;
   }
 
   // check the data according the schema
   if (CheckData(raw_data) != SUCCESS) {
     MS_LOG(ERROR) << "Data validate check failed";
-    return std::tuple<MSRStatus, int, int>(FAILED, schema_count_, row_count_);
+    return std::tuple<MSRStatus, int, int>(FAILED, schema_count, row_count);
   }
 
   // delete wrong data from raw data
   DeleteErrorData(raw_data, blob_data);
 
   // update raw count
-  row_count_ = row_count_ - err_mg_.begin()->second.size();
-  std::tuple<MSRStatus, int, int> success(SUCCESS, schema_count_, row_count_);
+  row_count = row_count - err_mg_.begin()->second.size();
+  std::tuple<MSRStatus, int, int> success(SUCCESS, schema_count, row_count);
   return success;
 }
 
@@ -526,12 +613,19 @@ void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>>
     return;
   }
   int schema_count = static_cast<int>(raw_data.size());
+  bool columnar = shard_header_->GetRawLayout() == kRawLayoutColumn;
   std::map<uint64_t, vector<json>>::const_iterator rawdata_iter;
   for (int x = start; x < end; ++x) {
     int cnt = 0;
     for (rawdata_iter = raw_data.begin(); rawdata_iter != raw_data.end(); ++rawdata_iter) {
       const json &line = raw_data.at(rawdata_iter->first)[x];
-      std::vector<std::uint8_t> bline = json::to_msgpack(line);
+      std::vector<std::uint8_t> bline;
+      if (!columnar) {
+        bline = json::to_msgpack(line);
+      } else if (shard_column_->SerializeRawRow(line, &bline) != SUCCESS) {
+        flag_ = true;
+        return;
+      }
 
       // Storage form is [Sample1-Schema1, Sample1-Schema2, Sample2-Schema1, Sample2-Schema2]
       bin_data[x * schema_count + cnt] = bline;
@@ -677,6 +771,11 @@ MSRStatus ShardWriter::MergeBlobData(const std::vector<string> &blob_fields,
 
 MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                     std::vector<std::vector<uint8_t>> &blob_data, bool sign, bool parallel_writer) {
+  if (streaming_ && parallel_writer) {
+    MS_LOG(ERROR) << "Parallel writer is not supported in streaming mode.";
+    return FAILED;
+  }
+
   // Lock Writer if loading data parallel
   int fd = LockWriter(parallel_writer);
   if (fd < 0) {
@@ -684,56 +783,180 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
     return FAILED;
   }
 
+  // Serialize raw data
+  auto batch = std::make_shared<RowBatch>();
+  if (SerializeBatch(raw_data, blob_data, sign, batch.get()) == FAILED) {
+    MS_LOG(ERROR) << "Serialize raw data failed";
+    return FAILED;
+  }
+
+  if (batch->row_count == kInt0) {
+    MS_LOG(INFO) << "Raw data size is 0.";
+    return SUCCESS;
+  }
+
+  // Rows are flushed by background thread while the next rows are serialized
+  if (streaming_) {
+    batch->blob_data = std::move(blob_data);
+    return PushBatch(batch);
+  }
+
+  // Write data to disk with multi threads, blob data is lent to the batch to avoid copying
+  batch->blob_data.swap(blob_data);
+  auto ret = FlushBatch(batch);
+  blob_data.swap(batch->blob_data);
+  if (ret == FAILED) {
+    MS_LOG(ERROR) << "Parallel write data failed";
+    return FAILED;
+  }
+
+  if (UnlockWriter(fd, parallel_writer) == FAILED) {
+    MS_LOG(ERROR) << "Unlock writer failed";
+    return FAILED;
+  }
+
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::SerializeBatch(std::map<uint64_t, std::vector<json>> &raw_data,
+                                      std::vector<std::vector<uint8_t>> &blob_data, bool sign, RowBatch *batch) {
   // Get the count of schemas and rows
   int schema_count = 0;
   int row_count = 0;
-
-  // Serialize raw data
   if (WriteRawDataPreCheck(raw_data, blob_data, sign, &schema_count, &row_count) == FAILED) {
     MS_LOG(ERROR) << "Check raw data failed";
     return FAILED;
   }
-
+  batch->schema_count = schema_count;
+  batch->row_count = row_count;
   if (row_count == kInt0) {
-    MS_LOG(INFO) << "Raw data size is 0.";
     return SUCCESS;
   }
 
-  std::vector<std::vector<uint8_t>> bin_raw_data(row_count * schema_count);
-
-  // Serialize raw data
-  if (SerializeRawData(raw_data, bin_raw_data, row_count) == FAILED) {
+  batch->bin_raw_data.resize(row_count * schema_count);
+  if (SerializeRawData(raw_data, batch->bin_raw_data, row_count) == FAILED) {
     MS_LOG(ERROR) << "Serialize raw data failed";
     return FAILED;
   }
 
   // Set row size of raw data
-  if (SetRawDataSize(bin_raw_data) == FAILED) {
+  if (SetRawDataSize(batch) == FAILED) {
     MS_LOG(ERROR) << "Set raw data size failed";
     return FAILED;
   }
 
+  // Compress blob data before the rows are fitted into pages
+  if (page_codec_ != nullptr && EncodeBlobData(blob_data) == FAILED) {
+    MS_LOG(ERROR) << "Encode blob data failed";
+    return FAILED;
+  }
+
   // Set row size of blob data
-  if (SetBlobDataSize(blob_data) == FAILED) {
+  if (SetBlobDataSize(blob_data, batch) == FAILED) {
     MS_LOG(ERROR) << "Set blob data size failed";
     return FAILED;
   }
 
-  // Write data to disk with multi threads
-  if (ParallelWriteData(blob_data, bin_raw_data) == FAILED) {
-    MS_LOG(ERROR) << "Parallel write data failed";
-    return FAILED;
+  if (streaming_ && !append_) {
+    CollectIndexDetail(raw_data, batch);
   }
-  MS_LOG(INFO) << "Write " << bin_raw_data.size() << " records successfully.";
+  return SUCCESS;
+}
 
-  if (UnlockWriter(fd, parallel_writer) == FAILED) {
-    MS_LOG(ERROR) << "Unlock writer failed";
+void ShardWriter::CollectIndexDetail(const std::map<uint64_t, std::vector<json>> &raw_data, RowBatch *batch) {
+  auto fields = shard_header_->GetFields();
+  batch->index_detail = std::vector<std::vector<json>>(batch->row_count, std::vector<json>(batch->schema_count));
+  for (const auto &field : fields) {
+    auto iter = raw_data.find(field.first);
+    if (iter == raw_data.end() || field.first >= batch->schema_count) {
+      continue;
+    }
+    for (uint32_t i = 0; i < batch->row_count; ++i) {
+      const json &row = iter->second[i];
+      if (row.find(field.second) != row.end()) {
+        batch->index_detail[i][field.first][field.second] = row[field.second];
+      }
+    }
+  }
+}
+
+MSRStatus ShardWriter::FlushBatch(const std::shared_ptr<RowBatch> &batch) {
+  row_count_ = batch->row_count;
+  schema_count_ = batch->schema_count;
+  raw_data_size_ = std::move(batch->raw_data_size);
+  blob_data_size_ = std::move(batch->blob_data_size);
+  auto shards = BreakIntoShards();
+  if (ParallelWriteData(batch->blob_data, batch->bin_raw_data, shards) == FAILED) {
     return FAILED;
   }
 
+  // Keep the rows for generating index, in the order they are appended to each shard
+  if (!batch->index_detail.empty()) {
+    row_index_info_.resize(shard_count_);
+    for (int shard_id = 0; shard_id < shard_count_; ++shard_id) {
+      for (int i = shards[shard_id].first; i < shards[shard_id].second; ++i) {
+        row_index_info_[shard_id].push_back(
+          RowIndexInfo{raw_data_size_[i], blob_data_size_[i], std::move(batch->index_detail[i])});
+      }
+    }
+  }
+  MS_LOG(INFO) << "Write " << row_count_ << " records successfully.";
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::PushBatch(const std::shared_ptr<RowBatch> &batch) {
+  std::unique_lock<std::mutex> lock(flush_mutex_);
+  if (flush_failed_) {
+    MS_LOG(ERROR) << "Flush data in streaming mode failed";
+    return FAILED;
+  }
+  if (!flush_thread_.joinable()) {
+    flush_stop_ = false;
+    flush_thread_ = std::thread(&ShardWriter::FlushWorker, this);
+  }
+  flush_cv_.wait(lock, [this] { return pending_batches_.size() < kMaxPendingBatches; });
+  pending_batches_.push_back(batch);
+  flush_cv_.notify_all();
+  return SUCCESS;
+}
+
+void ShardWriter::FlushWorker() {
+  while (true) {
+    std::shared_ptr<RowBatch> batch;
+    {
+      std::unique_lock<std::mutex> lock(flush_mutex_);
+      flush_cv_.wait(lock, [this] { return !pending_batches_.empty() || flush_stop_; });
+      if (pending_batches_.empty()) {
+        return;
+      }
+      batch = pending_batches_.front();
+    }
+
+    // the batch stays in queue until it is flushed, so that at most kMaxPendingBatches batches are held
+    if (!flush_failed_ && FlushBatch(batch) == FAILED) {
+      MS_LOG(ERROR) << "Parallel write data failed";
+      flush_failed_ = true;
+    }
+    {
+      std::unique_lock<std::mutex> lock(flush_mutex_);
+      pending_batches_.pop_front();
+    }
+    flush_cv_.notify_all();
+  }
+}
+
+MSRStatus ShardWriter::WaitForFlush() {
+  {
+    std::unique_lock<std::mutex> lock(flush_mutex_);
+    flush_stop_ = true;
+  }
+  flush_cv_.notify_all();
+  if (flush_thread_.joinable()) {
+    flush_thread_.join();
+  }
+  return flush_failed_ ? FAILED : SUCCESS;
+}
+
 MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>> &raw_data,
                                     std::map<uint64_t, std::vector<py::handle>> &blob_data, bool sign,
                                     bool parallel_writer) {
@@ -788,8 +1011,8 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>>
 }
 
 MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
-                                         const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  auto shards = BreakIntoShards();
+                                         const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                                         const std::vector<std::pair<int, int>> &shards) {
   // define the number of thread
   int thread_num = static_cast<int>(shard_count_);
   if (thread_num < 0) {
@@ -800,6 +1023,7 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
   }
   int left_thread = shard_count_;
   int current_thread = 0;
+  std::vector<MSRStatus> results(shard_count_, SUCCESS);
   while (left_thread) {
     if (left_thread < thread_num) {
       thread_num = left_thread;
@@ -810,8 +1034,10 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
       for (int x = 0; x < thread_num; ++x) {
         int start_row = shards[current_thread + x].first;
         int end_row = shards[current_thread + x].second;
-        thread_set[x] = std::thread(&ShardWriter::WriteByShard, this, current_thread + x, start_row, end_row,
-                                    std::ref(blob_data), std::ref(bin_raw_data));
+        int shard_id = current_thread + x;
+        thread_set[x] = std::thread([this, shard_id, start_row, end_row, &blob_data, &bin_raw_data, &results]() {
+          results[shard_id] = WriteByShard(shard_id, start_row, end_row, blob_data, bin_raw_data);
+        });
       }
       // Wait for threads done
       for (int x = 0; x < thread_num; ++x) {
@@ -821,6 +1047,10 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
       current_thread += thread_num;
     }
   }
+  if (std::any_of(results.begin(), results.end(), [](MSRStatus ret) { return ret != SUCCESS; })) {
+    MS_LOG(ERROR) << "Write data by shard failed";
+    return FAILED;
+  }
   return SUCCESS;
 }
 
@@ -1250,25 +1480,60 @@ MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &r
   return flag_ == true ? FAILED : SUCCESS;
 }
 
-MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  raw_data_size_ = std::vector<uint64_t>(row_count_, 0);
-  for (uint32_t i = 0; i < row_count_; ++i) {
-    raw_data_size_[i] = std::accumulate(
-      bin_raw_data.begin() + (i * schema_count_), bin_raw_data.begin() + (i * schema_count_) + schema_count_, 0,
+void ShardWriter::EncodeBlobArray(int start, int end, std::vector<std::vector<uint8_t>> &blob_data) {
+  for (int x = start; x < end; ++x) {
+    std::vector<uint8_t> encoded;
+    if (page_codec_->Encode(blob_data[x], &encoded) != SUCCESS) {
+      flag_ = true;
+      return;
+    }
+    blob_data[x] = std::move(encoded);
+  }
+}
+
+MSRStatus ShardWriter::EncodeBlobData(std::vector<std::vector<uint8_t>> &blob_data) {
+  uint32_t thread_num = std::thread::hardware_concurrency();
+  if (thread_num == 0) thread_num = kThreadNumber;
+  int row_count = static_cast<int>(blob_data.size());
+  int group_num = ceil(row_count * 1.0 / thread_num);
+  std::vector<std::thread> thread_set;
+  for (int x = 0; x < static_cast<int>(thread_num); ++x) {
+    int start_num = x * group_num;
+    int end_num = std::min((x + 1) * group_num, row_count);
+    if (start_num >= end_num) {
+      break;
+    }
+    thread_set.emplace_back(&ShardWriter::EncodeBlobArray, this, start_num, end_num, std::ref(blob_data));
+  }
+  for (auto &thread : thread_set) {
+    thread.join();
+  }
+  return flag_ == true ? FAILED : SUCCESS;
+}
+
+MSRStatus ShardWriter::SetRawDataSize(RowBatch *batch) {
+  const auto &bin_raw_data = batch->bin_raw_data;
+  auto schema_count = batch->schema_count;
+  auto &raw_data_size = batch->raw_data_size;
+  raw_data_size = std::vector<uint64_t>(batch->row_count, 0);
+  for (uint32_t i = 0; i < batch->row_count; ++i) {
+    raw_data_size[i] = std::accumulate(
+      bin_raw_data.begin() + (i * schema_count), bin_raw_data.begin() + (i * schema_count) + schema_count, 0,
       [](uint64_t accumulator, const std::vector<uint8_t> &row) { return accumulator + kInt64Len + row.size(); });
   }
-  if (*std::max_element(raw_data_size_.begin(), raw_data_size_.end()) > page_size_) {
+  if (*std::max_element(raw_data_size.begin(), raw_data_size.end()) > page_size_) {
     MS_LOG(ERROR) << "Page size is too small to save a row!";
     return FAILED;
   }
   return SUCCESS;
 }
 
-MSRStatus ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data) {
-  blob_data_size_ = std::vector<uint64_t>(row_count_);
-  (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size_.begin(),
+MSRStatus ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data, RowBatch *batch) {
+  auto &blob_data_size = batch->blob_data_size;
+  blob_data_size = std::vector<uint64_t>(batch->row_count);
+  (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size.begin(),
                        [](const std::vector<uint8_t> &row) { return kInt64Len + row.size(); });
-  if (*std::max_element(blob_data_size_.begin(), blob_data_size_.end()) > page_size_) {
+  if (*std::max_element(blob_data_size.begin(), blob_data_size.end()) > page_size_) {
     MS_LOG(ERROR) << "Page size is too small to save a row!";
     return FAILED;
   }
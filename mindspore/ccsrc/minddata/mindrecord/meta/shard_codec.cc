@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_codec.h"
+
+#ifdef ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "securec.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const uint8_t kMethodStored = 0;
+const uint8_t kMethodCompressed = 1;
+const uint64_t kCodecPrefixLen = 1 + kInt64Len;
+
+#ifdef ENABLE_ZLIB
+class ZlibCodec : public ShardCodec {
+ protected:
+  MSRStatus Compress(const uint8_t *input, uint64_t input_size, std::vector<uint8_t> *output) const override {
+    uLongf output_size = compressBound(input_size);
+    output->resize(output_size);
+    if (compress(output->data(), &output_size, input, input_size) != Z_OK) {
+      MS_LOG(ERROR) << "Failed to compress blob data by zlib.";
+      return FAILED;
+    }
+    output->resize(output_size);
+    return SUCCESS;
+  }
+
+  MSRStatus Decompress(const uint8_t *input, uint64_t input_size, std::vector<uint8_t> *output) const override {
+    uLongf output_size = output->size();
+    if (uncompress(output->data(), &output_size, input, input_size) != Z_OK || output_size != output->size()) {
+      MS_LOG(ERROR) << "Failed to decompress blob data by zlib.";
+      return FAILED;
+    }
+    return SUCCESS;
+  }
+
+  // deflate can not do better than 1032:1
+  uint64_t MaxRatio() const override { return 1032; }
+};
+#endif
+}  // namespace
+
+std::shared_ptr<ShardCodec> ShardCodec::Create(const std::string &name) {
+#ifdef ENABLE_ZLIB
+  if (name == kCodecZlib) {
+    return std::make_shared<ZlibCodec>();
+  }
+#endif
+  MS_LOG(ERROR) << "Codec " << name << " is not supported.";
+  return nullptr;
+}
+
+MSRStatus ShardCodec::Encode(const std::vector<uint8_t> &input, std::vector<uint8_t> *output) const {
+  std::vector<uint8_t> compressed;
+  if (!input.empty() && Compress(input.data(), input.size(), &compressed) != SUCCESS) {
+    return FAILED;
+  }
+  bool stored = input.empty() || compressed.size() >= input.size();
+  const std::vector<uint8_t> &payload = stored ? input : compressed;
+
+  output->resize(kCodecPrefixLen + payload.size());
+  (*output)[0] = stored ? kMethodStored : kMethodCompressed;
+  uint64_t size = input.size();
+  for (uint64_t i = 0; i < kInt64Len; ++i) {
+    (*output)[kCodecPrefixLen - 1 - i] = static_cast<uint8_t>(size >> (i * 8));
+  }
+  if (!payload.empty() &&
+      memcpy_s(output->data() + kCodecPrefixLen, payload.size(), payload.data(), payload.size()) != EOK) {
+    MS_LOG(ERROR) << "Failed to copy encoded blob data.";
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardCodec::Decode(const std::vector<uint8_t> &input, std::vector<uint8_t> *output) const {
+  if (input.size() < kCodecPrefixLen) {
+    MS_LOG(ERROR) << "Encoded blob data is too short, size: " << input.size();
+    return FAILED;
+  }
+  uint64_t size = 0;
+  for (uint64_t i = 1; i < kCodecPrefixLen; ++i) {
+    size = (size << 8) | input[i];
+  }
+  const uint8_t *payload = input.data() + kCodecPrefixLen;
+  uint64_t payload_size = input.size() - kCodecPrefixLen;
+
+  if (input[0] == kMethodStored) {
+    if (size != payload_size) {
+      MS_LOG(ERROR) << "Size of stored blob data mismatch, expected: " << size << ", actual: " << payload_size;
+      return FAILED;
+    }
+    output->assign(payload, payload + payload_size);
+    return SUCCESS;
+  }
+  if (input[0] != kMethodCompressed || size / MaxRatio() > payload_size) {
+    MS_LOG(ERROR) << "Invalid encoded blob data, method: " << static_cast<int>(input[0]) << ", size: " << size;
+    return FAILED;
+  }
+  output->resize(size);
+  return Decompress(payload, payload_size, output);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
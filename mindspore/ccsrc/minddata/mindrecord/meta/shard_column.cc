@@ -70,6 +70,21 @@ void ShardColumn::Init(const json &schema_json, bool compress_integer) {
 
   has_compress_blob_ = (compress_integer && has_integer_array);
   num_blob_column_ = blob_column_.size();
+
+  // numbers of raw columns are laid out before the strings, both in the order of column name list
+  uint64_t number_offset = 0;
+  for (uint64_t i = 0; i < column_name_.size(); i++) {
+    if (blob_column_id_.find(column_name_[i]) != blob_column_id_.end()) {
+      continue;
+    }
+    raw_column_.push_back(column_name_[i]);
+    if (column_data_type_[i] == ColumnString || column_data_type_[i] == ColumnBytes) {
+      raw_string_column_id_[column_name_[i]] = raw_string_column_id_.size();
+    } else {
+      raw_number_column_offset_[column_name_[i]] = number_offset;
+      number_offset += kBytesOfRawNumber;
+    }
+  }
 }
 
 std::pair<MSRStatus, ColumnCategory> ShardColumn::GetColumnTypeByName(const std::string &column_name,
@@ -96,6 +111,15 @@ MSRStatus ShardColumn::GetColumnValueByName(const std::string &column_name, cons
                                             std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes,
                                             ColumnDataType *column_data_type, uint64_t *column_data_type_size,
                                             std::vector<int64_t> *column_shape) {
+  return GetColumnValueByName(column_name, columns_blob.data(), columns_blob.size(), columns_json, data, data_ptr,
+                              n_bytes, column_data_type, column_data_type_size, column_shape);
+}
+
+MSRStatus ShardColumn::GetColumnValueByName(const std::string &column_name, const unsigned char *columns_blob,
+                                            const uint64_t &blob_size, const json &columns_json,
+                                            const unsigned char **data, std::unique_ptr<unsigned char[]> *data_ptr,
+                                            uint64_t *const n_bytes, ColumnDataType *column_data_type,
+                                            uint64_t *column_data_type_size, std::vector<int64_t> *column_shape) {
   // Skip if column not found
   auto column_category = CheckColumnName(column_name);
   if (column_category == ColumnNotFound) {
@@ -119,7 +143,7 @@ MSRStatus ShardColumn::GetColumnValueByName(const std::string &column_name, cons
   }
 
   // Retrieve value from blob
-  if (GetColumnFromBlob(column_name, columns_blob, data, data_ptr, n_bytes) == FAILED) {
+  if (GetColumnFromBlob(column_name, columns_blob, blob_size, data, data_ptr, n_bytes) == FAILED) {
     MS_LOG(ERROR) << "Error when get data from blob, column name is " << column_name << ".";
     return FAILED;
   }
@@ -174,6 +198,96 @@ MSRStatus ShardColumn::GetColumnFromJson(const std::string &column_name, const j
   return SUCCESS;
 }
 
+MSRStatus ShardColumn::SerializeRawRow(const json &row, std::vector<uint8_t> *output) {
+  uint64_t string_start = kBytesOfColumnLen + kBytesOfRawNumber * raw_number_column_offset_.size();
+  uint64_t data_start = string_start + kBytesOfColumnLen * raw_string_column_id_.size();
+  output->assign(data_start, 0);
+
+  auto num_columns = UIntToBytesBig(raw_column_.size(), kInt32Type);
+  std::copy(num_columns.begin(), num_columns.end(), output->begin());
+  for (const auto &column_name : raw_column_) {
+    auto it = row.find(column_name);
+    if (it == row.end()) {
+      MS_LOG(ERROR) << "Column " << column_name << " is not found in row.";
+      return FAILED;
+    }
+    auto column_data_type = column_data_type_[column_name_id_[column_name]];
+    try {
+      if (column_data_type == ColumnString || column_data_type == ColumnBytes) {
+        if (!it->is_string()) {
+          MS_LOG(ERROR) << "Column " << column_name << " is a string column, but value is " << *it << ".";
+          return FAILED;
+        }
+        std::string value = it->get<std::string>();
+        output->insert(output->end(), value.begin(), value.end());
+        auto end_offset = UIntToBytesBig(output->size() - data_start, kInt32Type);
+        std::copy(end_offset.begin(), end_offset.end(),
+                  output->begin() + string_start + kBytesOfColumnLen * raw_string_column_id_[column_name]);
+        continue;
+      }
+      // keep the value written by user, float32 is not narrowed and int32 is range checked when it is read.
+      // Numbers are big-endian like the counts and offsets of the row.
+      uint64_t bits = 0;
+      if (column_data_type == ColumnFloat32 || column_data_type == ColumnFloat64) {
+        double value = it->get<double>();
+        (void)memcpy_s(&bits, sizeof(bits), &value, sizeof(value));
+      } else {
+        bits = static_cast<uint64_t>(it->get<int64_t>());
+      }
+      auto bytes = UIntToBytesBig(bits, kInt64Type);
+      std::copy(bytes.begin(), bytes.end(),
+                output->begin() + kBytesOfColumnLen + raw_number_column_offset_[column_name]);
+    } catch (json::exception &e) {
+      MS_LOG(ERROR) << "Conversion failed, column name is " << column_name << ", value is " << *it << ".";
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardColumn::DeserializeRawRow(const unsigned char *raw_row, const uint64_t &row_size,
+                                         const std::vector<std::string> &columns, json *row) {
+  uint64_t string_start = kBytesOfColumnLen + kBytesOfRawNumber * raw_number_column_offset_.size();
+  uint64_t data_start = string_start + kBytesOfColumnLen * raw_string_column_id_.size();
+  if (row_size < data_start || BytesBigToUInt64(raw_row, 0, kInt32Type) != raw_column_.size()) {
+    MS_LOG(ERROR) << "Raw row does not match the schema, row size: " << row_size << ".";
+    return FAILED;
+  }
+
+  for (const auto &column_name : columns.empty() ? raw_column_ : columns) {
+    auto it_number = raw_number_column_offset_.find(column_name);
+    if (it_number != raw_number_column_offset_.end()) {
+      uint64_t bits = BytesBigToUInt64(raw_row, kBytesOfColumnLen + it_number->second, kInt64Type);
+      auto column_data_type = column_data_type_[column_name_id_[column_name]];
+      if (column_data_type == ColumnFloat32 || column_data_type == ColumnFloat64) {
+        double value = 0;
+        (void)memcpy_s(&value, sizeof(value), &bits, sizeof(bits));
+        (*row)[column_name] = value;
+      } else {
+        (*row)[column_name] = static_cast<int64_t>(bits);
+      }
+      continue;
+    }
+
+    // blob columns have nothing in raw row
+    auto it_string = raw_string_column_id_.find(column_name);
+    if (it_string == raw_string_column_id_.end()) {
+      continue;
+    }
+    uint64_t begin = 0;
+    if (it_string->second > 0) {
+      begin = BytesBigToUInt64(raw_row, string_start + kBytesOfColumnLen * (it_string->second - 1), kInt32Type);
+    }
+    uint64_t end = BytesBigToUInt64(raw_row, string_start + kBytesOfColumnLen * it_string->second, kInt32Type);
+    if (begin > end || data_start + end > row_size) {
+      MS_LOG(ERROR) << "Column " << column_name << " is out of raw row, row size: " << row_size << ".";
+      return FAILED;
+    }
+    (*row)[column_name] = std::string(reinterpret_cast<const char *>(raw_row + data_start + begin), end - begin);
+  }
+  return SUCCESS;
+}
+
 template <typename T>
 MSRStatus ShardColumn::GetFloat(std::unique_ptr<unsigned char[]> *data_ptr, const json &json_column_value,
                                 bool use_double) {
@@ -262,9 +376,15 @@ MSRStatus ShardColumn::GetInt(std::unique_ptr<unsigned char[]> *data_ptr, const
 MSRStatus ShardColumn::GetColumnFromBlob(const std::string &column_name, const std::vector<uint8_t> &columns_blob,
                                          const unsigned char **data, std::unique_ptr<unsigned char[]> *data_ptr,
                                          uint64_t *const n_bytes) {
+  return GetColumnFromBlob(column_name, columns_blob.data(), columns_blob.size(), data, data_ptr, n_bytes);
+}
+
+MSRStatus ShardColumn::GetColumnFromBlob(const std::string &column_name, const unsigned char *columns_blob,
+                                         const uint64_t &blob_size, const unsigned char **data,
+                                         std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes) {
   uint64_t offset_address = 0;
   auto column_id = column_name_id_[column_name];
-  if (GetColumnAddressInBlock(column_id, columns_blob, n_bytes, &offset_address) == FAILED) {
+  if (GetColumnAddressInBlock(column_id, columns_blob, blob_size, n_bytes, &offset_address) == FAILED) {
     return FAILED;
   }
 
@@ -278,7 +398,7 @@ MSRStatus ShardColumn::GetColumnFromBlob(const std::string &column_name, const s
       return FAILED;
     }
   } else {
-    *data = reinterpret_cast<const unsigned char *>(&(columns_blob[offset_address]));
+    *data = columns_blob + offset_address;
   }
 
   return SUCCESS;
@@ -313,7 +433,7 @@ std::vector<uint8_t> ShardColumn::CompressBlob(const std::vector<uint8_t> &blob,
     }
 
     // Just copy and continue if column dat type is not int32/int64
-    uint64_t num_bytes = BytesBigToUInt64(blob, i_src, kInt64Type);
+    uint64_t num_bytes = BytesBigToUInt64(blob.data(), i_src, kInt64Type);
     if (src_data_type != ColumnInt32 && src_data_type != ColumnInt64) {
       dst_blob.insert(dst_blob.end(), blob.begin() + i_src, blob.begin() + i_src + kInt64Len + num_bytes);
       i_src += kInt64Len + num_bytes;
@@ -361,7 +481,7 @@ vector<uint8_t> ShardColumn::CompressInt(const vector<uint8_t> &src_bytes, const
     // Shift to next int position
     uint64_t pos = i * (kUnsignedOne << static_cast<uint8_t>(int_type));
     // Narrow down this int
-    int64_t i_n = BytesLittleToMinIntType(src_bytes, pos, int_type, &dst_int_type);
+    int64_t i_n = BytesLittleToMinIntType(src_bytes.data(), pos, int_type, &dst_int_type);
 
     // Write this int to destination blob
     uint64_t u_n = *reinterpret_cast<uint64_t *>(&i_n);
@@ -380,29 +500,39 @@ vector<uint8_t> ShardColumn::CompressInt(const vector<uint8_t> &src_bytes, const
   return dst_bytes;
 }
 
-MSRStatus ShardColumn::GetColumnAddressInBlock(const uint64_t &column_id, const std::vector<uint8_t> &columns_blob,
-                                               uint64_t *num_bytes, uint64_t *shift_idx) {
+MSRStatus ShardColumn::GetColumnAddressInBlock(const uint64_t &column_id, const unsigned char *columns_blob,
+                                               const uint64_t &blob_size, uint64_t *num_bytes, uint64_t *shift_idx) {
   if (num_blob_column_ == 1) {
-    *num_bytes = columns_blob.size();
+    *num_bytes = blob_size;
     *shift_idx = 0;
     return SUCCESS;
   }
   auto blob_id = blob_column_id_[column_name_[column_id]];
 
-  for (int32_t i = 0; i < blob_id; i++) {
-    *shift_idx += kInt64Len + BytesBigToUInt64(columns_blob, *shift_idx, kInt64Type);
+  // Every length is checked against the blob before it is read
+  for (int32_t i = 0; i <= blob_id; i++) {
+    if (*shift_idx > blob_size || blob_size - *shift_idx < kInt64Len) {
+      MS_LOG(ERROR) << "Column address is out of blob, offset: " << *shift_idx << ", blob size: " << blob_size;
+      return FAILED;
+    }
+    *num_bytes = BytesBigToUInt64(columns_blob, *shift_idx, kInt64Type);
+    (*shift_idx) += kInt64Len;
+    if (*num_bytes > blob_size - *shift_idx) {
+      MS_LOG(ERROR) << "Column size is out of blob, offset: " << *shift_idx << ", size: " << *num_bytes
+                    << ", blob size: " << blob_size;
+      return FAILED;
+    }
+    if (i < blob_id) {
+      (*shift_idx) += *num_bytes;
+    }
   }
-  *num_bytes = BytesBigToUInt64(columns_blob, *shift_idx, kInt64Type);
-
-  (*shift_idx) += kInt64Len;
 
   return SUCCESS;
 }
 
 template <typename T>
 MSRStatus ShardColumn::UncompressInt(const uint64_t &column_id, std::unique_ptr<unsigned char[]> *const data_ptr,
-                                     const std::vector<uint8_t> &columns_blob, uint64_t *num_bytes,
-                                     uint64_t shift_idx) {
+                                     const unsigned char *columns_blob, uint64_t *num_bytes, uint64_t shift_idx) {
   auto num_elements = BytesBigToUInt64(columns_blob, shift_idx, kInt32Type);
   *num_bytes = sizeof(T) * num_elements;
 
@@ -429,7 +559,7 @@ MSRStatus ShardColumn::UncompressInt(const uint64_t &column_id, std::unique_ptr<
   return SUCCESS;
 }
 
-uint64_t ShardColumn::BytesBigToUInt64(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
+uint64_t ShardColumn::BytesBigToUInt64(const unsigned char *bytes_array, const uint64_t &pos,
                                        const IntegerType &i_type) {
   uint64_t result = 0;
   for (uint64_t i = 0; i < (kUnsignedOne << static_cast<uint8_t>(i_type)); i++) {
@@ -458,7 +588,7 @@ std::vector<uint8_t> ShardColumn::UIntToBytesLittle(uint64_t value, const Intege
   return result;
 }
 
-int64_t ShardColumn::BytesLittleToMinIntType(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
+int64_t ShardColumn::BytesLittleToMinIntType(const unsigned char *bytes_array, const uint64_t &pos,
                                              const IntegerType &src_i_type, IntegerType *dst_i_type) {
   uint64_t u_temp = 0;
   for (uint64_t i = 0; i < (kUnsignedOne << static_cast<uint8_t>(src_i_type)); i++) {
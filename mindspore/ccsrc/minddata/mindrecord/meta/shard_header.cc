@@ -33,7 +33,13 @@ using mindspore::MsLogLevel::ERROR;
 namespace mindspore {
 namespace mindrecord {
 std::atomic<bool> thread_status(false);
-ShardHeader::ShardHeader() : shard_count_(0), header_size_(0), page_size_(0), compression_size_(0) {
+ShardHeader::ShardHeader()
+    : shard_count_(0),
+      header_size_(0),
+      page_size_(0),
+      compression_size_(0),
+      raw_layout_(kRawLayoutRow),
+      page_codec_(kCodecNone) {
   index_ = std::make_shared<Index>();
 }
 
@@ -57,6 +63,8 @@ MSRStatus ShardHeader::InitializeHeader(const std::vector<json> &headers, bool l
       header_size_ = header["header_size"].get<uint64_t>();
       page_size_ = header["page_size"].get<uint64_t>();
       compression_size_ = header.contains("compression_size") ? header["compression_size"].get<uint64_t>() : 0;
+      raw_layout_ = header.contains("raw_layout") ? header["raw_layout"].get<std::string>() : kRawLayoutRow;
+      page_codec_ = header.contains("page_codec") ? header["page_codec"].get<std::string>() : kCodecNone;
     }
     if (SUCCESS != ParsePage(header["page"], shard_index, load_dataset)) {
       return FAILED;
@@ -151,10 +159,16 @@ std::pair<MSRStatus, json> ShardHeader::BuildSingleHeader(const std::string &fil
   json raw_header = ret.second;
   uint64_t compression_size =
     raw_header.contains("compression_size") ? raw_header["compression_size"].get<uint64_t>() : 0;
+  std::string raw_layout =
+    raw_header.contains("raw_layout") ? raw_header["raw_layout"].get<std::string>() : kRawLayoutRow;
+  std::string page_codec =
+    raw_header.contains("page_codec") ? raw_header["page_codec"].get<std::string>() : kCodecNone;
   json header = {{"shard_addresses", raw_header["shard_addresses"]},
                  {"header_size", raw_header["header_size"]},
                  {"page_size", raw_header["page_size"]},
                  {"compression_size", compression_size},
+                 {"raw_layout", raw_layout},
+                 {"page_codec", page_codec},
                  {"index_fields", raw_header["index_fields"]},
                  {"blob_fields", raw_header["schema"][0]["blob_fields"]},
                  {"schema", raw_header["schema"][0]["schema"]},
@@ -342,6 +356,7 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
   if (shard_count_ > static_cast<int>(pages.size())) {
     return std::vector<string>{};
   }
+  std::string version = raw_layout_ == kRawLayoutColumn || page_codec_ != kCodecNone ? kExtendedVersion : kVersion;
   if (shard_count_ <= kMaxShardCount) {
     for (int shardId = 0; shardId < shard_count_; shardId++) {
       string s;
@@ -350,11 +365,13 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
       s += "\"page\":" + pages[shardId] + ",";
       s += "\"page_size\":" + std::to_string(page_size_) + ",";
       s += "\"compression_size\":" + std::to_string(compression_size_) + ",";
+      s += "\"page_codec\":\"" + page_codec_ + "\",";
+      s += "\"raw_layout\":\"" + raw_layout_ + "\",";
       s += "\"schema\":" + schema + ",";
       s += "\"shard_addresses\":" + address + ",";
       s += "\"shard_id\":" + std::to_string(shardId) + ",";
       s += "\"statistics\":" + stats + ",";
-      s += "\"version\":\"" + std::string(kVersion) + "\"";
+      s += "\"version\":\"" + version + "\"";
       s += "}";
       header.emplace_back(s);
     }
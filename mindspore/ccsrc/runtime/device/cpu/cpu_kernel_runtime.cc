@@ -22,6 +22,9 @@
 #include <algorithm>
 #include <functional>
 #include <exception>
+#include <thread>
+#include <tuple>
+#include <mutex>
 #include "backend/kernel_compiler/kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "runtime/device/cpu/cpu_memory_manager.h"
@@ -29,9 +32,12 @@
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/session/session_basic.h"
 #include "frontend/operator/ops.h"
+#include "pybind_api/ir/primitive_py.h"
 #include "utils/shape_utils.h"
 #include "utils/profile.h"
 #include "utils/trace_base.h"
+#include "utils/ms_utils.h"
+#include "utils/flags.h"
 #ifdef MEM_REUSE_DEBUG
 #include "backend/optimizer/mem_reuse/mem_reuse_checker.h"
 #endif
@@ -39,6 +45,51 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+// Number of threads launching the kernels of a graph concurrently, the kernels run one by one in execution order if
+// it is not set
+const char kInterOpThreadsEnv[] = "MS_CPU_INTER_OP_THREADS";
+
+size_t GetInterOpThreadNum() {
+  auto env = common::GetEnv(kInterOpThreadsEnv);
+  if (env.empty()) {
+    return 1;
+  }
+  int thread_num = 1;
+  try {
+    thread_num = std::stoi(env);
+  } catch (std::exception &e) {
+    MS_LOG(WARNING) << "Invalid " << kInterOpThreadsEnv << ": " << env;
+    return 1;
+  }
+  int max_thread_num = static_cast<int>(std::thread::hardware_concurrency());
+  return static_cast<size_t>(std::max(1, std::min(thread_num, max_thread_num)));
+}
+
+// Kernels which must not overlap with any other kernel. The side effects of a kernel, such as the output of Print,
+// are not seen in the memory it touches, so they keep their place in the execution order.
+bool IsSerialKernel(const CNodePtr &kernel) {
+  auto name = AnfAlgo::GetCNodeName(kernel);
+  if (AnfAlgo::IsCommunicationOp(kernel) || name == kPushOpName || name == kPullOpName) {
+    return true;
+  }
+  if (!AnfAlgo::HasNodeAttr(GRAPH_FLAG_SIDE_EFFECT, kernel)) {
+    return false;
+  }
+  return AnfAlgo::GetNodeAttr<bool>(kernel, GRAPH_FLAG_SIDE_EFFECT);
+}
+
+// Whether a kernel updates a parameter input in place, as an optimizer does. The python primitives mark such inputs
+// as written in their signature, the parameter inputs of the other primitives are taken as written.
+bool IsWrittenParameterInput(const CNodePtr &kernel, size_t input_index) {
+  auto prim = AnfAlgo::GetCNodePrimitive(kernel);
+  if (prim == nullptr || !prim->isa<PrimitivePy>()) {
+    return true;
+  }
+  auto &signatures = prim->cast<PrimitivePyPtr>()->signatures();
+  return input_index < signatures.size() && signatures[input_index].rw == SignatureEnumRW::kRWWrite;
+}
+}  // namespace
 
 bool CPUKernelRuntime::Init() {
   if (initialized_) {
@@ -46,12 +97,23 @@ bool CPUKernelRuntime::Init() {
   }
   mem_manager_ = std::make_shared<CPUMemoryManager>();
   MS_EXCEPTION_IF_NULL(mem_manager_);
+  auto inter_op_thread_num = GetInterOpThreadNum();
+  if (inter_op_thread_num > 1) {
+    MS_LOG(INFO) << "Launch cpu kernels on " << inter_op_thread_num << " threads";
+    scheduler_ = std::make_unique<CPUKernelScheduler>(inter_op_thread_num);
+  }
   initialized_ = true;
   return true;
 }
 
 const size_t INIT_NODE_REF = 1;
 void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  // The launch plan holds the addresses assigned before
+  {
+    std::lock_guard<std::mutex> lock(launch_plans_mutex_);
+    (void)launch_plans_.erase(kernel_graph->graph_id());
+  }
   AssignValueNodeAddress(kernel_graph);
   AssignInputNodeAddress(kernel_graph);
   auto context_ptr = MsContext::GetInstance();
@@ -281,18 +343,31 @@ void CPUKernelRuntime::BindInputTensorAddressPtr(const session::KernelGraph &ker
   if (input_nodes.size() != inputs.size()) {
     MS_LOG(EXCEPTION) << "Input size not equal to input node size!";
   }
-  size_t input_idx = 0;
-  for (auto &item : input_nodes) {
-    MS_EXCEPTION_IF_NULL(item);
-    if (item->isa<Parameter>()) {
-      auto address = AnfAlgo::GetMutableOutputAddr(item, 0);
+  auto &graph_inputs = GetLaunchPlan(kernel_graph.graph_id())->inputs;
+  if (graph_inputs.size() != input_nodes.size()) {
+    graph_inputs.clear();
+    for (auto &item : input_nodes) {
+      MS_EXCEPTION_IF_NULL(item);
+      GraphInput input;
+      if (item->isa<Parameter>()) {
+        input.parameter = item->cast<ParameterPtr>();
+        input.address = AnfAlgo::GetMutableOutputAddr(item, 0);
+        MS_EXCEPTION_IF_NULL(input.address);
+        input.is_weight = AnfAlgo::IsParameterWeight(input.parameter);
+      }
+      graph_inputs.push_back(input);
+    }
+  }
+  for (size_t input_idx = 0; input_idx < graph_inputs.size(); ++input_idx) {
+    auto &item = graph_inputs[input_idx].parameter;
+    if (item != nullptr) {
+      auto &address = graph_inputs[input_idx].address;
       auto tensor = inputs[input_idx];
-      auto tensor_address = tensor->device_address();
-      MS_EXCEPTION_IF_NULL(address);
       MS_EXCEPTION_IF_NULL(tensor);
+      auto tensor_address = tensor->device_address();
       if (tensor_address != nullptr && tensor_address != address &&
           (std::dynamic_pointer_cast<device::DeviceAddress>(tensor_address)->DeviceType() != DeviceAddressType::kCPU ||
-           AnfAlgo::IsParameterWeight(item->cast<ParameterPtr>()))) {
+           graph_inputs[input_idx].is_weight)) {
         tensor->data_sync(false);
       }
       if (GetTypeByte(TypeIdToType(tensor->data_type())) == GetTypeByte(TypeIdToType(address->type_id_))) {
@@ -307,7 +382,7 @@ void CPUKernelRuntime::BindInputTensorAddressPtr(const session::KernelGraph &ker
           MS_LOG(EXCEPTION) << "Parameter node sync host to device failed!";
         }
       }
-      if (item->cast<ParameterPtr>()->is_used_by_dynamic_kernel()) {
+      if (item->is_used_by_dynamic_kernel()) {
         auto tensor_shape = tensor->shape();
         std::vector<size_t> shape_tmp;
         (void)std::transform(tensor_shape.begin(), tensor_shape.end(), std::back_inserter(shape_tmp), IntToSize);
@@ -316,7 +391,6 @@ void CPUKernelRuntime::BindInputTensorAddressPtr(const session::KernelGraph &ker
       address->ref_count_ = INIT_NODE_REF;
       tensor->set_device_address(address);
     }
-    input_idx++;
   }
 }
 
@@ -371,54 +445,233 @@ void CPUKernelRuntime::DecreaseSummaryRefCount(const session::NamedSummaryOutput
   static_cast<CPUMemoryManager *>(mem_manager_.get())->DecreaseSummaryRefCount(summary_outputs);
 }
 
+void CPUKernelRuntime::GetLaunchArgs(const CNodePtr &kernel, std::vector<kernel::AddressPtr> *inputs,
+                                     std::vector<kernel::AddressPtr> *workspaces,
+                                     std::vector<kernel::AddressPtr> *outputs) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, inputs);
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+  for (size_t i = 0; i < output_num; ++i) {
+    auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, outputs);
+  }
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+    auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, workspaces);
+  }
+}
+
+void CPUKernelRuntime::LaunchKernel(const CNodePtr &kernel, const std::vector<kernel::AddressPtr> &inputs,
+                                    const std::vector<kernel::AddressPtr> &workspaces,
+                                    const std::vector<kernel::AddressPtr> &outputs) {
+#ifdef ENABLE_PROFILE
+  double start_time = GetTime();
+#endif
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  bool ret = true;
+  try {
+    ret = kernel_mod->Launch(inputs, workspaces, outputs, 0);
+  } catch (std::exception &e) {
+    MS_LOG(EXCEPTION) << e.what() << "\nTrace:" << trace::DumpSourceLines(kernel);
+  }
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(kernel);
+  }
+#ifdef ENABLE_PROFILE
+  double cost_time = GetTime() - start_time;
+  MS_LOG(INFO) << "cpu kernel: " << kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
+#endif
+}
+
+void CPUKernelRuntime::BuildLaunchPlan(const session::KernelGraph *kernel_graph, GraphLaunchPlan *plan) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  MS_EXCEPTION_IF_NULL(plan);
+  plan->built = true;
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // The op of pynative mode gets new addresses on every run, and the arguments of a dynamic shape kernel change
+  // with its shapes
+  auto &kernels = kernel_graph->execution_order();
+  plan->enabled = context_ptr->get_param<int>(MS_CTX_EXECUTION_MODE) != kPynativeMode &&
+                  std::none_of(kernels.begin(), kernels.end(),
+                               [](const CNodePtr &kernel) { return AnfAlgo::IsDynamicShape(kernel); });
+  if (!plan->enabled) {
+    return;
+  }
+  // The parameters and the graph outputs are bound to the memory of new tensors on every step
+  std::set<const DeviceAddress *> output_addresses;
+  if (kernel_graph->output() != nullptr) {
+    for (const auto &output : AnfAlgo::GetAllOutput(kernel_graph->output(), {prim::kPrimTupleGetItem})) {
+      auto node = AnfAlgo::VisitKernelWithReturnType(output, 0, true).first;
+      MS_EXCEPTION_IF_NULL(node);
+      if (!node->isa<CNode>()) {
+        continue;
+      }
+      size_t output_num = AnfAlgo::GetOutputTensorNum(node);
+      for (size_t i = 0; i < output_num; ++i) {
+        (void)output_addresses.insert(AnfAlgo::GetMutableOutputAddr(node, i).get());
+      }
+    }
+  }
+  size_t kernel_num = kernels.size();
+  plan->kernel_args.resize(kernel_num);
+  plan->accesses.resize(kernel_num);
+  for (size_t k = 0; k < kernel_num; ++k) {
+    auto &kernel = kernels[k];
+    auto &args = plan->kernel_args[k];
+    GetLaunchArgs(kernel, &args.inputs, &args.workspaces, &args.outputs);
+    auto &access = plan->accesses[k];
+    access.writes = args.outputs;
+    access.writes.insert(access.writes.end(), args.workspaces.begin(), args.workspaces.end());
+    for (size_t i = 0; i < args.inputs.size(); ++i) {
+      bool is_parameter = AnfAlgo::GetPrevNodeOutput(kernel, i, true).first->isa<Parameter>();
+      auto address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
+      if (is_parameter || output_addresses.count(address) > 0) {
+        plan->bound_args.emplace_back(args.inputs[i], address);
+      }
+      // Optimizers update their parameters in place, the other kernels only read them
+      if (is_parameter && IsWrittenParameterInput(kernel, i)) {
+        access.writes.push_back(args.inputs[i]);
+      } else {
+        access.reads.push_back(args.inputs[i]);
+      }
+    }
+    for (size_t i = 0; i < args.outputs.size(); ++i) {
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
+      if (output_addresses.count(address) > 0) {
+        plan->bound_args.emplace_back(args.outputs[i], address);
+      }
+    }
+    access.serial = IsSerialKernel(kernel);
+  }
+  MS_LOG(INFO) << "Launch plan of graph " << kernel_graph->graph_id() << ": " << kernel_num << " kernels, "
+               << plan->bound_args.size() << " arguments bound to tensors";
+}
+
+CPUKernelRuntime::GraphLaunchPlan *CPUKernelRuntime::GetLaunchPlan(uint32_t graph_id) {
+  std::lock_guard<std::mutex> lock(launch_plans_mutex_);
+  return &launch_plans_[graph_id];
+}
+
+void CPUKernelRuntime::PatchBoundArgs(GraphLaunchPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  for (auto &bound_arg : plan->bound_args) {
+    auto &arg = bound_arg.first;
+    auto address = bound_arg.second;
+    if (address->ptr_ == nullptr) {
+      address->ptr_ = static_cast<CPUMemoryManager *>(mem_manager_.get())->StaticMemMalloc(address->size_);
+    }
+    arg->addr = address->ptr_;
+    arg->size = address->size_;
+  }
+}
+
+bool CPUKernelRuntime::UpdateBoundAliases(GraphLaunchPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  // The tensors bound to the graph get new memory on every step, apart from the memory planned for the graph. The
+  // kernels touching them keep their dependencies unless the tensors share memory in another way than before, as
+  // when one tensor is given for two inputs.
+  std::vector<std::tuple<size_t, size_t, const DeviceAddress *>> ranges;
+  ranges.reserve(plan->bound_args.size());
+  for (const auto &bound_arg : plan->bound_args) {
+    auto address = bound_arg.second;
+    if (address->ptr_ != nullptr && address->size_ > 0) {
+      auto begin = reinterpret_cast<size_t>(address->ptr_);
+      ranges.emplace_back(begin, begin + address->size_, address);
+    }
+  }
+  std::sort(ranges.begin(), ranges.end());
+  ranges.erase(std::unique(ranges.begin(), ranges.end()), ranges.end());
+  std::vector<std::pair<const DeviceAddress *, const DeviceAddress *>> aliases;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    for (size_t j = i + 1; j < ranges.size() && std::get<0>(ranges[j]) < std::get<1>(ranges[i]); ++j) {
+      auto first = std::get<2>(ranges[i]);
+      auto second = std::get<2>(ranges[j]);
+      if (first != second) {
+        aliases.emplace_back(std::min(first, second), std::max(first, second));
+      }
+    }
+  }
+  std::sort(aliases.begin(), aliases.end());
+  aliases.erase(std::unique(aliases.begin(), aliases.end()), aliases.end());
+  if (aliases == plan->bound_aliases) {
+    return false;
+  }
+  plan->bound_aliases = std::move(aliases);
+  return true;
+}
+
+void CPUKernelRuntime::RunLaunchPlan(const session::KernelGraph *kernel_graph, GraphLaunchPlan *plan) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  MS_EXCEPTION_IF_NULL(plan);
+  PatchBoundArgs(plan);
+  auto &kernels = kernel_graph->execution_order();
+  auto &kernel_args = plan->kernel_args;
+  if (scheduler_ == nullptr || kernels.size() < 2) {
+    for (size_t k = 0; k < kernels.size(); ++k) {
+      LaunchKernel(kernels[k], kernel_args[k].inputs, kernel_args[k].workspaces, kernel_args[k].outputs);
+    }
+    return;
+  }
+  // The dependencies follow the memory, they change when the tensors bound to the graph share it differently
+  bool aliases_changed = UpdateBoundAliases(plan);
+  if (!plan->dag_built || aliases_changed) {
+    plan->dag.Build(plan->accesses);
+    plan->dag_built = true;
+  }
+  scheduler_->Run(plan->dag, [this, &kernels, &kernel_args](size_t k) {
+    LaunchKernel(kernels[k], kernel_args[k].inputs, kernel_args[k].workspaces, kernel_args[k].outputs);
+  });
+}
+
+void CPUKernelRuntime::ClearGraphRuntimeResource(uint32_t graph_id, const std::vector<AnfNodePtr> &inputs,
+                                                 const std::unordered_set<ValueNodePtr> &value_nodes,
+                                                 const std::vector<CNodePtr> &execution_order) {
+  // The launch plan holds the addresses of the graph
+  {
+    std::lock_guard<std::mutex> lock(launch_plans_mutex_);
+    (void)launch_plans_.erase(graph_id);
+  }
+  KernelRuntime::ClearGraphRuntimeResource(graph_id, inputs, value_nodes, execution_order);
+}
+
 bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
-  static_cast<CPUMemoryManager *>(mem_manager_.get())->IncreaseAddressRefCount(kernel_graph);
+  auto mem_manager = static_cast<CPUMemoryManager *>(mem_manager_.get());
+  mem_manager->IncreaseAddressRefCount(kernel_graph);
+  // The memory of the kernels is only kept from one step to the next when it is not malloced on the fly
+  auto plan = GetLaunchPlan(kernel_graph->graph_id());
+  if (!mem_manager->dynamic_malloc()) {
+    if (!plan->built) {
+      BuildLaunchPlan(kernel_graph, plan);
+    }
+    if (plan->enabled) {
+      RunLaunchPlan(kernel_graph, plan);
+      return true;
+    }
+  }
 
   auto kernels = kernel_graph->execution_order();
   for (const auto &kernel : kernels) {
-#ifdef ENABLE_PROFILE
-    double start_time = GetTime();
-#endif
     if (AnfAlgo::IsDynamicShape(kernel)) {
       AnfAlgo::InferShape(kernel);
     }
     std::vector<kernel::AddressPtr> kernel_inputs;
     std::vector<kernel::AddressPtr> kernel_workspaces;
     std::vector<kernel::AddressPtr> kernel_outputs;
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_inputs);
-    }
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_outputs);
-    }
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_workspaces);
-    }
-    bool ret = true;
-    try {
-      ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
-    } catch (std::exception &e) {
-      MS_LOG(EXCEPTION) << e.what() << "\nTrace:" << trace::DumpSourceLines(kernel);
-    }
-    if (!ret) {
-      MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(kernel);
-    }
-    static_cast<CPUMemoryManager *>(mem_manager_.get())->DecreaseAddressRefCount(kernel);
-#ifdef ENABLE_PROFILE
-    double cost_time = GetTime() - start_time;
-    MS_LOG(INFO) << "cpu kernel: " << kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
-#endif
+    GetLaunchArgs(kernel, &kernel_inputs, &kernel_workspaces, &kernel_outputs);
+    LaunchKernel(kernel, kernel_inputs, kernel_workspaces, kernel_outputs);
+    mem_manager->DecreaseAddressRefCount(kernel);
   }
   return true;
 }
@@ -20,8 +20,12 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
 #include <set>
+#include <unordered_set>
+#include <utility>
 #include "runtime/device/kernel_runtime.h"
+#include "runtime/device/cpu/cpu_kernel_scheduler.h"
 #include "backend/session/kernel_graph.h"
 #include "backend/session/session_basic.h"
 #include "backend/session/anf_runtime_algorithm.h"
@@ -45,6 +49,9 @@ class CPUKernelRuntime : public KernelRuntime {
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   bool GenDynamicKernel(const session::KernelGraph *graph) override { return true; }
   bool RunDynamicKernelAsync(const session::KernelGraph *graph) override { return true; }
+  void ClearGraphRuntimeResource(uint32_t graph_id, const std::vector<AnfNodePtr> &inputs,
+                                 const std::unordered_set<ValueNodePtr> &value_nodes,
+                                 const std::vector<CNodePtr> &execution_order) override;
 
  protected:
   bool SyncStream() override { return true; };
@@ -62,6 +69,45 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  void GetLaunchArgs(const CNodePtr &kernel, std::vector<kernel::AddressPtr> *inputs,
+                     std::vector<kernel::AddressPtr> *workspaces, std::vector<kernel::AddressPtr> *outputs);
+  void LaunchKernel(const CNodePtr &kernel, const std::vector<kernel::AddressPtr> &inputs,
+                    const std::vector<kernel::AddressPtr> &workspaces, const std::vector<kernel::AddressPtr> &outputs);
+  struct KernelLaunchArgs {
+    std::vector<kernel::AddressPtr> inputs;
+    std::vector<kernel::AddressPtr> workspaces;
+    std::vector<kernel::AddressPtr> outputs;
+  };
+  struct GraphInput {
+    // Null if the input is not a parameter
+    ParameterPtr parameter;
+    DeviceAddressPtr address;
+    bool is_weight{false};
+  };
+  // The launch arguments of the kernels of a graph, built on the first step and reused by the next ones. Only the
+  // arguments of the addresses bound to the input and output tensors are patched before a step.
+  struct GraphLaunchPlan {
+    std::vector<GraphInput> inputs;
+    bool built{false};
+    // False if the arguments must be built again on every step
+    bool enabled{false};
+    std::vector<KernelLaunchArgs> kernel_args;
+    std::vector<std::pair<kernel::AddressPtr, DeviceAddress *>> bound_args;
+    std::vector<KernelMemAccess> accesses;
+    bool dag_built{false};
+    CPUKernelDag dag;
+    // Pairs of the addresses bound to tensors which share memory, the dag holds as long as they stay the same
+    std::vector<std::pair<const DeviceAddress *, const DeviceAddress *>> bound_aliases;
+  };
+  GraphLaunchPlan *GetLaunchPlan(uint32_t graph_id);
+  void BuildLaunchPlan(const session::KernelGraph *kernel_graph, GraphLaunchPlan *plan);
+  void PatchBoundArgs(GraphLaunchPlan *plan);
+  bool UpdateBoundAliases(GraphLaunchPlan *plan);
+  void RunLaunchPlan(const session::KernelGraph *kernel_graph, GraphLaunchPlan *plan);
+  std::unique_ptr<CPUKernelScheduler> scheduler_;
+  // The graphs may be released from another thread than the one running them
+  std::mutex launch_plans_mutex_;
+  std::map<uint32_t, GraphLaunchPlan> launch_plans_;
   std::set<DeviceAddressPtr> bound_addresses_;
   std::map<AnfNodePtr, tensor::TensorPtr> input_param_tensor_map_;
   bool initialized_{false};
@@ -0,0 +1,233 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "runtime/device/cpu/cpu_kernel_scheduler.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kNoKernel = std::numeric_limits<size_t>::max();
+
+// A range of bytes with the last kernel writing it and the kernels reading it since
+struct MemSegment {
+  size_t end;
+  size_t writer;
+  std::vector<size_t> readers;
+};
+using MemSegments = std::map<size_t, MemSegment>;
+
+// Make a segment start at pos if a segment covers it
+void SplitAt(size_t pos, MemSegments *segments) {
+  auto iter = segments->upper_bound(pos);
+  if (iter == segments->begin()) {
+    return;
+  }
+  --iter;
+  if (iter->first < pos && pos < iter->second.end) {
+    MemSegment tail = iter->second;
+    iter->second.end = pos;
+    segments->emplace(pos, std::move(tail));
+  }
+}
+
+void AddAccess(size_t kernel, const kernel::AddressPtr &address, bool write, MemSegments *segments,
+               std::vector<size_t> *deps) {
+  MS_EXCEPTION_IF_NULL(address);
+  if (address->addr == nullptr || address->size == 0) {
+    return;
+  }
+  size_t begin = reinterpret_cast<size_t>(address->addr);
+  size_t end = begin + address->size;
+  SplitAt(begin, segments);
+  SplitAt(end, segments);
+  auto iter = segments->lower_bound(begin);
+  size_t cursor = begin;
+  while (cursor < end) {
+    if (iter == segments->end() || iter->first > cursor) {
+      // Bytes nobody touched yet
+      size_t hole_end = iter == segments->end() ? end : std::min(end, iter->first);
+      iter = segments->emplace_hint(iter, cursor, MemSegment{hole_end, kNoKernel, {}});
+    }
+    auto &segment = iter->second;
+    if (segment.writer != kNoKernel) {
+      deps->push_back(segment.writer);
+    }
+    if (write) {
+      deps->insert(deps->end(), segment.readers.begin(), segment.readers.end());
+      segment.writer = kernel;
+      segment.readers.clear();
+    } else {
+      segment.readers.push_back(kernel);
+    }
+    cursor = segment.end;
+    ++iter;
+  }
+}
+}  // namespace
+
+void CPUKernelDag::Build(const std::vector<KernelMemAccess> &accesses) {
+  size_t kernel_num = accesses.size();
+  successors_.assign(kernel_num, {});
+  dependency_num_.assign(kernel_num, 0);
+  roots_.clear();
+  MemSegments segments;
+  size_t last_serial = kNoKernel;
+  std::vector<size_t> since_serial;
+  std::vector<size_t> deps;
+  for (size_t k = 0; k < kernel_num; ++k) {
+    deps.clear();
+    for (const auto &address : accesses[k].reads) {
+      AddAccess(k, address, false, &segments, &deps);
+    }
+    for (const auto &address : accesses[k].writes) {
+      AddAccess(k, address, true, &segments, &deps);
+    }
+    if (last_serial != kNoKernel) {
+      deps.push_back(last_serial);
+    }
+    if (accesses[k].serial) {
+      deps.insert(deps.end(), since_serial.begin(), since_serial.end());
+      last_serial = k;
+      since_serial.clear();
+    } else {
+      since_serial.push_back(k);
+    }
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    for (auto dep : deps) {
+      if (dep == k) {
+        continue;
+      }
+      successors_[dep].push_back(k);
+      dependency_num_[k]++;
+    }
+    if (dependency_num_[k] == 0) {
+      roots_.push_back(k);
+    }
+  }
+}
+
+CPUKernelScheduler::CPUKernelScheduler(size_t thread_num) {
+  for (size_t i = 1; i < thread_num; ++i) {
+    workers_.emplace_back(&CPUKernelScheduler::WorkerLoop, this);
+  }
+}
+
+CPUKernelScheduler::~CPUKernelScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exit_ = true;
+  }
+  ready_cond_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void CPUKernelScheduler::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  uint64_t seen_run_id = 0;
+  while (true) {
+    ready_cond_.wait(lock, [this, seen_run_id] { return exit_ || run_id_ != seen_run_id; });
+    if (exit_) {
+      return;
+    }
+    seen_run_id = run_id_;
+    active_workers_++;
+    LaunchReadyKernels(&lock);
+    active_workers_--;
+    idle_cond_.notify_all();
+  }
+}
+
+void CPUKernelScheduler::LaunchReadyKernels(std::unique_lock<std::mutex> *lock) {
+  while (true) {
+    ready_cond_.wait(*lock, [this] { return stop_ || !ready_.empty(); });
+    if (stop_) {
+      return;
+    }
+    size_t kernel = ready_.front();
+    ready_.pop_front();
+    lock->unlock();
+    std::exception_ptr error = nullptr;
+    try {
+      (*launch_)(kernel);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock->lock();
+    if (error != nullptr) {
+      if (error_ == nullptr) {
+        error_ = error;
+      }
+      stop_ = true;
+      ready_cond_.notify_all();
+      return;
+    }
+    if (++done_num_ == dag_->size()) {
+      stop_ = true;
+      ready_cond_.notify_all();
+      return;
+    }
+    bool new_ready = false;
+    for (auto successor : dag_->successors(kernel)) {
+      if (--pending_[successor] == 0) {
+        ready_.push_back(successor);
+        new_ready = true;
+      }
+    }
+    if (new_ready) {
+      ready_cond_.notify_all();
+    }
+  }
+}
+
+void CPUKernelScheduler::Run(const CPUKernelDag &dag, const std::function<void(size_t)> &launch) {
+  if (dag.size() == 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  dag_ = &dag;
+  launch_ = &launch;
+  pending_.resize(dag.size());
+  for (size_t k = 0; k < dag.size(); ++k) {
+    pending_[k] = dag.dependency_num(k);
+  }
+  ready_.assign(dag.roots().begin(), dag.roots().end());
+  done_num_ = 0;
+  error_ = nullptr;
+  stop_ = false;
+  run_id_++;
+  ready_cond_.notify_all();
+  LaunchReadyKernels(&lock);
+  idle_cond_.wait(lock, [this] { return active_workers_ == 0; });
+  dag_ = nullptr;
+  launch_ = nullptr;
+  if (error_ != nullptr) {
+    auto error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
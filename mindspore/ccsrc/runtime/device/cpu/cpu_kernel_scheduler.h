@@ -0,0 +1,96 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_KERNEL_SCHEDULER_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_KERNEL_SCHEDULER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "backend/kernel_compiler/kernel.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Memory touched by a kernel in one launch
+struct KernelMemAccess {
+  std::vector<kernel::AddressPtr> reads;
+  std::vector<kernel::AddressPtr> writes;
+  // The kernel runs after all the earlier kernels and before all the later ones
+  bool serial{false};
+};
+
+// Dependencies between the kernels of a graph, given in execution order. A kernel depends on the earlier kernels
+// which touch the same bytes, unless both of them only read the bytes. Any order allowed by the dependencies then
+// gives the results of the execution order, whatever memory the plan shares between buffers.
+class CPUKernelDag {
+ public:
+  CPUKernelDag() = default;
+  ~CPUKernelDag() = default;
+
+  void Build(const std::vector<KernelMemAccess> &accesses);
+  size_t size() const { return dependency_num_.size(); }
+  const std::vector<size_t> &successors(size_t kernel) const { return successors_[kernel]; }
+  size_t dependency_num(size_t kernel) const { return dependency_num_[kernel]; }
+  const std::vector<size_t> &roots() const { return roots_; }
+
+ private:
+  std::vector<std::vector<size_t>> successors_;
+  std::vector<size_t> dependency_num_;
+  std::vector<size_t> roots_;
+};
+
+// Launches the kernels of a dag on persistent threads, a kernel starts once all the kernels it depends on are done.
+// The thread calling Run launches kernels too.
+class CPUKernelScheduler {
+ public:
+  explicit CPUKernelScheduler(size_t thread_num);
+  ~CPUKernelScheduler();
+
+  size_t thread_num() const { return workers_.size() + 1; }
+
+  // Launch every kernel of the dag. The first exception thrown by a launch is thrown again once the kernels already
+  // started are done, and no other kernel is started.
+  void Run(const CPUKernelDag &dag, const std::function<void(size_t)> &launch);
+
+ private:
+  void WorkerLoop();
+  void LaunchReadyKernels(std::unique_lock<std::mutex> *lock);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable ready_cond_;
+  std::condition_variable idle_cond_;
+  const CPUKernelDag *dag_{nullptr};
+  const std::function<void(size_t)> *launch_{nullptr};
+  std::vector<size_t> pending_;
+  std::deque<size_t> ready_;
+  size_t done_num_{0};
+  size_t active_workers_{0};
+  uint64_t run_id_{0};
+  bool stop_{true};
+  bool exit_{false};
+  std::exception_ptr error_{nullptr};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_KERNEL_SCHEDULER_H_
@@ -105,7 +105,6 @@ void CPUMemoryManager::AssignMemory(const session::KernelGraph *graph) {
     }
     mem_ptr_ = reinterpret_cast<uint8_t *>(malloc(graph_mem_size));
     if (mem_ptr_ != nullptr) {
-      MS_LOG(INFO) << "Simple MemPlan GraphMemSize [" << graph_mem_size << "]";
       mem_size_ = graph_mem_size;
       dynamic_malloc_ = false;
     } else {
@@ -42,6 +42,7 @@ class CPUMemoryManager : public MemoryManager {
   void MemFree(void *ptr);
   void IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
+  bool dynamic_malloc() const { return dynamic_malloc_; }
 
  protected:
   uint8_t *MallocStaticMem(size_t size, bool communication_mem, uint32_t graph_id = kInvalidGraphId) override;
@@ -14,16 +14,66 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <limits>
 #include "backend/session/anf_runtime_algorithm.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+// The offsets of the buffers are multiples of a cache line
+constexpr size_t kCpuMemAlignSize = 64;
+// The graph memory is never empty
+constexpr size_t kMinMemSize = 32;
+
+size_t AlignMemorySize(size_t size) { return (size + kCpuMemAlignSize - 1) / kCpuMemAlignSize * kCpuMemAlignSize; }
+}  // namespace
+
+void CPUSimpleMemPlan::Touch(DeviceAddress *address, size_t kernel_index) {
+  MS_EXCEPTION_IF_NULL(address);
+  if (address->ptr_ != nullptr) {
+    return;
+  }
+  auto iter = block_index_.find(address);
+  if (iter == block_index_.end()) {
+    block_index_[address] = blocks_.size();
+    blocks_.push_back({address->size_, kernel_index, kernel_index, 0});
+    addresses_.push_back(address);
+    naive_size_ += address->size_;
+    return;
+  }
+  auto &block = blocks_[iter->second];
+  block.end = std::max(block.end, kernel_index);
+}
+
+void CPUSimpleMemPlan::KeepAlive(const AnfNodePtr &node, size_t end) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>()) {
+    return;
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(node);
+  for (size_t i = 0; i < output_num; ++i) {
+    if (!AnfAlgo::OutputAddrExist(node, i)) {
+      continue;
+    }
+    auto iter = block_index_.find(AnfAlgo::GetMutableOutputAddr(node, i).get());
+    if (iter != block_index_.end()) {
+      blocks_[iter->second].end = end;
+    }
+  }
+}
+
 size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
+  graph_ = graph;
+  blocks_.clear();
+  addresses_.clear();
+  block_index_.clear();
+  naive_size_ = kMinMemSize;
   auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  for (size_t k = 0; k < kernels.size(); ++k) {
+    const auto &kernel = kernels[k];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -32,79 +82,104 @@ size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
       if (kernel_with_index.first->isa<Parameter>()) {
         continue;
       }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
+      Touch(address.get(), k);
     }
 
     size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
+      Touch(address.get(), k);
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
       auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      Touch(address, k);
     }
   }
 
+  // The graph outputs and the summaries are read after the last kernel
+  size_t graph_end = kernels.size();
+  if (graph->output() != nullptr) {
+    for (const auto &output : AnfAlgo::GetAllOutput(graph->output(), {prim::kPrimTupleGetItem})) {
+      auto item_with_index = AnfAlgo::VisitKernelWithReturnType(output, 0, true);
+      KeepAlive(item_with_index.first, graph_end);
+    }
+  }
+  for (const auto &summary : graph->summary_nodes()) {
+    KeepAlive(summary.second.first, graph_end);
+  }
+
+  size_t total_mem_size = kMinMemSize + PackBlocks(&blocks_);
+  MS_LOG(INFO) << "Simple MemPlan of graph " << graph->graph_id() << ": " << blocks_.size()
+               << " buffers, planned size [" << total_mem_size << "], size without reuse [" << naive_size_ << "]";
   return total_mem_size;
 }
 
 void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
-        continue;
-      }
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
-    }
+  if (graph != graph_) {
+    MS_LOG(EXCEPTION) << "The memory of graph " << graph->graph_id() << " was not planned.";
+  }
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(addresses_[i]);
+    addresses_[i]->ptr_ = base_ptr + blocks_[i].offset;
+  }
+  graph_ = nullptr;
+  blocks_.clear();
+  addresses_.clear();
+  block_index_.clear();
+}
 
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+size_t CPUSimpleMemPlan::PackBlocks(std::vector<MemBlock> *blocks) {
+  MS_EXCEPTION_IF_NULL(blocks);
+  std::vector<size_t> order(blocks->size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [blocks](size_t a, size_t b) {
+    const auto &block_a = (*blocks)[a];
+    const auto &block_b = (*blocks)[b];
+    return block_a.size > block_b.size || (block_a.size == block_b.size && block_a.start < block_b.start);
+  });
+
+  size_t total_size = 0;
+  std::vector<size_t> placed;
+  std::vector<const MemBlock *> overlaps;
+  for (auto index : order) {
+    auto &block = (*blocks)[index];
+    size_t size = AlignMemorySize(block.size);
+    overlaps.clear();
+    for (auto other_index : placed) {
+      const auto &other = (*blocks)[other_index];
+      if (other.start <= block.end && block.start <= other.end) {
+        overlaps.push_back(&other);
       }
     }
-
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+    std::sort(overlaps.begin(), overlaps.end(),
+              [](const MemBlock *a, const MemBlock *b) { return a->offset < b->offset; });
+    // Best fit among the gaps left by the blocks live at the same time, else after all of them
+    size_t best_offset = 0;
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    size_t gap_start = 0;
+    for (auto other : overlaps) {
+      if (other->offset > gap_start) {
+        size_t gap = other->offset - gap_start;
+        if (gap >= size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = gap_start;
+        }
       }
+      gap_start = std::max(gap_start, other->offset + AlignMemorySize(other->size));
     }
+    block.offset = best_gap == std::numeric_limits<size_t>::max() ? gap_start : best_offset;
+    total_size = std::max(total_size, block.offset + size);
+    placed.push_back(index);
   }
+  return total_size;
 }
 }  // namespace cpu
 }  // namespace device
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
+#include <unordered_map>
 #include <vector>
 #include "backend/session/kernel_graph.h"
 #include "runtime/device/device_address.h"
@@ -23,13 +24,43 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+// Plans the kernel outputs and workspaces of a graph in one block. A buffer is live from the first to the last kernel
+// of the execution order using it, and buffers whose lifetimes do not overlap share memory.
 class CPUSimpleMemPlan {
  public:
+  // A buffer of the plan, live from kernel start to kernel end, both included
+  struct MemBlock {
+    size_t size;
+    size_t start;
+    size_t end;
+    size_t offset;
+  };
+
   CPUSimpleMemPlan() = default;
   ~CPUSimpleMemPlan() = default;
 
   size_t MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+
+  // Size of the graph memory if every buffer had its own memory
+  size_t naive_size() const { return naive_size_; }
+
+  // Set the offsets of the blocks such that blocks with overlapping lifetimes do not overlap in memory. The largest
+  // block is placed first, into the smallest gap it fits in among the blocks it overlaps with.
+  // Return the size of the memory holding all the blocks.
+  static size_t PackBlocks(std::vector<MemBlock> *blocks);
+
+ private:
+  // Extend the lifetime of the buffer to a kernel, the buffer is added on its first use
+  void Touch(DeviceAddress *address, size_t kernel_index);
+  // Keep the outputs of a node until the end of the graph
+  void KeepAlive(const AnfNodePtr &node, size_t end);
+
+  const session::KernelGraph *graph_{nullptr};
+  std::vector<MemBlock> blocks_;
+  std::vector<DeviceAddress *> addresses_;
+  std::unordered_map<DeviceAddress *, size_t> block_index_;
+  size_t naive_size_{0};
 };
 }  // namespace cpu
 }  // namespace device
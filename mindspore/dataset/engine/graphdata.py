@@ -363,3 +363,27 @@ class GraphData:
             raise Exception("This method is not supported when working mode is server.")
         return self._graph_data.random_walk(target_nodes, meta_path, step_home_param, step_away_param,
                                             default_node).as_array()
+
+    def save_csr(self, csr_file=None):
+        """
+        Save the adjacency and the node features of the graph to a preprocessed file. The file named
+        dataset_file + '.csr' is mapped by the GraphData created afterwards instead of building them again,
+        as long as the dataset files are not changed.
+
+        Args:
+            csr_file (str, optional): Path of the file (Default = None, dataset_file + '.csr').
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>>
+            >>> data_graph = ds.GraphData('dataset_file', 2)
+            >>> data_graph.save_csr()
+
+        Raises:
+            Exception: If the working mode is not local.
+        """
+        if self._working_mode != 'local':
+            raise Exception("This method is only supported when working mode is local.")
+        if csr_file is None:
+            csr_file = self._dataset_file + ".csr"
+        self._graph_data.save_csr(csr_file)
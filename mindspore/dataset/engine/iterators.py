@@ -135,6 +135,24 @@ class Iterator:
     def __deepcopy__(self, memo):
         return self
 
+    def get_checkpoint(self):
+        """
+        Get the position of the iterator in the dataset, i.e. the epoch and the number of rows returned in it.
+
+        Returns:
+            str, the checkpoint to pass to restore() of an iterator over the same pipeline.
+        """
+        return self._iterator.GetCheckpoint()
+
+    def restore(self, checkpoint):
+        """
+        Continue from a checkpoint returned by get_checkpoint(). It must be called before the first row is fetched.
+
+        Args:
+            checkpoint (str): The checkpoint returned by get_checkpoint() on the same pipeline.
+        """
+        self._iterator.Restore(checkpoint)
+
     def _getters(self):
         """
         Get pipeline information.
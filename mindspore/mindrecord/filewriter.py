@@ -76,6 +76,8 @@ class FileWriter:
         self._header = ShardHeader()
         self._writer = ShardWriter()
         self._generator = None
+        self._columnar_raw_page = False
+        self._page_codec = None
 
     @classmethod
     def open_for_append(cls, file_name):
@@ -213,6 +215,10 @@ class FileWriter:
             self._writer.open(self._paths)
         if not self._writer.get_shard_header():
             self._writer.set_shard_header(self._header)
+            if self._columnar_raw_page:
+                self._writer.set_columnar_raw_page(True)
+            if self._page_codec is not None:
+                self._writer.set_page_codec(self._page_codec)
 
     def write_raw_data(self, raw_data, parallel_writer=False):
         """
@@ -233,10 +239,7 @@ class FileWriter:
             MRMSetHeaderError: If failed to set header.
             MRMWriteDatasetError: If failed to write dataset.
         """
-        if not self._writer.is_open:
-            self._writer.open(self._paths)
-        if not self._writer.get_shard_header():
-            self._writer.set_shard_header(self._header)
+        self.open_and_set_header()
         if not isinstance(raw_data, list):
             raise ParamTypeError('raw_data', 'list')
         for each_raw in raw_data:
@@ -280,6 +283,41 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_columnar_raw_page(self, columnar):
+        """
+        Set the layout of raw data page. With the columnar layout the non-blob fields of each row are laid out \
+        by column, so that readers only decode the fields they load. Such files can not be read by versions \
+        without the layout. It must be called before write_raw_data.
+
+        Args:
+           columnar (bool): Lay out raw data page by column if True, by row (the default) if False.
+
+        Raises:
+            ParamTypeError: If `columnar` is not a bool.
+        """
+        if not isinstance(columnar, bool):
+            raise ParamTypeError('columnar', 'bool')
+        self._columnar_raw_page = columnar
+
+    def set_page_codec(self, codec):
+        """
+        Set the codec of blob data page. With 'zlib' the blob data of each row is compressed, and kept as is \
+        if it does not shrink. Such files can not be read by versions without the codec. It must be called \
+        before write_raw_data.
+
+        Args:
+           codec (str): Codec of blob data page, 'none' (the default) or 'zlib'.
+
+        Raises:
+            ParamTypeError: If `codec` is not a str.
+            ParamValueError: If `codec` is not 'none' or 'zlib'.
+        """
+        if not isinstance(codec, str):
+            raise ParamTypeError('codec', 'str')
+        if codec not in ('none', 'zlib'):
+            raise ParamValueError("Codec should be 'none' or 'zlib', but got '{}'.".format(codec))
+        self._page_codec = codec
+
     def commit(self):
         """
         Flush data to disk and generate the corresponding database files.
@@ -294,11 +332,8 @@ class FileWriter:
             MRMGenerateIndexError: If failed to write to database.
             MRMCommitError: If failed to flush data to disk.
         """
-        if not self._writer.is_open:
-            self._writer.open(self._paths)
         # permit commit without data
-        if not self._writer.get_shard_header():
-            self._writer.set_shard_header(self._header)
+        self.open_and_set_header()
         ret = self._writer.commit()
         if self._index_generator is True:
             if self._append:
@@ -315,10 +350,10 @@ class FileWriter:
             if os.path.exists(item):
                 os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
                 mindrecord_files.append(item)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
-                index_files.append(index_file)
+            for index_file in (item + ".db", item + ".idx"):
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+                    index_files.append(index_file)
 
         logger.info("The list of mindrecord files created are: {}, and the list of index files are: {}".format(
             mindrecord_files, index_files))
@@ -134,6 +134,65 @@ class ShardWriter:
             raise MRMSetHeaderError
         return ret
 
+    def set_columnar_raw_page(self, columnar):
+        """
+        Set the layout of raw data page, must be called after set_shard_header and before write_raw_data.
+
+        Args:
+           columnar (bool): Lay out the non-blob fields of each row by column, so that readers only decode
+               the fields they load.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMSetHeaderError: If failed to set the layout.
+        """
+        ret = self._writer.set_columnar_raw_page(columnar)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set layout of raw data page.")
+            raise MRMSetHeaderError
+        return ret
+
+    def set_page_codec(self, codec):
+        """
+        Set the codec of blob data page, must be called after set_shard_header and before write_raw_data.
+
+        Args:
+           codec (str): Codec which compresses the blob data of each row, 'none' or 'zlib'.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMSetHeaderError: If failed to set the codec.
+        """
+        ret = self._writer.set_page_codec(codec)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set codec of blob data page.")
+            raise MRMSetHeaderError
+        return ret
+
+    def set_streaming_mode(self, streaming):
+        """
+        Set streaming mode, pages are flushed in background while the next raw data is serialized,
+        and commit also generates the index, so ShardIndexGenerator must not be used afterwards.
+
+        Args:
+           streaming (bool): Write in streaming mode or not.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMWriteDatasetError: If failed to set the streaming mode.
+        """
+        ret = self._writer.set_streaming_mode(streaming)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set streaming mode.")
+            raise MRMWriteDatasetError
+        return ret
+
     def get_shard_header(self):
         return self._header
 
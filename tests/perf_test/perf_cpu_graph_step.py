@@ -0,0 +1,90 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Host overhead of a step of a CPU graph made of tiny kernels.
+
+The kernels work on a few floats, so a step is almost only the launch of its kernels. Run the script on two builds
+to compare their overhead per step, or with MS_CPU_INTER_OP_THREADS set to launch independent kernels concurrently.
+
+The first call of a net builds and compiles the graph, it is left out with the other warm-up steps. A graph is then
+timed in several runs of a number of steps, the median step of every run is taken and the median over the runs is
+reported with their spread.
+"""
+import argparse
+import time
+
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import Tensor, context
+from mindspore.ops import operations as P
+
+
+class TinyOpsNet(nn.Cell):
+    """Independent chains of Mul and TensorAdd, like the towers of a small policy or recommendation model."""
+
+    def __init__(self, num_chains, depth):
+        super(TinyOpsNet, self).__init__()
+        self.num_chains = num_chains
+        self.depth = depth
+        self.mul = P.Mul()
+        self.add = P.TensorAdd()
+
+    def construct(self, x, y):
+        out = x
+        for _ in range(self.num_chains):
+            chain = x
+            for _ in range(self.depth):
+                chain = self.add(self.mul(chain, y), y)
+            out = self.add(out, chain)
+        return out
+
+
+def run(num_chains, depth, size, warmup, steps, repeats):
+    net = TinyOpsNet(num_chains, depth)
+    x = Tensor(np.random.randn(1, size).astype(np.float32))
+    y = Tensor(np.random.randn(1, size).astype(np.float32))
+    # the first call builds and compiles the graph
+    for _ in range(max(warmup, 1)):
+        net(x, y).asnumpy()
+    medians = []
+    for _ in range(repeats):
+        costs = []
+        for _ in range(steps):
+            start = time.perf_counter()
+            net(x, y).asnumpy()
+            costs.append(time.perf_counter() - start)
+        medians.append(np.median(costs) * 1e6)
+    num_kernels = num_chains * (2 * depth + 1)
+    print("chains: {}, depth: {}, kernels: {}, step us: median {:.1f} over {} runs, min {:.1f}, max {:.1f}, "
+          "per kernel us: {:.2f}".format(num_chains, depth, num_kernels, np.median(medians), repeats,
+                                         np.min(medians), np.max(medians), np.median(medians) / num_kernels))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Host overhead of a step of a CPU graph made of tiny kernels")
+    parser.add_argument("--chains", type=int, nargs="+", default=[1, 4, 16])
+    parser.add_argument("--depth", type=int, default=32)
+    parser.add_argument("--size", type=int, default=16, help="number of floats of a tensor")
+    parser.add_argument("--warmup", type=int, default=20)
+    parser.add_argument("--steps", type=int, default=500)
+    parser.add_argument("--repeats", type=int, default=5, help="number of timed runs of a graph")
+    args = parser.parse_args()
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    for num_chains in args.chains:
+        run(num_chains, args.depth, args.size, args.warmup, args.steps, args.repeats)
+
+
+if __name__ == "__main__":
+    main()
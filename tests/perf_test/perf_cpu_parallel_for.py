@@ -0,0 +1,84 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Cost of a launch of an elementwise CPU kernel split over threads.
+
+A graph runs a chain of TensorAdd kernels on tensors of a few sizes, from below the grain of ParallelFor, where a
+kernel runs in the calling thread, to sizes spread over the whole thread pool. Run the script on two builds to compare
+the time of a kernel at each size.
+
+The first call of a net builds and compiles the graph, it is left out with the other warm-up steps. A size is then
+timed in several runs of a number of steps, the median step of every run is taken and the median over the runs is
+reported with their spread.
+"""
+import argparse
+import time
+
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import Tensor, context
+from mindspore.ops import operations as P
+
+
+class AddChainNet(nn.Cell):
+    """A chain of TensorAdd kernels, each one waiting for the one before."""
+
+    def __init__(self, depth):
+        super(AddChainNet, self).__init__()
+        self.depth = depth
+        self.add = P.TensorAdd()
+
+    def construct(self, x, y):
+        out = x
+        for _ in range(self.depth):
+            out = self.add(out, y)
+        return out
+
+
+def run(size, depth, warmup, steps, repeats):
+    net = AddChainNet(depth)
+    x = Tensor(np.random.randn(size).astype(np.float32))
+    y = Tensor(np.random.randn(size).astype(np.float32))
+    # the first call builds and compiles the graph
+    for _ in range(max(warmup, 1)):
+        net(x, y).asnumpy()
+    medians = []
+    for _ in range(repeats):
+        costs = []
+        for _ in range(steps):
+            start = time.perf_counter()
+            net(x, y).asnumpy()
+            costs.append(time.perf_counter() - start)
+        medians.append(np.median(costs) * 1e6 / depth)
+    print("size: {}, kernel us: median {:.1f} over {} runs, min {:.1f}, max {:.1f}".format(
+        size, np.median(medians), repeats, np.min(medians), np.max(medians)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Cost of a launch of an elementwise CPU kernel split over threads")
+    parser.add_argument("--sizes", type=int, nargs="+", default=[1024, 16 * 1024, 64 * 1024, 1024 * 1024],
+                        help="number of floats of a tensor")
+    parser.add_argument("--depth", type=int, default=32)
+    parser.add_argument("--warmup", type=int, default=10)
+    parser.add_argument("--steps", type=int, default=200)
+    parser.add_argument("--repeats", type=int, default=5, help="number of timed runs of a size")
+    args = parser.parse_args()
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    for size in args.sizes:
+        run(size, args.depth, args.warmup, args.steps, args.repeats)
+
+
+if __name__ == "__main__":
+    main()
@@ -23,10 +23,12 @@
 #include "minddata/dataset/include/datasets.h"
 #include "minddata/dataset/include/status.h"
 #include "minddata/dataset/text/vocab.h"
+#include "minddata/dataset/text/word_trie.h"
 
 using mindspore::dataset::Tensor;
 using mindspore::dataset::Status;
 using mindspore::dataset::Vocab;
+using mindspore::dataset::WordTrie;
 
 class MindDataTestVocab : public UT::DatasetOpTesting {
  protected:
@@ -251,3 +253,39 @@ TEST_F(MindDataTestVocab, TestVocabFromFileFail4) {
   Status s = Vocab::BuildFromFileCpp(vocab_dir, ",", -1, {"home"}, true, &vocab);
   EXPECT_NE(s, Status::OK());
 }
+
+TEST_F(MindDataTestVocab, TestVocabTrie) {
+  MS_LOG(INFO) << "Doing MindDataTestVocab-TestVocabTrie.";
+  std::unordered_map<std::string, int32_t> dict = {{"un", 0}, {"unaff", 1}, {"unaffable", 2}, {"##able", 3}, {"", 4}};
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromUnorderedMap(dict, &vocab);
+  EXPECT_EQ(s, Status::OK());
+  const WordTrie *trie = vocab->trie();
+  ASSERT_NE(trie, nullptr);
+
+  // Every prefix of the input which is a word is found in one walk
+  std::string input = "unaffableness";
+  std::vector<int32_t> found;
+  WordTrie::State state = WordTrie::kRoot;
+  for (char c : input) {
+    if (!trie->Next(&state, static_cast<uint8_t>(c))) {
+      break;
+    }
+    if (trie->Value(state) != WordTrie::kNoWord) {
+      found.push_back(trie->Value(state));
+    }
+  }
+  EXPECT_EQ(found, std::vector<int32_t>({0, 1, 2}));
+  EXPECT_EQ(vocab->Lookup(""), 4);
+  EXPECT_EQ(vocab->Lookup("una"), -1);
+  EXPECT_EQ(vocab->Lookup("##able"), 3);
+
+  // The trie is dropped by a new word until it is built again
+  vocab->append_word("dog");
+  EXPECT_EQ(vocab->trie(), nullptr);
+  EXPECT_EQ(vocab->Lookup("dog"), 5);
+  vocab->BuildTrie();
+  ASSERT_NE(vocab->trie(), nullptr);
+  EXPECT_EQ(vocab->Lookup("dog"), 5);
+  EXPECT_EQ(vocab->Lookup("unaff"), 1);
+}
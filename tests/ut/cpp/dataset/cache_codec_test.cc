@@ -0,0 +1,85 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/cache_codec.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCacheCodec : public UT::Common {
+ public:
+  MindDataTestCacheCodec() : codec_(CacheCompression::kZlib) {}
+
+  CacheCodec codec_;
+};
+
+TEST_F(MindDataTestCacheCodec, TestRoundTrip) {
+  // A repeating pattern split over a few slices, with empty ones in between and at the end
+  std::vector<uint8_t> first(4096);
+  std::vector<uint8_t> second(10000);
+  for (size_t i = 0; i < first.size(); ++i) {
+    first[i] = static_cast<uint8_t>(i % 16);
+  }
+  for (size_t i = 0; i < second.size(); ++i) {
+    second[i] = static_cast<uint8_t>(i % 7);
+  }
+  std::vector<ReadableSlice> buf = {ReadableSlice(first.data(), first.size()), ReadableSlice(first.data(), 0),
+                                    ReadableSlice(second.data(), second.size()), ReadableSlice(second.data(), 0)};
+  size_t sz = first.size() + second.size();
+  std::vector<uint8_t> compressed;
+  Status rc = codec_.Compress(buf, sz, &compressed);
+  ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+  ASSERT_FALSE(compressed.empty());
+  EXPECT_LT(compressed.size(), sz);
+
+  std::vector<uint8_t> out(sz);
+  WritableSlice dest(out.data(), out.size());
+  rc = codec_.Decompress(ReadableSlice(compressed.data(), compressed.size()), sz, &dest);
+  ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+  std::vector<uint8_t> expected(first);
+  expected.insert(expected.end(), second.begin(), second.end());
+  EXPECT_EQ(out, expected);
+
+  // The destination must hold the whole buffer
+  WritableSlice small(out.data(), sz - 1);
+  rc = codec_.Decompress(ReadableSlice(compressed.data(), compressed.size()), sz, &small);
+  EXPECT_TRUE(rc.IsError());
+}
+
+TEST_F(MindDataTestCacheCodec, TestKeptAsIs) {
+  std::vector<uint8_t> compressed;
+  // Nothing to compress
+  Status rc = codec_.Compress({}, 0, &compressed);
+  ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+  EXPECT_TRUE(compressed.empty());
+  uint8_t one = 1;
+  rc = codec_.Compress({ReadableSlice(&one, 0), ReadableSlice(&one, 1)}, 1, &compressed);
+  ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+  EXPECT_TRUE(compressed.empty());
+
+  // Random bytes do not shrink
+  std::vector<uint8_t> noise(8192);
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int32_t> dist(0, 255);
+  for (auto &c : noise) {
+    c = static_cast<uint8_t>(dist(gen));
+  }
+  rc = codec_.Compress({ReadableSlice(noise.data(), noise.size())}, noise.size(), &compressed);
+  ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+  EXPECT_TRUE(compressed.empty());
+}
@@ -0,0 +1,248 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <unistd.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/cache_eviction.h"
+#include "minddata/dataset/engine/cache/cache_hw.h"
+#include "minddata/dataset/engine/cache/cache_numa.h"
+#include "minddata/dataset/engine/cache/cache_pool.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCachePool : public UT::Common {
+ public:
+  MindDataTestCachePool() {}
+
+  // A pool of the given size in bytes. The arenas are sized by a ratio of the system memory.
+  std::shared_ptr<NumaMemoryPool> CreateMemoryPool(int64_t sz) {
+    float ratio = static_cast<float>(sz) / static_cast<float>(CacheServerHW::GetTotalSystemMemory());
+    return std::make_shared<NumaMemoryPool>(std::make_shared<CacheServerHW>(), ratio);
+  }
+
+  // A row of the given size, filled with a pattern of its key.
+  std::vector<uint8_t> MakeRow(int64_t key, size_t sz) {
+    std::vector<uint8_t> row(sz);
+    for (size_t i = 0; i < sz; ++i) {
+      row[i] = static_cast<uint8_t>((key * 31 + i) & 0xff);
+    }
+    return row;
+  }
+
+  // A row of random bytes below 16, which compresses to about half of its size.
+  std::vector<uint8_t> MakeNoisyRow(int64_t key, size_t sz) {
+    std::vector<uint8_t> row(sz);
+    std::mt19937 gen(key);
+    std::uniform_int_distribution<int32_t> dist(0, 15);
+    for (auto &c : row) {
+      c = static_cast<uint8_t>(dist(gen));
+    }
+    return row;
+  }
+
+  void ReadRow(CachePool *cp, int64_t key, const std::vector<uint8_t> &expected) {
+    std::vector<uint8_t> out(expected.size());
+    WritableSlice dest(out.data(), out.size());
+    size_t bytes_read = 0;
+    Status rc = cp->Read(key, &dest, &bytes_read);
+    ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+    ASSERT_EQ(bytes_read, expected.size());
+    EXPECT_EQ(out, expected);
+  }
+
+  void ReadRow(CachePool *cp, int64_t key, size_t sz) { ReadRow(cp, key, MakeRow(key, sz)); }
+};
+
+TEST_F(MindDataTestCachePool, TestLruVictimOrder) {
+  auto evict = CacheEviction::Create(CacheEvictionPolicy::kLru);
+  ASSERT_NE(evict, nullptr);
+  CacheEviction::key_type key;
+  EXPECT_FALSE(evict->Victim(&key));
+  evict->Admit(1);
+  evict->Admit(2);
+  evict->Admit(3);
+  // The least recently read row goes first
+  evict->Touch(1);
+  // A row which is not tracked is ignored
+  evict->Touch(100);
+  for (auto expected : {2, 3, 1}) {
+    ASSERT_TRUE(evict->Victim(&key));
+    EXPECT_EQ(key, expected);
+  }
+  EXPECT_FALSE(evict->Victim(&key));
+}
+
+TEST_F(MindDataTestCachePool, TestClockVictimOrder) {
+  auto evict = CacheEviction::Create(CacheEvictionPolicy::kClock);
+  ASSERT_NE(evict, nullptr);
+  CacheEviction::key_type key;
+  evict->Admit(1);
+  evict->Admit(2);
+  evict->Admit(3);
+  // Row 1 gets a second chance, the hand clears its bit and moves on
+  evict->Touch(1);
+  for (auto expected : {2, 3, 1}) {
+    ASSERT_TRUE(evict->Victim(&key));
+    EXPECT_EQ(key, expected);
+  }
+  EXPECT_FALSE(evict->Victim(&key));
+  // The free slots are reused
+  evict->Admit(4);
+  evict->Admit(5);
+  ASSERT_TRUE(evict->Victim(&key));
+  ASSERT_TRUE(evict->Victim(&key));
+  EXPECT_FALSE(evict->Victim(&key));
+}
+
+TEST_F(MindDataTestCachePool, TestArcGhostAdaptation) {
+  auto evict = CacheEviction::Create(CacheEvictionPolicy::kArc);
+  ASSERT_NE(evict, nullptr);
+  CacheEviction::key_type key;
+  for (auto k : {1, 2, 3, 4}) {
+    evict->Admit(k);
+  }
+  // All the rows are read once, the oldest goes to the first ghost list
+  ASSERT_TRUE(evict->Victim(&key));
+  EXPECT_EQ(key, 1);
+  // Row 1 comes back from the first ghost list. The target of the first list grows to one row, and row 1 joins the
+  // rows read again.
+  evict->Admit(1);
+  // The first list is trimmed down to its target before the second list is touched
+  for (auto expected : {2, 3, 1}) {
+    ASSERT_TRUE(evict->Victim(&key));
+    EXPECT_EQ(key, expected);
+  }
+  // Row 1 comes back from the second ghost list. The target shrinks back to zero, so row 4 in the first list goes
+  // before row 1 in the second list. With the target of one row, row 1 would have been picked.
+  evict->Admit(1);
+  for (auto expected : {4, 1}) {
+    ASSERT_TRUE(evict->Victim(&key));
+    EXPECT_EQ(key, expected);
+  }
+  EXPECT_FALSE(evict->Victim(&key));
+}
+
+TEST_F(MindDataTestCachePool, TestEvictPromote) {
+  const int64_t pool_sz = 1024 * 1024;
+  const size_t row_sz = 192 * 1024;
+  const int64_t num_rows = 8;
+  char temp_dir[] = "/tmp/cache_pool_XXXXXX";
+  ASSERT_NE(mkdtemp(temp_dir), nullptr);
+  {
+    CachePool cp(CreateMemoryPool(pool_sz), temp_dir, CacheEvictionPolicy::kLru);
+    Status rc = cp.ServiceStart();
+    ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+    cp.SetLocking(true);
+    // The memory holds a few rows, the older ones move to disk as the later ones come in.
+    for (int64_t key = 0; key < num_rows; ++key) {
+      auto row = MakeRow(key, row_sz);
+      rc = cp.Insert(key, {ReadableSlice(row.data(), row.size())});
+      ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+    }
+    auto stat = cp.GetStat();
+    EXPECT_EQ(stat.num_mem_cached + stat.num_disk_cached, num_rows);
+    EXPECT_GT(stat.num_mem_cached, 0);
+    EXPECT_GT(stat.num_disk_cached, 0);
+    EXPECT_EQ(stat.num_evicted, stat.num_disk_cached);
+
+    // Row 0 is the least recently used. It is read from disk until the second read moves it back to memory, and the
+    // third read finds it in memory.
+    ReadRow(&cp, 0, row_sz);
+    stat = cp.GetStat();
+    EXPECT_EQ(stat.num_disk_hit, 1);
+    EXPECT_EQ(stat.num_promoted, 0);
+    ReadRow(&cp, 0, row_sz);
+    stat = cp.GetStat();
+    EXPECT_EQ(stat.num_disk_hit, 2);
+    EXPECT_EQ(stat.num_promoted, 1);
+    auto mem_hit = stat.num_mem_hit;
+    ReadRow(&cp, 0, row_sz);
+    stat = cp.GetStat();
+    EXPECT_EQ(stat.num_disk_hit, 2);
+    EXPECT_EQ(stat.num_mem_hit, mem_hit + 1);
+
+    // A row bigger than the memory is written to disk directly, and stays there.
+    const size_t big_sz = 2 * pool_sz;
+    auto big = MakeRow(num_rows, big_sz);
+    rc = cp.Insert(num_rows, {ReadableSlice(big.data(), big.size())});
+    ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+    ReadRow(&cp, num_rows, big_sz);
+    ReadRow(&cp, num_rows, big_sz);
+
+    // Every row reads back the same, wherever it is.
+    for (int64_t key = 0; key < num_rows; ++key) {
+      ReadRow(&cp, key, row_sz);
+    }
+    stat = cp.GetStat();
+    EXPECT_EQ(stat.num_mem_cached + stat.num_disk_cached, num_rows + 1);
+    rc = cp.ServiceStop();
+    EXPECT_TRUE(rc.IsOk()) << rc.ToString();
+  }
+  EXPECT_EQ(rmdir(temp_dir), 0);
+}
+
+TEST_F(MindDataTestCachePool, TestCompressedEvictPromote) {
+  const int64_t pool_sz = 1024 * 1024;
+  const size_t row_sz = 192 * 1024;
+  const int64_t num_rows = 16;
+  char temp_dir[] = "/tmp/cache_pool_XXXXXX";
+  ASSERT_NE(mkdtemp(temp_dir), nullptr);
+  {
+    CachePool cp(CreateMemoryPool(pool_sz), temp_dir, CacheEvictionPolicy::kLru, CacheCompression::kZlib);
+    Status rc = cp.ServiceStart();
+    ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+    cp.SetLocking(true);
+    // The compressed rows still outgrow the memory, and the older ones move to disk in their compressed form.
+    for (int64_t key = 0; key < num_rows; ++key) {
+      auto row = MakeNoisyRow(key, row_sz);
+      rc = cp.Insert(key, {ReadableSlice(row.data(), row.size())});
+      ASSERT_TRUE(rc.IsOk()) << rc.ToString();
+    }
+    auto stat = cp.GetStat();
+    EXPECT_EQ(stat.num_mem_cached + stat.num_disk_cached, num_rows);
+    EXPECT_GT(stat.num_disk_cached, 0);
+    EXPECT_GT(stat.compression_ratio, 1.5);
+
+    // The last row is in memory
+    ReadRow(&cp, num_rows - 1, MakeNoisyRow(num_rows - 1, row_sz));
+    stat = cp.GetStat();
+    EXPECT_EQ(stat.num_mem_hit, 1);
+    EXPECT_EQ(stat.num_disk_hit, 0);
+
+    // The first row is restored from disk, moves back to memory on the second read, and is read from memory next.
+    auto first = MakeNoisyRow(0, row_sz);
+    ReadRow(&cp, 0, first);
+    ReadRow(&cp, 0, first);
+    stat = cp.GetStat();
+    EXPECT_EQ(stat.num_disk_hit, 2);
+    EXPECT_EQ(stat.num_promoted, 1);
+    ReadRow(&cp, 0, first);
+    stat = cp.GetStat();
+    EXPECT_EQ(stat.num_disk_hit, 2);
+    EXPECT_EQ(stat.num_mem_hit, 2);
+
+    for (int64_t key = 0; key < num_rows; ++key) {
+      ReadRow(&cp, key, MakeNoisyRow(key, row_sz));
+    }
+    rc = cp.ServiceStop();
+    EXPECT_TRUE(rc.IsOk()) << rc.ToString();
+  }
+  EXPECT_EQ(rmdir(temp_dir), 0);
+}
@@ -15,6 +15,7 @@
  */
 
 #include <fcntl.h>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -48,12 +49,19 @@ public:
   // A random sleep/delay can be introduced for each thread. See run().
   Status Run_test_1();
 
+  // Test scenario: multiple producers, single consumer of a connector which does not keep the order.
+  // The consumer pops in batches and checks that every element arrives exactly once.
+  Status Run_test_2();
+
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
+  void SetLockFree(bool lock_free) { lock_free_ = lock_free; }
+
 private:
   std::unique_ptr<TaskGroup> tg_;
   uint32_t last_input_;
   uint32_t sleep_ms_ = 0;
+  bool lock_free_ = false;
   std::vector<uint32_t> input_;
   WaitPost wp;
 
@@ -122,7 +130,25 @@ TEST_F(MindDataTestConnector, Test2) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+// Test3: same as Test2 with the lock-free connectors, the order must be kept as well.
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3.";
+  this->SetSleepMilliSec(30);
+  this->SetLockFree(true);
+  Status rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
 
+// Test4: multiple producers and a single consumer on a connector which does not keep the order.
+TEST_F(MindDataTestConnector, Test4) {
+  MS_LOG(INFO) << "MindDataTestConnector Test4.";
+  Status rc = this->Run_test_2();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
 
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
@@ -188,11 +214,13 @@ Status MindDataTestConnector::Run_test_1() {
 
   auto conn1 = std::make_shared<Connector<uint32_t>>(l1_threads,  // num of producers
                                                      l2_threads,  // num of consumers
-                                                     conn1_qcap);  // the cap of each queue
+                                                     conn1_qcap,  // the cap of each queue
+                                                     lock_free_);
 
   auto conn2 = std::make_shared<Connector<uint32_t>>(l2_threads,
                                                      l3_threads,
-                                                     conn2_qcap);
+                                                     conn2_qcap,
+                                                     lock_free_);
 
   rc = conn1->Register(tg_.get());
   RETURN_IF_NOT_OK(rc);
@@ -241,6 +269,35 @@ Status MindDataTestConnector::Run_test_1() {
   return ValidateOutput(output);
 }
 
+Status MindDataTestConnector::Run_test_2() {
+  int num_producers = 8;
+  auto my_conn = std::make_shared<Connector<uint32_t>>(num_producers,  // num of producers
+                                                      1,  // num of consumers
+                                                      4,  // capacity of each producer
+                                                      true,  // lock free
+                                                      false);  // not ordered
+  RETURN_IF_NOT_OK(my_conn->Register(tg_.get()));
+  CHECK_FAIL_RETURN_UNEXPECTED(my_conn->capacity() == num_producers * 4, "Unexpected capacity.");
+
+  for (int i = 0; i < num_producers; i++) {
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("Unordered Worker Push",
+                                          std::bind(&MindDataTestConnector::FirstWorkerPush, this, i, my_conn, i,
+                                                    num_producers)));
+  }
+
+  std::vector<uint32_t> output;
+  while (output.size() < input_.size()) {
+    RETURN_IF_NOT_OK(my_conn->PopBatch(0, &output, 16));
+  }
+  tg_->interrupt_all();
+  tg_->join_all(Task::WaitFlag::kNonBlocking);
+  CHECK_FAIL_RETURN_UNEXPECTED(my_conn->out_buffers_count() == input_.size(), "Unexpected number of pops.");
+  my_conn.reset();
+
+  std::sort(output.begin(), output.end());
+  return ValidateOutput(output);
+}
+
 Status MindDataTestConnector::SerialWorkerPull(
                                                int tid,
                                                std::shared_ptr<Connector<uint32_t>> my_conn,
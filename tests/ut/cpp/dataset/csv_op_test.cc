@@ -13,8 +13,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <unistd.h>
+#include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
@@ -34,7 +38,66 @@ using mindspore::ExceptionType::NoExceptionType;
 using mindspore::LogStream;
 
 class MindDataTestCSVOp : public UT::DatasetOpTesting {
+ public:
+  // Read one shard of the files over a few epochs with the row blocks shuffled, and collect the rows of each epoch.
+  void ReadShuffledBlocks(const std::vector<std::string> &files, int32_t num_shards, int32_t shard_id,
+                          int32_t num_epochs, int64_t rows_per_shard,
+                          std::vector<std::multimap<int32_t, std::string>> *seen) {
+    auto tree = std::make_shared<ExecutionTree>();
+    std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list;
+    column_default_list.push_back(std::make_shared<CsvOp::Record<int>>(CsvOp::INT, 0));
+    column_default_list.push_back(std::make_shared<CsvOp::Record<std::string>>(CsvOp::STRING, ""));
+    std::shared_ptr<CsvOp> op;
+    CsvOp::Builder builder;
+    builder.SetCsvFilesList(files)
+        .SetRowsPerBuffer(2)
+        .SetNumWorkers(2)
+        .SetOpConnectorSize(2)
+        .SetFieldDelim(',')
+        .SetColumDefault(column_default_list)
+        .SetColumName({"id", "text"})
+        .SetNumDevices(num_shards)
+        .SetDeviceId(shard_id)
+        .SetShuffleFiles(true)
+        .SetShuffleBlocks(true)
+        .SetShuffleBlockRows(2);
+    Status rc = builder.Build(&op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->AssociateNode(op);
+    ASSERT_TRUE(rc.IsOk());
+    std::shared_ptr<RepeatOp> repeat_op = std::make_shared<RepeatOp>(num_epochs);
+    rc = tree->AssociateNode(repeat_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = repeat_op->AddChild(op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->AssignRoot(repeat_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->Prepare();
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->Launch();
+    ASSERT_TRUE(rc.IsOk());
 
+    DatasetIterator di(tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    int64_t row_count = 0;
+    while (!tensor_list.empty()) {
+      int64_t epoch = row_count / rows_per_shard;
+      ASSERT_LT(epoch, num_epochs);
+      int32_t id = 0;
+      rc = tensor_list[0]->GetItemAt(&id, {});
+      ASSERT_TRUE(rc.IsOk());
+      std::string_view text;
+      rc = tensor_list[1]->GetItemAt(&text, {});
+      ASSERT_TRUE(rc.IsOk());
+      (*seen)[epoch].emplace(id, std::string(text));
+      rc = di.FetchNextTensorRow(&tensor_list);
+      ASSERT_TRUE(rc.IsOk());
+      row_count++;
+    }
+    ASSERT_EQ(row_count, rows_per_shard * num_epochs);
+  }
 };
 
 TEST_F(MindDataTestCSVOp, TestCSVBasic) {
@@ -99,6 +162,44 @@ TEST_F(MindDataTestCSVOp, TestCSVBasic) {
   ASSERT_EQ(row_count, 3);
 }
 
+TEST_F(MindDataTestCSVOp, TestCSVShuffleBlocksShards) {
+  // The row blocks start after a line break, whether it is \r\n or \n, and never inside a quoted field
+  char temp_dir[] = "/tmp/csv_blocks_XXXXXX";
+  ASSERT_NE(mkdtemp(temp_dir), nullptr);
+  std::vector<std::string> files = {std::string(temp_dir) + "/1.csv", std::string(temp_dir) + "/2.csv"};
+  const std::vector<std::string> contents = {
+    "1,a\r\n2,\"b\r\nc\"\r\n3,\"d,e\"\r\n4,f\r\n5,\"g\nh\"\r\n6,i\r\n7,\"j\"\"k\"\r\n",
+    "8,l\n9,\"m\nn\"\n10,o\n11,\"p\r\nq\"\n12,r\n"};
+  const std::map<int32_t, std::string> expected = {{1, "a"}, {2, "b\r\nc"}, {3, "d,e"}, {4, "f"},
+                                                   {5, "g\nh"}, {6, "i"}, {7, "j\"k"}, {8, "l"},
+                                                   {9, "m\nn"}, {10, "o"}, {11, "p\r\nq"}, {12, "r"}};
+  for (size_t i = 0; i < files.size(); ++i) {
+    std::ofstream out(files[i], std::ios::binary);
+    out << contents[i];
+  }
+
+  // Every row is read exactly once in each epoch by one of the shards
+  const int32_t num_shards = 2;
+  const int32_t num_epochs = 3;
+  const int64_t num_rows = expected.size();
+  std::vector<std::multimap<int32_t, std::string>> seen(num_epochs);
+  for (int32_t shard_id = 0; shard_id < num_shards; ++shard_id) {
+    ReadShuffledBlocks(files, num_shards, shard_id, num_epochs, num_rows / num_shards, &seen);
+  }
+  for (const auto &epoch : seen) {
+    ASSERT_EQ(epoch.size(), num_rows);
+    for (const auto &row : expected) {
+      ASSERT_EQ(epoch.count(row.first), 1) << row.first;
+      EXPECT_EQ(epoch.find(row.first)->second, row.second);
+    }
+  }
+
+  for (const auto &file : files) {
+    EXPECT_EQ(remove(file.c_str()), 0);
+  }
+  EXPECT_EQ(rmdir(temp_dir), 0);
+}
+
 TEST_F(MindDataTestCSVOp, TestTotalRows) {
   std::string csv_file1 = datasets_root_path_ + "/testCSV/1.csv";
   std::string csv_file2 = datasets_root_path_ + "/testCSV/size.csv";
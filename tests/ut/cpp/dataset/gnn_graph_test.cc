@@ -13,13 +13,19 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <string>
 #include <memory>
 #include <unordered_set>
 
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
@@ -266,3 +272,152 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+TEST_F(MindDataTestGNNGraph, TestRandomWalkWorkers) {
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(135);
+  std::string path = "data/mindrecord/testGraphData/sns";
+  GraphDataImpl graph(path, 4);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  s = graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+
+  std::shared_ptr<Tensor> nodes;
+  s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  // Enough walks to split them among the workers
+  std::vector<NodeIdType> node_list;
+  for (int i = 0; i < 16; ++i) {
+    for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+      node_list.push_back(*itr);
+    }
+  }
+
+  std::vector<NodeType> meta_path(10, 1);
+  std::shared_ptr<Tensor> walk_path;
+  s = graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &walk_path);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(walk_path->shape().ToString() == "<528,11>");
+
+  // Every step goes to a neighbor of the previous node
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    NodeIdType prev = -1;
+    s = walk_path->GetItemAt(&prev, {static_cast<dsize_t>(i), 0});
+    EXPECT_EQ(prev, node_list[i]);
+    for (dsize_t j = 1; j <= static_cast<dsize_t>(meta_path.size()); ++j) {
+      NodeIdType next = -1;
+      s = walk_path->GetItemAt(&next, {static_cast<dsize_t>(i), j});
+      if (next == -1) {
+        break;
+      }
+      std::shared_ptr<Tensor> neighbors;
+      s = graph.GetAllNeighbors({prev}, meta_path[j - 1], &neighbors);
+      EXPECT_TRUE(s.IsOk());
+      bool found = false;
+      for (auto itr = neighbors->begin<NodeIdType>(); itr != neighbors->end<NodeIdType>(); ++itr) {
+        found = found || *itr == next;
+      }
+      EXPECT_TRUE(found);
+      prev = next;
+    }
+  }
+
+  // The next call walks differently, the alias tables are reused
+  std::shared_ptr<Tensor> walk_path_next;
+  s = graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &walk_path_next);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_NE(walk_path_next->ToString(), walk_path->ToString());
+
+  // A graph created with the same seed gives the same walks
+  GraphDataImpl graph_again(path, 4);
+  s = graph_again.Init();
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<Tensor> walk_path_again;
+  s = graph_again.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &walk_path_again);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(walk_path_again->ToString(), walk_path->ToString());
+  s = graph_again.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &walk_path_again);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(walk_path_again->ToString(), walk_path_next->ToString());
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
+
+TEST_F(MindDataTestGNNGraph, TestGraphCsrFile) {
+  // The csr file is saved next to a copy of the dataset, the shared test data is left untouched
+  char temp_dir[] = "/tmp/gnn_graph_csr_XXXXXX";
+  ASSERT_NE(mkdtemp(temp_dir), nullptr);
+  const std::vector<std::string> names = {"testdata", "testdata.db"};
+  for (const auto &name : names) {
+    std::ifstream in("data/mindrecord/testGraphData/" + name, std::ios::binary);
+    std::ofstream out(std::string(temp_dir) + "/" + name, std::ios::binary);
+    out << in.rdbuf();
+  }
+  std::string path = std::string(temp_dir) + "/testdata";
+  GraphDataImpl graph(path, 1);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  s = graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<Tensor> nodes;
+  s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<NodeIdType> node_list;
+  for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+    node_list.push_back(*itr);
+  }
+  std::shared_ptr<Tensor> neighbors;
+  s = graph.GetAllNeighbors(node_list, meta_info.node_type[1], &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  TensorRow features;
+  s = graph.GetNodeFeature(nodes, meta_info.node_feature_type, &features);
+  EXPECT_TRUE(s.IsOk());
+
+  // The graph loaded again maps the csr file, and gives the same neighbors and features
+  std::string csr_file = path + kGraphCsrSuffix;
+  s = graph.SaveCsr(csr_file);
+  EXPECT_TRUE(s.IsOk());
+  GraphDataImpl mapped_graph(path, 1);
+  s = mapped_graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(mapped_graph.IsCsrLoaded());
+  std::shared_ptr<Tensor> mapped_neighbors;
+  s = mapped_graph.GetAllNeighbors(node_list, meta_info.node_type[1], &mapped_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(mapped_neighbors->ToString(), neighbors->ToString());
+  TensorRow mapped_features;
+  s = mapped_graph.GetNodeFeature(nodes, meta_info.node_feature_type, &mapped_features);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(mapped_features.size(), features.size());
+  for (size_t i = 0; i < features.size(); i++) {
+    EXPECT_EQ(mapped_features[i]->ToString(), features[i]->ToString());
+  }
+  std::shared_ptr<Tensor> sampled;
+  s = mapped_graph.GetSampledNeighbors(node_list, {3, 2}, {meta_info.node_type[1], meta_info.node_type[0]}, &sampled);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(sampled->shape().ToString(), "<" + std::to_string(node_list.size()) + ",10>");
+
+  // Once the dataset file is changed, the csr file is not used any more
+  struct stat file_stat;
+  ASSERT_EQ(stat(path.c_str(), &file_stat), 0);
+  struct utimbuf times = {file_stat.st_atime, file_stat.st_mtime + 10};
+  ASSERT_EQ(utime(path.c_str(), &times), 0);
+  GraphDataImpl changed_graph(path, 1);
+  s = changed_graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_FALSE(changed_graph.IsCsrLoaded());
+  std::shared_ptr<Tensor> changed_neighbors;
+  s = changed_graph.GetAllNeighbors(node_list, meta_info.node_type[1], &changed_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(changed_neighbors->ToString(), neighbors->ToString());
+
+  (void)std::remove(csr_file.c_str());
+  for (const auto &name : names) {
+    (void)std::remove((std::string(temp_dir) + "/" + name).c_str());
+  }
+  (void)rmdir(temp_dir);
+}
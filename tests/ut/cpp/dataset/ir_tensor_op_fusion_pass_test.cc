@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "common/common.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
@@ -30,6 +31,44 @@ using namespace mindspore::dataset;
 class MindDataTestTensorOpFusionPass : public UT::DatasetOpTesting {
  public:
   MindDataTestTensorOpFusionPass() = default;
+
+  // Compile a map of the given ops with the optimization pass enabled, and return the tensor ops of the MapOp.
+  std::vector<std::shared_ptr<TensorOp>> CompileMap(const std::vector<std::shared_ptr<TensorOperation>> &ops) {
+    std::string folder_path = datasets_root_path_ + "/testPK/data/";
+    std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, SequentialSampler(0, 11));
+    ds = ds->Map(ops, {"image"});
+
+    auto ir_tree = std::make_shared<TreeAdapter>();
+    ir_tree->SetOptimize(true);
+    Status rc = ir_tree->Compile(ds->IRNode());
+    EXPECT_TRUE(rc.IsOk());
+    if (rc.IsError()) {
+      return {};
+    }
+    auto tree = std::make_shared<ExecutionTree>();
+    auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(ir_tree->GetRoot()));
+    ++it;
+    return static_cast<MapOp *>(&(*it))->TFuncs();
+  }
+
+  // The names of the tensor ops in order
+  std::vector<std::string> Names(const std::vector<std::shared_ptr<TensorOp>> &tfuncs) {
+    std::vector<std::string> names;
+    for (const auto &tfunc : tfuncs) {
+      names.push_back(tfunc->Name());
+    }
+    return names;
+  }
+
+  // The output type of the tensor op for a decoded image
+  DataType FusedOutputType(const std::shared_ptr<TensorOp> &tfunc) {
+    std::vector<DataType> outputs;
+    EXPECT_TRUE(tfunc->OutputType({DataType(DataType::DE_UINT8)}, outputs).IsOk());
+    return outputs.empty() ? DataType(DataType::DE_UNKNOWN) : outputs[0];
+  }
+
+  const std::vector<float> mean_ = {121.0, 115.0, 100.0};
+  const std::vector<float> std_ = {70.0, 68.0, 71.0};
 };
 
 TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResizeDisabled) {
@@ -99,3 +138,63 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResizeEnabled) {
   // EXPECT_EQ(++func_it, tfuncs.end());
 }
 
+
+TEST_F(MindDataTestTensorOpFusionPass, NormalizeChainFused) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-NormalizeChainFused";
+
+  // with the optional flip
+  auto tfuncs = CompileMap({vision::Decode(), vision::RandomResizedCrop({5}), vision::RandomHorizontalFlip(0.5),
+                            vision::Normalize(mean_, std_), vision::HWC2CHW()});
+  ASSERT_EQ(Names(tfuncs), std::vector<std::string>({kRandomCropDecodeResizeNormalizeOp}));
+  EXPECT_EQ(FusedOutputType(tfuncs[0]), DataType(DataType::DE_FLOAT32));
+
+  // without the flip, the ops around the chain are kept
+  tfuncs = CompileMap({vision::Resize({20}), vision::Decode(), vision::RandomResizedCrop({5}),
+                       vision::Normalize(mean_, std_), vision::HWC2CHW(), transforms::TypeCast("int32")});
+  ASSERT_EQ(Names(tfuncs), std::vector<std::string>({kResizeOp, kRandomCropDecodeResizeNormalizeOp, kTypeCastOp}));
+  EXPECT_EQ(FusedOutputType(tfuncs[1]), DataType(DataType::DE_FLOAT32));
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, NormalizeChainFloat16) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-NormalizeChainFloat16";
+
+  // a cast to float16 right after the chain is written by the fused op directly
+  auto tfuncs = CompileMap({vision::Decode(), vision::RandomResizedCrop({5}), vision::RandomHorizontalFlip(0.5),
+                            vision::Normalize(mean_, std_), vision::HWC2CHW(), transforms::TypeCast("float16")});
+  ASSERT_EQ(Names(tfuncs), std::vector<std::string>({kRandomCropDecodeResizeNormalizeOp}));
+  EXPECT_EQ(FusedOutputType(tfuncs[0]), DataType(DataType::DE_FLOAT16));
+
+  // the pre-built ops of the python API take the same path
+  std::vector<std::shared_ptr<TensorOperation>> ops = {vision::Decode(), vision::RandomResizedCrop({5}),
+                                                       vision::Normalize(mean_, std_), vision::HWC2CHW(),
+                                                       transforms::TypeCast("float16")};
+  for (auto &op : ops) {
+    op = std::make_shared<transforms::PreBuiltOperation>(op->Build());
+  }
+  tfuncs = CompileMap(ops);
+  ASSERT_EQ(Names(tfuncs), std::vector<std::string>({kRandomCropDecodeResizeNormalizeOp}));
+  EXPECT_EQ(FusedOutputType(tfuncs[0]), DataType(DataType::DE_FLOAT16));
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, NormalizeChainNotFused) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-NormalizeChainNotFused";
+
+  // no HwcToChw, only Decode and RandomResizedCrop are fused
+  auto tfuncs = CompileMap({vision::Decode(), vision::RandomResizedCrop({5}), vision::Normalize(mean_, std_)});
+  EXPECT_EQ(Names(tfuncs), std::vector<std::string>({kRandomCropDecodeResizeOp, kNormalizeOp}));
+
+  // an op inside the chain breaks it
+  tfuncs = CompileMap({vision::Decode(), vision::RandomResizedCrop({5}), vision::Resize({5}),
+                       vision::Normalize(mean_, std_), vision::HWC2CHW()});
+  EXPECT_EQ(Names(tfuncs), std::vector<std::string>({kRandomCropDecodeResizeOp, kResizeOp, kNormalizeOp, kHwcToChwOp}));
+
+  // the flip must come between the crop and the normalization
+  tfuncs = CompileMap({vision::Decode(), vision::RandomResizedCrop({5}), vision::Normalize(mean_, std_),
+                       vision::RandomHorizontalFlip(0.5), vision::HWC2CHW()});
+  EXPECT_EQ(Names(tfuncs), std::vector<std::string>(
+                             {kRandomCropDecodeResizeOp, kNormalizeOp, kRandomHorizontalFlipOp, kHwcToChwOp}));
+
+  // without Decode nothing is fused
+  tfuncs = CompileMap({vision::RandomResizedCrop({5}), vision::Normalize(mean_, std_), vision::HWC2CHW()});
+  EXPECT_EQ(Names(tfuncs), std::vector<std::string>({kRandomCropAndResizeOp, kNormalizeOp, kHwcToChwOp}));
+}
@@ -16,6 +16,7 @@
 
 #include "minddata/dataset/engine/tree_adapter.h"
 #include "common/common.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/include/datasets.h"
 #include "minddata/dataset/include/transforms.h"
@@ -41,6 +42,45 @@ using mindspore::dataset::Tensor;
 
 class MindDataTestTreeAdapter : public UT::DatasetOpTesting {
  protected:
+  // Compare a run restored from the third row of the second epoch with an uninterrupted run.
+  // The dataset has 5 rows per epoch and is run for 3 epochs.
+  void CheckRestore(std::shared_ptr<Dataset> ds) {
+    const int32_t rows_per_epoch = 6;  // including the empty row at the end of an epoch
+    const int32_t total_rows = rows_per_epoch * 3;
+    const int32_t stop_row = rows_per_epoch + 2;
+
+    mindspore::dataset::TreeAdapter full_run;
+    ASSERT_TRUE(full_run.Compile(ds->IRNode(), 3).IsOk());
+    std::vector<TensorRow> expected;
+    TensorRow row;
+    for (int32_t i = 0; i < total_rows; i++) {
+      ASSERT_TRUE(full_run.GetNext(&row).IsOk());
+      expected.push_back(row);
+    }
+
+    mindspore::dataset::TreeAdapter first_run;
+    ASSERT_TRUE(first_run.Compile(ds->IRNode(), 3).IsOk());
+    for (int32_t i = 0; i < stop_row; i++) {
+      ASSERT_TRUE(first_run.GetNext(&row).IsOk());
+    }
+    nlohmann::json checkpoint;
+    ASSERT_TRUE(first_run.GetCheckpoint(&checkpoint).IsOk());
+    EXPECT_EQ(checkpoint["epoch"], 1);
+    EXPECT_EQ(checkpoint["rows_in_epoch"], 2);
+
+    mindspore::dataset::TreeAdapter second_run;
+    ASSERT_TRUE(second_run.Compile(ds->IRNode(), 3).IsOk());
+    ASSERT_TRUE(second_run.Restore(checkpoint).IsOk());
+    for (int32_t i = stop_row; i < total_rows; i++) {
+      ASSERT_TRUE(second_run.GetNext(&row).IsOk());
+      ASSERT_EQ(row.size(), expected[i].size());
+      for (size_t j = 0; j < row.size(); j++) {
+        EXPECT_TRUE(*row[j] == *expected[i][j]);
+      }
+    }
+    Status rc = second_run.GetNext(&row);
+    EXPECT_TRUE(rc.IsError());
+  }
 };
 
 TEST_F(MindDataTestTreeAdapter, TestSimpleTreeAdapter) {
@@ -147,3 +187,89 @@ TEST_F(MindDataTestTreeAdapter, TestProjectMapTreeAdapter) {
   const std::string err_msg = rc.ToString();
   EXPECT_TRUE(err_msg.find("EOF buffer encountered.") != err_msg.npos);
 }
+
+TEST_F(MindDataTestTreeAdapter, TestRestoreWithSampler) {
+  MS_LOG(INFO) << "Doing MindDataTestTreeAdapter-TestRestoreWithSampler.";
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(246);
+
+  // The rows before the checkpoint are skipped by the random sampler
+  std::string folder_path = datasets_root_path_ + "/testMnistData/";
+  std::shared_ptr<Dataset> ds = Mnist(folder_path, "all", RandomSampler(false, 10));
+  EXPECT_NE(ds, nullptr);
+  ds = ds->Batch(2);
+  EXPECT_NE(ds, nullptr);
+  CheckRestore(ds);
+
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
+
+TEST_F(MindDataTestTreeAdapter, TestRestoreWithShuffle) {
+  MS_LOG(INFO) << "Doing MindDataTestTreeAdapter-TestRestoreWithShuffle.";
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(246);
+
+  // The rows before the checkpoint are fetched again through the shuffle op restored to the same rng state
+  std::string folder_path = datasets_root_path_ + "/testMnistData/";
+  std::shared_ptr<Dataset> ds = Mnist(folder_path, "all", SequentialSampler(0, 10));
+  EXPECT_NE(ds, nullptr);
+  ds = ds->Shuffle(4);
+  EXPECT_NE(ds, nullptr);
+  ds = ds->Batch(2);
+  EXPECT_NE(ds, nullptr);
+  CheckRestore(ds);
+
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
+
+TEST_F(MindDataTestTreeAdapter, TestRestoreWithPKSampler) {
+  MS_LOG(INFO) << "Doing MindDataTestTreeAdapter-TestRestoreWithPKSampler.";
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(246);
+
+  // The shuffled pk sampler is fast forwarded to the rng state of the checkpointed epoch
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, PKSampler(3, true, 10));
+  EXPECT_NE(ds, nullptr);
+  ds = ds->Batch(2);
+  EXPECT_NE(ds, nullptr);
+  CheckRestore(ds);
+
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
+
+TEST_F(MindDataTestTreeAdapter, TestRestoreWithMindData) {
+  MS_LOG(INFO) << "Doing MindDataTestTreeAdapter-TestRestoreWithMindData.";
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(246);
+
+  // The shard reader shuffles again on top of the previous pass, so restoring replays the passes before the epoch
+  std::string file_path = datasets_root_path_ + "/../mindrecord/testMindDataSet/testImageNetData/imagenet.mindrecord0";
+  std::shared_ptr<Dataset> ds = MindData(std::vector<std::string>{file_path}, {"label"}, RandomSampler());
+  EXPECT_NE(ds, nullptr);
+  CheckRestore(ds);
+
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
+
+TEST_F(MindDataTestTreeAdapter, TestRestoreWithTFRecordShuffleFiles) {
+  MS_LOG(INFO) << "Doing MindDataTestTreeAdapter-TestRestoreWithTFRecordShuffleFiles.";
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  uint32_t original_num_parallel_workers = GlobalContext::config_manager()->num_parallel_workers();
+  GlobalContext::config_manager()->set_seed(246);
+  GlobalContext::config_manager()->set_num_parallel_workers(1);
+
+  // The file order of each epoch is shuffled from the one before, so restoring replays the earlier file shuffles
+  std::vector<std::string> files;
+  for (int32_t i = 1; i <= 4; i++) {
+    files.push_back(datasets_root_path_ + "/tf_file_dataset/test" + std::to_string(i) + ".data");
+  }
+  std::shared_ptr<Dataset> ds = TFRecord(files, "", {"scalars"}, 0, ShuffleMode::kFiles);
+  EXPECT_NE(ds, nullptr);
+  ds = ds->Batch(8);
+  EXPECT_NE(ds, nullptr);
+  CheckRestore(ds);
+
+  GlobalContext::config_manager()->set_seed(original_seed);
+  GlobalContext::config_manager()->set_num_parallel_workers(original_num_parallel_workers);
+}
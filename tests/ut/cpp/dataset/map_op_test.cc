@@ -13,13 +13,20 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 
 #include "common/common.h"
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
@@ -50,6 +57,43 @@ class NoOp : public TensorOp {
   std::string Name() const override { return kNoOp; }
 };
 
+// Same as NoOp but the first call takes a while, so that the other workers run out of work.
+class SlowFirstOp : public TensorOp {
+ public:
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    if (!slept_.exchange(true)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    }
+    *output = input;
+    return Status::OK();
+  };
+
+  void Print(std::ostream &out) const override { out << "SlowFirstOp"; };
+
+  std::string Name() const override { return "SlowFirstOp"; }
+
+ private:
+  std::atomic<bool> slept_{false};
+};
+
+class SleepOp : public TensorOp {
+ public:
+  explicit SleepOp(int32_t ms) : ms_(ms) {}
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms_));
+    *output = input;
+    return Status::OK();
+  };
+
+  void Print(std::ostream &out) const override { out << "SleepOp"; };
+
+  std::string Name() const override { return "SleepOp"; }
+
+ private:
+  int32_t ms_;
+};
+
 class ThreeToOneOp : public TensorOp {
  public:
   ThreeToOneOp(){};
@@ -501,6 +545,161 @@ TEST_F(MindDataTestMapOp, TestTFReaderMapRepeat) {
   ASSERT_EQ(row_count, 10 * num_repeats);
 }
 
+// TestWorkStealing scenario:
+//    TFReaderOp -> MapOp with a slow first buffer -> RepeatOp, run with and without work stealing.
+//    The idle workers steal the buffers queued behind the slow one, the output must be the same rows in the same
+//    order as without stealing, and no buffer is stolen when stealing is off.
+TEST_F(MindDataTestMapOp, TestWorkStealing) {
+  MS_LOG(INFO) << "Doing TestWorkStealing.";
+  auto run_pipeline = [this](bool work_stealing, std::vector<std::string> *rows, int64_t *num_stolen) {
+    GlobalContext::config_manager()->set_map_work_stealing(work_stealing);
+    my_tree_ = std::make_shared<ExecutionTree>();
+    auto my_tfreader_op = this->CreateTFReaderOp();
+    EXPECT_TRUE(my_tree_->AssociateNode(my_tfreader_op).IsOk());
+    std::shared_ptr<MapOp> my_map_op;
+    MapOp::Builder builder;
+    builder.SetInColNames({"label"})
+      .SetTensorFuncs({std::make_shared<mindspore::dataset::test::SlowFirstOp>()})
+      .SetNumWorkers(3)
+      .SetOpConnectorSize(2);
+    EXPECT_TRUE(builder.Build(&my_map_op).IsOk());
+    EXPECT_TRUE(my_tree_->AssociateNode(my_map_op).IsOk());
+    std::shared_ptr<RepeatOp> my_repeat_op;
+    EXPECT_TRUE(RepeatOp::Builder(2).Build(&my_repeat_op).IsOk());
+    EXPECT_TRUE(my_tree_->AssociateNode(my_repeat_op).IsOk());
+    EXPECT_TRUE(my_repeat_op->AddChild(my_map_op).IsOk());
+    EXPECT_TRUE(my_map_op->AddChild(my_tfreader_op).IsOk());
+    EXPECT_TRUE(my_tree_->AssignRoot(my_repeat_op).IsOk());
+    EXPECT_TRUE(my_tree_->Prepare().IsOk());
+    EXPECT_TRUE(my_tree_->Launch().IsOk());
+
+    DatasetIterator di(my_tree_);
+    TensorRow tensor_list;
+    EXPECT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+    while (!tensor_list.empty()) {
+      std::ostringstream ss;
+      for (const auto &tensor : tensor_list) {
+        ss << *tensor;
+      }
+      rows->push_back(ss.str());
+      EXPECT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+    }
+    *num_stolen = my_map_op->NumStolenJobs();
+  };
+  bool original_work_stealing = GlobalContext::config_manager()->map_work_stealing();
+  bool original_autotune = GlobalContext::config_manager()->enable_autotune();
+  GlobalContext::config_manager()->set_enable_autotune(false);
+  std::vector<std::string> expected_rows;
+  int64_t num_stolen = -1;
+  run_pipeline(false, &expected_rows, &num_stolen);
+  ASSERT_EQ(num_stolen, 0);
+  std::vector<std::string> rows;
+  run_pipeline(true, &rows, &num_stolen);
+  GlobalContext::config_manager()->set_map_work_stealing(original_work_stealing);
+  GlobalContext::config_manager()->set_enable_autotune(original_autotune);
+  ASSERT_EQ(expected_rows.size(), 20);
+  ASSERT_EQ(rows, expected_rows);
+  // the buffers queued behind the slow first one are computed by the idle workers
+  ASSERT_GT(num_stolen, 0);
+}
+
+// TestHelperWorkers scenario:
+//    TFReaderOp -> MapOp with a slow op -> RepeatOp, helpers are added to the MapOp right after launch.
+//    The helpers steal buffers from the backlog of the workers, every row still comes out once.
+TEST_F(MindDataTestMapOp, TestHelperWorkers) {
+  MS_LOG(INFO) << "Doing TestHelperWorkers.";
+  bool original_work_stealing = GlobalContext::config_manager()->map_work_stealing();
+  GlobalContext::config_manager()->set_map_work_stealing(true);
+  auto my_tfreader_op = this->CreateTFReaderOp();
+  EXPECT_TRUE(my_tree_->AssociateNode(my_tfreader_op).IsOk());
+  std::shared_ptr<MapOp> my_map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({"label"})
+    .SetTensorFuncs({std::make_shared<mindspore::dataset::test::SleepOp>(20)})
+    .SetNumWorkers(2)
+    .SetOpConnectorSize(2);
+  EXPECT_TRUE(builder.Build(&my_map_op).IsOk());
+  GlobalContext::config_manager()->set_map_work_stealing(original_work_stealing);
+  EXPECT_TRUE(my_tree_->AssociateNode(my_map_op).IsOk());
+  std::shared_ptr<RepeatOp> my_repeat_op;
+  EXPECT_TRUE(RepeatOp::Builder(5).Build(&my_repeat_op).IsOk());
+  EXPECT_TRUE(my_tree_->AssociateNode(my_repeat_op).IsOk());
+  EXPECT_TRUE(my_repeat_op->AddChild(my_map_op).IsOk());
+  EXPECT_TRUE(my_map_op->AddChild(my_tfreader_op).IsOk());
+  EXPECT_TRUE(my_tree_->AssignRoot(my_repeat_op).IsOk());
+  EXPECT_TRUE(my_tree_->Prepare().IsOk());
+  EXPECT_TRUE(my_tree_->Launch().IsOk());
+  // helper 1 stays launched but inactive, it must not swallow the wakeups meant for helper 0
+  EXPECT_TRUE(my_map_op->SetNumHelperWorkers(2).IsOk());
+  EXPECT_TRUE(my_map_op->SetNumHelperWorkers(1).IsOk());
+  EXPECT_EQ(my_map_op->NumHelperWorkers(), 1);
+  EXPECT_TRUE(my_map_op->SetNumHelperWorkers(-1).IsError());
+
+  DatasetIterator di(my_tree_);
+  TensorRow tensor_list;
+  EXPECT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+  uint32_t row_count = 0;
+  while (!tensor_list.empty()) {
+    row_count++;
+    EXPECT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+  }
+  ASSERT_EQ(row_count, 10 * 5);
+  ASSERT_GT(my_map_op->NumHelperJobs(), 0);
+}
+
+// TestAutoTuneHelperWorkers scenario:
+//    TFReaderOp -> MapOp with a slow op -> RepeatOp with the auto tuner on.
+//    The input of the MapOp stays full while its output stays empty, so the tuner gives it helpers as long as there
+//    are cpu threads left.
+TEST_F(MindDataTestMapOp, TestAutoTuneHelperWorkers) {
+  MS_LOG(INFO) << "Doing TestAutoTuneHelperWorkers.";
+  auto cfg = GlobalContext::config_manager();
+  bool original_autotune = cfg->enable_autotune();
+  int32_t original_interval = cfg->autotune_interval();
+  cfg->set_enable_autotune(true);
+  cfg->set_autotune_interval(5);
+  auto my_tfreader_op = this->CreateTFReaderOp();
+  EXPECT_TRUE(my_tree_->AssociateNode(my_tfreader_op).IsOk());
+  std::shared_ptr<MapOp> my_map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({"label"})
+    .SetTensorFuncs({std::make_shared<mindspore::dataset::test::SleepOp>(10)})
+    .SetNumWorkers(2)
+    .SetOpConnectorSize(2);
+  EXPECT_TRUE(builder.Build(&my_map_op).IsOk());
+  EXPECT_TRUE(my_tree_->AssociateNode(my_map_op).IsOk());
+  std::shared_ptr<RepeatOp> my_repeat_op;
+  EXPECT_TRUE(RepeatOp::Builder(20).Build(&my_repeat_op).IsOk());
+  EXPECT_TRUE(my_tree_->AssociateNode(my_repeat_op).IsOk());
+  EXPECT_TRUE(my_repeat_op->AddChild(my_map_op).IsOk());
+  EXPECT_TRUE(my_map_op->AddChild(my_tfreader_op).IsOk());
+  EXPECT_TRUE(my_tree_->AssignRoot(my_repeat_op).IsOk());
+  EXPECT_TRUE(my_tree_->Prepare().IsOk());
+  EXPECT_TRUE(my_tree_->Launch().IsOk());
+
+  DatasetIterator di(my_tree_);
+  TensorRow tensor_list;
+  EXPECT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+  uint32_t row_count = 0;
+  int32_t max_helpers = 0;
+  while (!tensor_list.empty()) {
+    row_count++;
+    max_helpers = std::max(max_helpers, my_map_op->NumHelperWorkers());
+    EXPECT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+  }
+  cfg->set_enable_autotune(original_autotune);
+  cfg->set_autotune_interval(original_interval);
+  ASSERT_EQ(row_count, 10 * 20);
+  // the workers of the TFReaderOp and of the MapOp use 4 threads already
+  const int32_t threads_in_use = 4;
+  if (cfg->num_cpu_threads() > threads_in_use) {
+    ASSERT_GT(max_helpers, 0);
+    ASSERT_GT(my_map_op->NumHelperJobs(), 0);
+  } else {
+    ASSERT_EQ(max_helpers, 0);
+  }
+}
+
 TEST_F(MindDataTestMapOp, TFReader_Decode_Repeat_Resize) {
   Status rc;
   MS_LOG(INFO) << "Doing TFReader_Decode_Repeat_Resize.";
@@ -15,7 +15,10 @@
  */
 
 #include "minddata/dataset/util/memory_pool.h"
+#include <cstring>
+#include <thread>
 #include "minddata/dataset/util/circular_pool.h"
+#include "minddata/dataset/util/recycling_pool.h"
 #include "minddata/dataset/util/system_pool.h"
 #include "minddata/dataset/util/allocator.h"
 #include "common/common.h"
@@ -86,3 +89,87 @@ TEST_F(MindDataTestMemoryPool, TestMemGuard) {
     p[sz / 2] = 'a';
   }
 }
+
+TEST_F(MindDataTestMemoryPool, TestRecyclingPool) {
+  auto pool = std::make_shared<RecyclingPool>(std::make_shared<SystemPool>(), 64 * 1024 * 1024);
+  void *p = nullptr;
+  void *q = nullptr;
+  // The first request of a size goes to the backing pool, the next ones reuse the freed block.
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(pool->Allocate(100000, &p).IsOk());
+    memset(p, i, 100000);
+    pool->Deallocate(p);
+  }
+  RecyclingPool::Stats stats = pool->GetStats();
+  ASSERT_EQ(stats.num_allocs, 10);
+  ASSERT_EQ(stats.num_thread_hits, 9);
+  ASSERT_GT(pool->HitRate(), 0.8);
+
+  // Small requests are not counted.
+  ASSERT_TRUE(pool->Allocate(16, &p).IsOk());
+  pool->Deallocate(p);
+  ASSERT_EQ(pool->GetStats().num_allocs, 10);
+
+  // Growing within the size class keeps the block, growing beyond it keeps the content.
+  ASSERT_TRUE(pool->Allocate(5000, &p).IsOk());
+  q = p;
+  ASSERT_TRUE(pool->Reallocate(&p, 5000, 5100).IsOk());
+  ASSERT_EQ(p, q);
+  static_cast<uint8_t *>(p)[5099] = 'a';
+  ASSERT_TRUE(pool->Reallocate(&p, 5100, 200000).IsOk());
+  ASSERT_EQ(static_cast<uint8_t *>(p)[5099], 'a');
+  pool->Deallocate(p);
+  MS_LOG(DEBUG) << *pool << std::endl;
+}
+
+TEST_F(MindDataTestMemoryPool, TestRecyclingPoolThreads) {
+  auto pool = std::make_shared<RecyclingPool>(std::make_shared<SystemPool>(), 64 * 1024 * 1024);
+  // The blocks freed by a thread are given to the other threads once it exits.
+  std::thread t([&pool]() {
+    void *p = nullptr;
+    ASSERT_TRUE(pool->Allocate(100000, &p).IsOk());
+    pool->Deallocate(p);
+  });
+  t.join();
+  RecyclingPool::Stats stats = pool->GetStats();
+  ASSERT_EQ(stats.num_allocs, 1);
+  ASSERT_GT(stats.cached_bytes, 0);
+}
+
+TEST_F(MindDataTestMemoryPool, TestRecyclingPoolTrim) {
+  auto pool = std::make_shared<RecyclingPool>(std::make_shared<SystemPool>(), 64 * 1024 * 1024);
+  void *p = nullptr;
+  // Trimming empties the cache of the calling thread too, the next request goes to the backing pool.
+  ASSERT_TRUE(pool->Allocate(100000, &p).IsOk());
+  pool->Deallocate(p);
+  ASSERT_GT(pool->GetStats().cached_bytes, 0);
+  pool->Trim();
+  ASSERT_EQ(pool->GetStats().cached_bytes, 0);
+  ASSERT_TRUE(pool->Allocate(100000, &p).IsOk());
+  pool->Deallocate(p);
+  RecyclingPool::Stats stats = pool->GetStats();
+  ASSERT_EQ(stats.num_allocs, 2);
+  ASSERT_EQ(stats.num_thread_hits + stats.num_node_hits, 0);
+
+  // A disabled pool keeps nothing, the blocks it handed out before can still be freed into it.
+  ASSERT_TRUE(pool->Allocate(100000, &p).IsOk());
+  pool->SetLimits(false, 64 * 1024 * 1024);
+  pool->Deallocate(p);
+  ASSERT_EQ(pool->GetStats().cached_bytes, 0);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(pool->Allocate(100000, &p).IsOk());
+    pool->Deallocate(p);
+  }
+  ASSERT_EQ(pool->GetStats().num_allocs, 3);
+  ASSERT_EQ(pool->GetStats().cached_bytes, 0);
+
+  // No free memory is kept for a node beyond the limit.
+  pool->SetLimits(true, 0);
+  std::thread t([&pool]() {
+    void *q = nullptr;
+    ASSERT_TRUE(pool->Allocate(100000, &q).IsOk());
+    pool->Deallocate(q);
+  });
+  t.join();
+  ASSERT_EQ(pool->GetStats().cached_bytes, 0);
+}
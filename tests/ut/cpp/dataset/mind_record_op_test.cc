@@ -13,17 +13,24 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <random>
+#include <string>
 #include <vector>
 #include "minddata/dataset/core/client.h"
 #include "common/common.h"
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "minddata/mindrecord/include/shard_category.h"
+#include "minddata/mindrecord/include/shard_codec.h"
 #include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_index_generator.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "minddata/mindrecord/include/shard_shuffle.h"
+#include "minddata/mindrecord/include/shard_writer.h"
 #include "utils/log_adapter.h"
 
 namespace common = mindspore::common;
@@ -521,3 +528,88 @@ TEST_F(MindDataTestMindRecordOp, TestMindRecordInvalidColumnList) {
   ASSERT_TRUE(rc.IsError());
   ASSERT_TRUE(rc.ToString().find_first_of("illegal column list") != std::string::npos);
 }
+
+TEST_F(MindDataTestMindRecordOp, TestMindRecordMmapPageCodec) {
+  // single MindRecord op reading a zlib encoded file while mmap is enabled
+  //
+  //    MindRecordOp
+
+  MS_LOG(INFO) << "UT test TestMindRecordMmapPageCodec";
+  ASSERT_TRUE(mindspore::mindrecord::ShardCodec::Create(mindspore::mindrecord::kCodecZlib) != nullptr)
+    << "Zlib codec is not built in.";
+
+  // even rows compress well, odd rows are incompressible and stored as is
+  const int num_rows = 10;
+  std::mt19937 gen(0);
+  std::vector<mindspore::mindrecord::json> rows;
+  std::vector<std::vector<uint8_t>> blobs;
+  for (int i = 0; i < num_rows; ++i) {
+    rows.push_back({{"file_name", std::to_string(i) + ".jpg"}, {"label", i}});
+    std::vector<uint8_t> blob(4096 + i, static_cast<uint8_t>(i));
+    if (i % 2 == 1) {
+      std::generate(blob.begin(), blob.end(), [&gen]() { return static_cast<uint8_t>(gen()); });
+    }
+    blobs.push_back(std::move(blob));
+  }
+
+  std::string file_name = "./mmap_codec.mindrecord";
+  {
+    mindspore::mindrecord::ShardHeader header;
+    auto schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}})";
+    auto schema = mindspore::mindrecord::Schema::Build("annotation", mindspore::mindrecord::json::parse(schema_json));
+    ASSERT_TRUE(schema != nullptr);
+    int schema_id = header.AddSchema(schema);
+    std::map<uint64_t, std::vector<mindspore::mindrecord::json>> raw_data{{schema_id, rows}};
+    mindspore::mindrecord::ShardWriter writer;
+    ASSERT_EQ(writer.Open({file_name}), mindspore::mindrecord::SUCCESS);
+    ASSERT_EQ(writer.SetShardHeader(std::make_shared<mindspore::mindrecord::ShardHeader>(header)),
+              mindspore::mindrecord::SUCCESS);
+    ASSERT_EQ(writer.SetPageCodec(mindspore::mindrecord::kCodecZlib), mindspore::mindrecord::SUCCESS);
+    ASSERT_EQ(writer.WriteRawData(raw_data, blobs), mindspore::mindrecord::SUCCESS);
+    ASSERT_EQ(writer.Commit(), mindspore::mindrecord::SUCCESS);
+    mindspore::mindrecord::ShardIndexGenerator index_generator{file_name};
+    ASSERT_EQ(index_generator.Build(), mindspore::mindrecord::SUCCESS);
+    ASSERT_EQ(index_generator.WriteToDatabase(), mindspore::mindrecord::SUCCESS);
+  }
+
+  bool original_mmap = GlobalContext::config_manager()->mindrecord_mmap();
+  GlobalContext::config_manager()->set_mindrecord_mmap(true);
+
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<MindRecordOp> my_mindrecord_op;
+  MindRecordOp::Builder builder;
+  builder.SetDatasetFile({file_name})
+      .SetLoadDataset(false)
+      .SetRowsPerBuffer(3)
+      .SetNumMindRecordWorkers(4)
+      .SetColumnsToLoad({"label", "data"});
+  Status rc = builder.Build(&my_mindrecord_op);
+  ASSERT_TRUE(rc.IsOk());
+  my_tree->AssociateNode(my_mindrecord_op);
+  my_tree->AssignRoot(my_mindrecord_op);
+  my_tree->Prepare();
+  my_tree->Launch();
+
+  DatasetIterator di(my_tree);
+  auto column_map = di.GetColumnNameMap();
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  ASSERT_TRUE(rc.IsOk());
+  int row_count = 0;
+  while (!tensor_list.empty()) {
+    int32_t label = -1;
+    ASSERT_TRUE(tensor_list[column_map["label"]]->GetItemAt(&label, {}).IsOk());
+    ASSERT_TRUE(label >= 0 && label < num_rows);
+    auto data = tensor_list[column_map["data"]];
+    std::vector<uint8_t> blob(data->GetBuffer(), data->GetBuffer() + data->SizeInBytes());
+    ASSERT_EQ(blob, blobs[label]);
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    row_count++;
+  }
+  ASSERT_EQ(row_count, num_rows);
+
+  GlobalContext::config_manager()->set_mindrecord_mmap(original_mmap);
+  remove(common::SafeCStr(file_name + ".db"));
+  remove(common::SafeCStr(file_name));
+}
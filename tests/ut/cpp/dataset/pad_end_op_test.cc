@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "common/common.h"
+#include "minddata/dataset/kernels/data/data_utils.h"
 #include "minddata/dataset/kernels/data/pad_end_op.h"
 #include "utils/log_adapter.h"
 
@@ -134,3 +135,33 @@ TEST_F(MindDataTestPadEndOp, TestOp) {
 
   MS_LOG(INFO) << "MindDataTestPadEndOp end.";
 }
+
+TEST_F(MindDataTestPadEndOp, TestPadEndBatch) {
+  MS_LOG(INFO) << "Doing MindDataTestPadEndOp-TestPadEndBatch.";
+  // rows of different shapes, the second one is cut to the pad shape
+  std::shared_ptr<Tensor> row1, row2, row3;
+  Tensor::CreateFromVector(std::vector<int32_t>{1, 2}, TensorShape({1, 2}), &row1);
+  Tensor::CreateFromVector(std::vector<int32_t>{3, 4, 5, 6, 7, 8, 9, 10}, TensorShape({2, 4}), &row2);
+  Tensor::CreateFromVector(std::vector<int32_t>{11, 12, 13, 14, 15, 16}, TensorShape({2, 3}), &row3);
+  std::shared_ptr<Tensor> pad_value;
+  Tensor::CreateScalar<float>(-1, &pad_value);
+
+  std::shared_ptr<Tensor> output;
+  Status s = PadEndBatch(TensorRow(0, {row1, row2, row3}), &output, {2, 3}, pad_value);
+  EXPECT_TRUE(s.IsOk());
+
+  std::shared_ptr<Tensor> expected;
+  Tensor::CreateFromVector(std::vector<int32_t>{1, 2, -1, -1, -1, -1, 3, 4, 5, 7, 8, 9, 11, 12, 13, 14, 15, 16},
+                           TensorShape({3, 2, 3}), &expected);
+  ASSERT_TRUE(output->shape() == expected->shape());
+  ASSERT_TRUE(*output == *expected);
+
+  // the result is the same as padding every row then batching them
+  std::shared_ptr<Tensor> padded;
+  s = PadEnd(row1, &padded, {2, 3}, pad_value);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<Tensor> first_row;
+  s = Tensor::CreateFromMemory(TensorShape({2, 3}), output->type(), output->GetBuffer(), &first_row);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_TRUE(*first_row == *padded);
+}
@@ -18,9 +18,12 @@
 #include "gtest/gtest.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/ring_queue.h"
 #include <atomic>
 #include <chrono>
 #include <random>
+#include <thread>
+#include <vector>
 #include "utils/log_adapter.h"
 
 using namespace mindspore::dataset;
@@ -177,3 +180,114 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, TestResize) {
+  Queue<std::unique_ptr<int>> que(3);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(que.Add(std::make_unique<int>(i)).IsOk());
+  }
+  std::unique_ptr<int> a;
+  ASSERT_TRUE(que.PopFront(&a).IsOk());
+  ASSERT_EQ(*a, 0);
+  // The elements now wrap around the end of the array.
+  ASSERT_TRUE(que.Add(std::make_unique<int>(3)).IsOk());
+  ASSERT_TRUE(que.Resize(2).IsError());
+  ASSERT_TRUE(que.Resize(5).IsOk());
+  ASSERT_EQ(que.capacity(), 5u);
+  ASSERT_EQ(que.size(), 3u);
+  for (int i = 4; i < 6; i++) {
+    ASSERT_TRUE(que.Add(std::make_unique<int>(i)).IsOk());
+  }
+  for (int i = 1; i < 6; i++) {
+    ASSERT_TRUE(que.PopFront(&a).IsOk());
+    ASSERT_EQ(*a, i);
+  }
+  ASSERT_TRUE(que.empty());
+}
+
+TEST_F(MindDataTestQueue, TestRingQueue1) {
+  // Same as Test3 on the lock-free queue, plus the non-blocking calls on a full and an empty queue.
+  RingQueue<std::unique_ptr<int>> que(2);
+  std::unique_ptr<int> a(new int(3));
+  Status rc = que.Add(std::move(a));
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(a.get(), nullptr);
+  rc = que.EmplaceBack(new int(40));
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.size(), 2u);
+  std::unique_ptr<int> c(new int(7));
+  ASSERT_FALSE(que.TryPush(&c));
+  ASSERT_NE(c.get(), nullptr);
+  std::unique_ptr<int> b;
+  rc = que.PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 3);
+  ASSERT_TRUE(que.TryPush(&c));
+  ASSERT_TRUE(que.TryPop(&b));
+  ASSERT_EQ(*b, 40);
+  ASSERT_TRUE(que.TryPop(&b));
+  ASSERT_EQ(*b, 7);
+  ASSERT_FALSE(que.TryPop(&b));
+  ASSERT_TRUE(que.empty());
+}
+
+TEST_F(MindDataTestQueue, TestRingQueue2) {
+  // Several producers and consumers through a small queue, every element must arrive once and the elements
+  // of one producer must arrive in order.
+  const int num_producers = 4;
+  const int num_consumers = 3;
+  const int num_elements = 10000;
+  RingQueue<std::pair<int, int>> que(8);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_producers; i++) {
+    threads.emplace_back([&que, i]() {
+      for (int j = 0; j < num_elements; j++) {
+        EXPECT_TRUE(que.Add(std::make_pair(i, j)).IsOk());
+      }
+    });
+  }
+  std::vector<std::vector<int>> received(num_consumers * num_producers);
+  std::atomic<int> total(0);
+  for (int i = 0; i < num_consumers; i++) {
+    threads.emplace_back([&que, &received, &total, i]() {
+      while (total.fetch_add(1) < num_producers * num_elements) {
+        std::pair<int, int> ele;
+        EXPECT_TRUE(que.PopFront(&ele).IsOk());
+        received[i * num_producers + ele.first].push_back(ele.second);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (int i = 0; i < num_producers; i++) {
+    std::vector<int> merged;
+    for (int j = 0; j < num_consumers; j++) {
+      auto &v = received[j * num_producers + i];
+      ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+      merged.insert(merged.end(), v.begin(), v.end());
+    }
+    std::sort(merged.begin(), merged.end());
+    ASSERT_EQ(merged.size(), static_cast<size_t>(num_elements));
+    for (int j = 0; j < num_elements; j++) {
+      ASSERT_EQ(merged[j], j);
+    }
+  }
+}
+
+TEST_F(MindDataTestQueue, TestRingQueue3) {
+  // Batched push and pop keep the order, the batch is larger than the queue so the producer has to park.
+  RingQueue<int> que(4);
+  std::vector<int> input(100);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = i;
+  }
+  std::thread producer([&que, input]() mutable { EXPECT_TRUE(que.AddBatch(&input).IsOk()); });
+  std::vector<int> output;
+  while (output.size() < input.size()) {
+    Status rc = que.PopFrontBatch(&output, 3);
+    ASSERT_TRUE(rc.IsOk());
+  }
+  producer.join();
+  ASSERT_EQ(output, input);
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestRandomCropDecodeResizeNormalizeOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestRandomCropDecodeResizeNormalizeOp() : CVOpCommon() {}
+
+  // Run the fused op and the ops it replaces on the same crop boxes, and compare the results.
+  void CompareWithUnfused(float flip_probability) {
+    constexpr int target_height = 224;
+    constexpr int target_width = 200;
+    const std::vector<float> mean = {121.0, 115.0, 100.0};
+    const std::vector<float> std = {70.0, 68.0, 71.0};
+    GlobalContext::config_manager()->set_seed(42);
+    RandomCropDecodeResizeOp crop_op(target_height, target_width);
+    NormalizeOp normalize_op(mean[0], mean[1], mean[2], std[0], std[1], std[2]);
+    for (int k = 0; k < 5; k++) {
+      // A copy starts from the same state of the random generator, so both take the same crop box.
+      RandomCropDecodeResizeNormalizeOp fused_op(crop_op, mean, std, flip_probability);
+      std::shared_ptr<Tensor> fused_output;
+      ASSERT_TRUE(fused_op.Compute(raw_input_tensor_, &fused_output).IsOk());
+      std::shared_ptr<Tensor> image;
+      ASSERT_TRUE(crop_op.Compute(raw_input_tensor_, &image).IsOk());
+      if (flip_probability > 0) {
+        ASSERT_TRUE(HorizontalFlip(image, &image).IsOk());
+      }
+      ASSERT_TRUE(normalize_op.Compute(image, &image).IsOk());
+      ASSERT_TRUE(HwcToChw(image, &image).IsOk());
+
+      ASSERT_EQ(fused_output->shape(), TensorShape({3, target_height, target_width}));
+      ASSERT_EQ(fused_output->type(), DataType(DataType::DE_FLOAT32));
+      ASSERT_EQ(fused_output->shape(), image->shape());
+      auto expected = image->begin<float>();
+      for (auto itr = fused_output->begin<float>(); itr != fused_output->end<float>(); ++itr, ++expected) {
+        ASSERT_LT(std::fabs(*itr - *expected), 1e-4);
+      }
+    }
+  }
+};
+
+TEST_F(MindDataTestRandomCropDecodeResizeNormalizeOp, TestOp) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeNormalizeOp-TestOp.";
+  CompareWithUnfused(0.0);
+}
+
+TEST_F(MindDataTestRandomCropDecodeResizeNormalizeOp, TestOpWithFlip) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeNormalizeOp-TestOpWithFlip.";
+  // Always flipped, so that the result does not depend on the draw.
+  CompareWithUnfused(1.0);
+}
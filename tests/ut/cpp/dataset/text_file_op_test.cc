@@ -13,8 +13,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <unistd.h>
+#include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
@@ -33,7 +37,57 @@ using mindspore::ExceptionType::NoExceptionType;
 using mindspore::LogStream;
 
 class MindDataTestTextFileOp : public UT::DatasetOpTesting {
+ public:
+  // Read one shard of the files over a few epochs with the row blocks shuffled, and count the lines of each epoch.
+  void ReadShuffledBlocks(const std::vector<std::string> &files, int32_t num_shards, int32_t shard_id,
+                          int32_t num_epochs, int64_t rows_per_shard,
+                          std::vector<std::map<std::string, int32_t>> *seen) {
+    auto tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<TextFileOp> op;
+    TextFileOp::Builder builder;
+    builder.SetTextFilesList(files)
+        .SetRowsPerBuffer(2)
+        .SetNumWorkers(2)
+        .SetOpConnectorSize(2)
+        .SetNumDevices(num_shards)
+        .SetDeviceId(shard_id)
+        .SetShuffleFiles(true)
+        .SetShuffleBlocks(true)
+        .SetShuffleBlockRows(2);
+    Status rc = builder.Build(&op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->AssociateNode(op);
+    ASSERT_TRUE(rc.IsOk());
+    std::shared_ptr<RepeatOp> repeat_op = std::make_shared<RepeatOp>(num_epochs);
+    rc = tree->AssociateNode(repeat_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = repeat_op->AddChild(op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->AssignRoot(repeat_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->Prepare();
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->Launch();
+    ASSERT_TRUE(rc.IsOk());
 
+    DatasetIterator di(tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    int64_t row_count = 0;
+    while (!tensor_list.empty()) {
+      int64_t epoch = row_count / rows_per_shard;
+      ASSERT_LT(epoch, num_epochs);
+      std::string_view line;
+      rc = tensor_list[0]->GetItemAt(&line, {});
+      ASSERT_TRUE(rc.IsOk());
+      (*seen)[epoch][std::string(line)]++;
+      rc = di.FetchNextTensorRow(&tensor_list);
+      ASSERT_TRUE(rc.IsOk());
+      row_count++;
+    }
+    ASSERT_EQ(row_count, rows_per_shard * num_epochs);
+  }
 };
 
 TEST_F(MindDataTestTextFileOp, TestTextFileBasic) {
@@ -89,6 +143,88 @@ TEST_F(MindDataTestTextFileOp, TestTextFileBasic) {
   ASSERT_EQ(row_count, 3);
 }
 
+TEST_F(MindDataTestTextFileOp, TestTextFileShuffleBlocks) {
+  // Start with an empty execution tree
+  auto tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path1 = datasets_root_path_ + "/testTextFileDataset/1.txt";
+  std::string dataset_path2 = datasets_root_path_ + "/testTextFileDataset/2.txt";
+
+  std::shared_ptr<TextFileOp> op;
+  TextFileOp::Builder builder;
+  builder.SetTextFilesList({dataset_path1, dataset_path2})
+      .SetRowsPerBuffer(16)
+      .SetNumWorkers(2)
+      .SetOpConnectorSize(2)
+      .SetShuffleFiles(true)
+      .SetShuffleBlocks(true);
+
+  Status rc = builder.Build(&op);
+  ASSERT_TRUE(rc.IsOk());
+
+  rc = tree->AssociateNode(op);
+  ASSERT_TRUE(rc.IsOk());
+
+  rc = tree->AssignRoot(op);
+  ASSERT_TRUE(rc.IsOk());
+
+  MS_LOG(INFO) << "Launching tree and begin iteration.";
+  rc = tree->Prepare();
+  ASSERT_TRUE(rc.IsOk());
+
+  rc = tree->Launch();
+  ASSERT_TRUE(rc.IsOk());
+
+  // Every row of both files is read once whatever the order of the blocks
+  DatasetIterator di(tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  ASSERT_TRUE(rc.IsOk());
+
+  int row_count = 0;
+  while (!tensor_list.empty()) {
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    row_count++;
+  }
+
+  ASSERT_EQ(row_count, 5);
+}
+
+TEST_F(MindDataTestTextFileOp, TestTextFileShuffleBlocksShards) {
+  // Files of 7 and 5 lines are cut into blocks of 2 rows, so a shard may start or end in the middle of a block
+  char temp_dir[] = "/tmp/text_file_blocks_XXXXXX";
+  ASSERT_NE(mkdtemp(temp_dir), nullptr);
+  std::vector<std::string> files = {std::string(temp_dir) + "/1.txt", std::string(temp_dir) + "/2.txt"};
+  const std::vector<int32_t> num_lines = {7, 5};
+  int64_t num_rows = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    std::ofstream out(files[i]);
+    for (int32_t j = 0; j < num_lines[i]; ++j) {
+      out << "line" << num_rows++ << "\n";
+    }
+  }
+
+  // Every line is read exactly once in each epoch by one of the shards
+  const int32_t num_shards = 2;
+  const int32_t num_epochs = 3;
+  std::vector<std::map<std::string, int32_t>> seen(num_epochs);
+  for (int32_t shard_id = 0; shard_id < num_shards; ++shard_id) {
+    ReadShuffledBlocks(files, num_shards, shard_id, num_epochs, num_rows / num_shards, &seen);
+  }
+  for (const auto &epoch : seen) {
+    EXPECT_EQ(epoch.size(), num_rows);
+    for (const auto &line : epoch) {
+      EXPECT_EQ(line.second, 1) << line.first;
+    }
+  }
+
+  for (const auto &file : files) {
+    EXPECT_EQ(remove(file.c_str()), 0);
+  }
+  EXPECT_EQ(rmdir(temp_dir), 0);
+}
+
 TEST_F(MindDataTestTextFileOp, TestTextFileFileNotExist) {
   // Start with an empty execution tree
   auto tree = std::make_shared<ExecutionTree>();
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <iostream>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -32,7 +33,59 @@ using mindspore::ExceptionType::NoExceptionType;
 using mindspore::LogStream;
 
 class MindDataTestTFReaderOp : public UT::DatasetOpTesting {
+ public:
+  // Read one shard of the files over a few epochs with the row blocks shuffled, and collect the rows of each epoch.
+  void ReadShuffledBlocks(const std::vector<std::string> &files, int32_t num_shards, int32_t shard_id,
+                          int32_t num_epochs, int64_t rows_per_shard, std::vector<std::map<int64_t, int32_t>> *seen) {
+    auto tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<TFReaderOp> op;
+    TFReaderOp::Builder builder;
+    builder.SetDatasetFilesList(files)
+        .SetRowsPerBuffer(2)
+        .SetNumWorkers(2)
+        .SetNumDevices(num_shards)
+        .SetDeviceId(shard_id)
+        .SetShardEqualRows(true)
+        .SetShuffleFiles(true)
+        .SetShuffleBlocks(true)
+        .SetShuffleBlockRows(3);
+    std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+    schema->LoadSchemaFile(datasets_root_path_ + "/tf_file_dataset/datasetSchema.json", {});
+    builder.SetDataSchema(std::move(schema));
+    Status rc = builder.Build(&op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->AssociateNode(op);
+    ASSERT_TRUE(rc.IsOk());
+    std::shared_ptr<RepeatOp> repeat_op = std::make_shared<RepeatOp>(num_epochs);
+    rc = tree->AssociateNode(repeat_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = repeat_op->AddChild(op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->AssignRoot(repeat_op);
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->Prepare();
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->Launch();
+    ASSERT_TRUE(rc.IsOk());
 
+    DatasetIterator di(tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    int64_t row_count = 0;
+    while (!tensor_list.empty()) {
+      int64_t epoch = row_count / rows_per_shard;
+      ASSERT_LT(epoch, num_epochs);
+      int64_t value = 0;
+      rc = tensor_list[0]->GetItemAt(&value, {0});
+      ASSERT_TRUE(rc.IsOk());
+      (*seen)[epoch][value]++;
+      rc = di.FetchNextTensorRow(&tensor_list);
+      ASSERT_TRUE(rc.IsOk());
+      row_count++;
+    }
+    ASSERT_EQ(row_count, rows_per_shard * num_epochs);
+  }
 };
 
 TEST_F(MindDataTestTFReaderOp, TestTFReaderBasic1) {
@@ -658,6 +711,32 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderBasicNoSchema) {
   ASSERT_EQ(row_count, 12);
 }
 
+TEST_F(MindDataTestTFReaderOp, TestTFReaderShuffleBlocksShards) {
+  // 40 rows in 4 files of 10, with the values 1 to 40. With equal rows, a shard of 5 rows starts or ends in the middle
+  // of a file, and the blocks of 3 rows are cut at the shard boundaries.
+  std::vector<std::string> files;
+  for (int32_t i = 1; i <= 4; ++i) {
+    files.push_back(datasets_root_path_ + "/tf_file_dataset/test" + std::to_string(i) + ".data");
+  }
+  const int32_t num_shards = 8;
+  const int32_t num_epochs = 3;
+  const int64_t num_rows = 40;
+
+  // Every row is read exactly once in each epoch by one of the shards
+  std::vector<std::map<int64_t, int32_t>> seen(num_epochs);
+  for (int32_t shard_id = 0; shard_id < num_shards; ++shard_id) {
+    ReadShuffledBlocks(files, num_shards, shard_id, num_epochs, num_rows / num_shards, &seen);
+  }
+  for (const auto &epoch : seen) {
+    ASSERT_EQ(epoch.size(), num_rows);
+    for (int64_t value = 1; value <= num_rows; ++value) {
+      auto it = epoch.find(value);
+      ASSERT_NE(it, epoch.end()) << value;
+      EXPECT_EQ(it->second, 1) << value;
+    }
+  }
+}
+
 TEST_F(MindDataTestTFReaderOp, TestTotalRowsBasic) {
   std::string tf_file = datasets_root_path_ + "/testTFTestAllTypes/test.data";
 
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "common/common_test.h"
+
+#include "runtime/device/cpu/cpu_kernel_scheduler.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUKernelScheduler : public UT::Common {
+ public:
+  TestCPUKernelScheduler() {}
+};
+
+namespace {
+kernel::AddressPtr Range(uint8_t *base, size_t offset, size_t size) {
+  return std::make_shared<kernel::Address>(base + offset, size);
+}
+}  // namespace
+
+TEST_F(TestCPUKernelScheduler, test_dag_hazards) {
+  std::vector<uint8_t> mem(256);
+  uint8_t *base = mem.data();
+  std::vector<KernelMemAccess> accesses(5);
+  // 0 writes [0, 64), 1 and 2 read it, 3 writes [32, 96) sharing bytes with the buffer read by 1 and 2
+  accesses[0].writes = {Range(base, 0, 64)};
+  accesses[1].reads = {Range(base, 0, 64)};
+  accesses[1].writes = {Range(base, 128, 32)};
+  accesses[2].reads = {Range(base, 0, 32)};
+  accesses[2].writes = {Range(base, 160, 32)};
+  accesses[3].writes = {Range(base, 32, 64)};
+  // 4 only touches bytes nobody else touches
+  accesses[4].writes = {Range(base, 192, 64)};
+  CPUKernelDag dag;
+  dag.Build(accesses);
+  EXPECT_EQ(dag.roots(), std::vector<size_t>({0, 4}));
+  EXPECT_EQ(dag.successors(0), std::vector<size_t>({1, 2, 3}));
+  EXPECT_EQ(dag.successors(1), std::vector<size_t>({3}));
+  // 2 read [0, 32) which 3 does not write
+  EXPECT_TRUE(dag.successors(2).empty());
+  EXPECT_EQ(dag.dependency_num(3), 2);
+}
+
+TEST_F(TestCPUKernelScheduler, test_dag_shared_weight) {
+  std::vector<uint8_t> mem(256);
+  uint8_t *base = mem.data();
+  std::vector<KernelMemAccess> accesses(3);
+  // 0 and 1 read the same weight, 2 updates it in place as an optimizer does
+  accesses[0].reads = {Range(base, 0, 64)};
+  accesses[0].writes = {Range(base, 64, 64)};
+  accesses[1].reads = {Range(base, 0, 64)};
+  accesses[1].writes = {Range(base, 128, 64)};
+  accesses[2].writes = {Range(base, 0, 64)};
+  CPUKernelDag dag;
+  dag.Build(accesses);
+  EXPECT_EQ(dag.roots(), std::vector<size_t>({0, 1}));
+  EXPECT_EQ(dag.successors(0), std::vector<size_t>({2}));
+  EXPECT_EQ(dag.successors(1), std::vector<size_t>({2}));
+  EXPECT_EQ(dag.dependency_num(2), 2);
+}
+
+TEST_F(TestCPUKernelScheduler, test_dag_serial_kernel) {
+  std::vector<uint8_t> mem(256);
+  uint8_t *base = mem.data();
+  std::vector<KernelMemAccess> accesses(4);
+  accesses[0].writes = {Range(base, 0, 64)};
+  accesses[1].writes = {Range(base, 64, 64)};
+  accesses[2].serial = true;
+  accesses[3].writes = {Range(base, 128, 64)};
+  CPUKernelDag dag;
+  dag.Build(accesses);
+  EXPECT_EQ(dag.roots(), std::vector<size_t>({0, 1}));
+  EXPECT_EQ(dag.dependency_num(2), 2);
+  EXPECT_EQ(dag.successors(2), std::vector<size_t>({3}));
+}
+
+TEST_F(TestCPUKernelScheduler, test_run_order) {
+  // A chain of additions on one buffer next to independent kernels, the chain must keep its order
+  const size_t kChain = 64;
+  std::vector<uint8_t> mem(kChain + 1);
+  std::vector<KernelMemAccess> accesses(2 * kChain);
+  for (size_t k = 0; k < kChain; ++k) {
+    accesses[2 * k].writes = {Range(mem.data(), kChain, 1)};
+    accesses[2 * k + 1].writes = {Range(mem.data(), k, 1)};
+  }
+  CPUKernelDag dag;
+  dag.Build(accesses);
+  CPUKernelScheduler scheduler(4);
+  std::vector<size_t> chain;
+  std::mutex chain_mutex;
+  std::atomic<size_t> launched(0);
+  for (int step = 0; step < 3; ++step) {
+    chain.clear();
+    launched = 0;
+    scheduler.Run(dag, [&](size_t k) {
+      launched++;
+      if (k % 2 == 0) {
+        std::lock_guard<std::mutex> lock(chain_mutex);
+        chain.push_back(k);
+      }
+    });
+    EXPECT_EQ(launched, 2 * kChain);
+    ASSERT_EQ(chain.size(), kChain);
+    for (size_t i = 0; i < kChain; ++i) {
+      EXPECT_EQ(chain[i], 2 * i);
+    }
+  }
+}
+
+TEST_F(TestCPUKernelScheduler, test_run_exception) {
+  std::vector<uint8_t> mem(1);
+  std::vector<KernelMemAccess> accesses(8);
+  for (auto &access : accesses) {
+    access.writes = {Range(mem.data(), 0, 1)};
+  }
+  CPUKernelDag dag;
+  dag.Build(accesses);
+  CPUKernelScheduler scheduler(2);
+  std::atomic<size_t> launched(0);
+  auto launch = [&launched](size_t k) {
+    launched++;
+    if (k == 3) {
+      throw std::runtime_error("launch failed");
+    }
+  };
+  EXPECT_THROW(scheduler.Run(dag, launch), std::runtime_error);
+  // Kernels after the failed one are not launched
+  EXPECT_EQ(launched, 4);
+  // The scheduler is still usable
+  launched = 0;
+  scheduler.Run(dag, [&launched](size_t) { launched++; });
+  EXPECT_EQ(launched, 8);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
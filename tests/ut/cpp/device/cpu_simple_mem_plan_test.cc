@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+
+#include "common/common_test.h"
+
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() {}
+};
+
+TEST_F(TestCPUSimpleMemPlan, test_pack_disjoint_lifetimes) {
+  std::vector<CPUSimpleMemPlan::MemBlock> blocks = {{100, 0, 1, 0}, {100, 2, 3, 0}, {50, 1, 2, 0}};
+  size_t size = CPUSimpleMemPlan::PackBlocks(&blocks);
+  // The first two blocks are never live at the same time
+  EXPECT_EQ(blocks[0].offset, 0);
+  EXPECT_EQ(blocks[1].offset, 0);
+  EXPECT_EQ(blocks[2].offset, 128);
+  EXPECT_EQ(size, 192);
+}
+
+TEST_F(TestCPUSimpleMemPlan, test_pack_fill_gap) {
+  std::vector<CPUSimpleMemPlan::MemBlock> blocks = {{200, 0, 1, 0}, {64, 0, 5, 0}, {64, 2, 3, 0}};
+  size_t size = CPUSimpleMemPlan::PackBlocks(&blocks);
+  // The last block goes where the first one was once it is dead
+  EXPECT_EQ(blocks[0].offset, 0);
+  EXPECT_EQ(blocks[1].offset, 256);
+  EXPECT_EQ(blocks[2].offset, 0);
+  EXPECT_EQ(size, 320);
+}
+
+TEST_F(TestCPUSimpleMemPlan, test_pack_no_conflict) {
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<size_t> size_dist(1, 4096);
+  std::uniform_int_distribution<size_t> start_dist(0, 99);
+  std::uniform_int_distribution<size_t> length_dist(0, 10);
+  std::vector<CPUSimpleMemPlan::MemBlock> blocks;
+  size_t naive_size = 0;
+  for (int i = 0; i < 200; ++i) {
+    size_t start = start_dist(rng);
+    blocks.push_back({size_dist(rng), start, start + length_dist(rng), 0});
+    naive_size += (blocks.back().size + 63) / 64 * 64;
+  }
+  size_t size = CPUSimpleMemPlan::PackBlocks(&blocks);
+  EXPECT_LT(size, naive_size);
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    EXPECT_LE(blocks[i].offset + blocks[i].size, size);
+    for (size_t j = i + 1; j < blocks.size(); ++j) {
+      bool live_together = blocks[i].start <= blocks[j].end && blocks[j].start <= blocks[i].end;
+      bool share_memory = blocks[i].offset < blocks[j].offset + blocks[j].size &&
+                          blocks[j].offset < blocks[i].offset + blocks[i].size;
+      EXPECT_FALSE(live_together && share_memory);
+    }
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
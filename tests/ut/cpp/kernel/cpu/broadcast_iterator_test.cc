@@ -0,0 +1,107 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/broadcast_iterator.h"
+
+namespace mindspore {
+namespace kernel {
+class BroadcastIteratorTest : public UT::Common {
+ public:
+  BroadcastIteratorTest() = default;
+
+  // Offsets of an output item in the inputs, computed one dimension at a time
+  static void NaiveIndex(const std::vector<size_t> &a, const std::vector<size_t> &b, const std::vector<size_t> &out,
+                         size_t pos, size_t *index_a, size_t *index_b) {
+    *index_a = 0;
+    *index_b = 0;
+    size_t stride_a = 1;
+    size_t stride_b = 1;
+    for (size_t d = out.size(); d-- > 0;) {
+      size_t coord = pos % out[d];
+      pos /= out[d];
+      size_t dim_a = d + a.size() >= out.size() ? a[d + a.size() - out.size()] : 1;
+      size_t dim_b = d + b.size() >= out.size() ? b[d + b.size() - out.size()] : 1;
+      *index_a += dim_a > 1 ? coord * stride_a : 0;
+      *index_b += dim_b > 1 ? coord * stride_b : 0;
+      stride_a *= dim_a;
+      stride_b *= dim_b;
+    }
+  }
+
+  static void CheckApply(const std::vector<size_t> &a, const std::vector<size_t> &b, const std::vector<size_t> &out,
+                         size_t start, size_t end) {
+    size_t len_a = 1;
+    size_t len_b = 1;
+    for (auto dim : a) {
+      len_a *= dim;
+    }
+    for (auto dim : b) {
+      len_b *= dim;
+    }
+    std::vector<float> input_a(len_a);
+    std::vector<float> input_b(len_b);
+    for (size_t i = 0; i < len_a; ++i) {
+      input_a[i] = i;
+    }
+    for (size_t i = 0; i < len_b; ++i) {
+      input_b[i] = i;
+    }
+    BroadcastIterator iterator(a, b, out);
+    std::vector<float> output(iterator.output_size(), -1);
+    iterator.Apply(input_a.data(), input_b.data(), output.data(), start, end,
+                   [](float x, float y) { return x * 1000 + y; });
+    for (size_t pos = 0; pos < output.size(); ++pos) {
+      size_t index_a = 0;
+      size_t index_b = 0;
+      NaiveIndex(a, b, out, pos, &index_a, &index_b);
+      float expect = pos >= start && pos < end ? input_a[index_a] * 1000 + input_b[index_b] : -1;
+      EXPECT_EQ(output[pos], expect);
+    }
+  }
+};
+
+TEST_F(BroadcastIteratorTest, test_same_shape) { CheckApply({2, 3, 4}, {2, 3, 4}, {2, 3, 4}, 0, 24); }
+
+TEST_F(BroadcastIteratorTest, test_scalar) {
+  CheckApply({}, {3, 4}, {3, 4}, 0, 12);
+  CheckApply({3, 4}, {}, {3, 4}, 0, 12);
+  CheckApply({}, {}, {}, 0, 1);
+}
+
+TEST_F(BroadcastIteratorTest, test_row_and_column) {
+  CheckApply({3, 1}, {1, 5}, {3, 5}, 0, 15);
+  CheckApply({2, 3, 1, 4}, {3, 5, 1}, {2, 3, 5, 4}, 0, 120);
+}
+
+TEST_F(BroadcastIteratorTest, test_partial_range) {
+  // Ranges starting and ending in the middle of the inner dimension, as given by ParallelFor
+  CheckApply({4, 1, 6}, {1, 3, 6}, {4, 3, 6}, 5, 7);
+  CheckApply({4, 1, 6}, {1, 3, 6}, {4, 3, 6}, 13, 61);
+  CheckApply({4, 1, 6}, {1, 3, 6}, {4, 3, 6}, 30, 30);
+}
+
+TEST_F(BroadcastIteratorTest, test_invalid_shape) {
+  // More dimensions than the output
+  EXPECT_THROW(BroadcastIterator({2, 3, 4}, {3, 4}, {3, 4}), std::runtime_error);
+  // A dimension neither 1 nor the size of the output
+  EXPECT_THROW(BroadcastIterator({2, 3}, {3}, {2, 4}), std::runtime_error);
+  EXPECT_THROW(BroadcastIterator({2, 1}, {2, 3}, {2, 1}), std::runtime_error);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+class CpuParallelForTest : public UT::Common {
+ public:
+  CpuParallelForTest() = default;
+};
+
+TEST_F(CpuParallelForTest, test_cover_all_items) {
+  for (size_t count : {0, 1, 127, 128, 1000, 100003}) {
+    std::vector<int> hits(count, 0);
+    auto task = [&hits](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        hits[i]++;
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, count, 64);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(hits[i], 1);
+    }
+  }
+}
+
+TEST_F(CpuParallelForTest, test_grain_size) {
+  std::atomic_int calls{0};
+  auto task = [&calls](size_t, size_t) { calls++; };
+  // Fewer items than one grain run in a single call
+  CPUKernelUtils::ParallelFor(task, 1000, 4096);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST_F(CpuParallelForTest, test_nested) {
+  const size_t outer = 16;
+  const size_t inner = 1024;
+  std::vector<int> hits(outer * inner, 0);
+  auto task = [&hits, inner](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      auto inner_task = [&hits, i, inner](size_t inner_start, size_t inner_end) {
+        for (size_t j = inner_start; j < inner_end; ++j) {
+          hits[i * inner + j]++;
+        }
+      };
+      CPUKernelUtils::ParallelFor(inner_task, inner, 16);
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, outer, 1);
+  for (auto hit : hits) {
+    EXPECT_EQ(hit, 1);
+  }
+}
+
+TEST_F(CpuParallelForTest, test_task_exception) {
+  const size_t count = 1000;
+  std::atomic_int calls{0};
+  auto task = [&calls](size_t start, size_t end) {
+    calls++;
+    if (start <= count / 2 && count / 2 < end) {
+      throw std::runtime_error("item " + std::to_string(count / 2) + " failed");
+    }
+  };
+  // The exception of the task comes back to the caller, after all the other ranges are done
+  EXPECT_THROW(CPUKernelUtils::ParallelFor(task, count, 64), std::runtime_error);
+  EXPECT_GT(calls, 1);
+  // A single range runs in the calling thread
+  EXPECT_THROW(CPUKernelUtils::ParallelFor(task, count, count), std::runtime_error);
+
+  // The pool runs the next tasks as usual
+  std::vector<int> hits(count, 0);
+  auto cover = [&hits](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      hits[i]++;
+    }
+  };
+  CPUKernelUtils::ParallelFor(cover, count, 64);
+  for (auto hit : hits) {
+    EXPECT_EQ(hit, 1);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -14,18 +14,25 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_category.h"
+#include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_index_file.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
+#include "minddata/mindrecord/include/shard_shuffle.h"
 #include "ut_common.h"
 
 using mindspore::LogStream;
@@ -45,6 +52,7 @@ class TestShardReader : public UT::Common {
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(filename + kIndexFileSuffix));
     }
   }
 };
@@ -243,5 +251,185 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+TEST_F(TestShardReader, TestShardReaderMmap) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet in mmap mode");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name"};
+
+  ShardReader stream_reader;
+  ASSERT_EQ(stream_reader.Open({file_name}, true, 4, column_list), SUCCESS);
+  ASSERT_EQ(stream_reader.Launch(true), SUCCESS);
+
+  ShardReader mmap_reader;
+  mmap_reader.SetUseMmap(true);
+  ASSERT_EQ(mmap_reader.Open({file_name}, true, 4, column_list), SUCCESS);
+  ASSERT_TRUE(mmap_reader.GetUseMmap());
+  ASSERT_EQ(mmap_reader.Launch(true), SUCCESS);
+
+  int count = 0;
+  for (int64_t task_id = 0; task_id < stream_reader.GetNumRows(); ++task_id) {
+    auto expected = stream_reader.GetNextById(task_id, 0).second;
+    auto sliced = mmap_reader.GetNextSliceById(task_id, 0).second;
+    ASSERT_EQ(expected.size(), sliced.size());
+    for (size_t i = 0; i < sliced.size(); ++i) {
+      auto &blob = std::get<0>(expected[i]);
+      auto &slice = std::get<0>(sliced[i]);
+      ASSERT_EQ(blob.size(), slice.second);
+      ASSERT_TRUE(std::equal(blob.begin(), blob.end(), slice.first));
+      ASSERT_EQ(std::get<1>(expected[i]), std::get<1>(sliced[i]));
+    }
+    count++;
+  }
+  ASSERT_EQ(count, 10);
+
+  // the row-reader mode copies out of the mapping
+  auto row = mmap_reader.GetNextById(0, 1).second;
+  ASSERT_EQ(row.size(), 1);
+  stream_reader.Close();
+  mmap_reader.Close();
+}
+
+TEST_F(TestShardReader, TestShardColumnBlobBounds) {
+  MS_LOG(INFO) << FormatInfo("Test blob column lengths past the end of the blob");
+  json schema = R"({"schema": {"a": {"type": "bytes"}, "b": {"type": "bytes"}}, "blob_fields": ["a", "b"]})"_json;
+  ShardColumn column(schema);
+  // "a" holds 2 bytes, "b" holds 3 bytes, each preceded by its big-endian length
+  std::vector<uint8_t> blob = {0, 0, 0, 0, 0, 0, 0, 2, 'x', 'y', 0, 0, 0, 0, 0, 0, 0, 3, 'a', 'b', 'c'};
+  const unsigned char *data = nullptr;
+  std::unique_ptr<unsigned char[]> data_ptr;
+  uint64_t n_bytes = 0;
+  ASSERT_EQ(column.GetColumnFromBlob("b", blob.data(), blob.size(), &data, &data_ptr, &n_bytes), SUCCESS);
+  ASSERT_EQ(n_bytes, 3);
+  ASSERT_EQ(data, blob.data() + 18);
+
+  // The length of "b" is cut off
+  ASSERT_EQ(column.GetColumnFromBlob("b", blob.data(), 14, &data, &data_ptr, &n_bytes), FAILED);
+  // The data of "b" is cut off
+  ASSERT_EQ(column.GetColumnFromBlob("b", blob.data(), 20, &data, &data_ptr, &n_bytes), FAILED);
+  // The length of "a" points past the blob, the length of "b" must not be read from there
+  blob[7] = 0xff;
+  ASSERT_EQ(column.GetColumnFromBlob("b", blob.data(), blob.size(), &data, &data_ptr, &n_bytes), FAILED);
+}
+
+TEST_F(TestShardReader, TestShardReaderPrefetch) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with prefetch");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name"};
+
+  ShardReader stream_reader;
+  ASSERT_EQ(stream_reader.Open({file_name}, true, 4, column_list), SUCCESS);
+  ASSERT_EQ(stream_reader.Launch(true), SUCCESS);
+
+  ShardReader prefetch_reader;
+  prefetch_reader.SetUsePrefetch(true);
+  ASSERT_EQ(prefetch_reader.Open({file_name}, true, 4, column_list), SUCCESS);
+  ASSERT_EQ(prefetch_reader.Launch(true), SUCCESS);
+
+  // submit every other task, the rest are read by the consumer itself
+  std::vector<int64_t> task_ids;
+  for (int64_t task_id = 0; task_id < prefetch_reader.GetNumRows(); task_id += 2) {
+    task_ids.push_back(task_id);
+  }
+  task_ids.push_back(prefetch_reader.GetNumRows());
+  prefetch_reader.Prefetch(task_ids);
+
+  int count = 0;
+  for (int64_t task_id = stream_reader.GetNumRows() - 1; task_id >= 0; --task_id) {
+    auto expected = stream_reader.GetNextById(task_id, 0).second;
+    auto prefetched = prefetch_reader.GetNextById(task_id, 0).second;
+    ASSERT_EQ(expected.size(), 1);
+    ASSERT_EQ(expected, prefetched);
+    count++;
+  }
+  ASSERT_EQ(count, 10);
+  stream_reader.Close();
+  prefetch_reader.Close();
+}
+TEST_F(TestShardReader, TestShardReaderPrefetchReshuffle) {
+  MS_LOG(INFO) << FormatInfo("Test reshuffle while prefetch threads are reading");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name"};
+  std::vector<std::shared_ptr<ShardOperator>> ops = {std::make_shared<ShardShuffle>(1)};
+
+  ShardReader prefetch_reader;
+  prefetch_reader.SetUsePrefetch(true);
+  ASSERT_EQ(prefetch_reader.Open({file_name}, true, 4, column_list, ops), SUCCESS);
+  ASSERT_EQ(prefetch_reader.Launch(true), SUCCESS);
+  auto num_rows = prefetch_reader.GetNumRows();
+  std::vector<int64_t> task_ids;
+  for (int64_t task_id = 0; task_id < num_rows; ++task_id) {
+    task_ids.push_back(task_id);
+  }
+
+  std::set<std::string> expected;
+  for (int epoch = 0; epoch < 50; ++epoch) {
+    // the tasks are swapped while the reads of the previous epoch are still in flight
+    prefetch_reader.Prefetch(task_ids);
+    prefetch_reader.ShuffleTask();
+    prefetch_reader.Prefetch(task_ids);
+    std::set<std::string> file_names;
+    for (int64_t task_id = 0; task_id < num_rows; ++task_id) {
+      auto row = prefetch_reader.GetNextById(task_id, 0).second;
+      ASSERT_EQ(row.size(), 1);
+      file_names.insert(std::get<1>(row[0])["file_name"].get<std::string>());
+    }
+    ASSERT_EQ(file_names.size(), static_cast<size_t>(num_rows));
+    if (epoch == 0) {
+      expected = file_names;
+    }
+    ASSERT_EQ(file_names, expected);
+  }
+  prefetch_reader.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderIndexFile) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with index file");
+  std::string file_name = "./imagenet.shard01";
+  ASSERT_TRUE(std::ifstream(file_name + kIndexFileSuffix).good());
+
+  auto read_all = [&file_name](const std::vector<std::shared_ptr<ShardOperator>> &ops) {
+    std::vector<std::string> rows;
+    ShardReader dataset;
+    EXPECT_EQ(dataset.Open({file_name}, true, 4, {"file_name", "label"}, ops), SUCCESS);
+    dataset.Launch();
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      for (auto &j : x) {
+        rows.emplace_back(std::get<1>(j).dump());
+      }
+    }
+    dataset.Close();
+    return rows;
+  };
+  std::vector<std::pair<std::string, std::string>> categories = {{"label", "257"}, {"label", "302"}};
+  std::vector<std::shared_ptr<ShardOperator>> ops = {std::make_shared<ShardCategory>(categories)};
+  std::vector<std::pair<std::string, std::string>> numeric_categories = {{"label", "257.0"}, {"label", "0302"}};
+  std::vector<std::shared_ptr<ShardOperator>> numeric_ops = {std::make_shared<ShardCategory>(numeric_categories)};
+
+  // rows located by the index file must be the same as the ones located by sqlite
+  auto all_rows = read_all({});
+  auto category_rows = read_all(ops);
+  ASSERT_EQ(read_all(numeric_ops), category_rows);
+  std::set<std::string> classes;
+  ShardReader dataset;
+  dataset.Open({file_name}, true, 4);
+  ASSERT_EQ(dataset.GetAllClasses("label", classes), SUCCESS);
+  dataset.Close();
+  ASSERT_FALSE(all_rows.empty());
+  ASSERT_FALSE(category_rows.empty());
+
+  remove(common::SafeCStr(file_name + kIndexFileSuffix));
+  ASSERT_EQ(read_all({}), all_rows);
+  ASSERT_EQ(read_all(ops), category_rows);
+  ASSERT_EQ(read_all(numeric_ops), category_rows);
+  std::set<std::string> sqlite_classes;
+  ShardReader sqlite_dataset;
+  sqlite_dataset.Open({file_name}, true, 4);
+  ASSERT_EQ(sqlite_dataset.GetAllClasses("label", sqlite_classes), SUCCESS);
+  ASSERT_EQ(sqlite_classes, classes);
+  sqlite_dataset.Close();
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -14,16 +14,24 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <random>
+#include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_category.h"
+#include "minddata/mindrecord/include/shard_codec.h"
+#include "minddata/mindrecord/include/shard_index_file.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_writer.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
@@ -866,6 +874,71 @@ TEST_F(TestShardWriter, TestShardNoBlob) {
   }
 }
 
+TEST_F(TestShardWriter, TestShardReaderFloatColumnInIndex) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read float32 in index"));
+
+  std::vector<std::vector<uint8_t>> bin_data;
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json = R"({"file_name": {"type": "string"}, "score": {"type": "float32"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(anno_schema_id, 0);
+  std::vector<std::pair<uint64_t, std::string>> fields;
+  fields.emplace_back(anno_schema_id, "file_name");
+  fields.emplace_back(anno_schema_id, "score");
+  ASSERT_EQ(header_data.AddIndexFields(fields), SUCCESS);
+
+  std::vector<json> annotations;
+  for (int i = 0; i < 10; i++) {
+    annotations.push_back(json{{"file_name", "image_" + std::to_string(i)}, {"score", i % 2 == 0 ? 1.0 : 0.5}});
+  }
+  std::map<std::uint64_t, std::vector<json>> rawdatas;
+  rawdatas.insert(pair<uint64_t, vector<json>>(anno_schema_id, annotations));
+
+  std::string filename = "./float_index.shard01";
+  mindrecord::ShardWriter fw_init;
+  ASSERT_TRUE(fw_init.Open({filename}) == SUCCESS);
+  ASSERT_TRUE(fw_init.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+  ASSERT_TRUE(fw_init.WriteRawData(rawdatas, bin_data) == SUCCESS);
+  ASSERT_TRUE(fw_init.Commit() == SUCCESS);
+  mindrecord::ShardIndexGenerator sg{filename};
+  sg.Build();
+  ASSERT_TRUE(sg.WriteToDatabase() == SUCCESS);
+
+  // the text of a float key does not compare the way sqlite compares numbers, so no index file is written
+  ASSERT_FALSE(std::ifstream(filename + kIndexFileSuffix).good());
+
+  auto count_rows = [&filename](const std::string &score) {
+    std::vector<std::pair<std::string, std::string>> categories = {{"score", score}};
+    std::vector<std::shared_ptr<ShardOperator>> ops = {std::make_shared<ShardCategory>(categories)};
+    ShardReader dataset;
+    EXPECT_EQ(dataset.Open({filename}, true, 4, {"file_name", "score"}, ops), SUCCESS);
+    dataset.Launch();
+    int count = 0;
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      count += static_cast<int>(x.size());
+    }
+    dataset.Close();
+    return count;
+  };
+  ASSERT_EQ(count_rows("1"), 5);
+  ASSERT_EQ(count_rows("1.0"), 5);
+  ASSERT_EQ(count_rows("0.5"), 5);
+
+  std::set<std::string> classes;
+  ShardReader dataset;
+  dataset.Open({filename}, true, 4);
+  ASSERT_EQ(dataset.GetAllClasses("score", classes), SUCCESS);
+  ASSERT_EQ(classes.size(), 2);
+  dataset.Close();
+
+  remove(common::SafeCStr(filename + ".db"));
+  remove(common::SafeCStr(filename));
+}
+
 TEST_F(TestShardWriter, TestShardReaderStringAndNumberNotColumnInIndex) {
   MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet int32 is in index"));
 
@@ -1136,5 +1209,236 @@ TEST_F(TestShardWriter, TestOpenForAppend) {
   }
 }
 
+TEST_F(TestShardWriter, TestShardColumnRawRow) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test layout of columnar raw row"));
+  json schema = R"({"schema": {"f": {"type": "float64"}, "i": {"type": "int64"}, "s": {"type": "string"}},
+                   "blob_fields": []})"_json;
+  mindrecord::ShardColumn column(schema);
+  json row = R"({"f": 1.5, "i": -2, "s": "ab"})"_json;
+  std::vector<uint8_t> raw_row;
+  ASSERT_EQ(column.SerializeRawRow(row, &raw_row), SUCCESS);
+  // column count, f, i, end offset of s, then the string, all big-endian
+  std::vector<uint8_t> expected = {0, 0, 0, 3, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                   0xff, 0xfe, 0, 0, 0, 2, 'a', 'b'};
+  ASSERT_EQ(raw_row, expected);
+  json decoded;
+  ASSERT_EQ(column.DeserializeRawRow(raw_row.data(), raw_row.size(), {}, &decoded), SUCCESS);
+  ASSERT_EQ(decoded, row);
+
+  // a string column only takes strings
+  row["s"] = 5;
+  ASSERT_EQ(column.SerializeRawRow(row, &raw_row), FAILED);
+}
+
+TEST_F(TestShardWriter, TestShardWriterColumnarRawPage) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test columnar raw page"));
+
+  std::vector<std::vector<uint8_t>> bin_data;
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(anno_schema_id, 0);
+  std::vector<std::pair<uint64_t, std::string>> fields;
+  fields.emplace_back(anno_schema_id, "label");
+  ASSERT_EQ(header_data.AddIndexFields(fields), SUCCESS);
+
+  std::vector<json> annotations;
+  LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+  std::map<std::uint64_t, std::vector<json>> rawdatas;
+  rawdatas.insert(pair<uint64_t, vector<json>>(anno_schema_id, annotations));
+
+  std::vector<std::string> file_names = {"./columnar.shard01", "./columnar.shard02"};
+  mindrecord::ShardWriter fw_init;
+  ASSERT_TRUE(fw_init.Open(file_names) == SUCCESS);
+  ASSERT_TRUE(fw_init.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+  ASSERT_TRUE(fw_init.SetColumnarRawPage(true) == SUCCESS);
+  ASSERT_TRUE(fw_init.WriteRawData(rawdatas, bin_data) == SUCCESS);
+  // layout can not be changed once raw pages exist
+  ASSERT_TRUE(fw_init.SetColumnarRawPage(false) == FAILED);
+  ASSERT_TRUE(fw_init.Commit() == SUCCESS);
+
+  mindrecord::ShardIndexGenerator sg{file_names[0]};
+  ASSERT_TRUE(sg.Build() == SUCCESS);
+  ASSERT_TRUE(sg.WriteToDatabase() == SUCCESS);
+
+  std::set<std::string> expected;
+  for (const auto &annotation : annotations) {
+    expected.insert(annotation["file_name"].get<std::string>());
+  }
+
+  // only file_name is decoded from the raw page, label comes from the index
+  auto column_list = std::vector<std::string>{"file_name"};
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open({file_names[0]}, true, 4, column_list), SUCCESS);
+  ASSERT_EQ(dataset.GetShardHeader()->GetRawLayout(), kRawLayoutColumn);
+  dataset.Launch();
+
+  std::set<std::string> actual;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    for (auto &j : x) {
+      json resp = std::get<1>(j);
+      ASSERT_EQ(resp.size(), 1);
+      actual.insert(resp["file_name"].get<std::string>());
+    }
+  }
+  ASSERT_EQ(actual, expected);
+  dataset.Close();
+  for (const auto &filename : file_names) {
+    auto filename_db = filename + ".db";
+    remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename));
+  }
+}
+
+TEST_F(TestShardWriter, TestShardWriterPageCodec) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test zlib codec of blob page"));
+  ASSERT_TRUE(ShardCodec::Create(kCodecZlib) != nullptr) << "Zlib codec is not built in.";
+
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(anno_schema_id, 0);
+
+  std::vector<json> annotations;
+  LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+
+  // even rows compress well, odd rows are incompressible and stored as is
+  std::mt19937 gen(0);
+  std::map<std::string, std::vector<uint8_t>> expected;
+  std::vector<std::vector<uint8_t>> bin_data;
+  for (size_t i = 0; i < annotations.size(); ++i) {
+    std::vector<uint8_t> blob(4096 + i, static_cast<uint8_t>(i));
+    if (i % 2 == 1) {
+      std::generate(blob.begin(), blob.end(), [&gen]() { return static_cast<uint8_t>(gen()); });
+    }
+    expected[annotations[i]["file_name"].get<std::string>()] = blob;
+    bin_data.push_back(blob);
+  }
+  std::map<std::uint64_t, std::vector<json>> rawdatas;
+  rawdatas.insert(pair<uint64_t, vector<json>>(anno_schema_id, annotations));
+
+  std::vector<std::string> file_names = {"./codec.shard01", "./codec.shard02"};
+  mindrecord::ShardWriter fw_init;
+  ASSERT_TRUE(fw_init.Open(file_names) == SUCCESS);
+  ASSERT_TRUE(fw_init.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+  ASSERT_TRUE(fw_init.SetPageCodec("unknown") == FAILED);
+  ASSERT_TRUE(fw_init.SetPageCodec(kCodecZlib) == SUCCESS);
+  ASSERT_TRUE(fw_init.WriteRawData(rawdatas, bin_data) == SUCCESS);
+  // codec can not be changed once blob pages exist
+  ASSERT_TRUE(fw_init.SetPageCodec(kCodecNone) == FAILED);
+  ASSERT_TRUE(fw_init.Commit() == SUCCESS);
+
+  mindrecord::ShardIndexGenerator sg{file_names[0]};
+  ASSERT_TRUE(sg.Build() == SUCCESS);
+  ASSERT_TRUE(sg.WriteToDatabase() == SUCCESS);
+
+  auto column_list = std::vector<std::string>{"file_name", "data"};
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open({file_names[0]}, true, 4, column_list), SUCCESS);
+  ASSERT_EQ(dataset.GetShardHeader()->GetPageCodec(), kCodecZlib);
+  dataset.Launch();
+
+  int count = 0;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    for (auto &j : x) {
+      auto file_name = std::get<1>(j)["file_name"].get<std::string>();
+      ASSERT_EQ(std::get<0>(j), expected[file_name]);
+      count++;
+    }
+  }
+  ASSERT_EQ(count, 10);
+  dataset.Close();
+  for (const auto &filename : file_names) {
+    auto filename_db = filename + ".db";
+    remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename));
+  }
+}
+
+TEST_F(TestShardWriter, TestShardWriterStreaming) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test write in streaming mode"));
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  header_data.AddIndexFields({{anno_schema_id, "label"}});
+
+  std::vector<std::string> file_names = {"./streaming.shard01", "./streaming.shard02"};
+  mindrecord::ShardWriter fw;
+  ASSERT_TRUE(fw.Open(file_names) == SUCCESS);
+  ASSERT_TRUE(fw.SetPageSize(1 << 15) == SUCCESS);
+  ASSERT_TRUE(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+  ASSERT_TRUE(fw.SetStreamingMode(true) == SUCCESS);
+
+  // several batches, so that rows are cut into pages while the next batch is serialized
+  std::map<std::string, std::vector<uint8_t>> expected;
+  for (int batch = 0; batch < 3; ++batch) {
+    std::vector<json> annotations;
+    LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+    std::vector<std::vector<uint8_t>> bin_data;
+    for (size_t i = 0; i < annotations.size(); ++i) {
+      annotations[i]["file_name"] = annotations[i]["file_name"].get<std::string>() + std::to_string(batch);
+      std::vector<uint8_t> blob(4000 + i, static_cast<uint8_t>(i + batch));
+      expected[annotations[i]["file_name"].get<std::string>()] = blob;
+      bin_data.push_back(blob);
+    }
+    std::map<std::uint64_t, std::vector<json>> rawdatas;
+    rawdatas.insert(pair<uint64_t, vector<json>>(anno_schema_id, annotations));
+    ASSERT_TRUE(fw.WriteRawData(rawdatas, bin_data) == SUCCESS);
+    ASSERT_TRUE(fw.WriteRawData(rawdatas, bin_data, true, true) == FAILED);
+  }
+  // the index is generated by Commit in streaming mode
+  ASSERT_TRUE(fw.Commit() == SUCCESS);
+
+  auto read_all = [&file_names]() {
+    std::vector<std::tuple<std::vector<uint8_t>, std::string>> rows;
+    ShardReader dataset;
+    EXPECT_EQ(dataset.Open({file_names[0]}, true, 4, {"file_name", "label", "data"}), SUCCESS);
+    dataset.Launch();
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      for (auto &j : x) {
+        rows.emplace_back(std::get<0>(j), std::get<1>(j).dump());
+      }
+    }
+    dataset.Close();
+    return rows;
+  };
+  auto rows = read_all();
+  ASSERT_EQ(rows.size(), expected.size());
+  for (const auto &row : rows) {
+    auto file_name = json::parse(std::get<1>(row))["file_name"].get<std::string>();
+    ASSERT_EQ(std::get<0>(row), expected[file_name]);
+  }
+
+  // index generated from the collected rows must be the same as the one read back from the files
+  for (const auto &filename : file_names) {
+    remove(common::SafeCStr(filename + ".db"));
+    remove(common::SafeCStr(filename + kIndexFileSuffix));
+  }
+  mindrecord::ShardIndexGenerator sg{file_names[0]};
+  ASSERT_TRUE(sg.Build() == SUCCESS);
+  ASSERT_TRUE(sg.WriteToDatabase() == SUCCESS);
+  ASSERT_EQ(read_all(), rows);
+
+  for (const auto &filename : file_names) {
+    remove(common::SafeCStr(filename + ".db"));
+    remove(common::SafeCStr(filename + kIndexFileSuffix));
+    remove(common::SafeCStr(filename));
+  }
+}
+
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -12,7 +12,10 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import os
 import random
+import shutil
+import tempfile
 import pytest
 import numpy as np
 import mindspore.dataset as ds
@@ -237,6 +240,31 @@ def test_graphdata_getedgefeature():
     assert features[1].shape == (40,)
 
 
+def test_graphdata_savecsr():
+    """
+    Test the graph loaded from the saved csr file gives the same neighbors and features
+    """
+    logger.info('test save csr.\n')
+    temp_dir = tempfile.mkdtemp()
+    try:
+        for name in ("testdata", "testdata.db"):
+            shutil.copy(os.path.join(os.path.dirname(DATASET_FILE), name), temp_dir)
+        dataset_file = os.path.join(temp_dir, "testdata")
+        g = ds.GraphData(dataset_file, 2)
+        nodes = g.get_all_nodes(1)
+        neighbor = g.get_all_neighbors(nodes, 2)
+        features = g.get_node_feature(nodes, [2, 3])
+        g.save_csr()
+        assert os.path.exists(dataset_file + ".csr")
+
+        g2 = ds.GraphData(dataset_file, 2)
+        assert np.array_equal(g2.get_all_neighbors(nodes, 2), neighbor)
+        for actual, expected in zip(g2.get_node_feature(nodes, [2, 3]), features):
+            assert np.array_equal(actual, expected)
+    finally:
+        shutil.rmtree(temp_dir)
+
+
 if __name__ == '__main__':
     test_graphdata_getfullneighbor()
     test_graphdata_getnodefeature_input_check()
@@ -247,3 +275,4 @@ if __name__ == '__main__':
     test_graphdata_randomwalkdefault()
     test_graphdata_randomwalk()
     test_graphdata_getedgefeature()
+    test_graphdata_savecsr()
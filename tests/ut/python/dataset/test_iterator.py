@@ -180,8 +180,35 @@ def test_tree_copy():
     itr.release()
 
 
+def test_iterator_checkpoint():
+    """
+    Test restoring an iterator from the checkpoint of another iterator over the same pipeline
+    """
+    data = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["col_sint64"], shuffle=False)
+    expected = [item[0] for item in data.create_tuple_iterator(num_epochs=1, output_numpy=True)]
+
+    itr1 = data.create_tuple_iterator(num_epochs=1, output_numpy=True)
+    for _ in range(5):
+        next(itr1)
+    checkpoint = itr1.get_checkpoint()
+    itr1.release()
+
+    itr2 = data.create_tuple_iterator(num_epochs=1, output_numpy=True)
+    itr2.restore(checkpoint)
+    actual = [item[0] for item in itr2]
+    assert len(actual) == len(expected) - 5
+    assert all([np.array_equal(d1, d2) for d1, d2 in zip(actual, expected[5:])])
+
+    itr3 = data.create_tuple_iterator(num_epochs=1, output_numpy=True)
+    with pytest.raises(RuntimeError) as info:
+        itr3.restore("not a checkpoint")
+    assert "Invalid checkpoint" in str(info.value)
+    itr3.release()
+
+
 if __name__ == '__main__':
     test_iterator_create_tuple_numpy()
     test_iterator_weak_ref()
     test_iterator_exception()
     test_tree_copy()
+    test_iterator_checkpoint()
@@ -14,12 +14,14 @@
 # ============================================================================
 """test mindrecord base"""
 import os
+import stat
 import uuid
 import numpy as np
+import pytest
 from utils import get_data, get_nlp_data
 
 from mindspore import log as logger
-from mindspore.mindrecord import FileWriter, FileReader, MindPage, SUCCESS
+from mindspore.mindrecord import FileWriter, FileReader, MindPage, SUCCESS, ParamValueError
 
 FILES_NUM = 4
 CV_FILE_NAME = "./imagenet.mindrecord"
@@ -79,6 +81,83 @@ def test_write_read_process():
     os.remove("{}.db".format(mindrecord_file_name))
 
 
+def test_write_read_process_with_columnar_raw_page():
+    mindrecord_file_name = "test_columnar.mindrecord"
+    data = [{"file_name": "001.jpg", "label": -43, "score": 0.8, "data": bytes("image bytes abc", encoding='UTF-8')},
+            {"file_name": "002.jpg", "label": 91, "score": -5.4, "data": bytes("image bytes def", encoding='UTF-8')},
+            {"file_name": "", "label": 0, "score": 6.4, "data": bytes("image bytes ghi", encoding='UTF-8')}]
+    writer = FileWriter(mindrecord_file_name)
+    schema = {"file_name": {"type": "string"},
+              "label": {"type": "int32"},
+              "score": {"type": "float64"},
+              "data": {"type": "bytes"}}
+    writer.add_schema(schema, "data is so cool")
+    writer.set_columnar_raw_page(True)
+    writer.write_raw_data(data)
+    writer.commit()
+
+    reader = FileReader(mindrecord_file_name)
+    count = 0
+    for index, x in enumerate(reader.get_next()):
+        assert len(x) == 4
+        for field in x:
+            assert x[field] == data[count][field]
+        count = count + 1
+        logger.info("#item{}: {}".format(index, x))
+    assert count == 3
+    reader.close()
+
+    os.remove("{}".format(mindrecord_file_name))
+    os.remove("{}.db".format(mindrecord_file_name))
+    os.remove("{}.idx".format(mindrecord_file_name))
+
+
+def test_write_read_process_with_page_codec():
+    mindrecord_file_name = "test_codec.mindrecord"
+    data = [{"file_name": "001.jpg", "label": 43, "data": bytes("image bytes abc" * 100, encoding='UTF-8')},
+            {"file_name": "002.jpg", "label": 91, "data": os.urandom(1000)},
+            {"file_name": "003.jpg", "label": 61, "data": bytes("", encoding='UTF-8')}]
+    writer = FileWriter(mindrecord_file_name)
+    schema = {"file_name": {"type": "string"},
+              "label": {"type": "int32"},
+              "data": {"type": "bytes"}}
+    writer.add_schema(schema, "data is so cool")
+    with pytest.raises(ParamValueError):
+        writer.set_page_codec("lz4")
+    writer.set_page_codec("zlib")
+    writer.write_raw_data(data)
+    writer.commit()
+
+    reader = FileReader(mindrecord_file_name)
+    count = 0
+    for index, x in enumerate(reader.get_next()):
+        assert len(x) == 3
+        for field in x:
+            assert x[field] == data[count][field]
+        count = count + 1
+        logger.info("#item{}: {}".format(index, x))
+    assert count == 3
+    reader.close()
+
+    os.remove("{}".format(mindrecord_file_name))
+    os.remove("{}.db".format(mindrecord_file_name))
+    os.remove("{}.idx".format(mindrecord_file_name))
+
+
+def test_write_file_mode():
+    mindrecord_file_name = "test_mode.mindrecord"
+    data = [{"file_name": "001.jpg", "label": 43}, {"file_name": "002.jpg", "label": 91}]
+    writer = FileWriter(mindrecord_file_name)
+    writer.add_schema({"file_name": {"type": "string"}, "label": {"type": "int32"}}, "data is so cool")
+    writer.add_index(["label"])
+    writer.write_raw_data(data)
+    writer.commit()
+
+    for file_name in (mindrecord_file_name, mindrecord_file_name + ".db", mindrecord_file_name + ".idx"):
+        assert stat.S_IMODE(os.stat(file_name).st_mode) == stat.S_IRUSR | stat.S_IWUSR
+        os.remove(file_name)
+
+
 def test_write_read_process_with_define_index_field():
     mindrecord_file_name = "test.mindrecord"
     data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),